@@ -32,6 +32,7 @@ __version__ = '0.17.0'
 SCRIPT_DIR = os.path.dirname(os.path.realpath(__file__))
 
 # Error codes.
+EIO                       = 5
 EINVAL                    = 22
 ERANGE                    = 34
 EPROTO                    = 71
@@ -44,8 +45,11 @@ EFLASHWRITE               = 1008
 EFLASHERASE               = 1009
 EENTERSERIALEXECUTIONMODE = 10000
 ERAMAPPUPLOAD             = 10001
+ECLOCKCALIBRATION         = 10002
+EVERIFY                   = 10003
 
 ERROR_CODE_MESSAGE = {
+    -EIO: "programmer flash access failed",
     -EINVAL: "invalid argument",
     -ERANGE: "bad value, likely a memory address out of range",
     -EPROTO: "communication between programmer and PIC failed",
@@ -57,7 +61,9 @@ ERROR_CODE_MESSAGE = {
     -EFLASHWRITE: "flash write failed",
     -EFLASHERASE: "flash erase failed",
     -EENTERSERIALEXECUTIONMODE: "enter serial execution mode failed",
-    -ERAMAPPUPLOAD: "ramapp (PE) upload failed"
+    -ERAMAPPUPLOAD: "ramapp (PE) upload failed",
+    -ECLOCKCALIBRATION: "ICSP clock calibration failed",
+    -EVERIFY: "flash verify failed"
 }
 
 # Command types. Anything less than zero is error codes.
@@ -67,7 +73,11 @@ COMMAND_TYPE_ERASE  =  2
 COMMAND_TYPE_READ   =  3
 COMMAND_TYPE_WRITE  =  4
 
-PROGRAMMER_COMMAND_TYPE_FAST_WRITE_ACK = 0
+# Command types handled by ramapp extension modules.
+COMMAND_TYPE_BLANK_CHECK = 7
+
+PROGRAMMER_COMMAND_TYPE_FAST_WRITE_CREDITS = 0
+PROGRAMMER_COMMAND_TYPE_FAST_READ_DATA = 0
 PROGRAMMER_COMMAND_TYPE_PING           =  100
 PROGRAMMER_COMMAND_TYPE_CONNECT        =  101
 PROGRAMMER_COMMAND_TYPE_DISCONNECT     =  102
@@ -76,12 +86,137 @@ PROGRAMMER_COMMAND_TYPE_DEVICE_STATUS  =  104
 PROGRAMMER_COMMAND_TYPE_CHIP_ERASE     =  105
 PROGRAMMER_COMMAND_TYPE_FAST_WRITE     =  106
 PROGRAMMER_COMMAND_TYPE_VERSION        =  107
+PROGRAMMER_COMMAND_TYPE_TARGETS_STATUS =  108
+PROGRAMMER_COMMAND_TYPE_READ_WORDS     =  109
+PROGRAMMER_COMMAND_TYPE_CAPABILITIES   =  110
+PROGRAMMER_COMMAND_TYPE_STAGE          =  111
+PROGRAMMER_COMMAND_TYPE_STAGED_WRITE   =  112
+PROGRAMMER_COMMAND_TYPE_PRODUCTION_STORE  = 113
+PROGRAMMER_COMMAND_TYPE_PRODUCTION_ENABLE = 114
+PROGRAMMER_COMMAND_TYPE_PRODUCTION_STATUS = 115
+PROGRAMMER_COMMAND_TYPE_JOB               = 116
+PROGRAMMER_COMMAND_TYPE_STATS             = 117
+PROGRAMMER_COMMAND_TYPE_TRACE_CONTROL     = 118
+PROGRAMMER_COMMAND_TYPE_TRACE_READ        = 119
+PROGRAMMER_COMMAND_TYPE_FAST_READ         = 120
+
+# Size field of packets with a 32 bits size after the size field.
+SIZE_EXTENDED = 0xffff
+
+# Optional commands in the capabilities response.
+CAPABILITIES_COMMANDS = [
+    'blank_check',
+    'read_words',
+    'targets_status',
+    'staging',
+    'production',
+    'job',
+    'trace',
+    'row_errors',
+    'fast_read'
+]
+
+# ICSP transports in the programmer.
+TRANSPORTS = {
+    'icsp_soft': 0,
+    'icsp_spi': 1,
+    'jtag_soft': 2,
+    'icsp_gang': 3
+}
+
+GANG_TARGETS_MAX = 8
+
+# Devices in a JTAG scan chain.
+JTAG_CHAIN_DEVICES_MAX = 4
+JTAG_IR_LENGTH_PIC32 = 5
+
+# The programmer vendor specific USB interface, an alternative to the
+# serial port.
+USB_VID = 0x2341
+USB_PID = 0x003e
+USB_VENDOR_ENDPOINT_OUT = 0x04
+USB_VENDOR_ENDPOINT_IN = 0x85
+USB_VENDOR_ENDPOINT_DATA_OUT = 0x06
+USB_VENDOR_PACKET_SIZE = 512
 
 ERASE_TIMEOUT = 5
 SERIAL_TIMEOUT = 1
 
 READ_CHUNK_SIZE = 504
 FAST_WRITE_SIZE = 256
+FLASH_PAGE_SIZE = 2048
+
+# Fast write and staged write request flags.
+FAST_WRITE_FLAG_REPORT_FAILED_ROWS = (1 << 0)
+
+# Segments of rows written by the programmer on its own are limited in
+# size so that the programmer can verify each of them within the
+# ramapp response timeout.
+SEGMENT_SIZE_MAX = 16384
+
+# Production mode.
+PRODUCTION_FLAG_CHIP_ERASE = (1 << 0)
+PRODUCTION_FLAG_VERIFY = (1 << 1)
+PRODUCTION_STORE_SIZE = 512
+
+# Programmer performance counter phases, in the stats response.
+STATS_PHASES = [
+    'Receive wait',
+    'ICSP shifting',
+    'PRACC polling',
+    'FASTDATA wait',
+    'CRC',
+    'Chip erase poll'
+]
+
+# ICSP trace entry kinds and flags.
+TRACE_KIND_COMMAND         = 0
+TRACE_KIND_INSTRUCTION     = 1
+TRACE_KIND_DATA            = 2
+TRACE_KIND_FAST_DATA_WRITE = 3
+TRACE_KIND_FAST_DATA_READ  = 4
+TRACE_KIND_REPLAY          = 5
+TRACE_KIND_MASK            = 0x0f
+TRACE_FLAG_ETAP            = 0x40
+TRACE_FLAG_PRACC           = 0x80
+
+TRACE_KIND_NAMES = [
+    'command',
+    'instruction',
+    'data',
+    'fast_data_write',
+    'fast_data_read',
+    'replay'
+]
+
+TRACE_ENTRY_SIZE = 12
+
+# Trace timestamps are in programmer CPU cycles.
+TRACE_CYCLES_PER_US = 84
+
+# The ETAP control register instruction, polled for PrAcc.
+ETAP_CONTROL = 0x0a
+
+# TAP clocks moving from Run-Test/Idle to Shift-IR or Shift-DR, and
+# from the last shifted bit back to Run-Test/Idle.
+TAP_INSTRUCTION_OVERHEAD_CLOCKS = 6
+TAP_DATA_OVERHEAD_CLOCKS = 5
+
+# Job steps.
+JOB_STEP_CHIP_ERASE = 1
+JOB_STEP_CONNECT = 2
+JOB_STEP_WRITE = 3
+JOB_STEP_VERIFY = 4
+JOB_STEP_DISCONNECT = 5
+JOB_STEPS_MAX = 64
+
+JOB_STEP_NAMES = {
+    JOB_STEP_CHIP_ERASE: 'chip erase',
+    JOB_STEP_CONNECT: 'connect',
+    JOB_STEP_WRITE: 'write',
+    JOB_STEP_VERIFY: 'verify',
+    JOB_STEP_DISCONNECT: 'disconnect'
+}
 
 PROGRAM_FLASH_ADDRESS       = 0x1d000000
 PROGRAM_FLASH_SIZE          = 0x00040000
@@ -100,11 +235,12 @@ UDID_ADDRESS                = 0x1fc41840
 
 COMMAND_TYPE_TO_STRING = {
     -1: 'FAILED',
-    0: 'PROGRAMMER_FAST_WRITE_ACK',
+    0: 'PROGRAMMER_FAST_WRITE_CREDITS',
     1: 'PING',
     2: 'ERASE',
     3: 'READ',
     4: 'WRITE',
+    7: 'BLANK_CHECK',
     100: 'PROGRAMMER_PING',
     101: 'PROGRAMMER_CONNECT',
     102: 'PROGRAMMER_DISCONNECT',
@@ -112,7 +248,19 @@ COMMAND_TYPE_TO_STRING = {
     104: 'PROGRAMMER_DEVICE_STATUS',
     105: 'PROGRAMMER_CHIP_ERASE',
     106: 'PROGRAMMER_FAST_WRITE',
-    107: 'PROGRAMMER_VERSION'
+    107: 'PROGRAMMER_VERSION',
+    108: 'PROGRAMMER_TARGETS_STATUS',
+    109: 'PROGRAMMER_READ_WORDS',
+    110: 'PROGRAMMER_CAPABILITIES',
+    111: 'PROGRAMMER_STAGE',
+    112: 'PROGRAMMER_STAGED_WRITE',
+    113: 'PROGRAMMER_PRODUCTION_STORE',
+    114: 'PROGRAMMER_PRODUCTION_ENABLE',
+    115: 'PROGRAMMER_PRODUCTION_STATUS',
+    116: 'PROGRAMMER_JOB',
+    117: 'PROGRAMMER_STATS',
+    118: 'PROGRAMMER_TRACE_CONTROL',
+    119: 'PROGRAMMER_TRACE_READ'
 }
 
 RAMAPP_UPLOAD_INSTRUCTIONS_I_FMT = '''\
@@ -120,13 +268,187 @@ RAMAPP_UPLOAD_INSTRUCTIONS_I_FMT = '''\
  * This file was generated by pictools.py version {}.
  */
 
-/* Upload the application. */
+/* Upload the loader. */
+{}
+
+/* Start the loader. */
+0x{:08x}, /* {} */
+0x{:08x}, /* {} */
+0x{:08x}  /* {} */
+'''
+
+RAMAPP_IMAGE_I_FMT = '''\
+/**
+ * This file was generated by pictools.py version {}.
+ */
+
+/* Number of words in the image. */
+{},
+
+/* The image. */
+{},
+
+/* CRC-32 of the image. */
+{}
+'''
+
+RAMAPP_EXT_IMAGES_I_FMT = '''\
+/**
+ * This file was generated by pictools.py version {}.
+ *
+ * Ramapp extension module images, loaded by the programmer when a
+ * command handled by a module is first forwarded to the ramapp.
+ */
+{}
+static const struct ramapp_ext_image_t ramapp_ext_images[] = {{
+{}    {{ {{ 0 }}, NULL }}
+}};
+'''
+
+RAMAPP_EXT_IMAGE_FMT = '''
+static const uint32_t ramapp_ext_{}_image[] = {{
+    /* Number of words in the image. */
+    {},
+
+    /* The image. */
+{},
+
+    /* CRC-32 of the image. */
+    {}
+}};
+'''
+
+# Ramapp extension modules are linked to and loaded into this
+# region. The module header, first in the image, is the magic, the
+# handler and the command types handled by the module.
+RAMAPP_EXT_ADDRESS = 0xa0006000
+RAMAPP_EXT_SIZE = 0x1000
+RAMAPP_EXT_MAGIC = 0x54584552
+RAMAPP_EXT_TYPES_MAX = 4
+
+# The loader is uploaded over PRACC to the top of the RAM. It reads
+# the number of words, the words and the CRC-32 from FASTDATA, stores
+# the words at the start of the RAM, writes the CRC check result
+# (zero(0) on match) to FASTDATA, and finally jumps to the uploaded
+# application.
+RAMAPP_LOADER_ADDRESS = 0xa0007f00
+
+RAMAPP_LOADER = [
+    (0xff2041a4, 'lui a0, 0xff20'),
+    (0xa00041a5, 'lui a1, 0xa000'),
+    (0x0000fcc4, 'lw a2, 0(a0)'),
+    (0x39500006, 'addu a3, a2, zero'),
+    (0x0000fd04, 'lw t0, 0(a0)'),
+    (0x0000f905, 'sw t0, 0(a1)'),
+    (0xffff30c6, 'addiu a2, a2, -1'),
+    (0xfff8b406, 'bne a2, zero, 0x10'),
+    (0x000430a5, 'addiu a1, a1, 4'),
+    (0x0000fd84, 'lw t4, 0(a0)'),
+    (0xa00041a5, 'lui a1, 0xa000'),
+    (0xffff3040, 'addiu v0, zero, -1'),
+    (0xedb841ab, 'lui t3, 0xedb8'),
+    (0x8320516b, 'ori t3, t3, 0x8320'),
+    (0x0000fd05, 'lw t0, 0(a1)'),
+    (0x13100102, 'xor v0, v0, t0'),
+    (0x00203120, 'addiu t1, zero, 32'),
+    (0x0001d142, 'andi t2, v0, 0x1'),
+    (0x51d00140, 'subu t2, zero, t2'),
+    (0x5250016a, 'and t2, t2, t3'),
+    (0x08400042, 'srl v0, v0, 1'),
+    (0xffff3129, 'addiu t1, t1, -1'),
+    (0xfff4b409, 'bne t1, zero, 0x44'),
+    (0x13100142, 'xor v0, v0, t2'),
+    (0xffff30e7, 'addiu a3, a3, -1'),
+    (0xffe8b407, 'bne a3, zero, 0x38'),
+    (0x000430a5, 'addiu a1, a1, 4'),
+    (0xffff3120, 'addiu t1, zero, -1'),
+    (0x13100122, 'xor v0, v0, t1'),
+    (0x43100182, 'xor t0, v0, t4'),
+    (0x0000f904, 'sw t0, 0(a0)'),
+    (0xfffeb408, 'bne t0, zero, 0x7c'),
+    (0x00000000, 'nop'),
+    (0xa00041b9, 'lui t9, 0xa000'),
+    (0x00015339, 'ori t9, t9, 0x1'),
+    (0x0f3c0019, 'jr t9'),
+    (0x00000000, 'nop')
+]
+
+# Registers the loader upload instructions may use for upper
+# halfwords, a1-a3 and t0-t7. The base address is in a0 and the stored
+# words in s0-s7, fp and ra.
+LOADER_UPLOAD_SCRATCH_GPRS = [5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15]
+
+# Executed over PRACC after the loader upload instructions. The
+# programmer also transfers a nop for the jump delay slot.
+RAMAPP_LOADER_START = [
+    (0xa00041b9, 'lui t9, 0xa000'),
+    (0x7f015339, 'ori t9, t9, 0x7f01'),
+    (0x0f3c0019, 'jr t9')
+]
+
+ICSP_SPI_SEQUENCES_I_FMT = '''\
+/**
+ * This file was generated by pictools.py version {}.
+ *
+ * Precompiled ICSP cycles for the USART SPI transport, one nibble per
+ * cycle. TDO is only sampled on the listed cycles.
+ */
+
+/* MTAP_SW_MTAP, MTAP_COMMAND and MCHP_STATUS. Samples the status. */
+static const uint8_t read_status_cycles[] = {{
+{}
+}};
+
+static const uint16_t read_status_samples[] = {{
+{}
+}};
+
+static const struct icsp_spi_sequence_t read_status_sequence = {{
+    .buf_p = &read_status_cycles[0],
+    .size = sizeof(read_status_cycles),
+    .samples_p = &read_status_samples[0],
+    .number_of_samples = membersof(read_status_samples)
+}};
+
+/* MCHP_ASSERT_RST, MTAP_SW_ETAP, ETAP_EJTAGBOOT, MTAP_SW_MTAP,
+   MTAP_COMMAND, MCHP_DE_ASSERT_RST and MTAP_SW_ETAP. */
+static const uint8_t enter_serial_execution_mode_cycles[] = {{
+{}
+}};
+
+static const struct icsp_spi_sequence_t enter_serial_execution_mode_sequence = {{
+    .buf_p = &enter_serial_execution_mode_cycles[0],
+    .size = sizeof(enter_serial_execution_mode_cycles),
+    .samples_p = NULL,
+    .number_of_samples = 0
+}};
+
+/* MTAP_SW_MTAP, MTAP_COMMAND, MCHP_ERASE and MCHP_DE_ASSERT_RST. */
+static const uint8_t chip_erase_cycles[] = {{
+{}
+}};
+
+static const struct icsp_spi_sequence_t chip_erase_sequence = {{
+    .buf_p = &chip_erase_cycles[0],
+    .size = sizeof(chip_erase_cycles),
+    .samples_p = NULL,
+    .number_of_samples = 0
+}};
+
+/* ETAP_CONTROL, PrAcc poll, ETAP_DATA, instruction, ETAP_CONTROL and
+   PrAcc clear for each loader upload instruction, followed by the
+   jump delay slot nop. Samples PrAcc in the poll. */
+static const uint8_t upload_loader_cycles[][{}] = {{
+{}
+}};
+
+static const uint16_t upload_loader_samples[] = {{
 {}
+}};
 
-/* Start the uploaded application. */
-0xa00041b9, /* lui t9, 0xa000 */
-0x00015339, /* ori t9, t9, 0x1 */
-0x0f3c0019  /* jr t9 */
+static const struct icsp_spi_sequence_t upload_loader_sequences[] = {{
+{}
+}};
 '''
 
 CONFIGURATION_FMT = '''\
@@ -289,9 +611,10 @@ REGLIST_GPRS = {
 
 class CommandFailedError(Exception):
 
-    def __init__(self, error):
+    def __init__(self, error, row=None):
         super().__init__()
         self.error = error
+        self.row = row
 
     def __str__(self):
         return format_error(self.error)
@@ -322,6 +645,83 @@ class Serial(serial.Serial):
 
         return data
 
+    def write_data(self, data):
+        """Write fast write data packets.
+
+        """
+
+        self.write(data)
+
+
+class UsbVendor(object):
+    """The programmer vendor specific USB interface, with the same
+    read, write and peek methods as Serial. Fast write data packets
+    are written to an endpoint of their own.
+
+    """
+
+    def __init__(self, timeout):
+        import usb.core
+        import usb.util
+
+        self._usb = usb
+        self._device = usb.core.find(idVendor=USB_VID, idProduct=USB_PID)
+
+        if self._device is None:
+            raise Exception('programmer USB device not found')
+
+        self.timeout = timeout
+        self._input_buffer = b''
+
+    def _timeout_ms(self):
+        return int(1000 * self.timeout)
+
+    def read(self, size=1):
+        """Read given number of bytes, or less on timeout. Whole packets
+        are read from the device, and any excess is kept for the
+        next read.
+
+        """
+
+        while len(self._input_buffer) < size:
+            left = size - len(self._input_buffer)
+            left += (-left % USB_VENDOR_PACKET_SIZE)
+
+            try:
+                data = self._device.read(USB_VENDOR_ENDPOINT_IN,
+                                         left,
+                                         self._timeout_ms())
+            except self._usb.core.USBTimeoutError:
+                break
+
+            self._input_buffer += bytes(data)
+
+        data = self._input_buffer[:size]
+        self._input_buffer = self._input_buffer[size:]
+
+        return data
+
+    def peek(self, size):
+        data = self.read(size)
+        self._input_buffer = (data + self._input_buffer)
+
+        return data
+
+    def write(self, data):
+        self._device.write(USB_VENDOR_ENDPOINT_OUT, data, self._timeout_ms())
+
+    def write_data(self, data):
+        """Write fast write data packets.
+
+        """
+
+        self._device.write(USB_VENDOR_ENDPOINT_DATA_OUT,
+                           data,
+                           self._timeout_ms())
+
+    def close(self):
+        self._usb.util.dispose_resources(self._device)
+
 
 def crc_ccitt(data):
     """Calculate a CRC of given data.
@@ -340,6 +740,153 @@ def crc_ccitt(data):
     return (msb << 8) + lsb
 
 
+def micromips_lui(rs, immediate):
+    instruction = bitstruct.pack('u16u6u5u5',
+                                 immediate,
+                                 0b010000,
+                                 0b01101,
+                                 rs)
+    comment = 'lui {}, 0x{:x}'.format(GPR_STRINGS[rs], immediate)
+
+    return (struct.unpack('>I', instruction)[0], comment)
+
+
+def micromips_ori(rt, rs, immediate):
+    instruction = bitstruct.pack('u16u6u5u5',
+                                 immediate,
+                                 0b010100,
+                                 rt,
+                                 rs)
+    comment = 'ori {}, {}, 0x{:x}'.format(GPR_STRINGS[rt],
+                                          GPR_STRINGS[rs],
+                                          immediate)
+
+    return (struct.unpack('>I', instruction)[0], comment)
+
+
+def micromips_addiu(rt, rs, immediate):
+    instruction = bitstruct.pack('u16u6u5u5',
+                                 immediate & 0xffff,
+                                 0b001100,
+                                 rt,
+                                 rs)
+    comment = 'addiu {}, {}, {}'.format(GPR_STRINGS[rt],
+                                        GPR_STRINGS[rs],
+                                        immediate)
+
+    return (struct.unpack('>I', instruction)[0], comment)
+
+
+def micromips_swm32(reglist, base, offset):
+    instruction = bitstruct.pack('u4u12u6u5u5',
+                                 0b1101,
+                                 offset,
+                                 0b001000,
+                                 reglist,
+                                 base)
+    reglist = ', '.join([GPR_STRINGS[i] for i in REGLIST_GPRS[reglist]])
+    comment = 'swm32 {}, 0x{:x}({})'.format(reglist,
+                                            offset,
+                                            GPR_STRINGS[base])
+
+    return (struct.unpack('>I', instruction)[0], comment)
+
+
+def is_simm16(value):
+    value &= 0xffffffff
+
+    return value < 0x8000 or value >= 0xffff8000
+
+
+def load_word_instructions(gpr, word, registers, scratch_gprs):
+    """Returns the fewest instructions loading given word into given
+    register, using the values already in registers. Upper halfwords
+    are loaded into the least recently used of given scratch
+    registers. The register values and scratch order are updated.
+
+    The loaded register is never a source register, so each
+    instruction may be executed twice without changing the result, as
+    may happen when feeding instructions speculatively.
+
+    """
+
+    instructions = None
+
+    if registers.get(gpr) == word:
+        instructions = []
+    elif word >> 16 == 0:
+        instructions = [micromips_ori(gpr, 0, word)]
+    elif word & 0xffff == 0:
+        instructions = [micromips_lui(gpr, word >> 16)]
+    else:
+        for rs, value in registers.items():
+            if rs == gpr:
+                continue
+
+            if is_simm16(word - value):
+                difference = ((word - value + 0x8000) & 0xffff) - 0x8000
+                instructions = [micromips_addiu(gpr, rs, difference)]
+                break
+
+            if value == (word & 0xffff0000):
+                instructions = [micromips_ori(gpr, rs, word & 0xffff)]
+                break
+
+    if instructions is None:
+        scratch = scratch_gprs.pop(0)
+        scratch_gprs.append(scratch)
+        registers[scratch] = (word & 0xffff0000)
+        instructions = [
+            micromips_lui(scratch, word >> 16),
+            micromips_ori(gpr, scratch, word & 0xffff)
+        ]
+
+    registers[gpr] = word
+
+    return instructions
+
+
+def loader_upload_instructions():
+    """Instructions executed over PRACC to store the loader in RAM.
+
+    """
+
+    instructions = []
+    words = [word for word, _ in RAMAPP_LOADER]
+
+    # Known register values. Most words are loaded with a single
+    # instruction from the zero register, a register with a close
+    # value, or a register with the same upper halfword.
+    registers = {0: 0}
+    scratch_gprs = list(LOADER_UPLOAD_SCRATCH_GPRS)
+
+    # Store up to 10 words at a time to RAM using with the SWM32
+    # instruction. Maximum positive immediate offset in SWM32 is 2047
+    # (12 bits signed).
+    for i in range(0, len(words), 512):
+        address = (RAMAPP_LOADER_ADDRESS + 4 * i)
+        instructions += load_word_instructions(4,
+                                               address,
+                                               registers,
+                                               scratch_gprs)
+        chunkwords = words[i:i + 512]
+
+        for j in range(0, len(chunkwords), 10):
+            subwords = chunkwords[j:j + 10]
+            reglist = (15 + len(subwords))
+            gprs = REGLIST_GPRS[reglist]
+
+            for gpr, word in zip(gprs, subwords):
+                instructions += load_word_instructions(gpr,
+                                                       word,
+                                                       registers,
+                                                       scratch_gprs)
+
+            instructions.append(micromips_swm32(reglist, 4, 4 * j))
+
+    return instructions
+
+
 def format_error(error):
     try:
         return 'error: {}: '.format(-error) + ERROR_CODE_MESSAGE[error]
@@ -381,7 +928,10 @@ def physical_flash_address(address):
 
 
 def serial_open(port):
-    return Serial(port, baudrate=460800, timeout=SERIAL_TIMEOUT)
+    if port == 'usb':
+        return UsbVendor(timeout=SERIAL_TIMEOUT)
+    else:
+        return Serial(port, baudrate=460800, timeout=SERIAL_TIMEOUT)
 
 
 def serial_open_ensure_connected_to_programmer(port):
@@ -392,17 +942,28 @@ def serial_open_ensure_connected_to_programmer(port):
     return serial_connection
 
 
-def serial_open_ensure_connected(port):
+def serial_open_ensure_connected(port,
+                                 transport=None,
+                                 icsp_clock=None,
+                                 targets=None,
+                                 jtag_chain=None):
     serial_connection = serial_open_ensure_connected_to_programmer(port)
 
     try:
-        connect(serial_connection)
+        connect(serial_connection, transport, icsp_clock, targets, jtag_chain)
     except CommandFailedError as e:
         if e.error == -EISCONN:
             pass
-        elif e.error in [-EPROTO, -EENTERSERIALEXECUTIONMODE, -ERAMAPPUPLOAD]:
+        elif e.error in [-EPROTO,
+                         -EENTERSERIALEXECUTIONMODE,
+                         -ERAMAPPUPLOAD,
+                         -ECLOCKCALIBRATION]:
             reset(serial_connection)
-            connect(serial_connection)
+            connect(serial_connection,
+                    transport,
+                    icsp_clock,
+                    targets,
+                    jtag_chain)
         else:
             raise
 
@@ -449,6 +1010,16 @@ def packet_read(serial_connection):
 
     command_type, payload_size = struct.unpack('>hH', header)
 
+    if payload_size == SIZE_EXTENDED:
+        extended_size = serial_connection.read(4)
+
+        if len(extended_size) != 4:
+            sys.exit('error: timeout reading the response packet header from '
+                     'the programmer')
+
+        header += extended_size
+        payload_size = struct.unpack('>I', extended_size)[0]
+
     if payload_size > 0:
         payload = serial_connection.read(payload_size)
 
@@ -486,6 +1057,22 @@ def send_command(serial_connection, command_type, payload):
     packet_write(serial_connection, command_type, payload)
 
 
+def raise_command_failed(payload):
+    """Raise given failure. Fast write failures have the index of the
+    failed data packet after the error code.
+
+    """
+
+    error = struct.unpack('>i', payload[:4])[0]
+
+    if len(payload) == 8:
+        row = struct.unpack('>I', payload[4:])[0]
+    else:
+        row = None
+
+    raise CommandFailedError(error, row)
+
+
 def receive_command(serial_connection, command_type):
     """Receive given command response and return the response payload.
 
@@ -496,9 +1083,7 @@ def receive_command(serial_connection, command_type):
     if response_command_type == command_type:
         return response_payload
     elif response_command_type == COMMAND_TYPE_FAILED:
-        error = struct.unpack('>i', response_payload)[0]
-
-        raise CommandFailedError(error)
+        raise_command_failed(response_payload)
     else:
         sys.exit(
             'error: expected programmer command response type {}, but '
@@ -524,37 +1109,129 @@ def assert_receive_failure(serial_connection):
     response_command_type, response_payload = packet_read(serial_connection)
 
     if response_command_type == COMMAND_TYPE_FAILED:
-        error = struct.unpack('>i', response_payload)[0]
-
-        raise CommandFailedError(error)
+        raise_command_failed(response_payload)
 
     sys.exit('error: expected command to fail, but got successful response '
              'for command {}'.format(response_command_type))
 
 
+class Capabilities(object):
+    """Programmer capabilities. Programmers without the capabilities
+    command have the default capabilities.
+
+    """
+
+    def __init__(self, payload=None):
+        if payload is None:
+            self.protocol_version = 1
+            self.maximum_request_payload_size = 1024
+            self.maximum_response_payload_size = READ_CHUNK_SIZE
+            self.row_size = FAST_WRITE_SIZE
+            self.window = 1
+            self.commands = []
+            self.staging_slice_size = 0
+        else:
+            (self.protocol_version,
+             self.maximum_request_payload_size,
+             self.maximum_response_payload_size,
+             self.row_size,
+             self.window,
+             commands) = struct.unpack('>BHIHHI', payload[:15])
+            self.commands = [
+                name
+                for i, name in enumerate(CAPABILITIES_COMMANDS)
+                if commands & (1 << i)
+            ]
+
+            if len(payload) >= 19:
+                self.staging_slice_size = struct.unpack('>I', payload[15:19])[0]
+            else:
+                self.staging_slice_size = 0
+
+
+def read_capabilities(serial_connection):
+    try:
+        payload = execute_command(serial_connection,
+                                  PROGRAMMER_COMMAND_TYPE_CAPABILITIES)
+    except CommandFailedError:
+        payload = None
+
+    return Capabilities(payload)
+
+
+def fast_read(serial_connection, address, size, progress):
+    """Read given memory area with a single request. The data is received
+    in data packets, each with a CRC of its own, followed by the
+    response. The ramapp reads whole words, so the area is widened to
+    whole words.
+
+    """
+
+    offset = (address % 4)
+    payload = struct.pack('>II',
+                          address - offset,
+                          size + offset + (-(size + offset) % 4))
+    send_command(serial_connection,
+                 PROGRAMMER_COMMAND_TYPE_FAST_READ,
+                 payload)
+    data = bytearray()
+    left = size
+
+    while serial_connection.peek(2) == b'\x00\x00':
+        _, payload = packet_read(serial_connection)
+        data += payload
+        progress.update(min(len(payload), left))
+        left -= min(len(payload), left)
+
+    receive_command(serial_connection, PROGRAMMER_COMMAND_TYPE_FAST_READ)
+
+    return bytes(data[offset:offset + size])
+
+
+def read_memory(serial_connection, capabilities, address, size, progress):
+    """Read given memory area, with a single fast read if available, or
+    otherwise in chunks of the maximum response payload size.
+
+    """
+
+    if 'fast_read' in capabilities.commands:
+        return fast_read(serial_connection, address, size, progress)
+
+    read_chunk_size = capabilities.maximum_response_payload_size
+    data = b''
+    left = size
+
+    while left > 0:
+        if left > read_chunk_size:
+            size = read_chunk_size
+        else:
+            size = left
+
+        payload = struct.pack('>II', address, size)
+        data += execute_command(serial_connection,
+                                COMMAND_TYPE_READ,
+                                payload)
+        address += size
+        left -= size
+        progress.update(size)
+
+    return data
+
+
 def read_to_file(serial_connection, ranges, outfile):
     binfile = bincopy.BinFile()
+    capabilities = read_capabilities(serial_connection)
 
     for address, size in ranges:
-        left = size
-
         print('Reading 0x{:08x}-0x{:08x}.'.format(address, address + size))
 
-        with tqdm(total=left, unit=' bytes') as progress:
-            while left > 0:
-                if left > READ_CHUNK_SIZE:
-                    size = READ_CHUNK_SIZE
-                else:
-                    size = left
-
-                payload = struct.pack('>II', address, size)
-                binfile.add_binary(execute_command(serial_connection,
-                                                   COMMAND_TYPE_READ,
-                                                   payload),
-                                   address)
-                address += size
-                left -= size
-                progress.update(size)
+        with tqdm(total=size, unit=' bytes') as progress:
+            binfile.add_binary(read_memory(serial_connection,
+                                           capabilities,
+                                           address,
+                                           size,
+                                           progress),
+                               address)
 
         print('Read complete.')
 
@@ -578,25 +1255,202 @@ def erase(serial_connection, address, size):
     print('Erase complete.')
 
 
+def blank_check(serial_connection, address, size):
+    """Check that given flash memory range is erased. Returns the
+    address of the first word not erased, or None.
+
+    """
+
+    payload = struct.pack('>II', address, size)
+
+    serial_connection.timeout = ERASE_TIMEOUT
+    response = execute_command(serial_connection,
+                               COMMAND_TYPE_BLANK_CHECK,
+                               payload)
+    serial_connection.timeout = SERIAL_TIMEOUT
+
+    if response:
+        return struct.unpack('>I', response)[0]
+    else:
+        return None
+
+
 def reset(serial_connection):
     execute_command(serial_connection, PROGRAMMER_COMMAND_TYPE_RESET)
 
     print('PIC reset.')
 
 
-def chip_erase(serial_connection):
+def parse_targets(value):
+    """Returns given comma separated list of gang target or JTAG scan
+    chain device numbers as a bit mask.
+
+    """
+
+    targets = 0
+
+    for target in value.split(','):
+        target = int(target)
+
+        if not 0 <= target < GANG_TARGETS_MAX:
+            raise argparse.ArgumentTypeError(
+                'target {} not in range 0-{}'.format(target,
+                                                     GANG_TARGETS_MAX - 1))
+
+        targets |= (1 << target)
+
+    return targets
+
+
+def parse_jtag_chain(value):
+    """Returns given comma separated list of JTAG scan chain instruction
+    register lengths, starting with the device closest to the
+    programmer TDO.
+
+    """
+
+    ir_lengths = [int(ir_length) for ir_length in value.split(',')]
+
+    if not 1 <= len(ir_lengths) <= JTAG_CHAIN_DEVICES_MAX:
+        raise argparse.ArgumentTypeError(
+            'JTAG scan chain must have 1-{} devices'.format(
+                JTAG_CHAIN_DEVICES_MAX))
+
+    for ir_length in ir_lengths:
+        if not 1 <= ir_length <= 32:
+            raise argparse.ArgumentTypeError(
+                'JTAG instruction register length {} not in range '
+                '1-32'.format(ir_length))
+
+    return ir_lengths
+
+
+def format_targets(targets):
+    return ', '.join([str(target)
+                      for target in range(GANG_TARGETS_MAX)
+                      if targets & (1 << target)])
+
+
+def jtag_chain_payload(targets, jtag_chain):
+    """Returns the JTAG scan chain payload. All PIC32 devices, that is
+    devices with a 5 bits instruction register, are programmed unless
+    targets are given.
+
+    """
+
+    if targets is None:
+        targets = 0
+
+        for device, ir_length in enumerate(jtag_chain):
+            if ir_length == JTAG_IR_LENGTH_PIC32:
+                targets |= (1 << device)
+
+    return struct.pack('BB{}B'.format(len(jtag_chain)),
+                       targets,
+                       len(jtag_chain),
+                       *jtag_chain)
+
+
+def transport_payload(transport, targets=None, jtag_chain=None):
+    """Returns the optional transport payload of the connect, device
+    status and chip erase commands. No payload selects the programmer
+    default transport. The gang transport may be followed by the
+    targets to program, otherwise all targets are programmed. The JTAG
+    transport may be followed by a scan chain.
+
+    """
+
+    if jtag_chain is not None and transport != 'jtag_soft':
+        sys.exit('error: the JTAG scan chain requires the jtag_soft transport')
+
+    if transport is None:
+        if targets is not None:
+            sys.exit('error: targets require the icsp_gang or jtag_soft '
+                     'transport')
+
+        return None
+
+    payload = struct.pack('B', TRANSPORTS[transport])
+
+    if jtag_chain is not None:
+        payload += jtag_chain_payload(targets, jtag_chain)
+    elif targets is not None:
+        if transport != 'icsp_gang':
+            sys.exit('error: targets require the icsp_gang transport, or the '
+                     'jtag_soft transport with a JTAG scan chain')
+
+        payload += struct.pack('B', targets)
+
+    return payload
+
+
+def chip_erase(serial_connection,
+               transport=None,
+               targets=None,
+               jtag_chain=None):
     print('Erasing the chip.')
 
-    execute_command(serial_connection, PROGRAMMER_COMMAND_TYPE_CHIP_ERASE)
+    response = execute_command(serial_connection,
+                               PROGRAMMER_COMMAND_TYPE_CHIP_ERASE,
+                               transport_payload(transport,
+                                                 targets,
+                                                 jtag_chain))
 
     print('Chip erase complete.')
 
+    if len(response) == 1:
+        print('Erased targets: {}.'.format(format_targets(response[0])))
+
+
+def connect_payload(transport, icsp_clock, targets=None, jtag_chain=None):
+    """Returns the optional transport and ICSP clock frequency payload of
+    the connect command. No frequency lets the programmer calibrate the
+    clock.
+
+    """
+
+    payload = transport_payload(transport, targets, jtag_chain)
 
-def connect(serial_connection):
-    execute_command(serial_connection, PROGRAMMER_COMMAND_TYPE_CONNECT)
+    if icsp_clock is not None:
+        if payload is None:
+            sys.exit('error: the ICSP clock requires a transport')
+
+        if transport == 'jtag_soft':
+            sys.exit('error: the jtag_soft transport has no adjustable clock')
+
+        payload += struct.pack('>I', icsp_clock)
+
+    return payload
+
+
+def connect(serial_connection,
+            transport=None,
+            icsp_clock=None,
+            targets=None,
+            jtag_chain=None):
+    """Connect to the PIC. Returns the ICSP clock frequency in Hz, or None
+    if the transport does not report it.
+
+    """
+
+    response = execute_command(serial_connection,
+                               PROGRAMMER_COMMAND_TYPE_CONNECT,
+                               connect_payload(transport,
+                                               icsp_clock,
+                                               targets,
+                                               jtag_chain))
 
     print('Connected to PIC.')
 
+    if len(response) == 1:
+        print('Connected targets: {}.'.format(format_targets(response[0])))
+
+    if len(response) == 4:
+        icsp_clock = struct.unpack('>I', response)[0]
+        print('ICSP clock is {} Hz.'.format(icsp_clock))
+
+        return icsp_clock
+
 
 def disconnect(serial_connection):
     execute_command(serial_connection, PROGRAMMER_COMMAND_TYPE_DISCONNECT)
@@ -605,11 +1459,34 @@ def disconnect(serial_connection):
 
 
 def read_words(args, address, length):
-    serial_connection = serial_open_ensure_connected(args.port)
-    payload = struct.pack('>II', address, 4 * length)
-    words = execute_command(serial_connection,
-                            COMMAND_TYPE_READ,
-                            payload)
+    """Read given number of words. The programmer reads the words without
+    uploading the ramapp, unless already connected to the PIC.
+
+    """
+
+    serial_connection = serial_open_ensure_connected_to_programmer(args.port)
+    payload = transport_payload(args.transport,
+                                args.targets,
+                                args.jtag_chain)
+
+    if payload is None:
+        payload = b''
+
+    payload += struct.pack('>IB', address, length)
+
+    try:
+        words = execute_command(serial_connection,
+                                PROGRAMMER_COMMAND_TYPE_READ_WORDS,
+                                payload)
+    except CommandFailedError as e:
+        if e.error != -EISCONN:
+            raise
+
+        ping(serial_connection)
+        payload = struct.pack('>II', address, 4 * length)
+        words = execute_command(serial_connection,
+                                COMMAND_TYPE_READ,
+                                payload)
 
     return bitstruct.byteswap(length * '4', words)
 
@@ -633,20 +1510,32 @@ def do_reset(args):
 
 def do_device_status_print(args):
     status = execute_command(serial_open_ensure_connected_to_programmer(args.port),
-                             PROGRAMMER_COMMAND_TYPE_DEVICE_STATUS)
-    unpacked = bitstruct.unpack('u1p1u1p1u1u1p1u1', status)
-    status = struct.unpack('B', status)[0]
+                             PROGRAMMER_COMMAND_TYPE_DEVICE_STATUS,
+                             transport_payload(args.transport,
+                                               args.targets,
+                                               args.jtag_chain))
+    unpacked = bitstruct.unpack('u1p1u1p1u1u1p1u1', status[:1])
 
-    print(DEVICE_STATUS_FMT.format(status, *unpacked))
+    print(DEVICE_STATUS_FMT.format(status[0], *unpacked))
+
+    if len(status) == 2:
+        print('Targets with this status: {}.'.format(format_targets(status[1])))
 
 
 def do_flash_erase_chip(args):
-    chip_erase(serial_open_ensure_disconnected(args.port))
+    chip_erase(serial_open_ensure_disconnected(args.port),
+               args.transport,
+               args.targets,
+               args.jtag_chain)
 
 
 def do_ping(args):
     # The open function pings the PIC.
-    serial_open_ensure_connected(args.port)
+    serial_open_ensure_connected(args.port,
+                                 args.transport,
+                                 args.icsp_clock,
+                                 args.targets,
+                                 args.jtag_chain)
 
 
 def do_flash_erase(args):
@@ -660,27 +1549,67 @@ def do_flash_erase(args):
                 address,
                 size))
 
-    erase(serial_open_ensure_connected(args.port), address, size)
+    erase(serial_open_ensure_connected(args.port,
+                                       args.transport,
+                                       args.icsp_clock,
+                                       args.targets,
+                                       args.jtag_chain),
+          address,
+          size)
 
 
-def do_flash_read(args):
+def do_flash_blank_check(args):
     address = int(args.address, 0)
     size = int(args.size, 0)
 
     if not (is_program_flash_range(address, size)
-            or is_boot_flash_configuration_bits_range(address, size)
-            or is_sfrs_range(address, size)):
+            or is_boot_flash_configuration_bits_range(address, size)):
         sys.exit(
             'error: address 0x{:08x} and size {} is out of range'.format(
                 address,
                 size))
 
-    serial_connection = serial_open_ensure_connected(args.port)
-    read_to_file(serial_connection, [(address, size)], args.outfile)
+    first_address = blank_check(
+        serial_open_ensure_connected(args.port,
+                                     args.transport,
+                                     args.icsp_clock,
+                                     args.targets,
+                                     args.jtag_chain),
+        address,
+        size)
+
+    if first_address is None:
+        print('0x{:08x}-0x{:08x} is blank.'.format(address, address + size))
+    else:
+        sys.exit('error: 0x{:08x} is not blank.'.format(first_address))
 
 
-def do_flash_read_all(args):
-    serial_connection = serial_open_ensure_connected(args.port)
+def do_flash_read(args):
+    address = int(args.address, 0)
+    size = int(args.size, 0)
+
+    if not (is_program_flash_range(address, size)
+            or is_boot_flash_configuration_bits_range(address, size)
+            or is_sfrs_range(address, size)):
+        sys.exit(
+            'error: address 0x{:08x} and size {} is out of range'.format(
+                address,
+                size))
+
+    serial_connection = serial_open_ensure_connected(args.port,
+                                                     args.transport,
+                                                     args.icsp_clock,
+                                                     args.targets,
+                                                     args.jtag_chain)
+    read_to_file(serial_connection, [(address, size)], args.outfile)
+
+
+def do_flash_read_all(args):
+    serial_connection = serial_open_ensure_connected(args.port,
+                                                     args.transport,
+                                                     args.icsp_clock,
+                                                     args.targets,
+                                                     args.jtag_chain)
     read_to_file(serial_connection,
                  flash_ranges(args.mcu),
                  args.outfile)
@@ -717,7 +1646,12 @@ def create_chunks(binfile):
     return chunks, fast_chunks, total
 
 
-def receive_fast_write_ack(serial_connection):
+def receive_fast_write_credits(serial_connection):
+    """Receive a credits packet and return the number of data packets
+    granted, or raise CommandFailedError on failure.
+
+    """
+
     response = serial_connection.peek(2)
 
     if len(response) != 2:
@@ -726,21 +1660,374 @@ def receive_fast_write_ack(serial_connection):
 
     command_type = struct.unpack('>h', response)[0]
 
-    if command_type == PROGRAMMER_COMMAND_TYPE_FAST_WRITE_ACK:
-        serial_connection.read(2)
+    if command_type == PROGRAMMER_COMMAND_TYPE_FAST_WRITE_CREDITS:
+        response = serial_connection.read(4)
+
+        if len(response) != 4:
+            sys.exit('error: timeout waiting for fast write credits from '
+                     'the programmer')
+
+        return struct.unpack('>H', response[2:])[0]
     else:
         assert_receive_failure(serial_connection)
 
 
+def write_fast_write_data(serial_connection, data, progress=None):
+    """Send given rows in data packets. The first data packet is sent
+    without a credit, and following data packets when granted by the
+    programmer.
+
+    """
+
+    credits = 1
+
+    for offset in range(0, len(data), FAST_WRITE_SIZE):
+        while credits == 0:
+            credits = receive_fast_write_credits(serial_connection)
+
+        serial_connection.write_data(data[offset:offset + FAST_WRITE_SIZE])
+        credits -= 1
+
+        if progress is not None:
+            progress.update(FAST_WRITE_SIZE)
+
+
+def skip_fast_write_credits(serial_connection):
+    """Skip credits not needed, sent before the response.
+
+    """
+
+    while True:
+        response = serial_connection.peek(2)
+
+        if response != b'\x00\x00':
+            break
+
+        receive_fast_write_credits(serial_connection)
+
+
+def unpack_failed_rows(payload):
+    """Returns the failed row addresses in given fast write or staged
+    write response payload.
+
+    """
+
+    return list(struct.unpack('>{}I'.format(len(payload) // 4), payload))
+
+
+def fast_write_data(serial_connection,
+                    address,
+                    data,
+                    progress=None,
+                    report_failed_rows=False):
+    """Write given rows at given address. The first data packet is sent
+    with the request, and following data packets when granted by the
+    programmer. Returns the addresses of failed rows if reported by
+    the programmer.
+
+    """
+
+    header = struct.pack('>IIH', address, len(data), crc_ccitt(data))
+
+    if report_failed_rows:
+        header += struct.pack('B', FAST_WRITE_FLAG_REPORT_FAILED_ROWS)
+
+    send_command(serial_connection,
+                 PROGRAMMER_COMMAND_TYPE_FAST_WRITE,
+                 header)
+
+    try:
+        write_fast_write_data(serial_connection, data, progress)
+        skip_fast_write_credits(serial_connection)
+        payload = receive_command(serial_connection,
+                                  PROGRAMMER_COMMAND_TYPE_FAST_WRITE)
+    except CommandFailedError as e:
+        if e.row is None:
+            raise
+
+        sys.exit('{} when writing row at 0x{:08x}'.format(
+            e,
+            address + FAST_WRITE_SIZE * e.row))
+
+    return unpack_failed_rows(payload)
+
+
+def fast_write(serial_connection, chunks, progress, report_failed_rows=False):
+    """Write given rows. Returns the addresses of failed rows if reported
+    by the programmer.
+
+    """
+
+    return fast_write_data(serial_connection,
+                           physical_flash_address(chunks[0].address),
+                           b''.join([chunk.data for chunk in chunks]),
+                           progress,
+                           report_failed_rows)
+
+
+def stage(serial_connection, index, data):
+    """Upload given data to given staging buffer slice in the
+    programmer. The response is not received.
+
+    """
+
+    send_command(serial_connection,
+                 PROGRAMMER_COMMAND_TYPE_STAGE,
+                 struct.pack('>BIH', index, len(data), crc_ccitt(data)))
+    serial_connection.write_data(data)
+
+
+def staged_write(serial_connection,
+                 chunks,
+                 slice_size,
+                 progress,
+                 report_failed_rows=False):
+    """Write given rows through the staging buffer in the programmer.
+    Each slice is written to the PIC while the next slice is uploaded
+    to the other half of the staging buffer. Returns the addresses of
+    failed rows if reported by the programmer.
+
+    """
+
+    data = b''.join([chunk.data for chunk in chunks])
+    address = physical_flash_address(chunks[0].address)
+    slices = [data[i:i + slice_size] for i in range(0, len(data), slice_size)]
+    failed_rows = []
+    stage(serial_connection, 0, slices[0])
+    receive_command(serial_connection, PROGRAMMER_COMMAND_TYPE_STAGE)
+
+    for i, data in enumerate(slices):
+        payload = struct.pack('>BI', i % 2, address)
+
+        if report_failed_rows:
+            payload += struct.pack('B', FAST_WRITE_FLAG_REPORT_FAILED_ROWS)
+
+        send_command(serial_connection,
+                     PROGRAMMER_COMMAND_TYPE_STAGED_WRITE,
+                     payload)
+
+        if i + 1 < len(slices):
+            stage(serial_connection, (i + 1) % 2, slices[i + 1])
+
+        try:
+            payload = receive_command(serial_connection,
+                                      PROGRAMMER_COMMAND_TYPE_STAGED_WRITE)
+        except CommandFailedError as e:
+            if e.row is None:
+                raise
+
+            sys.exit('{} when writing row at 0x{:08x}'.format(
+                e,
+                address + FAST_WRITE_SIZE * e.row))
+
+        failed_rows += unpack_failed_rows(payload)
+        progress.update(len(data))
+        address += len(data)
+
+        if i + 1 < len(slices):
+            receive_command(serial_connection, PROGRAMMER_COMMAND_TYPE_STAGE)
+
+    return failed_rows
+
+
+def rewrite_page(serial_connection, address, rows, read_chunk_size):
+    """Erase the flash page at given address and write it again, with
+    given rows replacing its current contents.
+
+    """
+
+    page = bytearray()
+
+    for offset in range(0, FLASH_PAGE_SIZE, read_chunk_size):
+        payload = struct.pack('>II',
+                              address + offset,
+                              min(read_chunk_size, FLASH_PAGE_SIZE - offset))
+        page += execute_command(serial_connection, COMMAND_TYPE_READ, payload)
+
+    for offset in range(0, FLASH_PAGE_SIZE, FAST_WRITE_SIZE):
+        if address + offset in rows:
+            page[offset:offset + FAST_WRITE_SIZE] = rows[address + offset]
+
+    erase(serial_connection, address, FLASH_PAGE_SIZE)
+
+    return fast_write_data(serial_connection,
+                           address,
+                           bytes(page),
+                           report_failed_rows=True)
+
+
+def rewrite_failed_rows(serial_connection,
+                        failed_rows,
+                        fast_chunks,
+                        read_chunk_size):
+    """Write given failed rows again, one at a time. A row failing its
+    CRC check in the PIC is not written and is still erased. The page
+    of a row failing again is erased and written again.
+
+    """
+
+    rows = {
+        physical_flash_address(chunk.address): chunk.data
+        for chunks in fast_chunks
+        for chunk in chunks
+    }
+
+    print('Rewriting {} failed row(s).'.format(len(failed_rows)))
+
+    pages = set()
+
+    for address in failed_rows:
+        if fast_write_data(serial_connection,
+                           address,
+                           rows[address],
+                           report_failed_rows=True):
+            pages.add(address - address % FLASH_PAGE_SIZE)
+
+    for address in sorted(pages):
+        failed_rows = rewrite_page(serial_connection,
+                                   address,
+                                   rows,
+                                   read_chunk_size)
+
+        if failed_rows:
+            sys.exit('error: flash write failed when writing row at '
+                     '0x{:08x}'.format(failed_rows[0]))
+
+
+def format_job_step(step):
+    kind, payload, _ = step
+
+    if kind in [JOB_STEP_WRITE, JOB_STEP_VERIFY]:
+        return '{} at 0x{:08x}'.format(JOB_STEP_NAMES[kind],
+                                       struct.unpack('>I', payload[:4])[0])
+    else:
+        return JOB_STEP_NAMES[kind]
+
+
+def run_job(serial_connection, transport, steps, progress):
+    """Run given steps in the programmer. The data of write steps is sent
+    after the request, in step order. Returns the time of each step in
+    microseconds.
+
+    """
+
+    payload = struct.pack('B', len(transport)) + transport
+
+    for kind, step_payload, _ in steps:
+        payload += struct.pack('B', kind) + step_payload
+
+    send_command(serial_connection, PROGRAMMER_COMMAND_TYPE_JOB, payload)
+
+    try:
+        for _, _, data in steps:
+            if data is not None:
+                write_fast_write_data(serial_connection, data, progress)
+
+        skip_fast_write_credits(serial_connection)
+        response = receive_command(serial_connection,
+                                   PROGRAMMER_COMMAND_TYPE_JOB)
+    except CommandFailedError as e:
+        if e.row is None:
+            raise
+
+        sys.exit('{} in job step {}'.format(e, format_job_step(steps[e.row])))
+
+    return struct.unpack('>{}I'.format(len(steps)), response)
+
+
+def flash_write_job(serial_connection, binfile, args):
+    """Erase the chip, write given file and optionally verify it with
+    programmer jobs. The data is padded to whole rows, as the chip is
+    erased.
+
+    """
+
+    steps = [
+        (JOB_STEP_CHIP_ERASE, b'', None),
+        (JOB_STEP_CONNECT, b'', None)
+    ]
+    total = 0
+
+    for address, data in create_row_segments(binfile):
+        steps.append((JOB_STEP_WRITE,
+                      struct.pack('>IIH', address, len(data), crc_ccitt(data)),
+                      data))
+
+        if args.verify:
+            steps.append((JOB_STEP_VERIFY,
+                          struct.pack('>III',
+                                      address,
+                                      len(data),
+                                      binascii.crc32(data) & 0xffffffff),
+                          None))
+
+        total += len(data)
+
+    transport = transport_payload(args.transport,
+                                  args.targets,
+                                  args.jtag_chain)
+
+    if transport is None:
+        transport = b''
+
+    times = {}
+
+    print('Writing {} to flash.'.format(os.path.abspath(args.binfile)))
+
+    with tqdm(total=total, unit=' bytes') as progress:
+        for offset in range(0, len(steps), JOB_STEPS_MAX):
+            job = steps[offset:offset + JOB_STEPS_MAX]
+
+            for step, time in zip(job,
+                                  run_job(serial_connection,
+                                          transport,
+                                          job,
+                                          progress)):
+                times[step[0]] = times.get(step[0], 0) + time
+
+    print('Write complete.')
+
+    if args.verify:
+        print('Verify complete.')
+
+    print('Programmer job time: {}.'.format(', '.join([
+        '{} {} ms'.format(JOB_STEP_NAMES[kind], times[kind] // 1000)
+        for kind in sorted(times)
+    ])))
+
+    if args.transport == 'icsp_gang' or args.jtag_chain is not None:
+        print_targets_status(serial_connection)
+
+
 def do_flash_write(args):
     binfile = bincopy.BinFile(args.binfile)
 
     if args.chip_erase:
         serial_connection = serial_open_ensure_disconnected(args.port)
-        chip_erase(serial_connection)
-        connect(serial_connection)
+
+        # Let the programmer erase, write and verify on its own if
+        # possible, without waiting for the host between the steps.
+        if (args.icsp_clock is None
+            and 'job' in read_capabilities(serial_connection).commands):
+            flash_write_job(serial_connection, binfile, args)
+
+            return
+
+        chip_erase(serial_connection,
+                   args.transport,
+                   args.targets,
+                   args.jtag_chain)
+        connect(serial_connection,
+                args.transport,
+                args.icsp_clock,
+                args.targets,
+                args.jtag_chain)
     elif args.erase:
-        serial_connection = serial_open_ensure_connected(args.port)
+        serial_connection = serial_open_ensure_connected(args.port,
+                                                         args.transport,
+                                                         args.icsp_clock,
+                                                         args.targets,
+                                                         args.jtag_chain)
 
         erase_segments = []
 
@@ -752,7 +2039,11 @@ def do_flash_write(args):
             address = physical_flash_address(address)
             erase(serial_connection, address, size)
     else:
-        serial_connection = serial_open_ensure_connected(args.port)
+        serial_connection = serial_open_ensure_connected(args.port,
+                                                         args.transport,
+                                                         args.icsp_clock,
+                                                         args.targets,
+                                                         args.jtag_chain)
 
     chunks, fast_chunks, total = create_chunks(binfile)
 
@@ -767,49 +2058,85 @@ def do_flash_write(args):
             execute_command(serial_connection, COMMAND_TYPE_WRITE, header + data)
             progress.update(len(data))
 
-        # Fast chunks.
+        # Fast chunks, through the staging buffer if available. Slices
+        # must fit in the receive buffer of the link, as a slice is
+        # uploaded while the previous slice is written.
+        # Failed rows are written again once all rows are written, if
+        # reported by the programmer.
+        if fast_chunks:
+            capabilities = read_capabilities(serial_connection)
+            slice_size = min(capabilities.staging_slice_size,
+                             capabilities.window * FAST_WRITE_SIZE)
+            report_failed_rows = ('row_errors' in capabilities.commands)
+
+        failed_rows = []
+
         for chunks in fast_chunks:
-            data = b''.join([chunk.data for chunk in chunks])
-            header = struct.pack('>IIH',
-                                 physical_flash_address(chunks[0].address),
-                                 len(data),
-                                 crc_ccitt(data))
-            send_command(serial_connection,
-                         PROGRAMMER_COMMAND_TYPE_FAST_WRITE,
-                         header)
-            serial_connection.write(chunks[0].data)
-
-            for chunk in chunks[1:]:
-                serial_connection.write(chunk.data)
-                receive_fast_write_ack(serial_connection)
-                progress.update(FAST_WRITE_SIZE)
-
-            receive_fast_write_ack(serial_connection)
-            progress.update(FAST_WRITE_SIZE)
-            receive_command(serial_connection, PROGRAMMER_COMMAND_TYPE_FAST_WRITE)
+            if 'staging' in capabilities.commands:
+                failed_rows += staged_write(serial_connection,
+                                            chunks,
+                                            slice_size,
+                                            progress,
+                                            report_failed_rows)
+            else:
+                failed_rows += fast_write(serial_connection,
+                                          chunks,
+                                          progress,
+                                          report_failed_rows)
+
+    if failed_rows:
+        rewrite_failed_rows(serial_connection,
+                            failed_rows,
+                            fast_chunks,
+                            capabilities.maximum_response_payload_size)
 
     print('Write complete.')
 
+    if args.transport == 'icsp_gang' or args.jtag_chain is not None:
+        print_targets_status(serial_connection)
+
     if args.verify:
         print('Verifying written data.')
 
+        capabilities = read_capabilities(serial_connection)
+
+        # Whole segments with a fast read each, if available.
+        if 'fast_read' in capabilities.commands:
+            chunks = binfile.segments
+        else:
+            chunks = binfile.segments.chunks(
+                capabilities.maximum_response_payload_size)
+
         with tqdm(total=total, unit=' bytes') as progress:
-            for address, data in binfile.segments.chunks(READ_CHUNK_SIZE):
+            for address, data in chunks:
                 address = physical_flash_address(address)
-                payload = struct.pack('>II', address, len(data))
-                read_data = execute_command(serial_connection,
-                                            COMMAND_TYPE_READ,
-                                            payload)
+                read_data = read_memory(serial_connection,
+                                        capabilities,
+                                        address,
+                                        len(data),
+                                        progress)
 
                 if bytearray(read_data) != data:
                     sys.exit(
                         'error: verify failed at address 0x{:x}'.format(address))
 
-                progress.update(len(data))
-
         print('Verify complete.')
 
 
+def print_targets_status(serial_connection):
+    response = execute_command(serial_connection,
+                               PROGRAMMER_COMMAND_TYPE_TARGETS_STATUS)
+    targets, alive = struct.unpack('BB', response)
+
+    print('Targets:        {}'.format(format_targets(targets)))
+    print('Alive targets:  {}'.format(format_targets(alive)))
+    print('Failed targets: {}'.format(format_targets(targets & ~alive)))
+
+
+def do_targets_status_print(args):
+    print_targets_status(serial_open_ensure_connected_to_programmer(args.port))
+
+
 def do_configuration_print(args):
     config = read_words(args, CONFIGURATION_BITS_ADDRESS + 0xc0, 10)
     unpacked = bitstruct.unpack('p32'                          # RESERVED
@@ -891,11 +2218,414 @@ def do_programmer_version(args):
     print(version.decode('ascii'))
 
 
-def do_generate_ramapp_upload_instructions(args):
-    instructions = []
+def do_programmer_capabilities(args):
+    serial_connection = serial_open_ensure_connected_to_programmer(args.port)
+    capabilities = read_capabilities(serial_connection)
+
+    print('Protocol version:         {}'.format(capabilities.protocol_version))
+    print('Maximum request payload:  {}'.format(
+        capabilities.maximum_request_payload_size))
+    print('Maximum response payload: {}'.format(
+        capabilities.maximum_response_payload_size))
+    print('Row size:                 {}'.format(capabilities.row_size))
+    print('Fast write window:        {}'.format(capabilities.window))
+    print('Optional commands:        {}'.format(
+        ', '.join(capabilities.commands)))
+    print('Staging slice size:       {}'.format(
+        capabilities.staging_slice_size))
+
+
+def format_stats_row(name, time, size=None):
+    if size is None:
+        size = '-'
+        rate = '-'
+    elif time > 0:
+        rate = size * 1000000 // time
+    else:
+        rate = '-'
+
+    return '{:16} {:>10.3f} {:>10} {:>12}'.format(name, time / 1000, size, rate)
+
+
+def do_programmer_stats(args):
+    serial_connection = serial_open_ensure_connected_to_programmer(args.port)
+    payload = execute_command(serial_connection,
+                              PROGRAMMER_COMMAND_TYPE_STATS)
+    values = struct.unpack('>{}I'.format(1 + 2 * len(STATS_PHASES)), payload)
+    elapsed = values[0]
+    other = elapsed
+
+    print('Phase             Time [ms]      Bytes      Bytes/s')
+
+    for name, time, size in zip(STATS_PHASES, values[1::2], values[2::2]):
+        print(format_stats_row(name, time, size))
+        other -= time
+
+    print(format_stats_row('Other', max(other, 0)))
+    print(format_stats_row('Total', elapsed))
+
+
+class TraceEntry(object):
+
+    def __init__(self, start, end, kind, instruction, number_of_bits):
+        self.start = start
+        self.end = end
+        self.kind = (kind & TRACE_KIND_MASK)
+        self.is_etap = ((kind & TRACE_FLAG_ETAP) != 0)
+        self.is_pracc = ((kind & TRACE_FLAG_PRACC) != 0)
+        self.instruction = instruction
+        self.number_of_bits = number_of_bits
+
+    @property
+    def duration(self):
+        return (self.end - self.start) & 0xffffffff
+
+    @property
+    def number_of_scans(self):
+        if self.kind in [TRACE_KIND_FAST_DATA_WRITE, TRACE_KIND_FAST_DATA_READ]:
+            return self.number_of_bits // 33
+        else:
+            return 1
+
+    @property
+    def number_of_clocks(self):
+        if self.kind == TRACE_KIND_INSTRUCTION:
+            return self.number_of_bits + TAP_INSTRUCTION_OVERHEAD_CLOCKS
+        elif self.kind == TRACE_KIND_REPLAY:
+            return self.number_of_bits
+        else:
+            return (self.number_of_bits
+                    + TAP_DATA_OVERHEAD_CLOCKS * self.number_of_scans)
+
+    @property
+    def number_of_payload_bits(self):
+        """Only fast data words are payload. Instructions, register
+        selects, control register polls, the PrAcc bit and the TAP
+        state transitions are overhead.
+
+        """
+
+        if self.kind in [TRACE_KIND_FAST_DATA_WRITE, TRACE_KIND_FAST_DATA_READ]:
+            return 32 * self.number_of_scans
+        else:
+            return 0
+
+    def __str__(self):
+        if self.kind == TRACE_KIND_COMMAND:
+            return '{:10} command {}'.format(
+                self.start,
+                format_command_type(self.instruction))
+        else:
+            return '{:10} {:7} {:15} {} 0x{:02x} {:4} bits{}'.format(
+                self.start,
+                self.duration,
+                TRACE_KIND_NAMES[self.kind],
+                'ETAP' if self.is_etap else 'MTAP',
+                self.instruction,
+                self.number_of_bits,
+                ' PrAcc' if self.is_pracc else '')
+
+
+TRACE_STATS_FMT = '{:28} {:>6} {:>8} {:>8} {:>6} {:>6} {:>6} {:>10} {:>10}'
+
+
+class TraceCommandStats(object):
+
+    def __init__(self, name):
+        self.name = name
+        self.number_of_scans = 0
+        self.number_of_payload_bits = 0
+        self.number_of_overhead_bits = 0
+        self.number_of_polls = 0
+        self.number_of_poll_misses = 0
+        self.shift_time = 0
+        self.idle_time = 0
+
+    def add(self, entry, previous_entry):
+        self.number_of_scans += entry.number_of_scans
+        self.number_of_payload_bits += entry.number_of_payload_bits
+        self.number_of_overhead_bits += (entry.number_of_clocks
+                                         - entry.number_of_payload_bits)
+
+        if (entry.kind == TRACE_KIND_DATA
+            and entry.instruction == ETAP_CONTROL
+            and entry.number_of_bits == 32):
+            self.number_of_polls += 1
+
+            if not entry.is_pracc:
+                self.number_of_poll_misses += 1
+
+        self.shift_time += entry.duration
+
+        if previous_entry is not None:
+            self.idle_time += (entry.start - previous_entry.end) & 0xffffffff
+
+    def format(self):
+        number_of_bits = (self.number_of_payload_bits
+                          + self.number_of_overhead_bits)
+
+        if number_of_bits > 0:
+            efficiency = 100 * self.number_of_payload_bits / number_of_bits
+        else:
+            efficiency = 0
+
+        return TRACE_STATS_FMT.format(
+            self.name,
+            self.number_of_scans,
+            self.number_of_payload_bits,
+            self.number_of_overhead_bits,
+            '{:.1f}%'.format(efficiency),
+            self.number_of_polls,
+            self.number_of_poll_misses,
+            '{:.3f}'.format(self.shift_time / TRACE_CYCLES_PER_US / 1000),
+            '{:.3f}'.format(self.idle_time / TRACE_CYCLES_PER_US / 1000))
+
+
+def read_trace(serial_connection):
+    """Read all entries still in the programmer trace ring buffer. Returns
+    the number of recorded entries and the read entries.
+
+    """
+
+    entries = []
+    index = 0
+
+    while True:
+        payload = execute_command(serial_connection,
+                                  PROGRAMMER_COMMAND_TYPE_TRACE_READ,
+                                  struct.pack('>I', index))
+        count, index = struct.unpack('>II', payload[:8])
+        payload = payload[8:]
+
+        if not payload:
+            break
+
+        for offset in range(0, len(payload), TRACE_ENTRY_SIZE):
+            entries.append(TraceEntry(*struct.unpack(
+                '>IIBBH',
+                payload[offset:offset + TRACE_ENTRY_SIZE])))
+
+        index += len(payload) // TRACE_ENTRY_SIZE
+
+    return count, entries
+
+
+def analyze_trace(entries):
+    """Returns the statistics of each traced command type, in order of
+    first appearance. Idle time is the time between shifts within a
+    command, and from the start of the command to its first shift.
+
+    """
+
+    stats = {}
+    command_stats = TraceCommandStats('-')
+    previous_entry = None
+
+    for entry in entries:
+        if entry.kind == TRACE_KIND_COMMAND:
+            name = format_command_type(entry.instruction)
+
+            if name not in stats:
+                stats[name] = TraceCommandStats(name)
+
+            command_stats = stats[name]
+        else:
+            if command_stats.name not in stats:
+                stats[command_stats.name] = command_stats
+
+            command_stats.add(entry, previous_entry)
+
+        previous_entry = entry
+
+    return [
+        command_stats
+        for command_stats in stats.values()
+        if command_stats.number_of_scans > 0
+    ]
+
+
+def do_programmer_trace_start(args):
+    serial_connection = serial_open_ensure_connected_to_programmer(args.port)
+    execute_command(serial_connection,
+                    PROGRAMMER_COMMAND_TYPE_TRACE_CONTROL,
+                    b'\x01')
+    print('Trace started.')
+
+
+def do_programmer_trace_analyze(args):
+    serial_connection = serial_open_ensure_connected_to_programmer(args.port)
+    execute_command(serial_connection,
+                    PROGRAMMER_COMMAND_TYPE_TRACE_CONTROL,
+                    b'\x00')
+    count, entries = read_trace(serial_connection)
+
+    if count > len(entries):
+        print('{} of {} entries overwritten.'.format(count - len(entries),
+                                                     count))
+
+    if args.dump:
+        print('     Start  Cycles Kind            TAP  Instr')
+
+        for entry in entries:
+            print(entry)
+
+    total = TraceCommandStats('Total')
+
+    print(TRACE_STATS_FMT.format('Command',
+                                 'Scans',
+                                 'Payload',
+                                 'Overhead',
+                                 'Eff.',
+                                 'Polls',
+                                 'Misses',
+                                 'ICSP [ms]',
+                                 'Idle [ms]'))
+
+    for command_stats in analyze_trace(entries):
+        print(command_stats.format())
+        total.number_of_scans += command_stats.number_of_scans
+        total.number_of_payload_bits += command_stats.number_of_payload_bits
+        total.number_of_overhead_bits += command_stats.number_of_overhead_bits
+        total.number_of_polls += command_stats.number_of_polls
+        total.number_of_poll_misses += command_stats.number_of_poll_misses
+        total.shift_time += command_stats.shift_time
+        total.idle_time += command_stats.idle_time
+
+    print(total.format())
+
+
+def create_row_segments(binfile):
+    """Returns given file padded to whole rows with erased flash, as a
+    list of segments of consecutive rows.
+
+    """
+
+    rows = {}
+
+    for segment in binfile.segments:
+        address = physical_flash_address(segment.address)
+        size = len(segment.data)
+
+        if not (is_program_flash_range(address, size)
+                or is_boot_flash_configuration_bits_range(address, size)):
+            sys.exit(
+                'error: address 0x{:08x} and size {} is out of range'.format(
+                    address,
+                    size))
+
+        for chunk in segment.chunks(FAST_WRITE_SIZE, FAST_WRITE_SIZE):
+            address = physical_flash_address(chunk.address)
+            offset = address % FAST_WRITE_SIZE
+            row = rows.setdefault(address - offset,
+                                  bytearray(FAST_WRITE_SIZE * b'\xff'))
+            row[offset:offset + len(chunk.data)] = chunk.data
+
+    segments = []
+
+    for address in sorted(rows):
+        if (segments
+            and segments[-1][0] + len(segments[-1][1]) == address
+            and len(segments[-1][1]) < SEGMENT_SIZE_MAX):
+            segments[-1][1].extend(rows[address])
+        else:
+            segments.append((address, rows[address]))
+
+    return [(address, bytes(data)) for address, data in segments]
+
+
+def create_production_image(binfile):
+    """Returns the production image of given file, as stored in the
+    programmer. The data is padded to whole rows, and grouped in
+    segments of consecutive rows, each with a header.
+
+    """
+
+    image = b''
+
+    for address, data in create_row_segments(binfile):
+        image += struct.pack('>IIIHH',
+                             address,
+                             len(data),
+                             binascii.crc32(data) & 0xffffffff,
+                             crc_ccitt(data),
+                             0)
+        image += data
+
+    return image
+
+
+def do_production_store(args):
+    if args.transport not in [None, 'icsp_soft', 'icsp_spi']:
+        sys.exit('error: production mode requires the icsp_soft or icsp_spi '
+                 'transport')
+
+    image = create_production_image(bincopy.BinFile(args.binfile))
+    serial_connection = serial_open_ensure_disconnected(args.port)
+
+    print('Storing {} in the programmer.'.format(os.path.abspath(args.binfile)))
+
+    with tqdm(total=len(image), unit=' bytes') as progress:
+        for offset in range(0, len(image), PRODUCTION_STORE_SIZE):
+            data = image[offset:offset + PRODUCTION_STORE_SIZE]
+            execute_command(serial_connection,
+                            PROGRAMMER_COMMAND_TYPE_PRODUCTION_STORE,
+                            struct.pack('>I', offset) + data)
+            progress.update(len(data))
+
+    flags = 0
+
+    if args.chip_erase:
+        flags |= PRODUCTION_FLAG_CHIP_ERASE
+
+    if args.verify:
+        flags |= PRODUCTION_FLAG_VERIFY
+
+    payload = struct.pack('>BII',
+                          flags,
+                          len(image),
+                          binascii.crc32(image) & 0xffffffff)
+
+    if args.transport is not None:
+        payload += struct.pack('B', TRANSPORTS[args.transport])
+
+    execute_command(serial_connection,
+                    PROGRAMMER_COMMAND_TYPE_PRODUCTION_ENABLE,
+                    payload)
+
+    print('Production mode enabled.')
+
+
+def do_production_disable(args):
+    serial_connection = serial_open_ensure_connected_to_programmer(args.port)
+    execute_command(serial_connection,
+                    PROGRAMMER_COMMAND_TYPE_PRODUCTION_ENABLE,
+                    struct.pack('>BII', 0, 0, 0))
+
+    print('Production mode disabled.')
+
+
+def do_production_status(args):
+    serial_connection = serial_open_ensure_connected_to_programmer(args.port)
+    status = execute_command(serial_connection,
+                             PROGRAMMER_COMMAND_TYPE_PRODUCTION_STATUS)
+    enabled, passed, failed, error = struct.unpack('>BIIi', status)
+
+    print('Production mode: {}'.format('enabled' if enabled else 'disabled'))
+    print('Passed:          {}'.format(passed))
+    print('Failed:          {}'.format(failed))
+
+    if failed > 0:
+        print('Last failure:    {}'.format(format_error(error)))
+
+
+def elf_image_words(elffile):
+    """Returns the text section words of given ELF file, as stored in
+    memory.
+
+    """
 
     disassembly = subprocess.check_output([
-        'mips-unknown-elf-objdump', '-d', args.elffile
+        'mips-unknown-elf-objdump', '-d', elffile
     ]).decode('utf-8')
 
     instructions = []
@@ -938,71 +2668,206 @@ def do_generate_ramapp_upload_instructions(args):
             else:
                 leftover = data
 
-    def fhex(packed):
-        return '0x' + binascii.hexlify(packed).decode('ascii')
-
-    def lui(rs, immediate):
-        instruction = fhex(bitstruct.pack('u16u6u5u5',
-                                          immediate,
-                                          0b010000,
-                                          0b01101,
-                                          rs))
-        comment = 'lui {}, 0x{:x}'.format(GPR_STRINGS[rs], immediate)
-
-        return (instruction, comment)
-
-    def ori(rt, rs, immediate):
-        instruction = fhex(bitstruct.pack('u16u6u5u5',
-                                          immediate,
-                                          0b010100,
-                                          rt,
-                                          rs))
-        comment = 'ori {}, {}, 0x{:x}'.format(GPR_STRINGS[rt],
-                                              GPR_STRINGS[rs],
-                                              immediate)
-
-        return (instruction, comment)
-
-    def swm32(reglist, base, offset):
-        instruction = fhex(bitstruct.pack('u4u12u6u5u5',
-                                          0b1101,
-                                          offset,
-                                          0b001000,
-                                          reglist,
-                                          base))
-        reglist = ', '.join([GPR_STRINGS[i] for i in REGLIST_GPRS[reglist]])
-        comment = 'swm32 {}, 0x{:x}({})'.format(reglist,
-                                                offset,
-                                                GPR_STRINGS[base])
-
-        return (instruction, comment)
+    return [int(high + low, 16) for high, low in pairs]
 
-    instructions = []
 
-    # Store up to 10 instructions at a time to RAM using with the
-    # SWM32 instruction. Maximum positive immediate offset in SWM32 is
-    # 2047 (12 bits signed).
-    for i in range(0, len(pairs), 512):
-        address = (0xa0000000 + 4 * i)
-        instructions.append(lui(4, address >> 16))
-        instructions.append(ori(4, 4, address & 0xffff))
-        chunkpairs = pairs[i:i + 512]
-
-        for j in range(0, len(chunkpairs), 10):
-            subpairs = chunkpairs[j:j + 10]
-            reglist = (15 + len(subpairs))
-            gprs = REGLIST_GPRS[reglist]
+def format_image_words(words):
+    lines = []
+
+    for i in range(0, len(words), 6):
+        lines.append(', '.join(['0x{:08x}'.format(word)
+                                for word in words[i:i + 6]]))
+
+    return ',\n'.join(lines)
+
 
-            for gpr, (high, low) in zip(gprs, subpairs):
-                instructions.append(lui(6, int(high, 16)))
-                instructions.append(ori(gpr, 6, int(low, 16)))
+def image_crc(words):
+    image = b''.join([struct.pack('<I', word) for word in words])
 
-            instructions.append(swm32(reglist, 4, 4 * j))
+    return '0x{:08x}'.format(binascii.crc32(image) & 0xffffffff)
+
+
+def do_generate_ramapp_upload_instructions(args):
+    words = elf_image_words(args.elffile)
+
+    if 0xa0000000 + 4 * len(words) > RAMAPP_LOADER_ADDRESS:
+        sys.exit('error: The application overlaps the loader.')
 
     with open(args.outfile, "w") as fout:
         fout.write(RAMAPP_UPLOAD_INSTRUCTIONS_I_FMT.format(
             __version__,
-            '\n'.join(['{}, /* {} */'.format(*i) for i in instructions])))
+            '\n'.join(['0x{:08x}, /* {} */'.format(*i)
+                       for i in loader_upload_instructions()]),
+            *[item for i in RAMAPP_LOADER_START for item in i]))
+
+    with open(args.imagefile, "w") as fout:
+        fout.write(RAMAPP_IMAGE_I_FMT.format(__version__,
+                                             len(words),
+                                             format_image_words(words),
+                                             image_crc(words)))
+
+
+def do_generate_ramapp_ext_images(args):
+    images = []
+    entries = []
+
+    for elffile in args.elffiles:
+        name = os.path.splitext(os.path.basename(elffile))[0]
+        words = elf_image_words(elffile)
+
+        if 4 * len(words) > RAMAPP_EXT_SIZE:
+            sys.exit('error: The module {} does not fit in the extension '
+                     'module region.'.format(name))
+
+        if len(words) < 2 + RAMAPP_EXT_TYPES_MAX:
+            words = [0]
+
+        if words[0] != RAMAPP_EXT_MAGIC:
+            sys.exit('error: The module {} has no header.'.format(name))
+
+        types = ', '.join([str(type_)
+                           for type_ in words[2:2 + RAMAPP_EXT_TYPES_MAX]])
+        image = '    ' + format_image_words(words).replace('\n', '\n    ')
+        images.append(RAMAPP_EXT_IMAGE_FMT.format(name,
+                                                  len(words),
+                                                  image,
+                                                  image_crc(words)))
+        entries.append(
+            '    {{ {{ {} }}, &ramapp_ext_{}_image[0] }},\n'.format(types,
+                                                                  name))
+
+    with open(args.outfile, "w") as fout:
+        fout.write(RAMAPP_EXT_IMAGES_I_FMT.format(__version__,
+                                                  ''.join(images),
+                                                  ''.join(entries)))
+
+
+def do_generate_icsp_spi_sequences(args):
+    # Instructions and commands, shifted least significant bit first.
+    mtap_command = 0x07
+    mtap_sw_mtap = 0x04
+    mtap_sw_etap = 0x05
+    etap_data = 0x09
+    etap_control = 0x0a
+    etap_ejtagboot = 0x0c
+    mchp_status = 0x00
+    mchp_assert_rst = 0xd1
+    mchp_de_assert_rst = 0xd0
+    mchp_erase = 0xfc
+    control_pracc_bit = 18
+
+    class Sequence(object):
+
+        def __init__(self):
+            self.cycles = []
+            self.samples = []
+
+        def append_cycle(self, tms, tdi):
+            self.cycles.append((tdi << 3) | (tms << 2))
+
+        def append_tms(self, tms, size):
+            for i in reversed(range(size)):
+                self.append_cycle((tms >> i) & 1, 0)
+
+        def append_bits(self, value, number_of_bits, samples):
+            for i in range(number_of_bits):
+                if i in samples:
+                    self.samples.append(len(self.cycles))
+
+                self.append_cycle(i == number_of_bits - 1, (value >> i) & 1)
+
+            self.append_tms(0b10, 2)
+
+            # Pad to a whole byte with an idle cycle, as the driver.
+            if len(self.cycles) % 2 == 1:
+                self.append_cycle(0, 0)
+
+        def instruction(self, value):
+            self.append_tms(0b1100, 4)
+            self.append_bits(value, 5, [])
+
+        def data(self, value, number_of_bits, samples=None):
+            if samples is None:
+                samples = []
+
+            self.append_tms(0b100, 3)
+            self.append_bits(value, number_of_bits, samples)
+
+        def to_bytes(self):
+            return bytearray([(self.cycles[i] << 4) | self.cycles[i + 1]
+                              for i in range(0, len(self.cycles), 2)])
+
+    def format_bytes(data):
+        lines = []
+
+        for i in range(0, len(data), 12):
+            lines.append('    ' + ', '.join(['0x{:02x}'.format(byte)
+                                             for byte in data[i:i + 12]]))
+
+        return ',\n'.join(lines)
+
+    def format_samples(samples):
+        return '    ' + ', '.join([str(sample) for sample in samples])
+
+    read_status = Sequence()
+    read_status.instruction(mtap_sw_mtap)
+    read_status.instruction(mtap_command)
+    read_status.data(mchp_status, 8, range(8))
+
+    enter_serial_execution_mode = Sequence()
+    enter_serial_execution_mode.data(mchp_assert_rst, 8)
+    enter_serial_execution_mode.instruction(mtap_sw_etap)
+    enter_serial_execution_mode.instruction(etap_ejtagboot)
+    enter_serial_execution_mode.instruction(mtap_sw_mtap)
+    enter_serial_execution_mode.instruction(mtap_command)
+    enter_serial_execution_mode.data(mchp_de_assert_rst, 8)
+    enter_serial_execution_mode.instruction(mtap_sw_etap)
+
+    chip_erase = Sequence()
+    chip_erase.instruction(mtap_sw_mtap)
+    chip_erase.instruction(mtap_command)
+    chip_erase.data(mchp_erase, 8)
+    chip_erase.data(mchp_de_assert_rst, 8)
+
+    instructions = (loader_upload_instructions()
+                    + RAMAPP_LOADER_START
+                    + [(0x00000000, 'nop')])
+    upload_loader = []
+
+    for instruction, comment in instructions:
+        sequence = Sequence()
+        sequence.instruction(etap_control)
+        sequence.data(0x0004c000, 32, [control_pracc_bit])
+        sequence.instruction(etap_data)
+        sequence.data(instruction, 32)
+        sequence.instruction(etap_control)
+        sequence.data(0x0000c000, 32)
+        upload_loader.append((sequence, comment))
+
+    size = len(upload_loader[0][0].to_bytes())
+    upload_loader_cycles = []
+    upload_loader_sequences = []
+
+    for i, (sequence, comment) in enumerate(upload_loader):
+        upload_loader_cycles.append(
+            '    {{ /* {} */\n    {}\n    }}'.format(
+                comment,
+                format_bytes(sequence.to_bytes()).replace('\n', '\n    ')))
+        upload_loader_sequences.append(
+            '    {{ &upload_loader_cycles[{}][0], {}, '
+            '&upload_loader_samples[0], 1 }}'.format(i, size))
+
+    with open(args.outfile, "w") as fout:
+        fout.write(ICSP_SPI_SEQUENCES_I_FMT.format(
+            __version__,
+            format_bytes(read_status.to_bytes()),
+            format_samples(read_status.samples),
+            format_bytes(enter_serial_execution_mode.to_bytes()),
+            format_bytes(chip_erase.to_bytes()),
+            size,
+            ',\n'.join(upload_loader_cycles),
+            format_samples(upload_loader[0][0].samples),
+            ',\n'.join(upload_loader_sequences)))
 
 
 def main():
@@ -1013,11 +2878,35 @@ def main():
     parser = argparse.ArgumentParser(description=description)
     parser.add_argument('-p', '--port',
                         default='/dev/ttyUSB1',
-                        help='Programmer serial port (default: /dev/ttyUSB1).')
+                        help=('Programmer serial port, or usb for the vendor '
+                              'specific USB interface (default: '
+                              '/dev/ttyUSB1).'))
     parser.add_argument('-d', '--debug', action='store_true')
     parser.add_argument('-m', '--mcu',
                         choices=SUPPORTED_MCUS,
                         default='pic32mm0256gpm064')
+    parser.add_argument('-t', '--transport',
+                        choices=sorted(TRANSPORTS),
+                        help=('ICSP transport in the programmer (default: '
+                              'programmer build default).'))
+    parser.add_argument('--icsp-clock',
+                        type=int,
+                        help=('ICSP clock frequency in Hz. Only the icsp_spi '
+                              'transport has an adjustable clock (default: '
+                              'calibrated by the programmer).'))
+    parser.add_argument('--targets',
+                        type=parse_targets,
+                        help=('Comma separated list of targets to program with '
+                              'the icsp_gang transport, or devices to program '
+                              'in the JTAG scan chain, for example 0,1,3 '
+                              '(default: all targets or PIC32 devices).'))
+    parser.add_argument('--jtag-chain',
+                        type=parse_jtag_chain,
+                        help=('Comma separated list of instruction register '
+                              'lengths of the devices in the JTAG scan chain '
+                              'of the jtag_soft transport, starting with the '
+                              'device connected to the programmer TDO, for '
+                              'example 5,4,5 (default: a single PIC32).'))
     parser.add_argument('--version',
                         action='version',
                         version=__version__,
@@ -1042,6 +2931,13 @@ def main():
     subparser.add_argument('size')
     subparser.set_defaults(func=do_flash_erase)
 
+    subparser = subparsers.add_parser(
+        'flash_blank_check',
+        help='Check that given flash range is erased.')
+    subparser.add_argument('address')
+    subparser.add_argument('size')
+    subparser.set_defaults(func=do_flash_blank_check)
+
     subparser = subparsers.add_parser('flash_read',
                                       help='Read from the flash memory.')
     subparser.add_argument('address')
@@ -1088,6 +2984,12 @@ def main():
                                       help='Print the device status.')
     subparser.set_defaults(func=do_device_status_print)
 
+    subparser = subparsers.add_parser(
+        'targets_status_print',
+        help=('Print the targets not yet dropped by the icsp_gang '
+              'transport or the JTAG scan chain.'))
+    subparser.set_defaults(func=do_targets_status_print)
+
     subparser = subparsers.add_parser(
         'programmer_ping',
         help='Test if the programmer is alive.')
@@ -1108,13 +3010,82 @@ def main():
         help='Read the programmer software version.')
     subparser.set_defaults(func=do_programmer_version)
 
+    subparser = subparsers.add_parser(
+        'programmer_capabilities',
+        help='Read the programmer protocol capabilities.')
+    subparser.set_defaults(func=do_programmer_capabilities)
+
+    subparser = subparsers.add_parser(
+        'programmer_stats',
+        help=('Print where the programmer has spent its time since the '
+              'statistics were last printed, and reset them.'))
+    subparser.set_defaults(func=do_programmer_stats)
+
+    subparser = subparsers.add_parser(
+        'programmer_trace_start',
+        help=('Start recording the ICSP shifts of the programmer, discarding '
+              'any previously recorded shifts.'))
+    subparser.set_defaults(func=do_programmer_trace_start)
+
+    subparser = subparsers.add_parser(
+        'programmer_trace_analyze',
+        help=('Stop recording the ICSP shifts of the programmer, and print '
+              'the payload and overhead bits, PrAcc polls and idle time per '
+              'command type.'))
+    subparser.add_argument('--dump',
+                           action='store_true',
+                           help='Also print each recorded shift.')
+    subparser.set_defaults(func=do_programmer_trace_analyze)
+
+    subparser = subparsers.add_parser(
+        'production_store',
+        help=('Store given file in the programmer and enable production mode, '
+              'in which the programmer writes the file to each PIC connected '
+              'to it, without a host.'))
+    subparser.add_argument('-c', '--chip-erase', action='store_true')
+    subparser.add_argument('-v', '--verify',
+                           action='store_true',
+                           help='CRC-32 verification.')
+    subparser.add_argument('binfile')
+    subparser.set_defaults(func=do_production_store)
+
+    subparser = subparsers.add_parser(
+        'production_disable',
+        help='Disable production mode.')
+    subparser.set_defaults(func=do_production_disable)
+
+    subparser = subparsers.add_parser(
+        'production_status',
+        help='Print the number of PICs programmed in production mode.')
+    subparser.set_defaults(func=do_production_status)
+
     subparser = subparsers.add_parser(
         'generate_ramapp_upload_instructions',
-        help='Generate the RAM application C source file.')
+        help='Generate the RAM application C source files.')
     subparser.add_argument('elffile')
-    subparser.add_argument('outfile')
+    subparser.add_argument('outfile',
+                           help='Loader upload instructions output file.')
+    subparser.add_argument('imagefile',
+                           help='Application image output file.')
     subparser.set_defaults(func=do_generate_ramapp_upload_instructions)
 
+    subparser = subparsers.add_parser(
+        'generate_ramapp_ext_images',
+        help='Generate the RAM application extension modules C source file.')
+    subparser.add_argument('outfile',
+                           help='Extension module images output file.')
+    subparser.add_argument('elffiles',
+                           nargs='*',
+                           help='Extension module ELF files.')
+    subparser.set_defaults(func=do_generate_ramapp_ext_images)
+
+    subparser = subparsers.add_parser(
+        'generate_icsp_spi_sequences',
+        help=('Generate the precompiled ICSP sequences C source file for '
+              'the USART SPI transport.'))
+    subparser.add_argument('outfile')
+    subparser.set_defaults(func=do_generate_icsp_spi_sequences)
+
     args = parser.parse_args()
 
     if args.debug:
@@ -0,0 +1,353 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#ifndef __COMPAT_H__
+#define __COMPAT_H__
+
+#include "simba.h"
+
+/* The cycle counter is clocked by the core clock. */
+#define CYCLE_COUNTER_FREQUENCY_MHZ                        84
+
+#if !defined(UNIT_TEST)
+
+/* Cortex-M3 debug exception and monitor control register, and the
+   data watchpoint and trace unit with the cycle counter. */
+#define CM3_DEMCR            ((volatile uint32_t *) 0xe000edfc)
+#define CM3_DWT_CTRL         ((volatile uint32_t *) 0xe0001000)
+#define CM3_DWT_CYCCNT       ((volatile uint32_t *) 0xe0001004)
+
+#define DEMCR_TRCENA                                   BIT(24)
+#define DWT_CTRL_CYCCNTENA                             BIT(0)
+
+/**
+ * Start the cycle counter.
+ */
+static inline void cycle_counter_start(void)
+{
+    *CM3_DEMCR |= DEMCR_TRCENA;
+    *CM3_DWT_CYCCNT = 0;
+    *CM3_DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+/**
+ * Read the cycle counter. It wraps around after about 51 seconds.
+ */
+static inline uint32_t cycle_counter_read(void)
+{
+    return (*CM3_DWT_CYCCNT);
+}
+
+/* Peripheral identifiers. */
+#define SAM3X_ID_USART1                                    18
+
+/* Power management controller. */
+#define SAM3X_PMC_PCER0      ((volatile uint32_t *) 0x400e0610)
+
+/* Parallel I/O controller A. */
+#define SAM3X_PIOA_PER       ((volatile uint32_t *) 0x400e0e00)
+#define SAM3X_PIOA_PDR       ((volatile uint32_t *) 0x400e0e04)
+#define SAM3X_PIOA_ODR       ((volatile uint32_t *) 0x400e0e14)
+#define SAM3X_PIOA_ABSR      ((volatile uint32_t *) 0x400e0e70)
+
+/* USART1 and its peripheral DMA controller. */
+#define SAM3X_USART1_CR      ((volatile uint32_t *) 0x4009c000)
+#define SAM3X_USART1_MR      ((volatile uint32_t *) 0x4009c004)
+#define SAM3X_USART1_IDR     ((volatile uint32_t *) 0x4009c00c)
+#define SAM3X_USART1_CSR     ((volatile uint32_t *) 0x4009c014)
+#define SAM3X_USART1_BRGR    ((volatile uint32_t *) 0x4009c020)
+#define SAM3X_USART1_RPR     ((volatile uint32_t *) 0x4009c100)
+#define SAM3X_USART1_RCR     ((volatile uint32_t *) 0x4009c104)
+#define SAM3X_USART1_TPR     ((volatile uint32_t *) 0x4009c108)
+#define SAM3X_USART1_TCR     ((volatile uint32_t *) 0x4009c10c)
+#define SAM3X_USART1_PTCR    ((volatile uint32_t *) 0x4009c120)
+
+#define USART_CR_RSTRX                                 BIT(2)
+#define USART_CR_RSTTX                                 BIT(3)
+#define USART_CR_RXEN                                  BIT(4)
+#define USART_CR_RXDIS                                 BIT(5)
+#define USART_CR_TXEN                                  BIT(6)
+#define USART_CR_TXDIS                                 BIT(7)
+#define USART_CR_RSTSTA                                BIT(8)
+
+#define USART_MR_MODE_SPI_MASTER                          0xe
+#define USART_MR_CHRL_8_BIT                     (0x3 << 6)
+#define USART_MR_CLKO                                 BIT(18)
+
+#define USART_CSR_ENDRX                                BIT(3)
+
+#define PDC_PTCR_RXTEN                                 BIT(0)
+#define PDC_PTCR_RXTDIS                                BIT(1)
+#define PDC_PTCR_TXTEN                                 BIT(8)
+#define PDC_PTCR_TXTDIS                                BIT(9)
+
+/* SCK1 (PGEC) on PA16, TXD1 (PGED out) on PA13 and RXD1 (PGED in)
+   on PA12. */
+#define USART1_SPI_PINS             (BIT(16) | BIT(13) | BIT(12))
+
+/**
+ * Configure USART1 as a SPI master clocking PGEC at MCK divided by
+ * given divider, with data changed on the rising edge and sampled on
+ * the falling edge.
+ */
+static inline void usart_spi_start(int clock_divider)
+{
+    *SAM3X_PMC_PCER0 = BIT(SAM3X_ID_USART1);
+    *SAM3X_PIOA_ABSR &= ~USART1_SPI_PINS;
+    *SAM3X_PIOA_PDR = USART1_SPI_PINS;
+
+    *SAM3X_USART1_CR = (USART_CR_RSTRX
+                        | USART_CR_RSTTX
+                        | USART_CR_RXDIS
+                        | USART_CR_TXDIS
+                        | USART_CR_RSTSTA);
+    *SAM3X_USART1_IDR = 0xffffffff;
+    *SAM3X_USART1_MR = (USART_MR_MODE_SPI_MASTER
+                        | USART_MR_CHRL_8_BIT
+                        | USART_MR_CLKO);
+    *SAM3X_USART1_BRGR = clock_divider;
+    *SAM3X_USART1_CR = (USART_CR_RXEN | USART_CR_TXEN);
+}
+
+/**
+ * Change the PGEC clock divider. Must not be called during a
+ * transfer.
+ */
+static inline void usart_spi_set_clock_divider(int clock_divider)
+{
+    *SAM3X_USART1_BRGR = clock_divider;
+}
+
+/**
+ * Stop USART1 and set PGEC and PGED to inputs.
+ */
+static inline void usart_spi_stop(void)
+{
+    *SAM3X_USART1_PTCR = (PDC_PTCR_RXTDIS | PDC_PTCR_TXTDIS);
+    *SAM3X_USART1_CR = (USART_CR_RXDIS | USART_CR_TXDIS);
+    *SAM3X_PIOA_ODR = USART1_SPI_PINS;
+    *SAM3X_PIOA_PER = USART1_SPI_PINS;
+}
+
+/**
+ * Let the PDC shift given transmit buffer out on PGEC/PGED while
+ * sampling PGED into given receive buffer. Returns when the last
+ * byte has been received.
+ */
+static inline void usart_spi_transfer(uint8_t *rxbuf_p,
+                                      const uint8_t *txbuf_p,
+                                      size_t size)
+{
+    *SAM3X_USART1_RPR = (uint32_t)(uintptr_t)rxbuf_p;
+    *SAM3X_USART1_RCR = size;
+    *SAM3X_USART1_TPR = (uint32_t)(uintptr_t)txbuf_p;
+    *SAM3X_USART1_TCR = size;
+    *SAM3X_USART1_PTCR = (PDC_PTCR_RXTEN | PDC_PTCR_TXTEN);
+
+    while ((*SAM3X_USART1_CSR & USART_CSR_ENDRX) == 0);
+
+    *SAM3X_USART1_PTCR = (PDC_PTCR_RXTDIS | PDC_PTCR_TXTDIS);
+}
+
+/* JTAG pin devices. */
+#define pin_tck_dev                                pin_d22_dev
+#define pin_tms_dev                                pin_d23_dev
+#define pin_tdi_dev                                pin_d24_dev
+#define pin_tdo_dev                                pin_d25_dev
+
+/**
+ * Set TCK, TMS and TDI to outputs and TDO to input.
+ */
+static inline void jtag_start(void)
+{
+    pin_device_write_low(&pin_tck_dev);
+    pin_device_set_mode(&pin_tck_dev, PIN_OUTPUT);
+    pin_device_write_high(&pin_tms_dev);
+    pin_device_set_mode(&pin_tms_dev, PIN_OUTPUT);
+    pin_device_write_low(&pin_tdi_dev);
+    pin_device_set_mode(&pin_tdi_dev, PIN_OUTPUT);
+    pin_device_set_mode(&pin_tdo_dev, PIN_INPUT);
+}
+
+/**
+ * Set all JTAG pins to inputs.
+ */
+static inline void jtag_stop(void)
+{
+    pin_device_set_mode(&pin_tck_dev, PIN_INPUT);
+    pin_device_set_mode(&pin_tms_dev, PIN_INPUT);
+    pin_device_set_mode(&pin_tdi_dev, PIN_INPUT);
+}
+
+/**
+ * Output given TMS and TDI values and clock them into the TAP. TDO
+ * is sampled before the rising edge, as it changes on the falling
+ * edge.
+ *
+ * @return TDO.
+ */
+static inline int jtag_clock(int tms, int tdi)
+{
+    int tdo;
+
+    if (tms) {
+        pin_device_write_high(&pin_tms_dev);
+    } else {
+        pin_device_write_low(&pin_tms_dev);
+    }
+
+    if (tdi) {
+        pin_device_write_high(&pin_tdi_dev);
+    } else {
+        pin_device_write_low(&pin_tdi_dev);
+    }
+
+    tdo = pin_device_read(&pin_tdo_dev);
+    pin_device_write_high(&pin_tck_dev);
+    pin_device_write_low(&pin_tck_dev);
+
+    return (tdo);
+}
+
+/* Gang pin devices. PGEC is shared by all targets. */
+#define pin_gang_pgec_dev                          pin_d2_dev
+
+#define GANG_PGED_DEVS                                          \
+    {                                                           \
+        &pin_d26_dev, &pin_d28_dev, &pin_d30_dev, &pin_d32_dev, \
+        &pin_d34_dev, &pin_d36_dev, &pin_d38_dev, &pin_d40_dev  \
+    }
+
+/**
+ * Set PGEC and the PGED of all targets to outputs.
+ */
+static inline void gang_start(void)
+{
+    static struct pin_device_t *const pged_devs[] = GANG_PGED_DEVS;
+    size_t i;
+
+    pin_device_write_low(&pin_gang_pgec_dev);
+    pin_device_set_mode(&pin_gang_pgec_dev, PIN_OUTPUT);
+
+    for (i = 0; i < membersof(pged_devs); i++) {
+        pin_device_write_low(pged_devs[i]);
+        pin_device_set_mode(pged_devs[i], PIN_OUTPUT);
+    }
+}
+
+/**
+ * Set PGEC and the PGED of all targets to inputs.
+ */
+static inline void gang_stop(void)
+{
+    static struct pin_device_t *const pged_devs[] = GANG_PGED_DEVS;
+    size_t i;
+
+    pin_device_set_mode(&pin_gang_pgec_dev, PIN_INPUT);
+
+    for (i = 0; i < membersof(pged_devs); i++) {
+        pin_device_set_mode(pged_devs[i], PIN_INPUT);
+    }
+}
+
+/**
+ * Output bit n of given value on PGED of target n, and clock it into
+ * all targets on the falling edge of PGEC.
+ */
+static inline void gang_clock(uint32_t pged)
+{
+    static struct pin_device_t *const pged_devs[] = GANG_PGED_DEVS;
+    size_t i;
+
+    for (i = 0; i < membersof(pged_devs); i++) {
+        if ((pged >> i) & 1) {
+            pin_device_write_high(pged_devs[i]);
+        } else {
+            pin_device_write_low(pged_devs[i]);
+        }
+    }
+
+    pin_device_write_high(&pin_gang_pgec_dev);
+    pin_device_write_low(&pin_gang_pgec_dev);
+}
+
+/**
+ * Release PGED for the turnaround phase, and sample TDO in the
+ * fourth phase of a cycle.
+ *
+ * @return TDO of target n in bit n.
+ */
+static inline uint32_t gang_sample(void)
+{
+    static struct pin_device_t *const pged_devs[] = GANG_PGED_DEVS;
+    size_t i;
+    uint32_t tdo;
+
+    for (i = 0; i < membersof(pged_devs); i++) {
+        pin_device_set_mode(pged_devs[i], PIN_INPUT);
+    }
+
+    pin_device_write_high(&pin_gang_pgec_dev);
+    pin_device_write_low(&pin_gang_pgec_dev);
+    pin_device_write_high(&pin_gang_pgec_dev);
+    tdo = 0;
+
+    for (i = 0; i < membersof(pged_devs); i++) {
+        tdo |= (pin_device_read(pged_devs[i]) << i);
+    }
+
+    pin_device_write_low(&pin_gang_pgec_dev);
+
+    for (i = 0; i < membersof(pged_devs); i++) {
+        pin_device_set_mode(pged_devs[i], PIN_OUTPUT);
+    }
+
+    return (tdo);
+}
+
+#else
+
+extern void cycle_counter_start(void);
+extern uint32_t cycle_counter_read(void);
+extern void usart_spi_start(int clock_divider);
+extern void usart_spi_set_clock_divider(int clock_divider);
+extern void usart_spi_stop(void);
+extern void usart_spi_transfer(uint8_t *rxbuf_p,
+                               const uint8_t *txbuf_p,
+                               size_t size);
+extern void jtag_start(void);
+extern void jtag_stop(void);
+extern int jtag_clock(int tms, int tdi);
+extern void gang_start(void);
+extern void gang_stop(void);
+extern void gang_clock(uint32_t pged);
+extern uint32_t gang_sample(void);
+
+#endif
+
+#endif
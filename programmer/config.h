@@ -32,8 +32,13 @@
 #define CONFIG_MINIMAL_SYSTEM                          1
 #define CONFIG_ICSP_SOFT                               1
 #define CONFIG_PIN                                     1
+#define CONFIG_FLASH                                   1
 #define CONFIG_USB                                     1
 #define CONFIG_START_CONSOLE_RX_BUFFER_SIZE            2048
-#define CONFIG_START_CONSOLE                           CONFIG_START_CONSOLE_USB_CDC
+#define CONFIG_START_CONSOLE                           CONFIG_START_CONSOLE_NONE
+#define CONFIG_PROGRAMMER_USB_VENDOR                   1
+#define CONFIG_PROGRAMMER_PIPELINE                     1
+#define CONFIG_PROGRAMMER_PRODUCTION                   1
+#define CONFIG_PROGRAMMER_TRANSPORT                    PROGRAMMER_TRANSPORT_ICSP_SOFT
 
 #endif
@@ -27,6 +27,15 @@
  */
 
 #include "simba.h"
+#include "usb_vendor.h"
+
+#if CONFIG_PROGRAMMER_USB_VENDOR == 1
+#    define NUM_INTERFACES                                  3
+#    define TOTAL_LENGTH                                  105
+#else
+#    define NUM_INTERFACES                                  2
+#    define TOTAL_LENGTH                                   75
+#endif
 
 static FAR const struct usb_descriptor_device_t
 device_descriptor = {
@@ -50,8 +59,8 @@ static FAR const struct usb_descriptor_configuration_t
 configuration_descriptor = {
     .length = sizeof(configuration_descriptor),
     .descriptor_type = DESCRIPTOR_TYPE_CONFIGURATION,
-    .total_length = 75,
-    .num_interfaces = 2,
+    .total_length = TOTAL_LENGTH,
+    .num_interfaces = NUM_INTERFACES,
     .configuration_value = 1,
     .configuration = 0,
     .configuration_attributes = CONFIGURATION_ATTRIBUTES_BUS_POWERED,
@@ -160,6 +169,53 @@ endpoint_3_descriptor = {
     .interval = 128
 };
 
+#if CONFIG_PROGRAMMER_USB_VENDOR == 1
+
+static FAR const struct usb_descriptor_interface_t
+inferface_2_descriptor = {
+    .length = sizeof(inferface_2_descriptor),
+    .descriptor_type = DESCRIPTOR_TYPE_INTERFACE,
+    .interface_number = USB_VENDOR_INTERFACE,
+    .alternate_setting = 0,
+    .num_endpoints = 3,
+    .interface_class = 0xff, /* Vendor specific. */
+    .interface_subclass = 0,
+    .interface_protocol = 0,
+    .interface = 0
+};
+
+static FAR const struct usb_descriptor_endpoint_t
+endpoint_4_descriptor = {
+    .length = sizeof(endpoint_4_descriptor),
+    .descriptor_type = DESCRIPTOR_TYPE_ENDPOINT,
+    .endpoint_address = USB_VENDOR_ENDPOINT_OUT, /* EP 4 OUT. */
+    .attributes = ENDPOINT_ATTRIBUTES_TRANSFER_TYPE_BULK,
+    .max_packet_size = USB_VENDOR_PACKET_SIZE,
+    .interval = 0
+};
+
+static FAR const struct usb_descriptor_endpoint_t
+endpoint_5_descriptor = {
+    .length = sizeof(endpoint_5_descriptor),
+    .descriptor_type = DESCRIPTOR_TYPE_ENDPOINT,
+    .endpoint_address = (0x80 | USB_VENDOR_ENDPOINT_IN), /* EP 5 IN. */
+    .attributes = ENDPOINT_ATTRIBUTES_TRANSFER_TYPE_BULK,
+    .max_packet_size = USB_VENDOR_PACKET_SIZE,
+    .interval = 0
+};
+
+static FAR const struct usb_descriptor_endpoint_t
+endpoint_6_descriptor = {
+    .length = sizeof(endpoint_6_descriptor),
+    .descriptor_type = DESCRIPTOR_TYPE_ENDPOINT,
+    .endpoint_address = USB_VENDOR_ENDPOINT_DATA_OUT, /* EP 6 OUT. */
+    .attributes = ENDPOINT_ATTRIBUTES_TRANSFER_TYPE_BULK,
+    .max_packet_size = USB_VENDOR_PACKET_SIZE,
+    .interval = 0
+};
+
+#endif
+
 /**
  * An array of all USB device descriptors.
  */
@@ -177,5 +233,11 @@ usb_device_descriptors[] = {
     (FAR const union usb_descriptor_t *)&inferface_1_descriptor,
     (FAR const union usb_descriptor_t *)&endpoint_2_descriptor,
     (FAR const union usb_descriptor_t *)&endpoint_3_descriptor,
+#if CONFIG_PROGRAMMER_USB_VENDOR == 1
+    (FAR const union usb_descriptor_t *)&inferface_2_descriptor,
+    (FAR const union usb_descriptor_t *)&endpoint_4_descriptor,
+    (FAR const union usb_descriptor_t *)&endpoint_5_descriptor,
+    (FAR const union usb_descriptor_t *)&endpoint_6_descriptor,
+#endif
     NULL
 };
@@ -0,0 +1,481 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#include "simba.h"
+#include "icsp_gang.h"
+#include "compat.h"
+
+/* TMS sequences, shifted out most significant bit first. */
+#define TMS_RESET                                        0x3e
+#define TMS_RESET_SIZE                                      6
+#define TMS_SELECT_IR_SCAN                                0xc
+#define TMS_SELECT_IR_SCAN_SIZE                             4
+#define TMS_SELECT_DR_SCAN                                0x4
+#define TMS_SELECT_DR_SCAN_SIZE                             3
+#define TMS_EXIT                                          0x2
+#define TMS_EXIT_SIZE                                       2
+
+/* Clocked into PGED, most significant bit first, to enter ICSP
+   mode. */
+#define KEY                                        0x4d434850
+
+/**
+ * Clock one 4-phase cycle into given targets. Other targets get TMS
+ * and TDI low, and stay in Run-Test/Idle.
+ *
+ * @return TDO of given targets.
+ */
+static uint32_t cycle(uint32_t targets, int tms, int tdi)
+{
+    gang_clock(tdi ? targets : 0);
+    gang_clock(tms ? targets : 0);
+
+    return (gang_sample() & targets);
+}
+
+static void shift_tms(uint32_t targets, uint8_t tms, size_t size)
+{
+    while (size > 0) {
+        size--;
+        cycle(targets, (tms >> size) & 1, 0);
+    }
+}
+
+/**
+ * Shift given bits, most significant bit of each byte first, with
+ * TMS set on the last bit to leave the shift state. Bits shifted out
+ * of target n are stored in samples[n], first bit in the most
+ * significant bit.
+ */
+static void shift_bits(uint32_t targets,
+                       uint32_t *samples_p,
+                       const uint8_t *txbuf_p,
+                       size_t number_of_bits)
+{
+    size_t i;
+    int j;
+    int tdi;
+    uint32_t tdo;
+
+    memset(samples_p, 0, sizeof(*samples_p) * ICSP_GANG_TARGETS_MAX);
+
+    for (i = 0; i < number_of_bits; i++) {
+        tdi = 0;
+
+        if (txbuf_p != NULL) {
+            tdi = ((txbuf_p[i / 8] >> (7 - (i % 8))) & 1);
+        }
+
+        tdo = cycle(targets, i == (number_of_bits - 1), tdi);
+
+        for (j = 0; j < ICSP_GANG_TARGETS_MAX; j++) {
+            samples_p[j] |= (((tdo >> j) & 1) << (31 - i));
+        }
+    }
+}
+
+/**
+ * Shift a 32 bits word, least significant bit first, preceded by the
+ * processor access (PrAcc) bit.
+ *
+ * @return Targets that accepted or provided the word.
+ */
+static uint32_t shift_fast_data(uint32_t targets,
+                                uint32_t *samples_p,
+                                uint32_t txdata)
+{
+    uint32_t pracc;
+    uint32_t tdo;
+    size_t i;
+    int j;
+
+    memset(samples_p, 0, sizeof(*samples_p) * ICSP_GANG_TARGETS_MAX);
+
+    shift_tms(targets, TMS_SELECT_DR_SCAN, TMS_SELECT_DR_SCAN_SIZE);
+    pracc = cycle(targets, 0, 0);
+
+    for (i = 0; i < 32; i++) {
+        tdo = cycle(targets, i == 31, (txdata >> i) & 1);
+
+        for (j = 0; j < ICSP_GANG_TARGETS_MAX; j++) {
+            samples_p[j] |= (((tdo >> j) & 1) << i);
+        }
+    }
+
+    shift_tms(targets, TMS_EXIT, TMS_EXIT_SIZE);
+
+    return (pracc);
+}
+
+/**
+ * Drop alive targets whose sample differs from the most common
+ * sample.
+ *
+ * @return The most common sample.
+ */
+static uint32_t vote(struct icsp_gang_driver_t *self_p,
+                     const uint32_t *samples_p)
+{
+    int i;
+    int j;
+    int votes;
+    int best_votes;
+    uint32_t best;
+
+    best = 0;
+    best_votes = 0;
+
+    for (i = 0; i < self_p->number_of_targets; i++) {
+        if ((self_p->alive & BIT(i)) == 0) {
+            continue;
+        }
+
+        votes = 0;
+
+        for (j = 0; j < self_p->number_of_targets; j++) {
+            if ((self_p->alive & BIT(j)) && (samples_p[j] == samples_p[i])) {
+                votes++;
+            }
+        }
+
+        if (votes > best_votes) {
+            best = samples_p[i];
+            best_votes = votes;
+        }
+    }
+
+    for (i = 0; i < self_p->number_of_targets; i++) {
+        if ((self_p->alive & BIT(i)) && (samples_p[i] != best)) {
+            self_p->alive &= ~BIT(i);
+        }
+    }
+
+    return (best);
+}
+
+static void sample_to_bytes(uint8_t *buf_p,
+                            uint32_t sample,
+                            size_t number_of_bits)
+{
+    size_t i;
+
+    for (i = 0; i < DIV_CEIL(number_of_bits, 8); i++) {
+        buf_p[i] = (sample >> (24 - 8 * i));
+    }
+}
+
+static uint32_t bytes_to_sample(const uint8_t *buf_p, size_t number_of_bits)
+{
+    size_t i;
+    uint32_t sample;
+
+    sample = 0;
+
+    for (i = 0; i < DIV_CEIL(number_of_bits, 8); i++) {
+        sample |= (buf_p[i] << (24 - 8 * i));
+    }
+
+    return (sample);
+}
+
+static int shift_data(struct icsp_gang_driver_t *self_p,
+                      uint8_t *rxbuf_p,
+                      const uint8_t *txbuf_p,
+                      size_t number_of_bits)
+{
+    uint32_t samples[ICSP_GANG_TARGETS_MAX];
+
+    if ((number_of_bits == 0) || (number_of_bits > 32)) {
+        return (-EINVAL);
+    }
+
+    if (self_p->alive == 0) {
+        return (-ENODEV);
+    }
+
+    shift_tms(self_p->alive, TMS_SELECT_DR_SCAN, TMS_SELECT_DR_SCAN_SIZE);
+    shift_bits(self_p->alive, &samples[0], txbuf_p, number_of_bits);
+    shift_tms(self_p->alive, TMS_EXIT, TMS_EXIT_SIZE);
+
+    if (rxbuf_p != NULL) {
+        sample_to_bytes(rxbuf_p, vote(self_p, &samples[0]), number_of_bits);
+    }
+
+    return (0);
+}
+
+/**
+ * Transfer given word to or from all alive targets. Once one target
+ * has transferred it, the others are given a few retries to catch
+ * up, as the targets run on their own clocks.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int transfer_fast_data(struct icsp_gang_driver_t *self_p,
+                              uint32_t *rxdata_p,
+                              uint32_t txdata)
+{
+    uint32_t samples[ICSP_GANG_TARGETS_MAX];
+    uint32_t pending;
+    uint32_t done;
+    int attempt;
+    int i;
+
+    if (self_p->alive == 0) {
+        return (-ENODEV);
+    }
+
+    pending = self_p->alive;
+    attempt = 0;
+
+    do {
+        done = shift_fast_data(pending, &samples[0], txdata);
+
+        if ((done == 0) && (pending == self_p->alive)) {
+            return (-EPROTO);
+        }
+
+        for (i = 0; i < ICSP_GANG_TARGETS_MAX; i++) {
+            if (done & BIT(i)) {
+                rxdata_p[i] = samples[i];
+            }
+        }
+
+        pending &= ~done;
+        attempt++;
+    } while ((pending != 0) && (attempt <= ICSP_GANG_FAST_DATA_RETRIES));
+
+    self_p->alive &= ~pending;
+
+    return (0);
+}
+
+int icsp_gang_init(struct icsp_gang_driver_t *self_p,
+                   struct pin_device_t **mclrn_pp,
+                   int number_of_targets)
+{
+    if ((number_of_targets < 1)
+        || (number_of_targets > ICSP_GANG_TARGETS_MAX)) {
+        return (-EINVAL);
+    }
+
+    self_p->mclrn_pp = mclrn_pp;
+    self_p->number_of_targets = number_of_targets;
+    self_p->targets = 0;
+    self_p->alive = 0;
+
+    return (0);
+}
+
+int icsp_gang_start(struct icsp_gang_driver_t *self_p, uint32_t targets)
+{
+    int i;
+
+    if ((targets == 0)
+        || ((targets >> self_p->number_of_targets) != 0)) {
+        return (-EINVAL);
+    }
+
+    self_p->targets = targets;
+    self_p->alive = targets;
+
+    for (i = 0; i < self_p->number_of_targets; i++) {
+        if (targets & BIT(i)) {
+            pin_init(&self_p->mclrn[i], self_p->mclrn_pp[i], PIN_OUTPUT);
+            pin_write(&self_p->mclrn[i], 0);
+        }
+    }
+
+    time_busy_wait_us(100);
+
+    gang_start();
+
+    /* The key is clocked in as is, not as 4-phase cycles. */
+    for (i = 31; i >= 0; i--) {
+        gang_clock(((KEY >> i) & 1) ? targets : 0);
+    }
+
+    time_busy_wait_us(1);
+
+    for (i = 0; i < self_p->number_of_targets; i++) {
+        if (targets & BIT(i)) {
+            pin_write(&self_p->mclrn[i], 1);
+        }
+    }
+
+    time_busy_wait_us(500);
+
+    shift_tms(targets, TMS_RESET, TMS_RESET_SIZE);
+
+    return (0);
+}
+
+int icsp_gang_stop(struct icsp_gang_driver_t *self_p)
+{
+    int i;
+
+    gang_stop();
+
+    for (i = 0; i < self_p->number_of_targets; i++) {
+        if (self_p->targets & BIT(i)) {
+            pin_set_mode(&self_p->mclrn[i], PIN_INPUT);
+        }
+    }
+
+    self_p->targets = 0;
+
+    return (0);
+}
+
+uint32_t icsp_gang_get_alive(struct icsp_gang_driver_t *self_p)
+{
+    return (self_p->alive);
+}
+
+int icsp_gang_instruction_write(struct icsp_gang_driver_t *self_p,
+                                const uint8_t *buf_p,
+                                size_t number_of_bits)
+{
+    uint32_t samples[ICSP_GANG_TARGETS_MAX];
+
+    if (number_of_bits == 0) {
+        return (-EINVAL);
+    }
+
+    if (self_p->alive == 0) {
+        return (-ENODEV);
+    }
+
+    shift_tms(self_p->alive, TMS_SELECT_IR_SCAN, TMS_SELECT_IR_SCAN_SIZE);
+    shift_bits(self_p->alive, &samples[0], buf_p, number_of_bits);
+    shift_tms(self_p->alive, TMS_EXIT, TMS_EXIT_SIZE);
+
+    return (0);
+}
+
+int icsp_gang_data_write(struct icsp_gang_driver_t *self_p,
+                         const uint8_t *buf_p,
+                         size_t number_of_bits)
+{
+    return (shift_data(self_p, NULL, buf_p, number_of_bits));
+}
+
+int icsp_gang_data_transfer(struct icsp_gang_driver_t *self_p,
+                            uint8_t *rxbuf_p,
+                            const uint8_t *txbuf_p,
+                            size_t number_of_bits)
+{
+    return (shift_data(self_p, rxbuf_p, txbuf_p, number_of_bits));
+}
+
+int icsp_gang_data_poll(struct icsp_gang_driver_t *self_p,
+                        uint8_t *rxbuf_p,
+                        const uint8_t *txbuf_p,
+                        const uint8_t *mask_p,
+                        const uint8_t *value_p,
+                        size_t number_of_bits,
+                        struct time_t *end_time_p)
+{
+    uint32_t samples[ICSP_GANG_TARGETS_MAX];
+    uint32_t done[ICSP_GANG_TARGETS_MAX];
+    uint32_t pending;
+    uint32_t mask;
+    uint32_t value;
+    struct time_t time;
+    int i;
+
+    if ((number_of_bits == 0) || (number_of_bits > 32)) {
+        return (-EINVAL);
+    }
+
+    if (self_p->alive == 0) {
+        return (-ENODEV);
+    }
+
+    mask = bytes_to_sample(mask_p, number_of_bits);
+    value = bytes_to_sample(value_p, number_of_bits);
+    pending = self_p->alive;
+
+    while (1) {
+        shift_tms(pending, TMS_SELECT_DR_SCAN, TMS_SELECT_DR_SCAN_SIZE);
+        shift_bits(pending, &samples[0], txbuf_p, number_of_bits);
+        shift_tms(pending, TMS_EXIT, TMS_EXIT_SIZE);
+
+        for (i = 0; i < ICSP_GANG_TARGETS_MAX; i++) {
+            if ((pending & BIT(i)) && ((samples[i] & mask) == value)) {
+                done[i] = samples[i];
+                pending &= ~BIT(i);
+            }
+        }
+
+        if (pending == 0) {
+            break;
+        }
+
+        time_get(&time);
+
+        if (time_compare_greater_than_t == time_compare(&time, end_time_p)) {
+            break;
+        }
+    }
+
+    self_p->alive &= ~pending;
+
+    if (self_p->alive == 0) {
+        return (-ETIMEDOUT);
+    }
+
+    sample_to_bytes(rxbuf_p, vote(self_p, &done[0]), number_of_bits);
+
+    return (0);
+}
+
+int icsp_gang_fast_data_write(struct icsp_gang_driver_t *self_p,
+                              uint32_t data)
+{
+    uint32_t samples[ICSP_GANG_TARGETS_MAX];
+
+    return (transfer_fast_data(self_p, &samples[0], data));
+}
+
+int icsp_gang_fast_data_read(struct icsp_gang_driver_t *self_p,
+                             uint32_t *data_p)
+{
+    uint32_t samples[ICSP_GANG_TARGETS_MAX];
+    int res;
+
+    res = transfer_fast_data(self_p, &samples[0], 0);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    *data_p = vote(self_p, &samples[0]);
+
+    return (0);
+}
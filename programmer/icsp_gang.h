@@ -0,0 +1,156 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#ifndef __ICSP_GANG_H__
+#define __ICSP_GANG_H__
+
+#include "simba.h"
+
+/* Maximum number of targets programmed at once. */
+#define ICSP_GANG_TARGETS_MAX                               8
+
+/* Number of times a fast data word is retried on targets lagging
+   behind the first target that transferred it. */
+#define ICSP_GANG_FAST_DATA_RETRIES                         8
+
+/**
+ * A 2-wire ICSP driver programming several targets at once. PGEC on
+ * D2 is shared by all targets, while each target has its own PGED
+ * and MCLRN. Target n has PGED on D(26 + 2n) and MCLRN on
+ * D(27 + 2n).
+ *
+ * The same bits are clocked into all alive targets, and TDO of each
+ * target is sampled separately. Sampled data is voted on, and
+ * targets disagreeing with the majority are dropped. A dropped
+ * target is kept in Run-Test/Idle by holding its TMS low.
+ */
+struct icsp_gang_driver_t {
+    struct pin_device_t **mclrn_pp;
+    struct pin_driver_t mclrn[ICSP_GANG_TARGETS_MAX];
+    int number_of_targets;
+    uint32_t targets;
+    uint32_t alive;
+};
+
+/**
+ * Initialize given driver object with given MCLRN pin device of each
+ * target.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_gang_init(struct icsp_gang_driver_t *self_p,
+                   struct pin_device_t **mclrn_pp,
+                   int number_of_targets);
+
+/**
+ * Enter ICSP mode in given targets, bit n for target n, and reset
+ * their TAP controllers.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_gang_start(struct icsp_gang_driver_t *self_p, uint32_t targets);
+
+/**
+ * Release PGEC, and PGED and MCLRN of all targets.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_gang_stop(struct icsp_gang_driver_t *self_p);
+
+/**
+ * Get the targets started and not dropped, bit n for target n. Kept
+ * after stopped.
+ *
+ * @return Alive targets.
+ */
+uint32_t icsp_gang_get_alive(struct icsp_gang_driver_t *self_p);
+
+/**
+ * Shift given instruction into the instruction register.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_gang_instruction_write(struct icsp_gang_driver_t *self_p,
+                                const uint8_t *buf_p,
+                                size_t number_of_bits);
+
+/**
+ * Shift given data into the data register.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_gang_data_write(struct icsp_gang_driver_t *self_p,
+                         const uint8_t *buf_p,
+                         size_t number_of_bits);
+
+/**
+ * Shift given data into the data register while shifting out its
+ * previous value, at most 32 bits. The majority value is returned.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_gang_data_transfer(struct icsp_gang_driver_t *self_p,
+                            uint8_t *rxbuf_p,
+                            const uint8_t *txbuf_p,
+                            size_t number_of_bits);
+
+/**
+ * Repeat given data transfer in each target until the shifted out
+ * bits selected by given mask equals given value. Targets not done
+ * by given end time are dropped. The majority value is returned.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_gang_data_poll(struct icsp_gang_driver_t *self_p,
+                        uint8_t *rxbuf_p,
+                        const uint8_t *txbuf_p,
+                        const uint8_t *mask_p,
+                        const uint8_t *value_p,
+                        size_t number_of_bits,
+                        struct time_t *end_time_p);
+
+/**
+ * Write given word to the fast data register. Fails with -EPROTO if
+ * no target accepted the word. Targets not accepting it within a few
+ * retries after the first target are dropped.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_gang_fast_data_write(struct icsp_gang_driver_t *self_p,
+                              uint32_t data);
+
+/**
+ * Read a word from the fast data register. See
+ * icsp_gang_fast_data_write(). The majority value is returned.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_gang_fast_data_read(struct icsp_gang_driver_t *self_p,
+                             uint32_t *data_p);
+
+#endif
@@ -0,0 +1,484 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#include "simba.h"
+#include "icsp_spi.h"
+#include "compat.h"
+
+/* TMS sequences, shifted out most significant bit first. */
+#define TMS_RESET                                        0x3e
+#define TMS_RESET_SIZE                                      6
+#define TMS_SELECT_IR_SCAN                                0xc
+#define TMS_SELECT_IR_SCAN_SIZE                             4
+#define TMS_SELECT_DR_SCAN                                0x4
+#define TMS_SELECT_DR_SCAN_SIZE                             3
+#define TMS_EXIT                                          0x2
+#define TMS_EXIT_SIZE                                       2
+
+/* Nibble phases. TDI is output in the first, TMS in the second and
+   TDO is input in the fourth. */
+#define NIBBLE_TDI                                     BIT(3)
+#define NIBBLE_TMS                                     BIT(2)
+#define NIBBLE_TDO                                     BIT(0)
+
+static void append_cycle(struct icsp_spi_driver_t *self_p,
+                         int tms,
+                         int tdi)
+{
+    uint8_t nibble;
+    size_t index;
+
+    nibble = 0;
+
+    if (tms) {
+        nibble |= NIBBLE_TMS;
+    }
+
+    if (tdi) {
+        nibble |= NIBBLE_TDI;
+    }
+
+    index = (self_p->number_of_cycles / 2);
+
+    if ((self_p->number_of_cycles % 2) == 0) {
+        self_p->txbuf[index] = (nibble << 4);
+    } else {
+        self_p->txbuf[index] |= nibble;
+    }
+
+    self_p->number_of_cycles++;
+}
+
+static void append_tms(struct icsp_spi_driver_t *self_p,
+                       uint8_t tms,
+                       size_t size)
+{
+    while (size > 0) {
+        size--;
+        append_cycle(self_p, (tms >> size) & 1, 0);
+    }
+}
+
+/**
+ * Append given bits, most significant bit of each byte first, with
+ * TMS set on the last bit to leave the shift state.
+ */
+static void append_bits(struct icsp_spi_driver_t *self_p,
+                        const uint8_t *buf_p,
+                        size_t number_of_bits)
+{
+    size_t i;
+    int tdi;
+
+    for (i = 0; i < number_of_bits; i++) {
+        tdi = 0;
+
+        if (buf_p != NULL) {
+            tdi = ((buf_p[i / 8] >> (7 - (i % 8))) & 1);
+        }
+
+        append_cycle(self_p, i == (number_of_bits - 1), tdi);
+    }
+}
+
+static int tdo(struct icsp_spi_driver_t *self_p, size_t cycle)
+{
+    uint8_t nibble;
+
+    nibble = self_p->rxbuf[cycle / 2];
+
+    if ((cycle % 2) == 0) {
+        nibble >>= 4;
+    }
+
+    return ((nibble & NIBBLE_TDO) != 0);
+}
+
+static void extract_bits(struct icsp_spi_driver_t *self_p,
+                         size_t cycle,
+                         uint8_t *buf_p,
+                         size_t number_of_bits)
+{
+    size_t i;
+
+    memset(buf_p, 0, DIV_CEIL(number_of_bits, 8));
+
+    for (i = 0; i < number_of_bits; i++) {
+        buf_p[i / 8] |= (tdo(self_p, cycle + i) << (7 - (i % 8)));
+    }
+}
+
+/**
+ * Pad to a whole byte with an idle cycle and let the PDC shift the
+ * buffer.
+ */
+static void transfer(struct icsp_spi_driver_t *self_p)
+{
+    if ((self_p->number_of_cycles % 2) == 1) {
+        append_cycle(self_p, 0, 0);
+    }
+
+    usart_spi_transfer(&self_p->rxbuf[0],
+                       &self_p->txbuf[0],
+                       self_p->number_of_cycles / 2);
+}
+
+static int shift_data(struct icsp_spi_driver_t *self_p,
+                      uint8_t *rxbuf_p,
+                      const uint8_t *txbuf_p,
+                      size_t number_of_bits)
+{
+    size_t cycle;
+
+    if ((number_of_bits == 0)
+        || (number_of_bits > (ICSP_SPI_CYCLES_MAX
+                              - TMS_SELECT_DR_SCAN_SIZE
+                              - TMS_EXIT_SIZE
+                              - 1))) {
+        return (-EINVAL);
+    }
+
+    self_p->number_of_cycles = 0;
+    append_tms(self_p, TMS_SELECT_DR_SCAN, TMS_SELECT_DR_SCAN_SIZE);
+    cycle = self_p->number_of_cycles;
+    append_bits(self_p, txbuf_p, number_of_bits);
+    append_tms(self_p, TMS_EXIT, TMS_EXIT_SIZE);
+    transfer(self_p);
+
+    if (rxbuf_p != NULL) {
+        extract_bits(self_p, cycle, rxbuf_p, number_of_bits);
+    }
+
+    return (0);
+}
+
+/**
+ * Append a 32 bits word, least significant bit first, preceded by the
+ * processor access (PrAcc) bit.
+ *
+ * @return Cycle of the PrAcc bit. The word follows it.
+ */
+static size_t append_fast_data(struct icsp_spi_driver_t *self_p,
+                               uint32_t txdata)
+{
+    size_t cycle;
+    size_t i;
+
+    append_tms(self_p, TMS_SELECT_DR_SCAN, TMS_SELECT_DR_SCAN_SIZE);
+    cycle = self_p->number_of_cycles;
+    append_cycle(self_p, 0, 0);
+
+    for (i = 0; i < 32; i++) {
+        append_cycle(self_p, i == 31, (txdata >> i) & 1);
+    }
+
+    append_tms(self_p, TMS_EXIT, TMS_EXIT_SIZE);
+
+    return (cycle);
+}
+
+static uint32_t extract_fast_data(struct icsp_spi_driver_t *self_p,
+                                  size_t cycle)
+{
+    size_t i;
+    uint32_t rxdata;
+
+    rxdata = 0;
+
+    for (i = 0; i < 32; i++) {
+        rxdata |= ((uint32_t)tdo(self_p, cycle + 1 + i) << i);
+    }
+
+    return (rxdata);
+}
+
+/**
+ * Shift a 32 bits word. Fails if the core did not accept or provide
+ * the word.
+ */
+static int shift_fast_data(struct icsp_spi_driver_t *self_p,
+                           uint32_t *rxdata_p,
+                           uint32_t txdata)
+{
+    size_t cycle;
+
+    self_p->number_of_cycles = 0;
+    cycle = append_fast_data(self_p, txdata);
+    transfer(self_p);
+
+    if (!tdo(self_p, cycle)) {
+        return (-EPROTO);
+    }
+
+    if (rxdata_p != NULL) {
+        *rxdata_p = extract_fast_data(self_p, cycle);
+    }
+
+    return (0);
+}
+
+/**
+ * Shift given words back-to-back, ICSP_SPI_FAST_DATA_BURST_MAX words
+ * per transfer, and check PrAcc of each word after the transfer. The
+ * core accepts words in order, so the burst is stopped at the first
+ * transfer with a rejected word.
+ *
+ * @return Number of accepted words, or negative error code if a word
+ *         was accepted after a rejected word.
+ */
+static ssize_t shift_fast_data_burst(struct icsp_spi_driver_t *self_p,
+                                     uint32_t *rxbuf_p,
+                                     const uint32_t *txbuf_p,
+                                     size_t number_of_words)
+{
+    size_t cycles[ICSP_SPI_FAST_DATA_BURST_MAX];
+    size_t offset;
+    size_t size;
+    size_t i;
+    ssize_t number_of_accepted_words;
+
+    number_of_accepted_words = -1;
+
+    for (offset = 0; offset < number_of_words; offset += size) {
+        size = MIN(number_of_words - offset, ICSP_SPI_FAST_DATA_BURST_MAX);
+        self_p->number_of_cycles = 0;
+
+        for (i = 0; i < size; i++) {
+            cycles[i] = append_fast_data(self_p,
+                                         (txbuf_p != NULL
+                                          ? txbuf_p[offset + i]
+                                          : 0));
+        }
+
+        transfer(self_p);
+
+        for (i = 0; i < size; i++) {
+            if (tdo(self_p, cycles[i])) {
+                if (number_of_accepted_words != -1) {
+                    return (-EPROTO);
+                }
+
+                if (rxbuf_p != NULL) {
+                    rxbuf_p[offset + i] = extract_fast_data(self_p,
+                                                            cycles[i]);
+                }
+            } else if (number_of_accepted_words == -1) {
+                number_of_accepted_words = (offset + i);
+            }
+        }
+
+        if (number_of_accepted_words != -1) {
+            return (number_of_accepted_words);
+        }
+    }
+
+    return (number_of_words);
+}
+
+int icsp_spi_init(struct icsp_spi_driver_t *self_p,
+                  struct pin_device_t *mclrn_p)
+{
+    self_p->mclrn_p = mclrn_p;
+    self_p->clock_divider = ICSP_SPI_CLOCK_DIVIDER_DEFAULT;
+    self_p->is_started = 0;
+    self_p->number_of_cycles = 0;
+
+    return (0);
+}
+
+int icsp_spi_start(struct icsp_spi_driver_t *self_p)
+{
+    static const uint8_t key[4] = { 'M', 'C', 'H', 'P' };
+
+    pin_init(&self_p->mclrn, self_p->mclrn_p, PIN_OUTPUT);
+    pin_write(&self_p->mclrn, 0);
+    time_busy_wait_us(100);
+
+    usart_spi_start(self_p->clock_divider);
+    self_p->is_started = 1;
+
+    /* The key is clocked in as is, not as 4-phase cycles. */
+    usart_spi_transfer(&self_p->rxbuf[0], &key[0], sizeof(key));
+    time_busy_wait_us(1);
+    pin_write(&self_p->mclrn, 1);
+    time_busy_wait_us(500);
+
+    return (icsp_spi_reset(self_p));
+}
+
+int icsp_spi_attach(struct icsp_spi_driver_t *self_p)
+{
+    /* Set the output level before driving MCLRN, as a short low pulse
+       resets the PIC. */
+    pin_init(&self_p->mclrn, self_p->mclrn_p, PIN_INPUT);
+    pin_write(&self_p->mclrn, 1);
+    pin_set_mode(&self_p->mclrn, PIN_OUTPUT);
+
+    usart_spi_start(self_p->clock_divider);
+    self_p->is_started = 1;
+
+    return (icsp_spi_reset(self_p));
+}
+
+int icsp_spi_stop(struct icsp_spi_driver_t *self_p)
+{
+    usart_spi_stop();
+    self_p->is_started = 0;
+    pin_set_mode(&self_p->mclrn, PIN_INPUT);
+
+    return (0);
+}
+
+int icsp_spi_reset(struct icsp_spi_driver_t *self_p)
+{
+    self_p->number_of_cycles = 0;
+    append_tms(self_p, TMS_RESET, TMS_RESET_SIZE);
+    transfer(self_p);
+
+    return (0);
+}
+
+int icsp_spi_set_clock_divider(struct icsp_spi_driver_t *self_p,
+                               int clock_divider)
+{
+    if ((clock_divider < ICSP_SPI_CLOCK_DIVIDER_MIN)
+        || (clock_divider > ICSP_SPI_CLOCK_DIVIDER_MAX)) {
+        return (-EINVAL);
+    }
+
+    self_p->clock_divider = clock_divider;
+
+    if (self_p->is_started) {
+        usart_spi_set_clock_divider(clock_divider);
+    }
+
+    return (0);
+}
+
+int icsp_spi_get_clock_frequency(struct icsp_spi_driver_t *self_p)
+{
+    return (ICSP_SPI_MCK_FREQUENCY / self_p->clock_divider);
+}
+
+int icsp_spi_instruction_write(struct icsp_spi_driver_t *self_p,
+                               const uint8_t *buf_p,
+                               size_t number_of_bits)
+{
+    if ((number_of_bits == 0) || (number_of_bits > 8)) {
+        return (-EINVAL);
+    }
+
+    self_p->number_of_cycles = 0;
+    append_tms(self_p, TMS_SELECT_IR_SCAN, TMS_SELECT_IR_SCAN_SIZE);
+    append_bits(self_p, buf_p, number_of_bits);
+    append_tms(self_p, TMS_EXIT, TMS_EXIT_SIZE);
+    transfer(self_p);
+
+    return (0);
+}
+
+int icsp_spi_data_write(struct icsp_spi_driver_t *self_p,
+                        const uint8_t *buf_p,
+                        size_t number_of_bits)
+{
+    return (shift_data(self_p, NULL, buf_p, number_of_bits));
+}
+
+int icsp_spi_data_read(struct icsp_spi_driver_t *self_p,
+                       uint8_t *buf_p,
+                       size_t number_of_bits)
+{
+    return (shift_data(self_p, buf_p, NULL, number_of_bits));
+}
+
+int icsp_spi_data_transfer(struct icsp_spi_driver_t *self_p,
+                           uint8_t *rxbuf_p,
+                           const uint8_t *txbuf_p,
+                           size_t number_of_bits)
+{
+    return (shift_data(self_p, rxbuf_p, txbuf_p, number_of_bits));
+}
+
+int icsp_spi_fast_data_write(struct icsp_spi_driver_t *self_p,
+                             uint32_t data)
+{
+    return (shift_fast_data(self_p, NULL, data));
+}
+
+int icsp_spi_fast_data_read(struct icsp_spi_driver_t *self_p,
+                            uint32_t *data_p)
+{
+    return (shift_fast_data(self_p, data_p, 0));
+}
+
+ssize_t icsp_spi_fast_data_write_burst(struct icsp_spi_driver_t *self_p,
+                                       const uint32_t *buf_p,
+                                       size_t number_of_words)
+{
+    return (shift_fast_data_burst(self_p, NULL, buf_p, number_of_words));
+}
+
+ssize_t icsp_spi_fast_data_read_burst(struct icsp_spi_driver_t *self_p,
+                                      uint32_t *buf_p,
+                                      size_t number_of_words)
+{
+    return (shift_fast_data_burst(self_p, buf_p, NULL, number_of_words));
+}
+
+int icsp_spi_replay(struct icsp_spi_driver_t *self_p,
+                    const struct icsp_spi_sequence_t *sequence_p,
+                    uint8_t *samples_p)
+{
+    size_t offset;
+    size_t size;
+    size_t sample;
+    size_t cycle;
+
+    if (sequence_p->number_of_samples > 0) {
+        memset(samples_p, 0, DIV_CEIL(sequence_p->number_of_samples, 8));
+    }
+
+    sample = 0;
+
+    for (offset = 0; offset < sequence_p->size; offset += size) {
+        size = MIN(sequence_p->size - offset, sizeof(self_p->rxbuf));
+        usart_spi_transfer(&self_p->rxbuf[0],
+                           &sequence_p->buf_p[offset],
+                           size);
+
+        while ((sample < sequence_p->number_of_samples)
+               && (sequence_p->samples_p[sample] < 2 * (offset + size))) {
+            cycle = (sequence_p->samples_p[sample] - 2 * offset);
+            samples_p[sample / 8] |= (tdo(self_p, cycle)
+                                      << (7 - (sample % 8)));
+            sample++;
+        }
+    }
+
+    return (0);
+}
@@ -0,0 +1,220 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#ifndef __ICSP_SPI_H__
+#define __ICSP_SPI_H__
+
+#include "simba.h"
+
+/* USART1 is clocked by the 84 MHz master clock. */
+#define ICSP_SPI_MCK_FREQUENCY                       84000000
+
+/* 84 MHz / 12 = 7 MHz PGEC. The USART does not support dividers
+   below 6 in SPI master mode. */
+#define ICSP_SPI_CLOCK_DIVIDER_DEFAULT                     12
+#define ICSP_SPI_CLOCK_DIVIDER_MIN                          6
+#define ICSP_SPI_CLOCK_DIVIDER_MAX                      65535
+
+/* Maximum number of fast data words in one transfer. Each word is 38
+   cycles. */
+#define ICSP_SPI_FAST_DATA_BURST_MAX                       16
+
+/* Maximum number of ICSP clock cycles in one transfer. Each cycle is
+   four PGEC clocks, or one nibble on the SPI bus. */
+#define ICSP_SPI_CYCLES_MAX       (38 * ICSP_SPI_FAST_DATA_BURST_MAX)
+
+/**
+ * A precompiled cycle sequence, two cycles per byte in the same
+ * encoding as the driver uses. TDO is sampled only on given cycles,
+ * which must be in increasing order.
+ */
+struct icsp_spi_sequence_t {
+    const uint8_t *buf_p;
+    size_t size;
+    const uint16_t *samples_p;
+    size_t number_of_samples;
+};
+
+/**
+ * An ICSP driver shifting the 4-phase 2-wire bitstream with the
+ * USART1 SPI master and its PDC. PGEC is SCK1 (A0), PGED is driven by
+ * TXD1 (D16) through a series resistor and sampled by RXD1 (D17).
+ */
+struct icsp_spi_driver_t {
+    struct pin_device_t *mclrn_p;
+    struct pin_driver_t mclrn;
+    int clock_divider;
+    int is_started;
+    size_t number_of_cycles;
+    uint8_t txbuf[ICSP_SPI_CYCLES_MAX / 2];
+    uint8_t rxbuf[ICSP_SPI_CYCLES_MAX / 2];
+};
+
+/**
+ * Initialize given driver object.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_init(struct icsp_spi_driver_t *self_p,
+                  struct pin_device_t *mclrn_p);
+
+/**
+ * Enter ICSP mode and reset the TAP controller.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_start(struct icsp_spi_driver_t *self_p);
+
+/**
+ * Attach to a PIC already in ICSP mode, for example running a ramapp
+ * left by a previous session. MCLRN is driven high without a reset
+ * pulse, and the TAP controller is reset.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_attach(struct icsp_spi_driver_t *self_p);
+
+/**
+ * Release PGEC, PGED and MCLRN.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_stop(struct icsp_spi_driver_t *self_p);
+
+/**
+ * Reset the TAP controller, for example after shifting with a too
+ * fast clock.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_reset(struct icsp_spi_driver_t *self_p);
+
+/**
+ * Set the PGEC clock divider. Takes effect immediately if started,
+ * otherwise when started.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_set_clock_divider(struct icsp_spi_driver_t *self_p,
+                               int clock_divider);
+
+/**
+ * Get the PGEC frequency in Hz.
+ *
+ * @return PGEC frequency.
+ */
+int icsp_spi_get_clock_frequency(struct icsp_spi_driver_t *self_p);
+
+/**
+ * Shift given instruction into the instruction register.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_instruction_write(struct icsp_spi_driver_t *self_p,
+                               const uint8_t *buf_p,
+                               size_t number_of_bits);
+
+/**
+ * Shift given data into the data register.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_data_write(struct icsp_spi_driver_t *self_p,
+                        const uint8_t *buf_p,
+                        size_t number_of_bits);
+
+/**
+ * Shift out the data register.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_data_read(struct icsp_spi_driver_t *self_p,
+                       uint8_t *buf_p,
+                       size_t number_of_bits);
+
+/**
+ * Shift given data into the data register while shifting out its
+ * previous value.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_data_transfer(struct icsp_spi_driver_t *self_p,
+                           uint8_t *rxbuf_p,
+                           const uint8_t *txbuf_p,
+                           size_t number_of_bits);
+
+/**
+ * Write given word to the fast data register.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_fast_data_write(struct icsp_spi_driver_t *self_p,
+                             uint32_t data);
+
+/**
+ * Read a word from the fast data register.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_fast_data_read(struct icsp_spi_driver_t *self_p,
+                            uint32_t *data_p);
+
+/**
+ * Write given words to the fast data register back-to-back, and check
+ * that the core accepted them after each transfer instead of after
+ * each word. Words after the first rejected word are not accepted
+ * either, and may be retried one by one.
+ *
+ * @return Number of accepted words or negative error code.
+ */
+ssize_t icsp_spi_fast_data_write_burst(struct icsp_spi_driver_t *self_p,
+                                       const uint32_t *buf_p,
+                                       size_t number_of_words);
+
+/**
+ * Read words from the fast data register back-to-back. See
+ * icsp_spi_fast_data_write_burst().
+ *
+ * @return Number of read words or negative error code.
+ */
+ssize_t icsp_spi_fast_data_read_burst(struct icsp_spi_driver_t *self_p,
+                                      uint32_t *buf_p,
+                                      size_t number_of_words);
+
+/**
+ * Shift given precompiled sequence as is. Sampled TDO bits are stored
+ * most significant bit of each byte first in given buffer, which must
+ * fit all samples.
+ *
+ * @return zero(0) or negative error code.
+ */
+int icsp_spi_replay(struct icsp_spi_driver_t *self_p,
+                    const struct icsp_spi_sequence_t *sequence_p,
+                    uint8_t *samples_p);
+
+#endif
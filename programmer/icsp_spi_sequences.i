@@ -0,0 +1,706 @@
+/**
+ * This file was generated by pictools.py version 0.17.0.
+ *
+ * Precompiled ICSP cycles for the USART SPI transport, one nibble per
+ * cycle. TDO is only sampled on the listed cycles.
+ */
+
+/* MTAP_SW_MTAP, MTAP_COMMAND and MCHP_STATUS. Samples the status. */
+static const uint8_t read_status_cycles[] = {
+    0x44, 0x00, 0x00, 0x80, 0x44, 0x00, 0x44, 0x00, 0x88, 0x80, 0x44, 0x00,
+    0x40, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00
+};
+
+static const uint16_t read_status_samples[] = {
+    27, 28, 29, 30, 31, 32, 33, 34
+};
+
+static const struct icsp_spi_sequence_t read_status_sequence = {
+    .buf_p = &read_status_cycles[0],
+    .size = sizeof(read_status_cycles),
+    .samples_p = &read_status_samples[0],
+    .number_of_samples = membersof(read_status_samples)
+};
+
+/* MCHP_ASSERT_RST, MTAP_SW_ETAP, ETAP_EJTAGBOOT, MTAP_SW_MTAP,
+   MTAP_COMMAND, MCHP_DE_ASSERT_RST and MTAP_SW_ETAP. */
+static const uint8_t enter_serial_execution_mode_cycles[] = {
+    0x40, 0x08, 0x00, 0x08, 0x08, 0xc4, 0x00, 0x44, 0x00, 0x80, 0x80, 0x44,
+    0x00, 0x44, 0x00, 0x00, 0x88, 0x44, 0x00, 0x44, 0x00, 0x00, 0x80, 0x44,
+    0x00, 0x44, 0x00, 0x88, 0x80, 0x44, 0x00, 0x40, 0x00, 0x00, 0x08, 0x08,
+    0xc4, 0x00, 0x44, 0x00, 0x80, 0x80, 0x44, 0x00
+};
+
+static const struct icsp_spi_sequence_t enter_serial_execution_mode_sequence = {
+    .buf_p = &enter_serial_execution_mode_cycles[0],
+    .size = sizeof(enter_serial_execution_mode_cycles),
+    .samples_p = NULL,
+    .number_of_samples = 0
+};
+
+/* MTAP_SW_MTAP, MTAP_COMMAND, MCHP_ERASE and MCHP_DE_ASSERT_RST. */
+static const uint8_t chip_erase_cycles[] = {
+    0x44, 0x00, 0x00, 0x80, 0x44, 0x00, 0x44, 0x00, 0x88, 0x80, 0x44, 0x00,
+    0x40, 0x00, 0x08, 0x88, 0x88, 0xc4, 0x00, 0x40, 0x00, 0x00, 0x08, 0x08,
+    0xc4, 0x00
+};
+
+static const struct icsp_spi_sequence_t chip_erase_sequence = {
+    .buf_p = &chip_erase_cycles[0],
+    .size = sizeof(chip_erase_cycles),
+    .samples_p = NULL,
+    .number_of_samples = 0
+};
+
+/* ETAP_CONTROL, PrAcc poll, ETAP_DATA, instruction, ETAP_CONTROL and
+   PrAcc clear for each loader upload instruction, followed by the
+   jump delay slot nop. Samples PrAcc in the poll. */
+static const uint8_t upload_loader_cycles[][75] = {
+    { /* lui a1, 0xa000 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x08, 0x00, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori a0, a1, 0x7f00 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x08, 0x00, 0x00,
+        0x80, 0x00, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x08, 0x88, 0x88, 0x88,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui a2, 0xff20 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x88, 0x00, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x80, 0x08, 0x88, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s0, a2, 0x41a4 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x88, 0x00, 0x00,
+        0x00, 0x80, 0x08, 0x08, 0x00, 0x08, 0x00, 0x80, 0x88, 0x00, 0x00, 0x08,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu s1, a1, 16805 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x08, 0x00, 0x80,
+        0x00, 0x80, 0x08, 0x80, 0x08, 0x08, 0x00, 0x80, 0x88, 0x00, 0x00, 0x08,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s2, zero, 0xfcc4 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x08,
+        0x00, 0x80, 0x08, 0x08, 0x00, 0x08, 0x00, 0x08, 0x80, 0x08, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui a3, 0x3950 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x88, 0x00, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x08, 0x08, 0x00, 0x88, 0x80,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s3, a3, 0x6 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x88, 0x00, 0x88,
+        0x00, 0x80, 0x08, 0x08, 0x00, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s4, zero, 0xfd04 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00,
+        0x80, 0x80, 0x08, 0x08, 0x00, 0x08, 0x00, 0x00, 0x08, 0x08, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s5, zero, 0xf905 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x80,
+        0x80, 0x80, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x08, 0x00, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t0, 0xffff */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x08, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s6, t0, 0x30c6 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x80, 0x08,
+        0x80, 0x80, 0x08, 0x08, 0x00, 0x88, 0x00, 0x08, 0x80, 0x00, 0x08, 0x80,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t1, 0xfff8 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x00, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s7, t1, 0xb406 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x00, 0x80, 0x88,
+        0x80, 0x80, 0x08, 0x08, 0x00, 0x88, 0x00, 0x00, 0x00, 0x08, 0x08, 0x80,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t2, 0x4 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x80, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori fp, t2, 0x30a5 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x80, 0x80, 0x08,
+        0x88, 0x80, 0x08, 0x08, 0x08, 0x08, 0x00, 0x80, 0x80, 0x00, 0x08, 0x80,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori ra, zero, 0xfd84 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x88,
+        0x88, 0x80, 0x08, 0x08, 0x00, 0x08, 0x00, 0x00, 0x88, 0x08, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* swm32 s0, s1, s2, s3, s4, s5, s6, s7, fp, ra, 0x0(a0) */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x08, 0x00, 0x80,
+        0x08, 0x80, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu s0, a1, 16805 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x08, 0x00, 0x00,
+        0x00, 0x80, 0x08, 0x80, 0x08, 0x08, 0x00, 0x80, 0x88, 0x00, 0x00, 0x08,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu s1, t0, 12352 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x80, 0x80,
+        0x00, 0x80, 0x08, 0x80, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x80,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t3, 0xedb8 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x80, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x88, 0x80, 0x88, 0x08, 0x80, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s2, t3, 0x41ab */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x80, 0x80, 0x08,
+        0x00, 0x80, 0x08, 0x08, 0x08, 0x80, 0x80, 0x80, 0x88, 0x00, 0x00, 0x08,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t4, 0x8320 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x08, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x80, 0x08, 0x80, 0x00, 0x00,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s3, t4, 0x516b */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x08, 0x80, 0x88,
+        0x00, 0x80, 0x08, 0x08, 0x08, 0x80, 0x80, 0x88, 0x08, 0x00, 0x08, 0x08,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s4, zero, 0xfd05 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00,
+        0x80, 0x80, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x08, 0x08, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t5, 0x1310 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x08, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x08, 0x80, 0x08, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s5, t5, 0x102 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x08, 0x80, 0x80,
+        0x80, 0x80, 0x08, 0x08, 0x00, 0x80, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t6, 0x20 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x88, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s6, t6, 0x3120 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x88, 0x80, 0x08,
+        0x80, 0x80, 0x08, 0x08, 0x00, 0x00, 0x00, 0x80, 0x08, 0x00, 0x08, 0x80,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t7, 0x1 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x88, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s7, t7, 0xd142 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x88, 0x80, 0x88,
+        0x80, 0x80, 0x08, 0x08, 0x00, 0x80, 0x00, 0x08, 0x08, 0x00, 0x08, 0x08,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui a1, 0x51d0 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x08, 0x00, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x08, 0x88, 0x00, 0x08, 0x08,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori fp, a1, 0x140 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x08, 0x00, 0x08,
+        0x88, 0x80, 0x08, 0x08, 0x00, 0x00, 0x00, 0x08, 0x08, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui a2, 0x5250 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x88, 0x00, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x08, 0x00, 0x80, 0x08, 0x08,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori ra, a2, 0x16a */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x88, 0x00, 0x88,
+        0x88, 0x80, 0x08, 0x08, 0x00, 0x80, 0x80, 0x88, 0x08, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* swm32 s0, s1, s2, s3, s4, s5, s6, s7, fp, ra, 0x28(a0) */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x08, 0x00, 0x80,
+        0x08, 0x80, 0x00, 0x80, 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x08, 0x08,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui a3, 0x840 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x88, 0x00, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x80, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s0, a3, 0x42 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x88, 0x00, 0x00,
+        0x00, 0x80, 0x08, 0x08, 0x00, 0x80, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu s1, t0, 12585 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x80, 0x80,
+        0x00, 0x80, 0x08, 0x80, 0x08, 0x00, 0x80, 0x80, 0x08, 0x00, 0x08, 0x80,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t0, 0xfff4 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x08, 0x08, 0x88, 0x88, 0x88, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s2, t0, 0xb409 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x80, 0x08,
+        0x00, 0x80, 0x08, 0x08, 0x08, 0x00, 0x80, 0x00, 0x00, 0x08, 0x08, 0x80,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu s3, s5, 64 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x08, 0x08, 0x88,
+        0x00, 0x80, 0x08, 0x80, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu s4, s1, -66 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x00, 0x08, 0x00,
+        0x80, 0x80, 0x08, 0x80, 0x00, 0x88, 0x88, 0x80, 0x88, 0x88, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t1, 0xffe8 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x00, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x80, 0x88, 0x88, 0x88, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s5, t1, 0xb407 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x00, 0x80, 0x80,
+        0x80, 0x80, 0x08, 0x08, 0x08, 0x88, 0x00, 0x00, 0x00, 0x08, 0x08, 0x80,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu s6, t2, 12453 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x80, 0x80, 0x08,
+        0x80, 0x80, 0x08, 0x80, 0x08, 0x08, 0x00, 0x80, 0x80, 0x00, 0x08, 0x80,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu s7, s1, -9 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x00, 0x08, 0x88,
+        0x80, 0x80, 0x08, 0x80, 0x08, 0x88, 0x08, 0x88, 0x88, 0x88, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu fp, s3, -32 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x80, 0x08, 0x08,
+        0x88, 0x80, 0x08, 0x80, 0x00, 0x00, 0x00, 0x88, 0x88, 0x88, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t2, 0x4310 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x80, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x08, 0x80, 0x00, 0x08,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori ra, t2, 0x182 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x80, 0x80, 0x88,
+        0x88, 0x80, 0x08, 0x08, 0x00, 0x80, 0x00, 0x00, 0x88, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* swm32 s0, s1, s2, s3, s4, s5, s6, s7, fp, ra, 0x50(a0) */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x08, 0x00, 0x80,
+        0x08, 0x80, 0x00, 0x80, 0x00, 0x00, 0x08, 0x08, 0x00, 0x00, 0x08, 0x08,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s0, zero, 0xf904 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x80, 0x08, 0x08, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x88, 0x88,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu s1, s4, -31967 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x08, 0x08, 0x80,
+        0x00, 0x80, 0x08, 0x80, 0x08, 0x00, 0x00, 0x80, 0x08, 0x80, 0x00, 0x00,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s2, zero, 0x0 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x08,
+        0x00, 0x80, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu s3, a0, -15687 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x08, 0x00, 0x88,
+        0x00, 0x80, 0x08, 0x80, 0x08, 0x00, 0x88, 0x80, 0x80, 0x80, 0x00, 0x08,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* addiu s4, s0, 23093 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x08, 0x00,
+        0x80, 0x80, 0x08, 0x80, 0x08, 0x08, 0x08, 0x80, 0x00, 0x80, 0x88, 0x08,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t3, 0xf3c */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x80, 0x80, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x08, 0x88, 0x80, 0x08, 0x88, 0x80, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori s5, t3, 0x19 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x08, 0x08, 0x08, 0x00, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori ra, zero, 0x0 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x88,
+        0x88, 0x80, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* swm32 s0, s1, s2, s3, s4, s5, ra, 0x78(a0) */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x08, 0x00, 0x08,
+        0x80, 0x80, 0x00, 0x80, 0x00, 0x00, 0x88, 0x88, 0x00, 0x00, 0x08, 0x08,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* lui t9, 0xa000 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x00, 0x88, 0x80,
+        0x88, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+        0xc4, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* ori t9, t9, 0x7f01 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x00, 0x88, 0x80,
+        0x08, 0x80, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x08, 0x88, 0x88, 0x88,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* jr t9 */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x08, 0x00, 0x88, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x88, 0x80, 0x08, 0x88, 0x80, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    },
+    { /* nop */
+        0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x08, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+        0x00, 0x44, 0x00, 0x80, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x44, 0x00, 0x44, 0x00, 0x08, 0x08, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x44, 0x00
+    }
+};
+
+static const uint16_t upload_loader_samples[] = {
+    33
+};
+
+static const struct icsp_spi_sequence_t upload_loader_sequences[] = {
+    { &upload_loader_cycles[0][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[1][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[2][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[3][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[4][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[5][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[6][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[7][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[8][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[9][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[10][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[11][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[12][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[13][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[14][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[15][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[16][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[17][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[18][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[19][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[20][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[21][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[22][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[23][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[24][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[25][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[26][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[27][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[28][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[29][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[30][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[31][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[32][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[33][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[34][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[35][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[36][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[37][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[38][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[39][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[40][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[41][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[42][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[43][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[44][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[45][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[46][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[47][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[48][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[49][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[50][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[51][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[52][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[53][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[54][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[55][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[56][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[57][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[58][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[59][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[60][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[61][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[62][0], 75, &upload_loader_samples[0], 1 },
+    { &upload_loader_cycles[63][0], 75, &upload_loader_samples[0], 1 }
+};
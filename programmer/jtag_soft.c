@@ -0,0 +1,553 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#include "simba.h"
+#include "jtag_soft.h"
+#include "compat.h"
+
+/* TMS sequences, shifted out most significant bit first. */
+#define TMS_RESET                                        0x3e
+#define TMS_RESET_SIZE                                      6
+#define TMS_SELECT_IR_SCAN                                0xc
+#define TMS_SELECT_IR_SCAN_SIZE                             4
+#define TMS_SELECT_DR_SCAN                                0x4
+#define TMS_SELECT_DR_SCAN_SIZE                             3
+#define TMS_EXIT                                          0x2
+#define TMS_EXIT_SIZE                                       2
+
+
+static void shift_tms(uint8_t tms, size_t size)
+{
+    while (size > 0) {
+        size--;
+        jtag_clock((tms >> size) & 1, 0);
+    }
+}
+
+/**
+ * Shift given bits, most significant bit of each byte first. TMS is
+ * set on the last bit of the last segment of a scan to leave the
+ * shift state.
+ */
+static void shift_bits(uint8_t *rxbuf_p,
+                       const uint8_t *txbuf_p,
+                       size_t number_of_bits,
+                       int is_last)
+{
+    size_t i;
+    int tdi;
+    int tdo;
+
+    if (rxbuf_p != NULL) {
+        memset(rxbuf_p, 0, DIV_CEIL(number_of_bits, 8));
+    }
+
+    for (i = 0; i < number_of_bits; i++) {
+        tdi = 0;
+
+        if (txbuf_p != NULL) {
+            tdi = ((txbuf_p[i / 8] >> (7 - (i % 8))) & 1);
+        }
+
+        tdo = jtag_clock(is_last && (i == (number_of_bits - 1)), tdi);
+
+        if (rxbuf_p != NULL) {
+            rxbuf_p[i / 8] |= (tdo << (7 - (i % 8)));
+        }
+    }
+}
+
+/**
+ * Shift the BYPASS instruction, all ones, into a device.
+ */
+static void shift_bypass_instruction(size_t number_of_bits, int is_last)
+{
+    size_t i;
+
+    for (i = 0; i < number_of_bits; i++) {
+        jtag_clock(is_last && (i == (number_of_bits - 1)), 1);
+    }
+}
+
+/**
+ * Shift the stored instruction into given devices, and BYPASS into
+ * all other devices.
+ */
+static void shift_instruction(struct jtag_soft_driver_t *self_p,
+                              uint32_t devices)
+{
+    int i;
+    int is_last;
+
+    shift_tms(TMS_SELECT_IR_SCAN, TMS_SELECT_IR_SCAN_SIZE);
+
+    for (i = 0; i < self_p->number_of_devices; i++) {
+        is_last = (i == (self_p->number_of_devices - 1));
+
+        if (devices & BIT(i)) {
+            shift_bits(NULL,
+                       &self_p->instruction[0],
+                       self_p->instruction_size,
+                       is_last);
+        } else {
+            shift_bypass_instruction(self_p->ir_lengths[i], is_last);
+        }
+    }
+
+    shift_tms(TMS_EXIT, TMS_EXIT_SIZE);
+}
+
+/**
+ * Drop alive devices whose sample differs from the most common
+ * sample.
+ *
+ * @return Index of a device with the most common sample.
+ */
+static int vote(struct jtag_soft_driver_t *self_p,
+                uint8_t samples[][4],
+                size_t size)
+{
+    int i;
+    int j;
+    int votes;
+    int best_votes;
+    int best;
+    uint32_t alive;
+
+    best = 0;
+    best_votes = 0;
+
+    for (i = 0; i < self_p->number_of_devices; i++) {
+        if ((self_p->alive & BIT(i)) == 0) {
+            continue;
+        }
+
+        votes = 0;
+
+        for (j = 0; j < self_p->number_of_devices; j++) {
+            if ((self_p->alive & BIT(j))
+                && (memcmp(&samples[j][0], &samples[i][0], size) == 0)) {
+                votes++;
+            }
+        }
+
+        if (votes > best_votes) {
+            best = i;
+            best_votes = votes;
+        }
+    }
+
+    alive = self_p->alive;
+
+    for (i = 0; i < self_p->number_of_devices; i++) {
+        if ((alive & BIT(i))
+            && (memcmp(&samples[i][0], &samples[best][0], size) != 0)) {
+            self_p->alive &= ~BIT(i);
+        }
+    }
+
+    /* Put dropped devices in BYPASS. */
+    if (self_p->alive != alive) {
+        shift_instruction(self_p, self_p->alive);
+    }
+
+    return (best);
+}
+
+/**
+ * Shift given data through the data register of each alive device,
+ * and a bypass bit through each other device.
+ */
+static void shift_data_chain(struct jtag_soft_driver_t *self_p,
+                             uint8_t samples[][4],
+                             const uint8_t *txbuf_p,
+                             size_t number_of_bits)
+{
+    int i;
+    int is_last;
+
+    shift_tms(TMS_SELECT_DR_SCAN, TMS_SELECT_DR_SCAN_SIZE);
+
+    for (i = 0; i < self_p->number_of_devices; i++) {
+        is_last = (i == (self_p->number_of_devices - 1));
+
+        if (self_p->alive & BIT(i)) {
+            shift_bits(&samples[i][0], txbuf_p, number_of_bits, is_last);
+        } else {
+            shift_bits(NULL, NULL, 1, is_last);
+        }
+    }
+
+    shift_tms(TMS_EXIT, TMS_EXIT_SIZE);
+}
+
+static int shift_data(struct jtag_soft_driver_t *self_p,
+                      uint8_t *rxbuf_p,
+                      const uint8_t *txbuf_p,
+                      size_t number_of_bits)
+{
+    uint8_t samples[JTAG_SOFT_DEVICES_MAX][4];
+    int i;
+
+    if (number_of_bits == 0) {
+        return (-EINVAL);
+    }
+
+    if (self_p->alive == 0) {
+        return (-ENODEV);
+    }
+
+    /* A single device may shift any number of bits. */
+    if (self_p->number_of_devices == 1) {
+        shift_tms(TMS_SELECT_DR_SCAN, TMS_SELECT_DR_SCAN_SIZE);
+        shift_bits(rxbuf_p, txbuf_p, number_of_bits, 1);
+        shift_tms(TMS_EXIT, TMS_EXIT_SIZE);
+
+        return (0);
+    }
+
+    if (number_of_bits > 32) {
+        return (-EINVAL);
+    }
+
+    shift_data_chain(self_p, samples, txbuf_p, number_of_bits);
+
+    if (rxbuf_p != NULL) {
+        i = vote(self_p, samples, DIV_CEIL(number_of_bits, 8));
+        memcpy(rxbuf_p, &samples[i][0], DIV_CEIL(number_of_bits, 8));
+    }
+
+    return (0);
+}
+
+/**
+ * Shift a 32 bits word, least significant bit first, preceded by the
+ * processor access (PrAcc) bit.
+ *
+ * @return PrAcc, one(1) if the core accepted or provided the word.
+ */
+static int shift_fast_data(uint32_t *rxdata_p, uint32_t txdata, int is_last)
+{
+    int pracc;
+    size_t i;
+    uint32_t rxdata;
+
+    pracc = jtag_clock(0, 0);
+    rxdata = 0;
+
+    for (i = 0; i < 32; i++) {
+        rxdata |= ((uint32_t)jtag_clock(is_last && (i == 31),
+                                        (txdata >> i) & 1) << i);
+    }
+
+    *rxdata_p = rxdata;
+
+    return (pracc);
+}
+
+/**
+ * Transfer given word to or from all alive devices. Once one device
+ * has transferred it, the others are given a few retries to catch up,
+ * with the done devices in BYPASS.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int transfer_fast_data(struct jtag_soft_driver_t *self_p,
+                              uint32_t *rxdata_p,
+                              uint32_t txdata)
+{
+    uint32_t rxdata;
+    uint32_t pending;
+    uint32_t done;
+    int attempt;
+    int is_last;
+    int i;
+
+    if (self_p->alive == 0) {
+        return (-ENODEV);
+    }
+
+    pending = self_p->alive;
+    attempt = 0;
+
+    do {
+        if (attempt > 0) {
+            shift_instruction(self_p, pending);
+        }
+
+        done = 0;
+        shift_tms(TMS_SELECT_DR_SCAN, TMS_SELECT_DR_SCAN_SIZE);
+
+        for (i = 0; i < self_p->number_of_devices; i++) {
+            is_last = (i == (self_p->number_of_devices - 1));
+
+            if (pending & BIT(i)) {
+                if (shift_fast_data(&rxdata, txdata, is_last)) {
+                    rxdata_p[i] = rxdata;
+                    done |= BIT(i);
+                }
+            } else {
+                shift_bits(NULL, NULL, 1, is_last);
+            }
+        }
+
+        shift_tms(TMS_EXIT, TMS_EXIT_SIZE);
+
+        if ((done == 0) && (pending == self_p->alive)) {
+            return (-EPROTO);
+        }
+
+        pending &= ~done;
+        attempt++;
+    } while ((pending != 0) && (attempt <= JTAG_SOFT_FAST_DATA_RETRIES));
+
+    self_p->alive &= ~pending;
+
+    if (attempt > 1) {
+        shift_instruction(self_p, self_p->alive);
+    }
+
+    return (0);
+}
+
+int jtag_soft_init(struct jtag_soft_driver_t *self_p,
+                   struct pin_device_t *mclrn_p)
+{
+    self_p->mclrn_p = mclrn_p;
+    self_p->number_of_devices = 1;
+    self_p->ir_lengths[0] = JTAG_SOFT_IR_LENGTH_PIC32;
+    self_p->devices = 0x1;
+    self_p->alive = 0;
+    self_p->instruction_size = 0;
+
+    return (0);
+}
+
+int jtag_soft_set_chain(struct jtag_soft_driver_t *self_p,
+                        const uint8_t *ir_lengths_p,
+                        int number_of_devices,
+                        uint32_t devices)
+{
+    int i;
+
+    if ((number_of_devices < 1)
+        || (number_of_devices > JTAG_SOFT_DEVICES_MAX)) {
+        return (-EINVAL);
+    }
+
+    if ((devices == 0) || ((devices >> number_of_devices) != 0)) {
+        return (-EINVAL);
+    }
+
+    for (i = 0; i < number_of_devices; i++) {
+        if ((ir_lengths_p[i] == 0) || (ir_lengths_p[i] > 32)) {
+            return (-EINVAL);
+        }
+
+        if ((devices & BIT(i))
+            && (ir_lengths_p[i] != JTAG_SOFT_IR_LENGTH_PIC32)) {
+            return (-EINVAL);
+        }
+
+        self_p->ir_lengths[i] = ir_lengths_p[i];
+    }
+
+    self_p->number_of_devices = number_of_devices;
+    self_p->devices = devices;
+
+    return (0);
+}
+
+uint32_t jtag_soft_get_alive(struct jtag_soft_driver_t *self_p)
+{
+    return (self_p->alive);
+}
+
+int jtag_soft_start(struct jtag_soft_driver_t *self_p)
+{
+    pin_init(&self_p->mclrn, self_p->mclrn_p, PIN_OUTPUT);
+    pin_write(&self_p->mclrn, 1);
+    jtag_start();
+    shift_tms(TMS_RESET, TMS_RESET_SIZE);
+    self_p->alive = self_p->devices;
+
+    return (0);
+}
+
+int jtag_soft_stop(struct jtag_soft_driver_t *self_p)
+{
+    jtag_stop();
+    pin_set_mode(&self_p->mclrn, PIN_INPUT);
+
+    return (0);
+}
+
+int jtag_soft_instruction_write(struct jtag_soft_driver_t *self_p,
+                                const uint8_t *buf_p,
+                                size_t number_of_bits)
+{
+    if (number_of_bits != JTAG_SOFT_IR_LENGTH_PIC32) {
+        return (-EINVAL);
+    }
+
+    if (self_p->alive == 0) {
+        return (-ENODEV);
+    }
+
+    self_p->instruction[0] = buf_p[0];
+    self_p->instruction_size = number_of_bits;
+    shift_instruction(self_p, self_p->alive);
+
+    return (0);
+}
+
+int jtag_soft_data_write(struct jtag_soft_driver_t *self_p,
+                         const uint8_t *buf_p,
+                         size_t number_of_bits)
+{
+    return (shift_data(self_p, NULL, buf_p, number_of_bits));
+}
+
+int jtag_soft_data_read(struct jtag_soft_driver_t *self_p,
+                        uint8_t *buf_p,
+                        size_t number_of_bits)
+{
+    return (shift_data(self_p, buf_p, NULL, number_of_bits));
+}
+
+int jtag_soft_data_transfer(struct jtag_soft_driver_t *self_p,
+                            uint8_t *rxbuf_p,
+                            const uint8_t *txbuf_p,
+                            size_t number_of_bits)
+{
+    return (shift_data(self_p, rxbuf_p, txbuf_p, number_of_bits));
+}
+
+int jtag_soft_data_poll(struct jtag_soft_driver_t *self_p,
+                        uint8_t *rxbuf_p,
+                        const uint8_t *txbuf_p,
+                        const uint8_t *mask_p,
+                        const uint8_t *value_p,
+                        size_t number_of_bits,
+                        struct time_t *end_time_p)
+{
+    uint8_t samples[JTAG_SOFT_DEVICES_MAX][4];
+    uint8_t done_samples[JTAG_SOFT_DEVICES_MAX][4];
+    uint32_t done;
+    size_t size;
+    size_t i;
+    int j;
+    struct time_t time;
+
+    if ((number_of_bits == 0) || (number_of_bits > 32)) {
+        return (-EINVAL);
+    }
+
+    if (self_p->alive == 0) {
+        return (-ENODEV);
+    }
+
+    size = DIV_CEIL(number_of_bits, 8);
+    done = 0;
+
+    while (1) {
+        shift_data_chain(self_p, samples, txbuf_p, number_of_bits);
+
+        for (j = 0; j < self_p->number_of_devices; j++) {
+            if (((self_p->alive & ~done) & BIT(j)) == 0) {
+                continue;
+            }
+
+            for (i = 0; i < size; i++) {
+                if ((samples[j][i] & mask_p[i]) != value_p[i]) {
+                    break;
+                }
+            }
+
+            if (i == size) {
+                memcpy(&done_samples[j][0], &samples[j][0], size);
+                done |= BIT(j);
+            }
+        }
+
+        if (done == self_p->alive) {
+            break;
+        }
+
+        time_get(&time);
+
+        if (time_compare_greater_than_t == time_compare(&time, end_time_p)) {
+            break;
+        }
+    }
+
+    if (done == 0) {
+        return (-ETIMEDOUT);
+    }
+
+    if (done != self_p->alive) {
+        self_p->alive = done;
+        shift_instruction(self_p, self_p->alive);
+    }
+
+    j = vote(self_p, done_samples, size);
+    memcpy(rxbuf_p, &done_samples[j][0], size);
+
+    return (0);
+}
+
+int jtag_soft_fast_data_write(struct jtag_soft_driver_t *self_p,
+                              uint32_t data)
+{
+    uint32_t rxdata[JTAG_SOFT_DEVICES_MAX];
+
+    return (transfer_fast_data(self_p, &rxdata[0], data));
+}
+
+int jtag_soft_fast_data_read(struct jtag_soft_driver_t *self_p,
+                             uint32_t *data_p)
+{
+    uint32_t rxdata[JTAG_SOFT_DEVICES_MAX];
+    uint8_t samples[JTAG_SOFT_DEVICES_MAX][4];
+    int res;
+    int i;
+
+    res = transfer_fast_data(self_p, &rxdata[0], 0);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    for (i = 0; i < JTAG_SOFT_DEVICES_MAX; i++) {
+        memcpy(&samples[i][0], &rxdata[i], sizeof(rxdata[i]));
+    }
+
+    *data_p = rxdata[vote(self_p, samples, sizeof(rxdata[0]))];
+
+    return (0);
+}
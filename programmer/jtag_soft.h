@@ -0,0 +1,184 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#ifndef __JTAG_SOFT_H__
+#define __JTAG_SOFT_H__
+
+#include "simba.h"
+
+/* Maximum number of devices in the scan chain. */
+#define JTAG_SOFT_DEVICES_MAX                               4
+
+/* PIC32 MTAP and ETAP instruction register length. */
+#define JTAG_SOFT_IR_LENGTH_PIC32                           5
+
+/* Number of times a fast data word is retried on devices lagging
+   behind the first device that transferred it. */
+#define JTAG_SOFT_FAST_DATA_RETRIES                         8
+
+/**
+ * A 4-wire JTAG driver. TCK, TMS, TDI and TDO are bit-banged on D22,
+ * D23, D24 and D25. Each TDI/TMS/TDO bit is one TCK clock, compared
+ * to four PGEC clocks in 2-wire ICSP. Requires JTAGEN set in the PIC
+ * configuration.
+ *
+ * The scan chain may have several devices, numbered from TDO, that
+ * is, device 0 drives the programmer TDO input. Instructions and data
+ * are broadcast to all selected devices in one scan, while other
+ * devices are kept in BYPASS. Shifted out data is voted on, and
+ * selected devices disagreeing with the majority are dropped.
+ */
+struct jtag_soft_driver_t {
+    struct pin_device_t *mclrn_p;
+    struct pin_driver_t mclrn;
+    int number_of_devices;
+    uint8_t ir_lengths[JTAG_SOFT_DEVICES_MAX];
+    uint32_t devices;
+    uint32_t alive;
+    uint8_t instruction[4];
+    size_t instruction_size;
+};
+
+/**
+ * Initialize given driver object with a single PIC32 in the scan
+ * chain.
+ *
+ * @return zero(0) or negative error code.
+ */
+int jtag_soft_init(struct jtag_soft_driver_t *self_p,
+                   struct pin_device_t *mclrn_p);
+
+/**
+ * Set the instruction register length of each device in the scan
+ * chain, and the devices to select, bit n for device n. Selected
+ * devices must be PIC32s. Must be called before started.
+ *
+ * @return zero(0) or negative error code.
+ */
+int jtag_soft_set_chain(struct jtag_soft_driver_t *self_p,
+                        const uint8_t *ir_lengths_p,
+                        int number_of_devices,
+                        uint32_t devices);
+
+/**
+ * Get the selected devices not dropped, bit n for device n. Kept
+ * after stopped.
+ *
+ * @return Alive devices.
+ */
+uint32_t jtag_soft_get_alive(struct jtag_soft_driver_t *self_p);
+
+/**
+ * Release the PIC from reset and reset the TAP controller.
+ *
+ * @return zero(0) or negative error code.
+ */
+int jtag_soft_start(struct jtag_soft_driver_t *self_p);
+
+/**
+ * Release all JTAG pins and MCLRN.
+ *
+ * @return zero(0) or negative error code.
+ */
+int jtag_soft_stop(struct jtag_soft_driver_t *self_p);
+
+/**
+ * Shift given instruction into the instruction register.
+ *
+ * @return zero(0) or negative error code.
+ */
+int jtag_soft_instruction_write(struct jtag_soft_driver_t *self_p,
+                                const uint8_t *buf_p,
+                                size_t number_of_bits);
+
+/**
+ * Shift given data into the data register.
+ *
+ * @return zero(0) or negative error code.
+ */
+int jtag_soft_data_write(struct jtag_soft_driver_t *self_p,
+                         const uint8_t *buf_p,
+                         size_t number_of_bits);
+
+/**
+ * Shift out the data register.
+ *
+ * @return zero(0) or negative error code.
+ */
+int jtag_soft_data_read(struct jtag_soft_driver_t *self_p,
+                        uint8_t *buf_p,
+                        size_t number_of_bits);
+
+/**
+ * Shift given data into the data register while shifting out its
+ * previous value. At most 32 bits if more than one device is
+ * selected. The majority value is returned.
+ *
+ * @return zero(0) or negative error code.
+ */
+int jtag_soft_data_transfer(struct jtag_soft_driver_t *self_p,
+                            uint8_t *rxbuf_p,
+                            const uint8_t *txbuf_p,
+                            size_t number_of_bits);
+
+/**
+ * Repeat given data transfer until the shifted out bits selected by
+ * given mask equals given value in each device, at most 32
+ * bits. Devices not done by given end time are dropped. The majority
+ * value is returned.
+ *
+ * @return zero(0) or negative error code.
+ */
+int jtag_soft_data_poll(struct jtag_soft_driver_t *self_p,
+                        uint8_t *rxbuf_p,
+                        const uint8_t *txbuf_p,
+                        const uint8_t *mask_p,
+                        const uint8_t *value_p,
+                        size_t number_of_bits,
+                        struct time_t *end_time_p);
+
+/**
+ * Write given word to the fast data register. Fails with -EPROTO if
+ * no device accepted the word. Devices not accepting it within a few
+ * retries after the first device are dropped.
+ *
+ * @return zero(0) or negative error code.
+ */
+int jtag_soft_fast_data_write(struct jtag_soft_driver_t *self_p,
+                              uint32_t data);
+
+/**
+ * Read a word from the fast data register. See
+ * jtag_soft_fast_data_write(). The majority value is returned.
+ *
+ * @return zero(0) or negative error code.
+ */
+int jtag_soft_fast_data_read(struct jtag_soft_driver_t *self_p,
+                             uint32_t *data_p);
+
+#endif
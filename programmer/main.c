@@ -28,6 +28,108 @@
 
 #include "simba.h"
 #include "programmer.h"
+#include "usb_vendor.h"
+
+#if CONFIG_PROGRAMMER_USB_VENDOR == 1
+
+/* The host may use either the CDC ACM console or the vendor specific
+   interface. Fast write data is buffered in a large ring, so the host
+   can stream ahead of the ICSP transfers. */
+#define VENDOR_RXBUF_SIZE                                2048
+#define VENDOR_DATA_RXBUF_SIZE                          16384
+
+/* Production mode polls for a PIC when the host is idle for this
+   long. */
+#define PRODUCTION_POLL_PERIOD_MS                         500
+
+static struct usb_device_driver_t usb;
+static struct usb_device_class_cdc_driver_t cdc;
+static struct usb_vendor_driver_t vendor;
+static struct usb_device_driver_base_t *drivers[2];
+static uint8_t cdc_rxbuf[CONFIG_START_CONSOLE_RX_BUFFER_SIZE];
+static uint8_t vendor_rxbuf[VENDOR_RXBUF_SIZE];
+static uint8_t vendor_data_rxbuf[VENDOR_DATA_RXBUF_SIZE];
+static struct programmer_link_t cdc_link;
+static struct programmer_link_t vendor_link;
+static struct chan_list_t list;
+static struct chan_list_elem_t workspace[2];
+
+static void usb_start(void)
+{
+    usb_device_module_init();
+    usb_device_class_cdc_module_init();
+
+    usb_device_class_cdc_init(&cdc,
+                              0,
+                              2,
+                              3,
+                              &cdc_rxbuf[0],
+                              sizeof(cdc_rxbuf));
+    usb_vendor_init(&vendor,
+                    &usb,
+                    &vendor_rxbuf[0],
+                    sizeof(vendor_rxbuf),
+                    &vendor_data_rxbuf[0],
+                    sizeof(vendor_data_rxbuf));
+    drivers[0] = &cdc.base;
+    drivers[1] = &vendor.base;
+    usb_device_init(&usb,
+                    &usb_device[0],
+                    drivers,
+                    membersof(drivers),
+                    usb_device_descriptors);
+    usb_device_start(&usb);
+
+    cdc_link.chin_p = &cdc.chin;
+    cdc_link.chout_p = &cdc.chout;
+    cdc_link.data_chin_p = &cdc.chin;
+    cdc_link.window = (sizeof(cdc_rxbuf) / 256);
+    vendor_link.chin_p = &vendor.chin;
+    vendor_link.chout_p = &vendor.chout;
+    vendor_link.data_chin_p = &vendor.data_chin;
+    vendor_link.window = (sizeof(vendor_data_rxbuf) / 256);
+
+    chan_list_init(&list, &workspace[0], sizeof(workspace));
+    chan_list_add(&list, &cdc.chin);
+    chan_list_add(&list, &vendor.chin);
+}
+
+int main()
+{
+    struct programmer_t programmer;
+    struct time_t timeout;
+    void *chan_p;
+
+    sys_start();
+    usb_start();
+
+    programmer_init(&programmer);
+
+    timeout.seconds = 0;
+    timeout.nanoseconds = (1000000L * PRODUCTION_POLL_PERIOD_MS);
+
+    while (1) {
+        chan_p = chan_list_poll(&list, &timeout);
+
+        if (chan_p == NULL) {
+            programmer_production_poll(&programmer);
+            continue;
+        }
+
+        /* Respond on the link the request was received on. */
+        if (chan_p == &vendor.chin) {
+            programmer_set_link(&programmer, &vendor_link);
+        } else {
+            programmer_set_link(&programmer, &cdc_link);
+        }
+
+        programmer_process_packet(&programmer);
+    }
+
+    return (0);
+}
+
+#else
 
 int main()
 {
@@ -38,8 +140,13 @@ int main()
     programmer_init(&programmer);
     
     while (1) {
-        programmer_process_packet(&programmer);
+        /* No request from the host. */
+        if (programmer_process_packet(&programmer) == -ETIMEDOUT) {
+            programmer_production_poll(&programmer);
+        }
     }
 
     return (0);
 }
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#ifndef __PACKET_CRC_H__
+#define __PACKET_CRC_H__
+
+#include "simba.h"
+
+/* Calculate packet CRCs with a lookup table instead of crc_ccitt() in
+   Simba. */
+#ifndef CONFIG_PROGRAMMER_CRC_TABLE
+#    define CONFIG_PROGRAMMER_CRC_TABLE                     1
+#endif
+
+/**
+ * Calculate the CRC-CCITT of given buffer, continuing from given CRC,
+ * with the same result as crc_ccitt() in Simba.
+ *
+ * @return The CRC.
+ */
+uint16_t packet_crc_ccitt(uint16_t crc, const void *buf_p, size_t size);
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#include "simba.h"
+#include "packet_ring.h"
+
+/* The head and tail indices are only written by the producer and the
+   consumer respectively, and wrap at twice the length to tell a full
+   ring from an empty one. The buffer contents must be written before
+   the index is published. */
+#define BARRIER() __sync_synchronize()
+
+int packet_ring_init(struct packet_ring_t *self_p,
+                     void *buf_p,
+                     ssize_t *sizes_p,
+                     size_t packet_size,
+                     size_t length)
+{
+    self_p->buf_p = buf_p;
+    self_p->sizes_p = sizes_p;
+    self_p->packet_size = packet_size;
+    self_p->length = length;
+    self_p->head = 0;
+    self_p->tail = 0;
+
+    return (0);
+}
+
+uint8_t *packet_ring_write_begin(struct packet_ring_t *self_p)
+{
+    size_t index;
+
+    if (packet_ring_used(self_p) == self_p->length) {
+        return (NULL);
+    }
+
+    index = (self_p->head % self_p->length);
+
+    return (&self_p->buf_p[index * self_p->packet_size]);
+}
+
+void packet_ring_write_end(struct packet_ring_t *self_p, ssize_t size)
+{
+    self_p->sizes_p[self_p->head % self_p->length] = size;
+    BARRIER();
+    self_p->head = ((self_p->head + 1) % (2 * self_p->length));
+}
+
+uint8_t *packet_ring_read_begin(struct packet_ring_t *self_p,
+                                ssize_t *size_p)
+{
+    size_t index;
+
+    if (packet_ring_used(self_p) == 0) {
+        return (NULL);
+    }
+
+    BARRIER();
+    index = (self_p->tail % self_p->length);
+    *size_p = self_p->sizes_p[index];
+
+    return (&self_p->buf_p[index * self_p->packet_size]);
+}
+
+void packet_ring_read_end(struct packet_ring_t *self_p)
+{
+    BARRIER();
+    self_p->tail = ((self_p->tail + 1) % (2 * self_p->length));
+}
+
+size_t packet_ring_used(struct packet_ring_t *self_p)
+{
+    return ((self_p->head + 2 * self_p->length - self_p->tail)
+            % (2 * self_p->length));
+}
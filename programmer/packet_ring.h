@@ -0,0 +1,94 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#ifndef __PACKET_RING_H__
+#define __PACKET_RING_H__
+
+#include "simba.h"
+
+/**
+ * A lock-free single producer, single consumer ring of packet
+ * buffers. The producer fills the buffer at the head, and the
+ * consumer drains the buffer at the tail, without copying.
+ */
+struct packet_ring_t {
+    uint8_t *buf_p;
+    ssize_t *sizes_p;
+    size_t packet_size;
+    size_t length;
+    volatile size_t head;
+    volatile size_t tail;
+};
+
+/**
+ * Initialize given ring of given number of packets of given size
+ * each, stored in given buffer. The sizes buffer holds one size per
+ * packet.
+ *
+ * @return zero(0) or negative error code.
+ */
+int packet_ring_init(struct packet_ring_t *self_p,
+                     void *buf_p,
+                     ssize_t *sizes_p,
+                     size_t packet_size,
+                     size_t length);
+
+/**
+ * Get the buffer at the head of the ring. Only called by the
+ * producer.
+ *
+ * @return Buffer, or NULL if the ring is full.
+ */
+uint8_t *packet_ring_write_begin(struct packet_ring_t *self_p);
+
+/**
+ * Make the buffer at the head of the ring, with given packet size or
+ * negative error code, available to the consumer.
+ */
+void packet_ring_write_end(struct packet_ring_t *self_p, ssize_t size);
+
+/**
+ * Get the buffer at the tail of the ring. Only called by the
+ * consumer.
+ *
+ * @return Buffer, or NULL if the ring is empty.
+ */
+uint8_t *packet_ring_read_begin(struct packet_ring_t *self_p,
+                                ssize_t *size_p);
+
+/**
+ * Give the buffer at the tail of the ring back to the producer.
+ */
+void packet_ring_read_end(struct packet_ring_t *self_p);
+
+/**
+ * Returns the number of packets in the ring.
+ */
+size_t packet_ring_used(struct packet_ring_t *self_p);
+
+#endif
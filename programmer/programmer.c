@@ -28,12 +28,21 @@
 
 #include "simba.h"
 #include "programmer.h"
+#include "packet_ring.h"
+#include "packet_crc.h"
+#include "compat.h"
 
 /* ICSP pin devices. */
 #define pin_pgec_dev                               pin_d2_dev
 #define pin_pged_dev                               pin_d3_dev
 #define pin_mclrn_dev                              pin_d4_dev
 
+/* Gang MCLRN pin devices, one per target. */
+static struct pin_device_t *gang_mclrn_devs[] = {
+    &pin_d27_dev, &pin_d29_dev, &pin_d31_dev, &pin_d33_dev,
+    &pin_d35_dev, &pin_d37_dev, &pin_d39_dev, &pin_d41_dev
+};
+
 /* Device status. */
 #define STATUS_CPS                     bits_reverse_8(BIT(7))
 #define STATUS_NVMERR                  bits_reverse_8(BIT(5))
@@ -73,8 +82,29 @@
 
 #define PAYLOAD_OFFSET                (TYPE_SIZE + SIZE_SIZE)
 
+/* Size field of packets with a 32 bits size after the size field,
+   used by responses too big for the packet buffer. */
+#define SIZE_EXTENDED                                  0xffff
+#define EXTENDED_SIZE_SIZE                                  4
+#define MAXIMUM_EXTENDED_PAYLOAD_SIZE                   65536
+
+/* Version of this protocol, and optional commands, in the
+   capabilities response. */
+#define PROTOCOL_VERSION                                    2
+#define CAPABILITY_BLANK_CHECK                         (1 << 0)
+#define CAPABILITY_READ_WORDS                          (1 << 1)
+#define CAPABILITY_TARGETS_STATUS                      (1 << 2)
+#define CAPABILITY_STAGING                             (1 << 3)
+#define CAPABILITY_PRODUCTION                          (1 << 4)
+#define CAPABILITY_JOB                                 (1 << 5)
+#define CAPABILITY_TRACE                               (1 << 6)
+#define CAPABILITY_ROW_ERRORS                          (1 << 7)
+#define CAPABILITY_FAST_READ                           (1 << 8)
+
 /* Command types. */
 #define COMMAND_TYPE_FAILED                                -1
+#define COMMAND_TYPE_FAST_WRITE_CREDITS                     0
+#define COMMAND_TYPE_FAST_READ_DATA                         0
 #define COMMAND_TYPE_PING                                 100
 #define COMMAND_TYPE_CONNECT                              101
 #define COMMAND_TYPE_DISCONNECT                           102
@@ -83,616 +113,4922 @@
 #define COMMAND_TYPE_CHIP_ERASE                           105
 #define COMMAND_TYPE_FAST_WRITE                           106
 #define COMMAND_TYPE_VERSION                              107
+#define COMMAND_TYPE_TARGETS_STATUS                       108
+#define COMMAND_TYPE_READ_WORDS                           109
+#define COMMAND_TYPE_CAPABILITIES                         110
+#define COMMAND_TYPE_STAGE                                111
+#define COMMAND_TYPE_STAGED_WRITE                         112
+#define COMMAND_TYPE_PRODUCTION_STORE                     113
+#define COMMAND_TYPE_PRODUCTION_ENABLE                    114
+#define COMMAND_TYPE_PRODUCTION_STATUS                    115
+#define COMMAND_TYPE_JOB                                  116
+#define COMMAND_TYPE_STATS                                117
+#define COMMAND_TYPE_TRACE_CONTROL                        118
+#define COMMAND_TYPE_TRACE_READ                           119
+#define COMMAND_TYPE_FAST_READ                            120
+
+/* Ramapp command types. */
+#define RAMAPP_COMMAND_TYPE_PING                            1
+#define RAMAPP_COMMAND_TYPE_READ                            3
+#define RAMAPP_COMMAND_TYPE_CRC                             5
+#define RAMAPP_COMMAND_TYPE_EXT_LOAD                        6
+#define RAMAPP_COMMAND_TYPE_BLANK_CHECK                     7
+#define RAMAPP_COMMAND_TYPE_FEATURES                        8
+
+/* Ramapp features. A ramapp without the features command has none of
+   them. */
+#define RAMAPP_FEATURE_PING_ECHO                       (1 << 0)
+#define RAMAPP_FEATURE_CRC                             (1 << 1)
+#define RAMAPP_FEATURE_EXT_LOAD                        (1 << 2)
+#define RAMAPP_FEATURE_EXTENDED_READ                   (1 << 3)
+#define RAMAPP_FEATURE_FAST_WRITE_ROW_CRC              (1 << 4)
+#define RAMAPP_FEATURE_FAST_READ                       (1 << 5)
+
+/* The ramapp image is stored at the start of the RAM. */
+#define RAMAPP_ADDRESS                             0xa0000000
+
+/* Ramapp extension modules. */
+#define RAMAPP_EXT_TYPES_MAX                                4
+
+/* Reading words over PRACC, without the ramapp. */
+#define READ_WORDS_MAX                                     64
+#define FASTDATA_ADDRESS                           0xff200000
+
+/* microMIPS registers. */
+#define GPR_T0                                              8
+#define GPR_T1                                              9
+#define GPR_S3                                             19
 
 /* Packet sizes. */
 #define PACKET_FAST_WRITE_REQUEST_SIZE                     16
 #define PACKET_FAST_WRITE_DATA_SIZE                       256
+#define PACKET_FAST_READ_REQUEST_SIZE                      14
+#define PACKET_STAGE_REQUEST_SIZE                          13
+#define PACKET_STAGED_WRITE_REQUEST_SIZE                   11
+#define PACKET_PRODUCTION_ENABLE_REQUEST_SIZE              15
+
+/* Fast write and staged write request flags, in an optional last
+   payload byte. */
+#define FAST_WRITE_FLAG_REPORT_FAILED_ROWS             (1 << 0)
+
+/* Failed rows listed in a ramapp fast write response. */
+#define FAST_WRITE_FAILED_ROWS_MAX                         64
+
+/* Job steps. */
+#define JOB_STEP_CHIP_ERASE                                 1
+#define JOB_STEP_CONNECT                                    2
+#define JOB_STEP_WRITE                                      3
+#define JOB_STEP_VERIFY                                     4
+#define JOB_STEP_DISCONNECT                                 5
+#define JOB_STEPS_MAX                                      64
 
 #define CTRL_TIMEOUT_NS                             500000000
 #define ERASE_TIMEOUT_S                                     3
+#define LOADER_TIMEOUT_NS                           500000000
+
+/* Fast data bursts. */
+#define FAST_DATA_BURST_WORDS_MAX                          16
+#define FAST_DATA_RETRIES                                   3
+
+/* ICSP clock calibration. */
+#define CLOCK_CALIBRATION_READS                             4
 
 /* Error codes. */
 #define EENTERSERIALEXECUTIONMODE                       10000
 #define ERAMAPPUPLOAD                                   10001
+#define ECLOCKCALIBRATION                               10002
+#define EVERIFY                                         10003
 
 static const uint32_t ramapp_upload_instructions[] = {
 #include "ramapp_upload_instructions.i"
 };
 
-static int send_command(struct icsp_soft_driver_t *icsp_p,
-                        uint8_t command)
-{
-    return (icsp_soft_instruction_write(icsp_p, &command, 5));
-}
+static const uint32_t ramapp_image[] = {
+#include "ramapp_image.i"
+};
 
-static int xfer_data_32(struct icsp_soft_driver_t *icsp_p,
-                        uint32_t request,
-                        uint32_t *response_p)
-{
-    int res;
+/* A ramapp extension module image, and the ramapp command types it
+   handles. The image is the number of words, the words and the
+   CRC-32 of the words. */
+struct ramapp_ext_image_t {
+    int32_t types[RAMAPP_EXT_TYPES_MAX];
+    const uint32_t *image_p;
+};
 
-    request = htonl(request);
+#include "ramapp_ext_images.i"
 
-    res = icsp_soft_data_transfer(icsp_p,
-                                  (uint8_t *)response_p,
-                                  (uint8_t *)&request,
-                                  32);
+/* ICSP clock dividers tried by the clock calibration, slowest
+   first. */
+static const int clock_dividers[] = { 48, 32, 24, 16, 12, 8, 6 };
 
-    if (res != 0) {
-        return (res);
-    }
+/* Shifted through the ETAP data register, and echoed by the ramapp,
+   to verify the ICSP clock. */
+static const uint8_t loopback_patterns[] = {
+    0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+    0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0x55
+};
 
-    *response_p = ntohl(*response_p);
+#include "icsp_spi_sequences.i"
+
+/* The USB CDC ACM console. */
+static struct programmer_link_t console_link;
+
+/* Fast write data packets buffered ahead of the ICSP transfers, and
+   responses waiting to be sent to the host. */
+#define RX_PACKETS                                          4
+#define TX_PACKETS                                          2
+#define TX_PACKET_SIZE    (PAYLOAD_OFFSET + MAXIMUM_PAYLOAD_SIZE + CRC_SIZE + 2)
+
+struct pipeline_t {
+    struct packet_ring_t rx;
+    uint8_t rx_buf[RX_PACKETS][PACKET_FAST_WRITE_DATA_SIZE];
+    ssize_t rx_sizes[RX_PACKETS];
+    struct packet_ring_t tx;
+    uint8_t tx_buf[TX_PACKETS][TX_PACKET_SIZE];
+    ssize_t tx_sizes[TX_PACKETS];
+    /* Fast write flow control. Packets granted to the host but not yet
+       received, packets not yet granted, and received packets not yet
+       returned as credits. */
+    int rx_outstanding;
+    int rx_ungranted;
+    int rx_credits;
+    int rx_batch;
+#if CONFIG_PROGRAMMER_PIPELINE == 1
+    int rx_number_of_packets;
+    volatile int rx_abort;
+    struct sem_t rx_start;
+    struct sem_t rx_ready;
+    struct sem_t rx_free;
+    struct sem_t rx_done;
+    struct sem_t tx_ready;
+    struct sem_t tx_free;
+#endif
+};
 
-    return (0);
-}
+static struct pipeline_t pipeline;
 
-static int xfer_instruction(struct icsp_soft_driver_t *icsp_p,
-                            uint32_t instruction)
-{
-    int res;
-    uint32_t response;
-    struct time_t time;
-    struct time_t end_time;
+/* Image data uploaded by the host at full USB speed, written to the
+   PIC from one slice while the host uploads the next slice into the
+   other. */
+#define STAGING_SLICES                                      2
 
-    res = send_command(icsp_p, ETAP_CONTROL);
+struct staging_t {
+    uint8_t buf[STAGING_SLICES][CONFIG_PROGRAMMER_STAGING_SLICE_SIZE];
+    size_t sizes[STAGING_SLICES];
+    uint16_t crcs[STAGING_SLICES];
+};
 
-    if (res != 0) {
-        return (res);
-    }
+#if CONFIG_PROGRAMMER_STAGING_SLICE_SIZE > 0
+static struct staging_t staging;
+#endif
 
-    time.seconds = 0;
-    time.nanoseconds = 500000000;
+#if CONFIG_PROGRAMMER_PRODUCTION == 1
+
+/* Production mode outputs. The on-board LED is lit while a PIC is
+   programmed. The sense input is high while a PIC is powered. */
+#define pin_production_pass_dev                    pin_d5_dev
+#define pin_production_fail_dev                    pin_d6_dev
+#define pin_production_busy_dev                    pin_d13_dev
+#define pin_production_sense_dev                   pin_d7_dev
+
+#define PRODUCTION_MAGIC                           0x70726f64
+#define PRODUCTION_FLAG_CHIP_ERASE                   (1 << 0)
+#define PRODUCTION_FLAG_VERIFY                       (1 << 1)
+
+/* The header is alone in the first flash page of the region,
+   followed by the image segments. Each segment is a header with the
+   PIC flash address, size, CRC-32 and 16 bits CRC of the data,
+   followed by the data. */
+#define PRODUCTION_IMAGE_OFFSET                           256
+#define PRODUCTION_SEGMENT_HEADER_SIZE                     16
+
+#define PRODUCTION_STATE_WAIT_PRESENT                       0
+#define PRODUCTION_STATE_WAIT_REMOVED                       1
+
+struct production_header_t {
+    uint32_t magic;
+    uint32_t flags;
+    uint32_t transport;
+    uint32_t size;
+    uint32_t crc;
+};
 
-    time_get(&end_time);
-    time_add(&end_time, &end_time, &time);
+struct production_segment_t {
+    uint32_t address;
+    uint32_t size;
+    uint32_t crc_32;
+    uint16_t crc;
+};
 
-    do {
-        res = xfer_data_32(icsp_p,
-                           bits_reverse_32(0x0004c000),
-                           &response);
+struct production_t {
+    struct flash_driver_t flash;
+    struct pin_driver_t pass;
+    struct pin_driver_t fail;
+    struct pin_driver_t busy;
+    struct pin_driver_t sense;
+    int state;
+    uint32_t passed;
+    uint32_t failed;
+    int error;
+};
 
-        time_get(&time);
+static struct production_t production;
 
-        if (time_compare_greater_than_t == time_compare(&time, &end_time)) {
-            res = -ETIMEDOUT;
-        }
-    } while (((response & CONTROL_PRACC) == 0) && (res == 0));
+#endif
 
-    if (res != 0) {
-        return (res);
-    }
+#if CONFIG_PROGRAMMER_PIPELINE == 1
+static THRD_STACK(reader_stack, 1024);
+static THRD_STACK(writer_stack, 1024);
+#endif
 
-    res = send_command(icsp_p, ETAP_DATA);
+/* Performance counter phases. */
+#define STATS_PHASE_NONE                                   -1
+#define STATS_PHASE_RECEIVE                                 0
+#define STATS_PHASE_ICSP                                    1
+#define STATS_PHASE_PRACC_POLL                              2
+#define STATS_PHASE_FASTDATA_WAIT                           3
+#define STATS_PHASE_CRC                                     4
+#define STATS_PHASE_ERASE_POLL                              5
+#define STATS_PHASES                                        6
+
+/* Cycles spent and bytes transferred in each phase of the main
+   thread since the counters were last read. A phase started within
+   another phase is counted as the outer phase, so ICSP shifting while
+   polling is counted as polling. */
+struct stats_t {
+    uint64_t cycles[STATS_PHASES];
+    uint32_t bytes[STATS_PHASES];
+    int phase;
+    uint32_t start;
+    struct time_t reset_time;
+};
 
-    if (res != 0) {
-        return (res);
-    }
+static struct stats_t stats;
 
-    res = xfer_data_32(icsp_p, bits_reverse_32(instruction), &response);
+static void stats_reset(void)
+{
+    memset(&stats.cycles[0], 0, sizeof(stats.cycles));
+    memset(&stats.bytes[0], 0, sizeof(stats.bytes));
+    stats.phase = STATS_PHASE_NONE;
+}
 
-    if (res != 0) {
-        return (res);
+/**
+ * Start given phase, unless another phase is already started.
+ *
+ * @return The started phase, or STATS_PHASE_NONE.
+ */
+static int stats_begin(int phase)
+{
+    if (stats.phase != STATS_PHASE_NONE) {
+        return (STATS_PHASE_NONE);
     }
 
-    res = send_command(icsp_p, ETAP_CONTROL);
+    stats.phase = phase;
+    stats.start = cycle_counter_read();
 
-    if (res != 0) {
-        return (res);
+    return (phase);
+}
+
+/**
+ * End given phase started by stats_begin(), in which given number of
+ * bytes were transferred.
+ */
+static void stats_end(int phase, size_t size)
+{
+    if (phase == STATS_PHASE_NONE) {
+        return;
     }
 
-    res = xfer_data_32(icsp_p, bits_reverse_32(0x0000c000), &response);
+    stats.cycles[phase] += (uint32_t)(cycle_counter_read() - stats.start);
+    stats.bytes[phase] += size;
+    stats.phase = STATS_PHASE_NONE;
+}
 
-    return (res);
+/**
+ * Calculate the CRC of given packet data.
+ */
+static uint16_t packet_crc(const uint8_t *buf_p, size_t size)
+{
+    uint16_t crc;
+    int phase;
+
+    phase = stats_begin(STATS_PHASE_CRC);
+    crc = packet_crc_ccitt(0xffff, buf_p, size);
+    stats_end(phase, size);
+
+    return (crc);
 }
 
-static int enter_serial_execution_mode(struct icsp_soft_driver_t *icsp_p)
+/* Trace entry kinds, in the low bits of the kind field. The TAP and
+   PrAcc flags are in the high bits. */
+#define TRACE_KIND_COMMAND                                  0
+#define TRACE_KIND_INSTRUCTION                              1
+#define TRACE_KIND_DATA                                     2
+#define TRACE_KIND_FAST_DATA_WRITE                          3
+#define TRACE_KIND_FAST_DATA_READ                           4
+#define TRACE_KIND_REPLAY                                   5
+#define TRACE_FLAG_ETAP                                  0x40
+#define TRACE_FLAG_PRACC                                 0x80
+
+#define TRACE_ENTRY_SIZE                                   12
+#define TRACE_READ_ENTRIES_MAX \
+    ((MAXIMUM_PAYLOAD_SIZE - 8) / TRACE_ENTRY_SIZE)
+
+#if CONFIG_PROGRAMMER_TRACE_ENTRIES > 0
+
+/* A shift, or the start of a command. Times are in cycle counter
+   ticks. Fast data bursts are one entry with 33 bits per word, and
+   replayed sequences one entry with the number of clocks as bits. */
+struct trace_entry_t {
+    uint32_t start;
+    uint32_t end;
+    uint8_t kind;
+    uint8_t instruction;
+    uint16_t number_of_bits;
+};
+
+/* The most recent shifts of the main thread, and the number of
+   shifts recorded since the trace was started. The TAP and
+   instruction register of the last instruction written are tracked
+   to tag data shifts. */
+struct trace_t {
+    struct trace_entry_t entries[CONFIG_PROGRAMMER_TRACE_ENTRIES];
+    uint32_t count;
+    int is_enabled;
+    uint8_t instruction;
+    uint8_t flags;
+};
+
+static struct trace_t trace;
+
+static uint32_t trace_begin(void)
 {
-    int res;
-    uint8_t command;
-    uint8_t status;
+    return (cycle_counter_read());
+}
 
-    res = send_command(icsp_p, MTAP_SW_MTAP);
+static void trace_record(uint32_t start,
+                         int kind,
+                         size_t number_of_bits,
+                         int pracc)
+{
+    struct trace_entry_t *entry_p;
 
-    if (res != 0) {
-        return (res);
+    if (!trace.is_enabled) {
+        return;
     }
 
-    res = send_command(icsp_p, MTAP_COMMAND);
+    entry_p = &trace.entries[trace.count % CONFIG_PROGRAMMER_TRACE_ENTRIES];
+    entry_p->start = start;
+    entry_p->end = cycle_counter_read();
+    entry_p->kind = (kind | trace.flags);
+    entry_p->instruction = trace.instruction;
+    entry_p->number_of_bits = MIN(number_of_bits, 0xffff);
 
-    if (res != 0) {
-        return (res);
+    if (pracc) {
+        entry_p->kind |= TRACE_FLAG_PRACC;
     }
 
-    command = MCHP_STATUS;
-    res = icsp_soft_data_transfer(icsp_p, &status, &command, 8);
+    trace.count++;
+}
 
-    if (res != 0) {
-        return (res);
-    }
+/**
+ * Record given instruction shift. The instruction selects the data
+ * register of following data shifts, or switches TAP.
+ */
+static void trace_instruction(uint32_t start,
+                              const uint8_t *buf_p,
+                              size_t number_of_bits)
+{
+    trace.instruction = bits_reverse_8(buf_p[0]);
+    trace_record(start, TRACE_KIND_INSTRUCTION, number_of_bits, 0);
 
-    if ((status & STATUS_CPS) == 0) {
-        return (-EPROTO);
+    if (buf_p[0] == MTAP_SW_ETAP) {
+        trace.flags = TRACE_FLAG_ETAP;
+    } else if (buf_p[0] == MTAP_SW_MTAP) {
+        trace.flags = 0;
     }
+}
 
-    command = MCHP_ASSERT_RST;
-    res = icsp_soft_data_write(icsp_p, &command, 8);
+/**
+ * Record given data shift, with the PrAcc bit of the response if the
+ * control register was shifted.
+ */
+static void trace_data(uint32_t start,
+                       const uint8_t *rxbuf_p,
+                       size_t number_of_bits)
+{
+    uint32_t control;
+    int pracc;
 
-    if (res != 0) {
-        return (res);
+    pracc = 0;
+
+    if ((rxbuf_p != NULL)
+        && (trace.instruction == bits_reverse_8(ETAP_CONTROL))
+        && (number_of_bits == 32)) {
+        memcpy(&control, rxbuf_p, sizeof(control));
+        pracc = ((control & htonl(CONTROL_PRACC)) != 0);
     }
 
-    res = send_command(icsp_p, MTAP_SW_ETAP);
+    trace_record(start, TRACE_KIND_DATA, number_of_bits, pracc);
+}
 
-    if (res != 0) {
-        return (res);
-    }
+/**
+ * Record the start of given command, with the command type in the
+ * instruction field.
+ */
+static void trace_command(int type)
+{
+    uint8_t instruction;
 
-    res = send_command(icsp_p, ETAP_EJTAGBOOT);
+    instruction = trace.instruction;
+    trace.instruction = type;
+    trace_record(cycle_counter_read(), TRACE_KIND_COMMAND, 0, 0);
+    trace.instruction = instruction;
+}
 
-    if (res != 0) {
-        return (res);
-    }
+#else
 
-    res = send_command(icsp_p, MTAP_SW_MTAP);
+static uint32_t trace_begin(void)
+{
+    return (0);
+}
 
-    if (res != 0) {
-        return (res);
-    }
+static void trace_record(uint32_t start,
+                         int kind,
+                         size_t number_of_bits,
+                         int pracc)
+{
+}
 
-    res = send_command(icsp_p, MTAP_COMMAND);
+static void trace_instruction(uint32_t start,
+                              const uint8_t *buf_p,
+                              size_t number_of_bits)
+{
+}
 
-    if (res != 0) {
-        return (res);
-    }
+static void trace_data(uint32_t start,
+                       const uint8_t *rxbuf_p,
+                       size_t number_of_bits)
+{
+}
 
-    command = MCHP_DE_ASSERT_RST;
-    res = icsp_soft_data_write(icsp_p, &command, 8);
+static void trace_command(int type)
+{
+}
 
-    if (res != 0) {
-        return (res);
+#endif
+
+/**
+ * Returns true(1) if several targets may be programmed at once, that
+ * is, a gang or a JTAG scan chain.
+ */
+static int is_multi_target(struct programmer_t *self_p)
+{
+    return ((self_p->transport == PROGRAMMER_TRANSPORT_ICSP_GANG)
+            || ((self_p->transport == PROGRAMMER_TRANSPORT_JTAG_SOFT)
+                && (self_p->jtag_number_of_devices > 1)));
+}
+
+static uint32_t get_alive_targets(struct programmer_t *self_p)
+{
+    if (self_p->transport == PROGRAMMER_TRANSPORT_JTAG_SOFT) {
+        return (jtag_soft_get_alive(&self_p->jtag_soft));
     }
 
-    res = send_command(icsp_p, MTAP_SW_ETAP);
+    return (icsp_gang_get_alive(&self_p->icsp_gang));
+}
 
-    return (res);
+static void icsp_start(struct programmer_t *self_p)
+{
+    switch (self_p->transport) {
+
+    case PROGRAMMER_TRANSPORT_ICSP_SPI:
+        icsp_spi_init(&self_p->icsp_spi, &pin_mclrn_dev);
+        icsp_spi_start(&self_p->icsp_spi);
+        break;
+
+    case PROGRAMMER_TRANSPORT_JTAG_SOFT:
+        jtag_soft_init(&self_p->jtag_soft, &pin_mclrn_dev);
+        jtag_soft_set_chain(&self_p->jtag_soft,
+                            &self_p->jtag_ir_lengths[0],
+                            self_p->jtag_number_of_devices,
+                            self_p->targets);
+        jtag_soft_start(&self_p->jtag_soft);
+        break;
+
+    case PROGRAMMER_TRANSPORT_ICSP_GANG:
+        icsp_gang_init(&self_p->icsp_gang,
+                       &gang_mclrn_devs[0],
+                       membersof(gang_mclrn_devs));
+        icsp_gang_start(&self_p->icsp_gang, self_p->targets);
+        break;
+
+    default:
+        icsp_soft_init(&self_p->icsp,
+                       &pin_pgec_dev,
+                       &pin_pged_dev,
+                       &pin_mclrn_dev);
+        icsp_soft_start(&self_p->icsp);
+        break;
+    }
 }
 
-static int upload_ramapp(struct icsp_soft_driver_t *icsp_p)
+static void icsp_stop(struct programmer_t *self_p)
 {
-    int res;
-    size_t i;
+    switch (self_p->transport) {
 
-    res = 0;
+    case PROGRAMMER_TRANSPORT_ICSP_SPI:
+        icsp_spi_stop(&self_p->icsp_spi);
+        break;
 
-    for (i = 0; i < membersof(ramapp_upload_instructions); i++) {
-        res = xfer_instruction(icsp_p, ramapp_upload_instructions[i]);
+    case PROGRAMMER_TRANSPORT_JTAG_SOFT:
+        jtag_soft_stop(&self_p->jtag_soft);
+        break;
 
-        if (res != 0) {
-            break;
-        }
+    case PROGRAMMER_TRANSPORT_ICSP_GANG:
+        icsp_gang_stop(&self_p->icsp_gang);
+        break;
+
+    default:
+        icsp_soft_stop(&self_p->icsp);
+        break;
     }
+}
 
-    /* Start the uploaded application. */
-    if (res == 0) {
-        res = xfer_instruction(icsp_p, 0x00000000);
+static int icsp_instruction_write(struct programmer_t *self_p,
+                                  const uint8_t *buf_p,
+                                  size_t number_of_bits)
+{
+    int phase;
+    int res;
+    uint32_t start;
+
+    phase = stats_begin(STATS_PHASE_ICSP);
+    start = trace_begin();
+
+    switch (self_p->transport) {
+
+    case PROGRAMMER_TRANSPORT_ICSP_SPI:
+        res = icsp_spi_instruction_write(&self_p->icsp_spi,
+                                         buf_p,
+                                         number_of_bits);
+        break;
+
+    case PROGRAMMER_TRANSPORT_JTAG_SOFT:
+        res = jtag_soft_instruction_write(&self_p->jtag_soft,
+                                          buf_p,
+                                          number_of_bits);
+        break;
+
+    case PROGRAMMER_TRANSPORT_ICSP_GANG:
+        res = icsp_gang_instruction_write(&self_p->icsp_gang,
+                                          buf_p,
+                                          number_of_bits);
+        break;
+
+    default:
+        res = icsp_soft_instruction_write(&self_p->icsp,
+                                          buf_p,
+                                          number_of_bits);
+        break;
     }
 
+    stats_end(phase, DIV_CEIL(number_of_bits, 8));
+    trace_instruction(start, buf_p, number_of_bits);
+
     return (res);
 }
 
-static int read_device_status(struct icsp_soft_driver_t *icsp_p)
+static int icsp_data_write(struct programmer_t *self_p,
+                           const uint8_t *buf_p,
+                           size_t number_of_bits)
 {
+    int phase;
     int res;
-    uint8_t command;
-    uint8_t status;
+    uint32_t start;
 
-    res = send_command(icsp_p, MTAP_SW_MTAP);
+    phase = stats_begin(STATS_PHASE_ICSP);
+    start = trace_begin();
 
-    if (res != 0) {
-        return (res);
-    }
+    switch (self_p->transport) {
 
-    res = send_command(icsp_p, MTAP_COMMAND);
+    case PROGRAMMER_TRANSPORT_ICSP_SPI:
+        res = icsp_spi_data_write(&self_p->icsp_spi, buf_p, number_of_bits);
+        break;
 
-    if (res != 0) {
-        return (res);
+    case PROGRAMMER_TRANSPORT_JTAG_SOFT:
+        res = jtag_soft_data_write(&self_p->jtag_soft, buf_p, number_of_bits);
+        break;
+
+    case PROGRAMMER_TRANSPORT_ICSP_GANG:
+        res = icsp_gang_data_write(&self_p->icsp_gang, buf_p, number_of_bits);
+        break;
+
+    default:
+        res = icsp_soft_data_write(&self_p->icsp, buf_p, number_of_bits);
+        break;
     }
 
-    command = MCHP_STATUS;
-    res = icsp_soft_data_transfer(icsp_p, &status, &command, 8);
+    stats_end(phase, DIV_CEIL(number_of_bits, 8));
+    trace_data(start, NULL, number_of_bits);
 
-    if (res != 0) {
-        return (res);
+    return (res);
+}
+
+static int icsp_data_transfer(struct programmer_t *self_p,
+                              uint8_t *rxbuf_p,
+                              const uint8_t *txbuf_p,
+                              size_t number_of_bits)
+{
+    int phase;
+    int res;
+    uint32_t start;
+
+    phase = stats_begin(STATS_PHASE_ICSP);
+    start = trace_begin();
+
+    switch (self_p->transport) {
+
+    case PROGRAMMER_TRANSPORT_ICSP_SPI:
+        res = icsp_spi_data_transfer(&self_p->icsp_spi,
+                                     rxbuf_p,
+                                     txbuf_p,
+                                     number_of_bits);
+        break;
+
+    case PROGRAMMER_TRANSPORT_JTAG_SOFT:
+        res = jtag_soft_data_transfer(&self_p->jtag_soft,
+                                      rxbuf_p,
+                                      txbuf_p,
+                                      number_of_bits);
+        break;
+
+    case PROGRAMMER_TRANSPORT_ICSP_GANG:
+        res = icsp_gang_data_transfer(&self_p->icsp_gang,
+                                      rxbuf_p,
+                                      txbuf_p,
+                                      number_of_bits);
+        break;
+
+    default:
+        res = icsp_soft_data_transfer(&self_p->icsp,
+                                      rxbuf_p,
+                                      txbuf_p,
+                                      number_of_bits);
+        break;
     }
 
-    return (status);
+    stats_end(phase, DIV_CEIL(number_of_bits, 8));
+    trace_data(start, rxbuf_p, number_of_bits);
+
+    return (res);
 }
 
-static int chip_erase(struct icsp_soft_driver_t *icsp_p)
+static int icsp_fast_data_write(struct programmer_t *self_p,
+                                uint32_t data)
 {
+    int phase;
     int res;
-    uint8_t command;
-    uint8_t status;
-    struct time_t time;
-    struct time_t end_time;
+    uint32_t start;
 
-    res = send_command(icsp_p, MTAP_SW_MTAP);
+    phase = stats_begin(STATS_PHASE_ICSP);
+    start = trace_begin();
 
-    if (res != 0) {
-        return (res);
-    }
+    switch (self_p->transport) {
 
-    res = send_command(icsp_p, MTAP_COMMAND);
+    case PROGRAMMER_TRANSPORT_ICSP_SPI:
+        res = icsp_spi_fast_data_write(&self_p->icsp_spi, data);
+        break;
 
-    if (res != 0) {
-        return (res);
-    }
+    case PROGRAMMER_TRANSPORT_JTAG_SOFT:
+        res = jtag_soft_fast_data_write(&self_p->jtag_soft, data);
+        break;
 
-    command = MCHP_ERASE;
-    res = icsp_soft_data_transfer(icsp_p, &status, &command, 8);
+    case PROGRAMMER_TRANSPORT_ICSP_GANG:
+        res = icsp_gang_fast_data_write(&self_p->icsp_gang, data);
+        break;
 
-    if (res != 0) {
-        return (res);
+    default:
+        res = icsp_soft_fast_data_write(&self_p->icsp, data);
+        break;
     }
 
-    command = MCHP_DE_ASSERT_RST;
-    res = icsp_soft_data_transfer(icsp_p, &status, &command, 8);
+    stats_end(phase, 4);
+    trace_record(start, TRACE_KIND_FAST_DATA_WRITE, 33, res == 0);
 
-    if (res != 0) {
-        return (res);
-    }
+    return (res);
+}
 
-    thrd_sleep_ms(10);
+static int icsp_fast_data_read(struct programmer_t *self_p,
+                               uint32_t *data_p)
+{
+    int phase;
+    int res;
+    uint32_t start;
 
-    time.seconds = ERASE_TIMEOUT_S;
-    time.nanoseconds = 0;
+    phase = stats_begin(STATS_PHASE_ICSP);
+    start = trace_begin();
 
-    time_get(&end_time);
-    time_add(&end_time, &end_time, &time);
+    switch (self_p->transport) {
 
-    command = MCHP_STATUS;
+    case PROGRAMMER_TRANSPORT_ICSP_SPI:
+        res = icsp_spi_fast_data_read(&self_p->icsp_spi, data_p);
+        break;
 
-    do {
-        res = icsp_soft_data_transfer(icsp_p, &status, &command, 8);
-        status &= (STATUS_FCBUSY | STATUS_CFGRDY);
+    case PROGRAMMER_TRANSPORT_JTAG_SOFT:
+        res = jtag_soft_fast_data_read(&self_p->jtag_soft, data_p);
+        break;
 
-        time_get(&time);
+    case PROGRAMMER_TRANSPORT_ICSP_GANG:
+        res = icsp_gang_fast_data_read(&self_p->icsp_gang, data_p);
+        break;
 
-        if (time_compare_greater_than_t == time_compare(&time, &end_time)) {
-            res = -ETIMEDOUT;
-        }
-    } while ((status != STATUS_CFGRDY) && (res == 0));
+    default:
+        res = icsp_soft_fast_data_read(&self_p->icsp, data_p);
+        break;
+    }
+
+    stats_end(phase, 4);
+    trace_record(start, TRACE_KIND_FAST_DATA_READ, 33, res == 0);
 
     return (res);
 }
 
 /**
- * Read a packet from the ramapp in the PIC.
+ * Repeat given data transfer until the shifted out bits selected by
+ * given mask equals given value, or until given end time. Each gang
+ * target and JTAG chain device is polled until done by itself.
  *
- * @return Number of read bytes or negative error code.
+ * @return zero(0) or negative error code.
  */
-static ssize_t ramapp_read(struct programmer_t *self_p, uint8_t *buf_p)
+static int icsp_data_poll(struct programmer_t *self_p,
+                          uint8_t *rxbuf_p,
+                          const uint8_t *txbuf_p,
+                          const uint8_t *mask_p,
+                          const uint8_t *value_p,
+                          size_t number_of_bits,
+                          struct time_t *end_time_p)
 {
     int res;
-    uint32_t data;
-    size_t size;
-    size_t number_of_words;
     size_t i;
+    struct time_t time;
 
-    /* Read type and size. */
-    res = icsp_soft_fast_data_read(&self_p->icsp, &data);
-
-    if (res != 0) {
-        return (res);
+    if (self_p->transport == PROGRAMMER_TRANSPORT_ICSP_GANG) {
+        return (icsp_gang_data_poll(&self_p->icsp_gang,
+                                    rxbuf_p,
+                                    txbuf_p,
+                                    mask_p,
+                                    value_p,
+                                    number_of_bits,
+                                    end_time_p));
+    } else if (self_p->transport == PROGRAMMER_TRANSPORT_JTAG_SOFT) {
+        return (jtag_soft_data_poll(&self_p->jtag_soft,
+                                    rxbuf_p,
+                                    txbuf_p,
+                                    mask_p,
+                                    value_p,
+                                    number_of_bits,
+                                    end_time_p));
     }
 
-    buf_p[0] = (data >> 24);
-    buf_p[1] = (data >> 16);
-    buf_p[2] = (data >> 8);
-    buf_p[3] = (data >> 0);
-
-    size = ((buf_p[2] << 8) | buf_p[3]);
-
-    if (size > MAXIMUM_PAYLOAD_SIZE) {
-        return (-EPROTO);
-    }
+    do {
+        res = icsp_data_transfer(self_p, rxbuf_p, txbuf_p, number_of_bits);
 
-    /* Read payload and crc. */
-    number_of_words = DIV_CEIL(size + CRC_SIZE, 4);
+        time_get(&time);
 
-    for (i = 0; i < number_of_words; i++) {
-        res = icsp_soft_fast_data_read(&self_p->icsp, &data);
+        if (time_compare_greater_than_t == time_compare(&time, end_time_p)) {
+            res = -ETIMEDOUT;
+        }
 
         if (res != 0) {
-            return (res);
+            break;
         }
 
-        buf_p[4 * i + 4] = (data >> 24);
-        buf_p[4 * i + 5] = (data >> 16);
-        buf_p[4 * i + 6] = (data >> 8);
-        buf_p[4 * i + 7] = (data >> 0);
-    }
+        for (i = 0; i < DIV_CEIL(number_of_bits, 8); i++) {
+            if ((rxbuf_p[i] & mask_p[i]) != value_p[i]) {
+                break;
+            }
+        }
+    } while (i < DIV_CEIL(number_of_bits, 8));
 
-    return (PAYLOAD_OFFSET + size + CRC_SIZE);
+    return (res);
+}
+
+/**
+ * Write given words to the fast data register back-to-back.
+ *
+ * @return Number of accepted words, -ENOSYS if the transport has no
+ *         burst support, or negative error code.
+ */
+static ssize_t icsp_fast_data_write_burst(struct programmer_t *self_p,
+                                          const uint32_t *buf_p,
+                                          size_t number_of_words)
+{
+    int phase;
+    ssize_t res;
+    uint32_t start;
+
+    if (self_p->transport != PROGRAMMER_TRANSPORT_ICSP_SPI) {
+        return (-ENOSYS);
+    }
+
+    phase = stats_begin(STATS_PHASE_ICSP);
+    start = trace_begin();
+    res = icsp_spi_fast_data_write_burst(&self_p->icsp_spi,
+                                         buf_p,
+                                         number_of_words);
+    stats_end(phase, 4 * MAX(res, 0));
+    trace_record(start,
+                 TRACE_KIND_FAST_DATA_WRITE,
+                 33 * MAX(res, 0),
+                 res == number_of_words);
+
+    return (res);
+}
+
+/**
+ * Read words from the fast data register back-to-back.
+ *
+ * @return Number of read words, -ENOSYS if the transport has no burst
+ *         support, or negative error code.
+ */
+static ssize_t icsp_fast_data_read_burst(struct programmer_t *self_p,
+                                         uint32_t *buf_p,
+                                         size_t number_of_words)
+{
+    int phase;
+    ssize_t res;
+    uint32_t start;
+
+    if (self_p->transport != PROGRAMMER_TRANSPORT_ICSP_SPI) {
+        return (-ENOSYS);
+    }
+
+    phase = stats_begin(STATS_PHASE_ICSP);
+    start = trace_begin();
+    res = icsp_spi_fast_data_read_burst(&self_p->icsp_spi,
+                                        buf_p,
+                                        number_of_words);
+    stats_end(phase, 4 * MAX(res, 0));
+    trace_record(start,
+                 TRACE_KIND_FAST_DATA_READ,
+                 33 * MAX(res, 0),
+                 res == number_of_words);
+
+    return (res);
+}
+
+/**
+ * Replay given precompiled sequence.
+ *
+ * @return zero(0), -ENOSYS if the transport cannot replay sequences,
+ *         or negative error code.
+ */
+static int icsp_replay(struct programmer_t *self_p,
+                       const struct icsp_spi_sequence_t *sequence_p,
+                       uint8_t *samples_p)
+{
+    int phase;
+    int res;
+    uint32_t start;
+
+    if (self_p->transport != PROGRAMMER_TRANSPORT_ICSP_SPI) {
+        return (-ENOSYS);
+    }
+
+    phase = stats_begin(STATS_PHASE_ICSP);
+    start = trace_begin();
+    res = icsp_spi_replay(&self_p->icsp_spi, sequence_p, samples_p);
+    stats_end(phase, 0);
+    trace_record(start, TRACE_KIND_REPLAY, 2 * sequence_p->size, 0);
+
+    return (res);
+}
+
+/**
+ * Select the JTAG scan chain given as the targets to program, the
+ * number of devices and the IR length of each device.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int select_jtag_chain(struct programmer_t *self_p,
+                             const uint8_t *buf_p,
+                             size_t size)
+{
+    int i;
+    int number_of_devices;
+
+    number_of_devices = buf_p[1];
+
+    if (size != (2 + number_of_devices)) {
+        return (-EMSGSIZE);
+    }
+
+    if ((number_of_devices == 0)
+        || (number_of_devices > JTAG_SOFT_DEVICES_MAX)) {
+        return (-EINVAL);
+    }
+
+    if ((buf_p[0] == 0) || ((buf_p[0] >> number_of_devices) != 0)) {
+        return (-EINVAL);
+    }
+
+    for (i = 0; i < number_of_devices; i++) {
+        if ((buf_p[2 + i] == 0) || (buf_p[2 + i] > 32)) {
+            return (-EINVAL);
+        }
+
+        /* Only PIC32 devices may be programmed. */
+        if ((buf_p[0] & BIT(i))
+            && (buf_p[2 + i] != JTAG_SOFT_IR_LENGTH_PIC32)) {
+            return (-EINVAL);
+        }
+
+        self_p->jtag_ir_lengths[i] = buf_p[2 + i];
+    }
+
+    self_p->jtag_number_of_devices = number_of_devices;
+    self_p->targets = buf_p[0];
+
+    return (0);
+}
+
+/**
+ * Select given transport, or the default transport if size is
+ * zero(0). The gang transport may be followed by the targets to
+ * program, otherwise all targets are programmed. The JTAG transport
+ * may be followed by a scan chain, otherwise the PIC is alone in the
+ * chain.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int select_transport(struct programmer_t *self_p,
+                            const uint8_t *transport_p,
+                            size_t size)
+{
+    int res;
+
+    self_p->targets = (BIT(membersof(gang_mclrn_devs)) - 1);
+    self_p->jtag_number_of_devices = 1;
+    self_p->jtag_ir_lengths[0] = JTAG_SOFT_IR_LENGTH_PIC32;
+
+    if (size == 0) {
+        self_p->transport = CONFIG_PROGRAMMER_TRANSPORT;
+
+        return (0);
+    }
+
+    if ((size == 2) && (transport_p[0] == PROGRAMMER_TRANSPORT_ICSP_GANG)) {
+        if ((transport_p[1] == 0) || (transport_p[1] > self_p->targets)) {
+            return (-EINVAL);
+        }
+
+        self_p->targets = transport_p[1];
+    } else if ((size >= 3)
+               && (transport_p[0] == PROGRAMMER_TRANSPORT_JTAG_SOFT)) {
+        res = select_jtag_chain(self_p, &transport_p[1], size - 1);
+
+        if (res != 0) {
+            return (res);
+        }
+    } else if (size != 1) {
+        return (-EMSGSIZE);
+    }
+
+    if (transport_p[0] == PROGRAMMER_TRANSPORT_JTAG_SOFT) {
+        self_p->targets &= (BIT(self_p->jtag_number_of_devices) - 1);
+    }
+
+    switch (transport_p[0]) {
+
+    case PROGRAMMER_TRANSPORT_ICSP_SOFT:
+    case PROGRAMMER_TRANSPORT_ICSP_SPI:
+    case PROGRAMMER_TRANSPORT_JTAG_SOFT:
+    case PROGRAMMER_TRANSPORT_ICSP_GANG:
+        self_p->transport = transport_p[0];
+        break;
+
+    default:
+        return (-EINVAL);
+    }
+
+    return (0);
+}
+
+static int send_command(struct programmer_t *self_p,
+                        uint8_t command)
+{
+    return (icsp_instruction_write(self_p, &command, 5));
+}
+
+static int xfer_data_32(struct programmer_t *self_p,
+                        uint32_t request,
+                        uint32_t *response_p)
+{
+    int res;
+
+    request = htonl(request);
+
+    res = icsp_data_transfer(self_p,
+                             (uint8_t *)response_p,
+                             (uint8_t *)&request,
+                             32);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    *response_p = ntohl(*response_p);
+
+    return (0);
+}
+
+static int xfer_instruction(struct programmer_t *self_p,
+                            uint32_t instruction)
+{
+    int phase;
+    int res;
+    uint32_t request;
+    uint32_t response;
+    uint32_t pracc;
+    struct time_t time;
+    struct time_t end_time;
+
+    res = send_command(self_p, ETAP_CONTROL);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+
+    time_get(&end_time);
+    time_add(&end_time, &end_time, &time);
+
+    request = htonl(bits_reverse_32(0x0004c000));
+    pracc = htonl(CONTROL_PRACC);
+    phase = stats_begin(STATS_PHASE_PRACC_POLL);
+    res = icsp_data_poll(self_p,
+                         (uint8_t *)&response,
+                         (uint8_t *)&request,
+                         (uint8_t *)&pracc,
+                         (uint8_t *)&pracc,
+                         32,
+                         &end_time);
+    stats_end(phase, 4);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, ETAP_DATA);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = xfer_data_32(self_p, bits_reverse_32(instruction), &response);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, ETAP_CONTROL);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = xfer_data_32(self_p, bits_reverse_32(0x0000c000), &response);
+
+    return (res);
+}
+
+/**
+ * Transfer given instruction without first polling for the core to
+ * fetch it. The control register value captured when clearing PrAcc
+ * tells if the core was waiting for the instruction.
+ *
+ * @return zero(0), -EAGAIN if the core was not waiting for the
+ *         instruction, or negative error code.
+ */
+static int xfer_instruction_speculative(struct programmer_t *self_p,
+                                        uint32_t instruction)
+{
+    int res;
+    uint32_t response;
+
+    res = send_command(self_p, ETAP_DATA);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = xfer_data_32(self_p, bits_reverse_32(instruction), &response);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, ETAP_CONTROL);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = xfer_data_32(self_p, bits_reverse_32(0x0000c000), &response);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    if ((response & CONTROL_PRACC) == 0) {
+        return (-EAGAIN);
+    }
+
+    return (0);
+}
+
+/**
+ * microMIPS instructions as transferred over PRACC, with the
+ * immediate in the upper halfword.
+ */
+static uint32_t micromips_lui(int rs, uint16_t immediate)
+{
+    return ((immediate << 16) | (0x10 << 10) | (0x0d << 5) | rs);
+}
+
+static uint32_t micromips_ori(int rt, int rs, uint16_t immediate)
+{
+    return ((immediate << 16) | (0x14 << 10) | (rt << 5) | rs);
+}
+
+static uint32_t micromips_lw(int rt, int base, uint16_t offset)
+{
+    return ((offset << 16) | (0x3f << 10) | (rt << 5) | base);
+}
+
+static uint32_t micromips_sw(int rt, int base, uint16_t offset)
+{
+    return ((offset << 16) | (0x3e << 10) | (rt << 5) | base);
+}
+
+/**
+ * Step the ICSP clock down to the next slower divider.
+ *
+ * @return zero(0) or negative error code if already at the slowest
+ *         divider.
+ */
+static int downclock(struct programmer_t *self_p)
+{
+    int i;
+
+    for (i = membersof(clock_dividers) - 1; i >= 0; i--) {
+        if (clock_dividers[i] > self_p->icsp_spi.clock_divider) {
+            return (icsp_spi_set_clock_divider(&self_p->icsp_spi,
+                                               clock_dividers[i]));
+        }
+    }
+
+    return (-ERANGE);
+}
+
+/**
+ * Read the IDCODE a few times and shift the loopback patterns through
+ * the ETAP data register at the current ICSP clock. The ramapp is not
+ * yet running, so the data register is used as loopback instead of
+ * FASTDATA. Both registers share the same shift path.
+ *
+ * @return zero(0), -EPROTO on a mismatch, or other negative error
+ *         code.
+ */
+static int check_clock(struct programmer_t *self_p, uint32_t reference)
+{
+    int res;
+    uint32_t value;
+    uint32_t pattern;
+    uint32_t previous;
+    size_t i;
+    const uint8_t *pattern_p;
+
+    res = send_command(self_p, MTAP_SW_MTAP);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, MTAP_IDCODE);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    for (i = 0; i < CLOCK_CALIBRATION_READS; i++) {
+        res = xfer_data_32(self_p, 0, &value);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        if (value != reference) {
+            return (-EPROTO);
+        }
+    }
+
+    res = send_command(self_p, MTAP_SW_ETAP);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, ETAP_DATA);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    /* Each transfer shifts out the previously written pattern. */
+    for (i = 0; i <= sizeof(loopback_patterns); i += 4) {
+        pattern_p = &loopback_patterns[i % sizeof(loopback_patterns)];
+        pattern = ((pattern_p[0] << 24)
+                   | (pattern_p[1] << 16)
+                   | (pattern_p[2] << 8)
+                   | (pattern_p[3] << 0));
+        res = xfer_data_32(self_p, pattern, &value);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        if ((i > 0) && (value != previous)) {
+            return (-EPROTO);
+        }
+
+        previous = pattern;
+    }
+
+    return (0);
+}
+
+/**
+ * Read the IDCODE at the slowest ICSP clock, and then check the
+ * IDCODE and the loopback at faster and faster clocks until either
+ * fails. The clock is set one divider slower than the fastest clock
+ * without errors, as safety margin.
+ */
+static int calibrate_clock(struct programmer_t *self_p)
+{
+    int res;
+    uint32_t reference;
+    size_t i;
+
+    icsp_spi_set_clock_divider(&self_p->icsp_spi, clock_dividers[0]);
+
+    res = send_command(self_p, MTAP_SW_MTAP);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, MTAP_IDCODE);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = xfer_data_32(self_p, 0, &reference);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    /* PGED stuck low or high. */
+    if ((reference == 0x00000000) || (reference == 0xffffffff)) {
+        return (-ECLOCKCALIBRATION);
+    }
+
+    for (i = 0; i < membersof(clock_dividers); i++) {
+        if (i > 0) {
+            icsp_spi_set_clock_divider(&self_p->icsp_spi,
+                                       clock_dividers[i]);
+        }
+
+        res = check_clock(self_p, reference);
+
+        if (res == -EPROTO) {
+            break;
+        }
+
+        if (res != 0) {
+            return (res);
+        }
+    }
+
+    /* Errors already at the slowest clock. */
+    if (i == 0) {
+        return (-ECLOCKCALIBRATION);
+    }
+
+    i = (MAX(i, 2) - 2);
+    icsp_spi_set_clock_divider(&self_p->icsp_spi, clock_dividers[i]);
+
+    /* The TAP state is unknown after an error. */
+    return (icsp_spi_reset(&self_p->icsp_spi));
+}
+
+/**
+ * Set the ICSP clock to given frequency in Hz, or calibrate it if
+ * zero(0). Only the USART SPI transport has an adjustable clock.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int select_clock(struct programmer_t *self_p, uint32_t frequency)
+{
+    if (self_p->transport != PROGRAMMER_TRANSPORT_ICSP_SPI) {
+        return (0);
+    }
+
+    if (frequency == 0) {
+        return (calibrate_clock(self_p));
+    }
+
+    return (icsp_spi_set_clock_divider(&self_p->icsp_spi,
+                                       DIV_CEIL(ICSP_SPI_MCK_FREQUENCY,
+                                                frequency)));
+}
+
+static int enter_serial_execution_mode(struct programmer_t *self_p)
+{
+    int res;
+    uint8_t command;
+    uint8_t status;
+
+    res = icsp_replay(self_p, &read_status_sequence, &status);
+
+    if (res == 0) {
+        if ((status & STATUS_CPS) == 0) {
+            return (-EPROTO);
+        }
+
+        return (icsp_replay(self_p,
+                            &enter_serial_execution_mode_sequence,
+                            NULL));
+    } else if (res != -ENOSYS) {
+        return (res);
+    }
+
+    res = send_command(self_p, MTAP_SW_MTAP);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, MTAP_COMMAND);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    command = MCHP_STATUS;
+    res = icsp_data_transfer(self_p, &status, &command, 8);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    if ((status & STATUS_CPS) == 0) {
+        return (-EPROTO);
+    }
+
+    command = MCHP_ASSERT_RST;
+    res = icsp_data_write(self_p, &command, 8);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, MTAP_SW_ETAP);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, ETAP_EJTAGBOOT);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, MTAP_SW_MTAP);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, MTAP_COMMAND);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    command = MCHP_DE_ASSERT_RST;
+    res = icsp_data_write(self_p, &command, 8);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, MTAP_SW_ETAP);
+
+    return (res);
+}
+
+/**
+ * Write given words to the ramapp in a burst. Words not accepted by
+ * the core in the burst are retried one by one.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int fast_data_write_words(struct programmer_t *self_p,
+                                 const uint32_t *buf_p,
+                                 size_t number_of_words)
+{
+    ssize_t res;
+    size_t i;
+    int attempt;
+
+    res = icsp_fast_data_write_burst(self_p, buf_p, number_of_words);
+
+    if (res == -ENOSYS) {
+        res = 0;
+    } else if (res < 0) {
+        return (res);
+    }
+
+    for (i = res; i < number_of_words; i++) {
+        attempt = 0;
+
+        do {
+            res = icsp_fast_data_write(self_p, buf_p[i]);
+            attempt++;
+        } while ((res == -EPROTO) && (attempt < FAST_DATA_RETRIES));
+
+        if (res != 0) {
+            return (res);
+        }
+    }
+
+    return (0);
+}
+
+/**
+ * Read given number of words from the ramapp in a burst. Words not
+ * provided by the core in the burst are retried one by one.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int fast_data_read_words(struct programmer_t *self_p,
+                                uint32_t *buf_p,
+                                size_t number_of_words)
+{
+    ssize_t res;
+    size_t i;
+    int attempt;
+
+    res = icsp_fast_data_read_burst(self_p, buf_p, number_of_words);
+
+    if (res == -ENOSYS) {
+        res = 0;
+    } else if (res < 0) {
+        return (res);
+    }
+
+    for (i = res; i < number_of_words; i++) {
+        attempt = 0;
+
+        do {
+            res = icsp_fast_data_read(self_p, &buf_p[i]);
+            attempt++;
+        } while ((res == -EPROTO) && (attempt < FAST_DATA_RETRIES));
+
+        if (res != 0) {
+            return (res);
+        }
+    }
+
+    return (0);
+}
+
+/**
+ * Transfer given loader upload instruction, the index'th in the
+ * precompiled sequences. The precompiled transfer is only valid if
+ * the core was already waiting for the instruction, otherwise it is
+ * repeated with polling.
+ *
+ * Transports without precompiled sequences transfer the instruction
+ * speculatively, as the core executes the straight-line loader upload
+ * instructions faster than they are shifted. Speculation is turned
+ * off for the rest of the upload on the first miss.
+ */
+static int upload_loader_instruction(struct programmer_t *self_p,
+                                     size_t index,
+                                     uint32_t instruction,
+                                     int *speculative_p)
+{
+    int res;
+    uint8_t pracc;
+
+    res = icsp_replay(self_p, &upload_loader_sequences[index], &pracc);
+
+    if ((res == 0) && (pracc != 0)) {
+        return (0);
+    } else if ((res != 0) && (res != -ENOSYS)) {
+        return (res);
+    }
+
+    if ((res == -ENOSYS) && *speculative_p) {
+        res = xfer_instruction_speculative(self_p, instruction);
+
+        if (res != -EAGAIN) {
+            return (res);
+        }
+
+        *speculative_p = 0;
+    }
+
+    return (xfer_instruction(self_p, instruction));
+}
+
+/**
+ * Upload and start the loader over PRACC. Only a few words are
+ * transferred this way, as each instruction costs a full PRACC
+ * handshake.
+ */
+static int upload_loader(struct programmer_t *self_p)
+{
+    int res;
+    size_t i;
+    int speculative;
+
+    res = 0;
+
+    /* A miss would drop the targets that were not waiting for the
+       instruction. */
+    speculative = !is_multi_target(self_p);
+
+    for (i = 0; i < membersof(ramapp_upload_instructions); i++) {
+        /* A miss may also be a core fetching the instruction just
+           after the capture, and then it is transferred twice. That
+           is harmless for the loads and stores, but not for the
+           jump. */
+        if (i == (membersof(ramapp_upload_instructions) - 1)) {
+            speculative = 0;
+        }
+
+        res = upload_loader_instruction(self_p,
+                                        i,
+                                        ramapp_upload_instructions[i],
+                                        &speculative);
+
+        if (res != 0) {
+            break;
+        }
+    }
+
+    /* Start the uploaded loader. */
+    if (res == 0) {
+        res = upload_loader_instruction(self_p, i, 0x00000000, &speculative);
+    }
+
+    return (res);
+}
+
+/**
+ * Read a word from the fast data register, repeated until the core
+ * provides it or until the loader timeout.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int fast_data_read_wait(struct programmer_t *self_p,
+                               uint32_t *data_p)
+{
+    int phase;
+    int res;
+    struct time_t time;
+    struct time_t end_time;
+
+    time.seconds = 0;
+    time.nanoseconds = LOADER_TIMEOUT_NS;
+
+    time_get(&end_time);
+    time_add(&end_time, &end_time, &time);
+    phase = stats_begin(STATS_PHASE_FASTDATA_WAIT);
+
+    do {
+        res = icsp_fast_data_read(self_p, data_p);
+
+        time_get(&time);
+
+        if (time_compare_greater_than_t == time_compare(&time, &end_time)) {
+            res = -ETIMEDOUT;
+        }
+    } while (res == -EPROTO);
+
+    stats_end(phase, 4);
+
+    return (res);
+}
+
+/**
+ * Stream the ramapp image, framed by its size and CRC-32, to the
+ * loader over FASTDATA. The loader verifies the CRC before responding
+ * and then starts the ramapp.
+ */
+static int upload_ramapp(struct programmer_t *self_p)
+{
+    int res;
+    uint32_t result;
+
+    res = fast_data_write_words(self_p,
+                                &ramapp_image[0],
+                                membersof(ramapp_image));
+
+    if (res != 0) {
+        return (res);
+    }
+
+    /* The loader does not accept the read until the CRC is
+       calculated. */
+    res = fast_data_read_wait(self_p, &result);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    if (result != 0) {
+        return (-EPROTO);
+    }
+
+    return (0);
+}
+
+static int read_device_status(struct programmer_t *self_p)
+{
+    int res;
+    uint8_t command;
+    uint8_t status;
+
+    res = icsp_replay(self_p, &read_status_sequence, &status);
+
+    if (res == 0) {
+        return (status);
+    } else if (res != -ENOSYS) {
+        return (res);
+    }
+
+    res = send_command(self_p, MTAP_SW_MTAP);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = send_command(self_p, MTAP_COMMAND);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    command = MCHP_STATUS;
+    res = icsp_data_transfer(self_p, &status, &command, 8);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    return (status);
+}
+
+/**
+ * Read given number of words from given address over PRACC, without
+ * the ramapp. Each word is loaded into a register and stored to the
+ * FASTDATA register in the debug segment, where it is shifted out.
+ * Requires serial execution mode.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int read_words(struct programmer_t *self_p,
+                      uint32_t address,
+                      uint8_t *buf_p,
+                      int number_of_words)
+{
+    int res;
+    int i;
+    uint32_t data;
+
+    res = xfer_instruction(self_p,
+                           micromips_lui(GPR_S3, FASTDATA_ADDRESS >> 16));
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = xfer_instruction(self_p, micromips_lui(GPR_T0, address >> 16));
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = xfer_instruction(self_p, micromips_ori(GPR_T0, GPR_T0, address));
+
+    if (res != 0) {
+        return (res);
+    }
+
+    for (i = 0; i < number_of_words; i++) {
+        res = xfer_instruction(self_p, micromips_lw(GPR_T1, GPR_T0, 4 * i));
+
+        if (res != 0) {
+            return (res);
+        }
+
+        res = xfer_instruction(self_p, micromips_sw(GPR_T1, GPR_S3, 0));
+
+        if (res != 0) {
+            return (res);
+        }
+
+        /* The store is performed after this instruction is fetched. */
+        res = xfer_instruction(self_p, 0x00000000);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        res = send_command(self_p, ETAP_FASTDATA);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        res = fast_data_read_wait(self_p, &data);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        /* Same byte order as in memory. */
+        buf_p[4 * i + 0] = (data >> 0);
+        buf_p[4 * i + 1] = (data >> 8);
+        buf_p[4 * i + 2] = (data >> 16);
+        buf_p[4 * i + 3] = (data >> 24);
+    }
+
+    return (0);
+}
+
+static int chip_erase(struct programmer_t *self_p)
+{
+    int phase;
+    int res;
+    uint8_t command;
+    uint8_t status;
+    uint8_t mask;
+    uint8_t value;
+    struct time_t time;
+    struct time_t end_time;
+
+    res = icsp_replay(self_p, &chip_erase_sequence, NULL);
+
+    if (res == -ENOSYS) {
+        res = send_command(self_p, MTAP_SW_MTAP);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        res = send_command(self_p, MTAP_COMMAND);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        command = MCHP_ERASE;
+        res = icsp_data_transfer(self_p, &status, &command, 8);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        command = MCHP_DE_ASSERT_RST;
+        res = icsp_data_transfer(self_p, &status, &command, 8);
+    }
+
+    if (res != 0) {
+        return (res);
+    }
+
+    thrd_sleep_ms(10);
+
+    time.seconds = ERASE_TIMEOUT_S;
+    time.nanoseconds = 0;
+
+    time_get(&end_time);
+    time_add(&end_time, &end_time, &time);
+
+    command = MCHP_STATUS;
+    mask = (STATUS_FCBUSY | STATUS_CFGRDY);
+    value = STATUS_CFGRDY;
+    phase = stats_begin(STATS_PHASE_ERASE_POLL);
+    res = icsp_data_poll(self_p,
+                         &status,
+                         &command,
+                         &mask,
+                         &value,
+                         8,
+                         &end_time);
+    stats_end(phase, 0);
+
+    return (res);
+}
+
+/**
+ * Read the rest of a packet from the ramapp, after given first word
+ * with type and size.
+ *
+ * @return Packet size or negative error code.
+ */
+static ssize_t ramapp_read_rest(struct programmer_t *self_p,
+                                uint8_t *buf_p,
+                                uint32_t data)
+{
+    int res;
+    uint32_t words[FAST_DATA_BURST_WORDS_MAX];
+    size_t size;
+    size_t number_of_words;
+    size_t left;
+    size_t i;
+
+    buf_p[0] = (data >> 24);
+    buf_p[1] = (data >> 16);
+    buf_p[2] = (data >> 8);
+    buf_p[3] = (data >> 0);
+
+    size = ((buf_p[2] << 8) | buf_p[3]);
+
+    if (size > MAXIMUM_PAYLOAD_SIZE) {
+        return (-EPROTO);
+    }
+
+    /* Read payload and crc. */
+    left = DIV_CEIL(size + CRC_SIZE, 4);
+    buf_p += PAYLOAD_OFFSET;
+
+    while (left > 0) {
+        number_of_words = MIN(left, membersof(words));
+        res = fast_data_read_words(self_p, &words[0], number_of_words);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        for (i = 0; i < number_of_words; i++) {
+            buf_p[4 * i + 0] = (words[i] >> 24);
+            buf_p[4 * i + 1] = (words[i] >> 16);
+            buf_p[4 * i + 2] = (words[i] >> 8);
+            buf_p[4 * i + 3] = (words[i] >> 0);
+        }
+
+        buf_p += (4 * number_of_words);
+        left -= number_of_words;
+    }
+
+    return (PAYLOAD_OFFSET + size + CRC_SIZE);
+}
+
+/**
+ * Read a packet from the ramapp in the PIC.
+ *
+ * @return Number of read bytes or negative error code.
+ */
+static ssize_t ramapp_read(struct programmer_t *self_p, uint8_t *buf_p)
+{
+    int res;
+    uint32_t data;
+
+    /* Read type and size. */
+    res = icsp_fast_data_read(self_p, &data);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    return (ramapp_read_rest(self_p, buf_p, data));
+}
+
+/**
+ * Write a packet to the ramapp in the PIC.
+ *
+ * @return zero(0) or negative error code.
+ */
+static ssize_t ramapp_write(struct programmer_t *self_p,
+                            uint8_t *buf_p,
+                            size_t size)
+{
+    uint32_t words[FAST_DATA_BURST_WORDS_MAX];
+    size_t number_of_words;
+    size_t left;
+    size_t i;
+    int res;
+
+    left = DIV_CEIL(size, 4);
+
+    while (left > 0) {
+        number_of_words = MIN(left, membersof(words));
+
+        for (i = 0; i < number_of_words; i++) {
+            words[i] = ((buf_p[4 * i + 0] << 24)
+                        | (buf_p[4 * i + 1] << 16)
+                        | (buf_p[4 * i + 2] << 8)
+                        | (buf_p[4 * i + 3] << 0));
+        }
+
+        res = fast_data_write_words(self_p, &words[0], number_of_words);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        buf_p += (4 * number_of_words);
+        left -= number_of_words;
+    }
+
+    return (size);
+}
+
+/**
+ * Ping the ramapp with a payload of bit patterns and check that it is
+ * echoed unmodified.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int verify_clock(struct programmer_t *self_p)
+{
+    uint8_t request[PAYLOAD_OFFSET + sizeof(loopback_patterns) + CRC_SIZE + 2];
+    uint8_t response[sizeof(request)];
+    ssize_t size;
+    ssize_t res;
+    uint16_t crc;
+
+    size = (PAYLOAD_OFFSET + sizeof(loopback_patterns));
+    request[0] = 0;
+    request[1] = RAMAPP_COMMAND_TYPE_PING;
+    request[2] = 0;
+    request[3] = sizeof(loopback_patterns);
+    memcpy(&request[PAYLOAD_OFFSET],
+           &loopback_patterns[0],
+           sizeof(loopback_patterns));
+    crc = packet_crc(&request[0], size);
+    request[size] = (crc >> 8);
+    request[size + 1] = crc;
+    request[size + 2] = 0;
+    request[size + 3] = 0;
+    size += CRC_SIZE;
+
+    res = ramapp_write(self_p, &request[0], size);
+
+    if (res != size) {
+        return (res);
+    }
+
+    res = ramapp_read(self_p, &response[0]);
+
+    if (res < 0) {
+        return (res);
+    }
+
+    if ((res != size) || (memcmp(&response[0], &request[0], size) != 0)) {
+        return (-EPROTO);
+    }
+
+    return (0);
+}
+
+/**
+ * Bit errors on the ICSP bus show up as a bad CRC, either of the
+ * response or of the request as received by the ramapp.
+ */
+static int is_bad_crc_response(uint8_t *buf_p, size_t size)
+{
+    uint16_t actual_crc;
+    uint16_t expected_crc;
+    int32_t error;
+
+    actual_crc = ((buf_p[size - CRC_SIZE] << 8)
+                  | buf_p[size - CRC_SIZE + 1]);
+    expected_crc = packet_crc(&buf_p[0], size - CRC_SIZE);
+
+    if (actual_crc != expected_crc) {
+        return (1);
+    }
+
+    if ((buf_p[0] != 0xff)
+        || (buf_p[1] != 0xff)
+        || (size != (PAYLOAD_OFFSET + 4 + CRC_SIZE))) {
+        return (0);
+    }
+
+    error = ((buf_p[4] << 24)
+             | (buf_p[5] << 16)
+             | (buf_p[6] << 8)
+             | (buf_p[7] << 0));
+
+    return (error == -EBADCRC);
+}
+
+/**
+ * Prepare a features request in given buffer.
+ *
+ * @return Request size.
+ */
+static size_t prepare_features_request(uint8_t *request_p)
+{
+    uint16_t crc;
+
+    request_p[0] = 0;
+    request_p[1] = RAMAPP_COMMAND_TYPE_FEATURES;
+    request_p[2] = 0;
+    request_p[3] = 0;
+    crc = packet_crc(&request_p[0], PAYLOAD_OFFSET);
+    request_p[4] = (crc >> 8);
+    request_p[5] = crc;
+    request_p[6] = 0;
+    request_p[7] = 0;
+
+    return (PAYLOAD_OFFSET + CRC_SIZE);
+}
+
+/**
+ * Read the features response of the ramapp running in the PIC, and
+ * the size of the code and constants of its image, if given. A ramapp
+ * without the features command fails it, and has no features.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int read_features_response(struct programmer_t *self_p,
+                                  uint32_t *constant_size_p)
+{
+    uint8_t response[PAYLOAD_OFFSET + 8 + CRC_SIZE + 2];
+    uint32_t data;
+    ssize_t res;
+
+    res = icsp_fast_data_read(self_p, &data);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    /* Anything but a features or failure response may not fit in the
+       buffer. */
+    if ((data != ((RAMAPP_COMMAND_TYPE_FEATURES << 16) | 8))
+        && (data != 0xffff0004)) {
+        return (-EPROTO);
+    }
+
+    res = ramapp_read_rest(self_p, &response[0], data);
+
+    if (res < 0) {
+        return (res);
+    }
+
+    if (is_bad_crc_response(&response[0], res)) {
+        return (-EPROTO);
+    }
+
+    if (response[0] == 0xff) {
+        self_p->ramapp_features = 0;
+
+        return (0);
+    }
+
+    self_p->ramapp_features = ((response[4] << 24)
+                               | (response[5] << 16)
+                               | (response[6] << 8)
+                               | (response[7] << 0));
+
+    if (constant_size_p != NULL) {
+        *constant_size_p = ((response[8] << 24)
+                            | (response[9] << 16)
+                            | (response[10] << 8)
+                            | (response[11] << 0));
+    }
+
+    return (0);
+}
+
+/**
+ * Read the features of the ramapp running in the PIC.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int read_ramapp_features(struct programmer_t *self_p)
+{
+    uint8_t request[PAYLOAD_OFFSET + CRC_SIZE + 2];
+    size_t size;
+    ssize_t res;
+
+    size = prepare_features_request(&request[0]);
+    res = ramapp_write(self_p, &request[0], size);
+
+    if (res != size) {
+        return (res);
+    }
+
+    return (read_features_response(self_p, NULL));
+}
+
+/**
+ * Check fast data transfers at the selected clock, with a ping echo
+ * if the ramapp has it. For a ramapp without echo only the CRCs of
+ * the features request and response are checked.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int check_ramapp_clock(struct programmer_t *self_p)
+{
+    int res;
+
+    res = read_ramapp_features(self_p);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    if (!(self_p->ramapp_features & RAMAPP_FEATURE_PING_ECHO)) {
+        return (0);
+    }
+
+    return (verify_clock(self_p));
+}
+
+/**
+ * Calculate the CRC-32 of given memory area in the PIC by reading it
+ * with the read command of the ramapp, for ramapps without the CRC-32
+ * command.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int ramapp_read_crc_32(struct programmer_t *self_p,
+                              uint32_t address,
+                              uint32_t size,
+                              uint32_t *crc_32_p)
+{
+    uint8_t request[PAYLOAD_OFFSET + 8 + CRC_SIZE + 2];
+    uint8_t response[PAYLOAD_OFFSET
+                     + PACKET_FAST_WRITE_DATA_SIZE
+                     + CRC_SIZE
+                     + 2];
+    uint32_t data;
+    uint32_t chunk_size;
+    uint32_t crc_32_value;
+    uint16_t crc;
+    ssize_t res;
+
+    crc_32_value = 0;
+
+    while (size > 0) {
+        chunk_size = MIN(size, PACKET_FAST_WRITE_DATA_SIZE);
+        request[0] = 0;
+        request[1] = RAMAPP_COMMAND_TYPE_READ;
+        request[2] = 0;
+        request[3] = 8;
+        request[4] = (address >> 24);
+        request[5] = (address >> 16);
+        request[6] = (address >> 8);
+        request[7] = (address >> 0);
+        request[8] = (chunk_size >> 24);
+        request[9] = (chunk_size >> 16);
+        request[10] = (chunk_size >> 8);
+        request[11] = (chunk_size >> 0);
+        crc = packet_crc(&request[0], 12);
+        request[12] = (crc >> 8);
+        request[13] = crc;
+        request[14] = 0;
+        request[15] = 0;
+
+        res = ramapp_write(self_p, &request[0], 14);
+
+        if (res != 14) {
+            return (res);
+        }
+
+        res = icsp_fast_data_read(self_p, &data);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        if ((data != ((RAMAPP_COMMAND_TYPE_READ << 16) | chunk_size))
+            && (data != 0xffff0004)) {
+            return (-EPROTO);
+        }
+
+        res = ramapp_read_rest(self_p, &response[0], data);
+
+        if (res < 0) {
+            return (res);
+        }
+
+        if (is_bad_crc_response(&response[0], res)) {
+            return (-EPROTO);
+        }
+
+        if (data == 0xffff0004) {
+            return ((response[4] << 24)
+                    | (response[5] << 16)
+                    | (response[6] << 8)
+                    | (response[7] << 0));
+        }
+
+        crc_32_value = crc_32(crc_32_value, &response[4], chunk_size);
+        address += chunk_size;
+        size -= chunk_size;
+    }
+
+    *crc_32_p = crc_32_value;
+
+    return (0);
+}
+
+/**
+ * Calculate the CRC-32 of given memory area in the PIC with the
+ * ramapp. The memory area is read instead if the ramapp does not have
+ * the CRC-32 command.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int ramapp_crc_32(struct programmer_t *self_p,
+                         uint32_t address,
+                         uint32_t size,
+                         uint32_t *crc_32_p)
+{
+    uint8_t request[PAYLOAD_OFFSET + 8 + CRC_SIZE + 2];
+    uint8_t response[PAYLOAD_OFFSET + 4 + CRC_SIZE + 2];
+    uint32_t data;
+    uint16_t crc;
+    ssize_t res;
+
+    if (!(self_p->ramapp_features & RAMAPP_FEATURE_CRC)) {
+        return (ramapp_read_crc_32(self_p, address, size, crc_32_p));
+    }
+
+    request[0] = 0;
+    request[1] = RAMAPP_COMMAND_TYPE_CRC;
+    request[2] = 0;
+    request[3] = 8;
+    request[4] = (address >> 24);
+    request[5] = (address >> 16);
+    request[6] = (address >> 8);
+    request[7] = (address >> 0);
+    request[8] = (size >> 24);
+    request[9] = (size >> 16);
+    request[10] = (size >> 8);
+    request[11] = (size >> 0);
+    crc = packet_crc(&request[0], 12);
+    request[12] = (crc >> 8);
+    request[13] = crc;
+    request[14] = 0;
+    request[15] = 0;
+
+    res = ramapp_write(self_p, &request[0], 14);
+
+    if (res != 14) {
+        return (res);
+    }
+
+    /* The ramapp does not provide the response until the CRC-32 is
+       calculated. */
+    res = fast_data_read_wait(self_p, &data);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    if (data != ((RAMAPP_COMMAND_TYPE_CRC << 16) | 4)) {
+        return (-EPROTO);
+    }
+
+    res = ramapp_read_rest(self_p, &response[0], data);
+
+    if (res < 0) {
+        return (res);
+    }
+
+    if (is_bad_crc_response(&response[0], res)) {
+        return (-EPROTO);
+    }
+
+    *crc_32_p = ((response[4] << 24)
+                 | (response[5] << 16)
+                 | (response[6] << 8)
+                 | (response[7] << 0));
+
+    return (0);
+}
+
+/**
+ * Check that the ramapp running in the PIC is the one in the
+ * programmer, by comparing the CRC-32 of its code and constants in
+ * RAM with the CRC-32 of the same part of the image in the
+ * programmer. Small data after the constants may have been written by
+ * the ramapp, and is not compared. The features of the ramapp are
+ * read as well.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int verify_ramapp(struct programmer_t *self_p)
+{
+    uint8_t request[PAYLOAD_OFFSET + CRC_SIZE + 2];
+    uint32_t constant_size;
+    uint32_t crc;
+    size_t size;
+    ssize_t res;
+
+    size = prepare_features_request(&request[0]);
+
+    /* The first word is only accepted if a ramapp is waiting for a
+       request. */
+    res = icsp_fast_data_write(self_p, (RAMAPP_COMMAND_TYPE_FEATURES << 16));
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = ramapp_write(self_p, &request[4], size - 4);
+
+    if (res != (size - 4)) {
+        return (res);
+    }
+
+    res = read_features_response(self_p, &constant_size);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    if (!(self_p->ramapp_features & RAMAPP_FEATURE_CRC)) {
+        return (-ENOSYS);
+    }
+
+    if ((constant_size > 4 * ramapp_image[0]) || ((constant_size % 4) != 0)) {
+        return (-EPROTO);
+    }
+
+    res = ramapp_crc_32(self_p, RAMAPP_ADDRESS, constant_size, &crc);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    if (crc != crc_32(0, &ramapp_image[1], constant_size)) {
+        return (-EPROTO);
+    }
+
+    return (0);
+}
+
+/**
+ * Find the extension module handling given ramapp command type.
+ *
+ * @return The module image, or NULL if the command is handled by the
+ *         ramapp itself.
+ */
+static const struct ramapp_ext_image_t *find_ext_image(int type)
+{
+    const struct ramapp_ext_image_t *ext_image_p;
+    int i;
+
+    for (ext_image_p = &ramapp_ext_images[0];
+         ext_image_p->image_p != NULL;
+         ext_image_p++) {
+        for (i = 0; i < RAMAPP_EXT_TYPES_MAX; i++) {
+            if ((ext_image_p->types[i] != 0)
+                && (ext_image_p->types[i] == type)) {
+                return (ext_image_p);
+            }
+        }
+    }
+
+    return (NULL);
+}
+
+/**
+ * Load the extension module handling given ramapp command type into
+ * the ramapp, unless already loaded. Only one module is loaded at a
+ * time.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int load_ext(struct programmer_t *self_p, int type)
+{
+    const struct ramapp_ext_image_t *ext_image_p;
+    const uint32_t *image_p;
+    uint8_t request[PAYLOAD_OFFSET + 8 + CRC_SIZE + 2];
+    uint8_t response[PAYLOAD_OFFSET + 4 + CRC_SIZE + 2];
+    uint32_t data;
+    ssize_t size;
+    ssize_t res;
+    uint16_t crc;
+
+    ext_image_p = find_ext_image(type);
+
+    if ((ext_image_p == NULL) || (ext_image_p == self_p->ext_image_p)) {
+        return (0);
+    }
+
+    /* A ramapp without the load command would take the image for
+       request packets. */
+    if (!(self_p->ramapp_features & RAMAPP_FEATURE_EXT_LOAD)) {
+        return (-ENOSYS);
+    }
+
+    image_p = ext_image_p->image_p;
+    size = (PAYLOAD_OFFSET + 8);
+    request[0] = 0;
+    request[1] = RAMAPP_COMMAND_TYPE_EXT_LOAD;
+    request[2] = 0;
+    request[3] = 8;
+    data = (4 * image_p[0]);
+    request[4] = (data >> 24);
+    request[5] = (data >> 16);
+    request[6] = (data >> 8);
+    request[7] = (data >> 0);
+    data = image_p[image_p[0] + 1];
+    request[8] = (data >> 24);
+    request[9] = (data >> 16);
+    request[10] = (data >> 8);
+    request[11] = (data >> 0);
+    crc = packet_crc(&request[0], size);
+    request[size] = (crc >> 8);
+    request[size + 1] = crc;
+    request[size + 2] = 0;
+    request[size + 3] = 0;
+    size += CRC_SIZE;
+
+    res = ramapp_write(self_p, &request[0], size);
+
+    if (res != size) {
+        return (res);
+    }
+
+    /* The image follows the request as is. */
+    res = fast_data_write_words(self_p, &image_p[1], image_p[0]);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    /* The ramapp does not respond until the CRC-32 of the image is
+       calculated. */
+    res = fast_data_read_wait(self_p, &data);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    /* Anything but a load or failure response may not fit in the
+       buffer. */
+    if ((data != (RAMAPP_COMMAND_TYPE_EXT_LOAD << 16))
+        && (data != 0xffff0004)) {
+        return (-EPROTO);
+    }
+
+    res = ramapp_read_rest(self_p, &response[0], data);
+
+    if (res < 0) {
+        return (res);
+    }
+
+    if (is_bad_crc_response(&response[0], res)) {
+        return (-EPROTO);
+    }
+
+    if (response[0] == 0xff) {
+        return ((response[4] << 24)
+                | (response[5] << 16)
+                | (response[6] << 8)
+                | (response[7] << 0));
+    }
+
+    self_p->ext_image_p = ext_image_p;
+
+    return (0);
+}
+
+/**
+ * Attach to a ramapp left running in the PIC by a previous session,
+ * for example before the programmer was reset. The PIC is not reset,
+ * and nothing is uploaded. Only single target transports that can
+ * start without resetting the PIC may attach.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int attach_ramapp(struct programmer_t *self_p, uint32_t frequency)
+{
+    int res;
+
+    if (is_multi_target(self_p)) {
+        return (-ENOSYS);
+    }
+
+    res = 0;
+
+    switch (self_p->transport) {
+
+    case PROGRAMMER_TRANSPORT_ICSP_SPI:
+        icsp_spi_init(&self_p->icsp_spi, &pin_mclrn_dev);
+        icsp_spi_attach(&self_p->icsp_spi);
+
+        /* Keep the default clock unless given, as calibration
+           requires a PIC reset. */
+        if (frequency != 0) {
+            res = select_clock(self_p, frequency);
+        }
+
+        break;
+
+    case PROGRAMMER_TRANSPORT_JTAG_SOFT:
+        /* Does not reset the PIC. */
+        icsp_start(self_p);
+        break;
+
+    default:
+        return (-ENOSYS);
+    }
+
+    if (res == 0) {
+        res = send_command(self_p, MTAP_SW_ETAP);
+    }
+
+    if (res == 0) {
+        res = send_command(self_p, ETAP_FASTDATA);
+    }
+
+    if (res == 0) {
+        res = verify_ramapp(self_p);
+    }
+
+    if (res != 0) {
+        icsp_stop(self_p);
+    }
+
+    return (res);
+}
+
+/**
+ * Reset the PIC and upload the ramapp.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int start_ramapp(struct programmer_t *self_p, uint32_t frequency)
+{
+    int res;
+
+    icsp_start(self_p);
+
+    res = select_clock(self_p, frequency);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = enter_serial_execution_mode(self_p);
+
+    if (res != 0) {
+        return (-EENTERSERIALEXECUTIONMODE);
+    }
+
+    res = upload_loader(self_p);
+
+    if (res != 0) {
+        return (-ERAMAPPUPLOAD);
+    }
+
+    res = send_command(self_p, ETAP_FASTDATA);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    res = upload_ramapp(self_p);
+
+    if (res != 0) {
+        return (-ERAMAPPUPLOAD);
+    }
+
+    if (self_p->transport == PROGRAMMER_TRANSPORT_ICSP_SPI) {
+        /* Verify fast data transfers at the selected clock. */
+        while ((res = check_ramapp_clock(self_p)) == -EPROTO) {
+            if (downclock(self_p) != 0) {
+                break;
+            }
+        }
+
+        if (res != 0) {
+            return (-ECLOCKCALIBRATION);
+        }
+    } else {
+        res = read_ramapp_features(self_p);
+
+        if (res != 0) {
+            return (-ERAMAPPUPLOAD);
+        }
+    }
+
+    return (0);
+}
+
+static ssize_t handle_connect(struct programmer_t *self_p,
+                              uint8_t *buf_p,
+                              size_t size)
+{
+    int res;
+    uint32_t frequency;
+
+    res = 0;
+
+    if (self_p->is_connected) {
+        return (-EISCONN);
+    }
+
+    /* Optional clock frequency after the transport. The JTAG
+       transport is followed by a scan chain instead. */
+    frequency = 0;
+
+    if ((size == (PAYLOAD_OFFSET + 5 + CRC_SIZE))
+        && (buf_p[4] != PROGRAMMER_TRANSPORT_JTAG_SOFT)) {
+        frequency = ((buf_p[5] << 24)
+                     | (buf_p[6] << 16)
+                     | (buf_p[7] << 8)
+                     | (buf_p[8] << 0));
+
+        if (frequency == 0) {
+            return (-EINVAL);
+        }
+
+        size -= 4;
+    }
+
+    res = select_transport(self_p,
+                           &buf_p[PAYLOAD_OFFSET],
+                           size - PAYLOAD_OFFSET - CRC_SIZE);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    /* Skip the upload if the same ramapp is already running. */
+    if (attach_ramapp(self_p, frequency) != 0) {
+        res = start_ramapp(self_p, frequency);
+
+        if (res != 0) {
+            return (res);
+        }
+    }
+
+    if (self_p->transport == PROGRAMMER_TRANSPORT_ICSP_SPI) {
+        /* Respond with the clock frequency. */
+        frequency = icsp_spi_get_clock_frequency(&self_p->icsp_spi);
+        buf_p[4] = (frequency >> 24);
+        buf_p[5] = (frequency >> 16);
+        buf_p[6] = (frequency >> 8);
+        buf_p[7] = (frequency >> 0);
+        res = 4;
+    } else if (is_multi_target(self_p)) {
+        /* Respond with the connected targets. */
+        buf_p[4] = get_alive_targets(self_p);
+        res = 1;
+    }
+
+    /* Extension modules left in an attached ramapp are loaded
+       again. */
+    self_p->ext_image_p = NULL;
+    self_p->is_connected = 1;
+
+    return (res);
+}
+
+static ssize_t handle_disconnect(struct programmer_t *self_p,
+                                 uint8_t *buf_p,
+                                 size_t size)
+{
+    if (!self_p->is_connected) {
+        return (-ENOTCONN);
+    }
+
+    icsp_stop(self_p);
+
+    self_p->is_connected = 0;
+
+    return (0);
+}
+
+static ssize_t handle_reset(struct programmer_t *self_p,
+                            uint8_t *buf_p,
+                            size_t size)
+{
+    struct pin_driver_t mclrn;
+
+    if (self_p->is_connected) {
+        return (-EISCONN);
+    }
+
+    pin_init(&mclrn, &pin_mclrn_dev, PIN_OUTPUT);
+    pin_write(&mclrn, 0);
+    time_busy_wait_us(2);
+    pin_set_mode(&mclrn, PIN_INPUT);
+    thrd_sleep_ms(20);
+
+    return (0);
+}
+
+static ssize_t handle_device_status(struct programmer_t *self_p,
+                                    uint8_t *buf_p,
+                                    size_t size)
+{
+    int status;
+
+    if (self_p->is_connected) {
+        return (-EISCONN);
+    }
+
+    status = select_transport(self_p,
+                              &buf_p[PAYLOAD_OFFSET],
+                              size - PAYLOAD_OFFSET - CRC_SIZE);
+
+    if (status != 0) {
+        return (status);
+    }
+
+    icsp_start(self_p);
+
+    status = read_device_status(self_p);
+
+    icsp_stop(self_p);
+
+    buf_p[4] = bits_reverse_8(status);
+    status = 1;
+
+    /* Followed by the targets with the majority status. */
+    if (is_multi_target(self_p)) {
+        buf_p[5] = get_alive_targets(self_p);
+        status = 2;
+    }
+
+    return (status);
+}
+
+static ssize_t handle_chip_erase(struct programmer_t *self_p,
+                                 uint8_t *buf_p,
+                                 size_t size)
+{
+    int res;
+
+    if (self_p->is_connected) {
+        return (-EISCONN);
+    }
+
+    res = select_transport(self_p,
+                           &buf_p[PAYLOAD_OFFSET],
+                           size - PAYLOAD_OFFSET - CRC_SIZE);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    icsp_start(self_p);
+
+    res = chip_erase(self_p);
+
+    icsp_stop(self_p);
+
+    /* Respond with the erased targets. */
+    if ((res == 0) && is_multi_target(self_p)) {
+        buf_p[4] = get_alive_targets(self_p);
+        res = 1;
+    }
+
+    return (res);
+}
+
+static ssize_t handle_read_words(struct programmer_t *self_p,
+                                 uint8_t *buf_p,
+                                 size_t size)
+{
+    int res;
+    uint32_t address;
+    int number_of_words;
+    uint8_t *payload_p;
+
+    if (self_p->is_connected) {
+        return (-EISCONN);
+    }
+
+    /* Address and number of words after the optional transport. */
+    if (size < (PAYLOAD_OFFSET + 5 + CRC_SIZE)) {
+        return (-EMSGSIZE);
+    }
+
+    size -= 5;
+    payload_p = &buf_p[size - CRC_SIZE];
+    address = ((payload_p[0] << 24)
+               | (payload_p[1] << 16)
+               | (payload_p[2] << 8)
+               | (payload_p[3] << 0));
+    number_of_words = payload_p[4];
+
+    if ((number_of_words == 0) || (number_of_words > READ_WORDS_MAX)) {
+        return (-EINVAL);
+    }
+
+    res = select_transport(self_p,
+                           &buf_p[PAYLOAD_OFFSET],
+                           size - PAYLOAD_OFFSET - CRC_SIZE);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    icsp_start(self_p);
+
+    res = enter_serial_execution_mode(self_p);
+
+    if (res == 0) {
+        res = read_words(self_p, address, &buf_p[4], number_of_words);
+    } else {
+        res = -EENTERSERIALEXECUTIONMODE;
+    }
+
+    icsp_stop(self_p);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    return (4 * number_of_words);
+}
+
+static ssize_t handle_version(uint8_t *buf_p, size_t size)
+{
+    strcpy((char *)&buf_p[4], VERSION_STR);
+
+    return (strlen((char *)&buf_p[4]));
+}
+
+/**
+ * A slice is queued in the receive buffer of the link while the
+ * previous slice is written, so it may not be bigger than the fast
+ * write window of the link.
+ *
+ * @return Staging buffer slice size in bytes, zero(0) if staging is
+ *         not available.
+ */
+static size_t staging_slice_size(struct programmer_t *self_p)
+{
+    return (MIN(CONFIG_PROGRAMMER_STAGING_SLICE_SIZE,
+                self_p->link_p->window * PACKET_FAST_WRITE_DATA_SIZE));
+}
+
+static ssize_t handle_capabilities(struct programmer_t *self_p,
+                                   uint8_t *buf_p,
+                                   size_t size)
+{
+    uint32_t commands;
+    uint32_t features;
+    uint32_t maximum_response_size;
+    uint32_t slice_size;
+
+    commands = CAPABILITY_READ_WORDS;
+
+    if (is_multi_target(self_p)) {
+        commands |= CAPABILITY_TARGETS_STATUS;
+    }
+
+    if (CONFIG_PROGRAMMER_STAGING_SLICE_SIZE > 0) {
+        commands |= CAPABILITY_STAGING;
+    }
+
+    if (CONFIG_PROGRAMMER_PRODUCTION == 1) {
+        commands |= CAPABILITY_PRODUCTION;
+    }
+
+    commands |= CAPABILITY_JOB;
+
+    if (CONFIG_PROGRAMMER_TRACE_ENTRIES > 0) {
+        commands |= CAPABILITY_TRACE;
+    }
+
+    if (self_p->is_connected) {
+        features = self_p->ramapp_features;
+    } else {
+        features = 0;
+    }
+
+    if ((features & RAMAPP_FEATURE_EXT_LOAD)
+        && (find_ext_image(RAMAPP_COMMAND_TYPE_BLANK_CHECK) != NULL)) {
+        commands |= CAPABILITY_BLANK_CHECK;
+    }
+
+    if (features & RAMAPP_FEATURE_FAST_WRITE_ROW_CRC) {
+        commands |= CAPABILITY_ROW_ERRORS;
+    }
+
+    if (features & RAMAPP_FEATURE_FAST_READ) {
+        commands |= CAPABILITY_FAST_READ;
+    }
+
+    if (features & RAMAPP_FEATURE_EXTENDED_READ) {
+        maximum_response_size = MAXIMUM_EXTENDED_PAYLOAD_SIZE;
+    } else {
+        maximum_response_size = MAXIMUM_PAYLOAD_SIZE;
+    }
+
+    buf_p[4] = PROTOCOL_VERSION;
+    buf_p[5] = (MAXIMUM_PAYLOAD_SIZE >> 8);
+    buf_p[6] = (MAXIMUM_PAYLOAD_SIZE & 0xff);
+    buf_p[7] = (maximum_response_size >> 24);
+    buf_p[8] = (maximum_response_size >> 16);
+    buf_p[9] = (maximum_response_size >> 8);
+    buf_p[10] = maximum_response_size;
+    buf_p[11] = (PACKET_FAST_WRITE_DATA_SIZE >> 8);
+    buf_p[12] = (PACKET_FAST_WRITE_DATA_SIZE & 0xff);
+    buf_p[13] = (self_p->link_p->window >> 8);
+    buf_p[14] = self_p->link_p->window;
+    buf_p[15] = (commands >> 24);
+    buf_p[16] = (commands >> 16);
+    buf_p[17] = (commands >> 8);
+    buf_p[18] = commands;
+    slice_size = staging_slice_size(self_p);
+    buf_p[19] = (slice_size >> 24);
+    buf_p[20] = (slice_size >> 16);
+    buf_p[21] = (slice_size >> 8);
+    buf_p[22] = slice_size;
+
+    return (19);
+}
+
+static ssize_t handle_targets_status(struct programmer_t *self_p,
+                                  uint8_t *buf_p,
+                                  size_t size)
+{
+    if (!self_p->is_connected) {
+        return (-ENOTCONN);
+    }
+
+    if (!is_multi_target(self_p)) {
+        return (-ENOSYS);
+    }
+
+    buf_p[4] = self_p->targets;
+    buf_p[5] = get_alive_targets(self_p);
+
+    return (2);
+}
+
+/**
+ * Grant the host given number of fast write data packets.
+ */
+static void credits_write(struct programmer_t *self_p, int credits)
+{
+    uint8_t buf[4];
+
+    if (credits == 0) {
+        return;
+    }
+
+    buf[0] = (COMMAND_TYPE_FAST_WRITE_CREDITS >> 8);
+    buf[1] = COMMAND_TYPE_FAST_WRITE_CREDITS;
+    buf[2] = (credits >> 8);
+    buf[3] = credits;
+    chan_write(self_p->link_p->chout_p, &buf[0], sizeof(buf));
+    pipeline.rx_ungranted -= credits;
+    pipeline.rx_outstanding += credits;
+}
+
+/**
+ * Grant the host a window of fast write data packets. The first data
+ * packet is sent along with the request, without a credit.
+ */
+static void credits_start(struct programmer_t *self_p, int number_of_packets)
+{
+    int window;
+
+    window = MIN(self_p->link_p->window, number_of_packets);
+    pipeline.rx_outstanding = 1;
+    pipeline.rx_ungranted = (number_of_packets - 1);
+    pipeline.rx_credits = 0;
+    pipeline.rx_batch = MAX(window / 2, 1);
+    credits_write(self_p, window - 1);
+}
+
+/**
+ * A fast write data packet has been received. Credits are returned
+ * in batches of half the window, or when the remaining packets are
+ * granted.
+ */
+static void credits_received(struct programmer_t *self_p)
+{
+    pipeline.rx_outstanding--;
+
+    if (pipeline.rx_ungranted == 0) {
+        return;
+    }
+
+    pipeline.rx_credits++;
+
+    if ((pipeline.rx_credits == pipeline.rx_batch)
+        || (pipeline.rx_credits == pipeline.rx_ungranted)) {
+        credits_write(self_p, pipeline.rx_credits);
+        pipeline.rx_credits = 0;
+    }
+}
+
+/**
+ * Discard data packets already granted to the host after a fast write
+ * error, so they are not read as requests.
+ */
+static void credits_drain(struct programmer_t *self_p)
+{
+    struct time_t timeout;
+    ssize_t res;
+
+    while (pipeline.rx_outstanding > 0) {
+        timeout.seconds = 0;
+        timeout.nanoseconds = CTRL_TIMEOUT_NS;
+        res = chan_read_with_timeout(self_p->link_p->data_chin_p,
+                                     &pipeline.rx_buf[0][0],
+                                     PACKET_FAST_WRITE_DATA_SIZE,
+                                     &timeout);
+
+        if (res != PACKET_FAST_WRITE_DATA_SIZE) {
+            break;
+        }
+
+        pipeline.rx_outstanding--;
+    }
+
+    pipeline.rx_outstanding = 0;
+}
+
+#if CONFIG_PROGRAMMER_PIPELINE == 1
+
+/**
+ * Wait for a free receive buffer, or until aborted.
+ *
+ * @return true(1) if aborted, otherwise false(0).
+ */
+static int reader_wait_free(void)
+{
+    while (packet_ring_write_begin(&pipeline.rx) == NULL) {
+        if (pipeline.rx_abort) {
+            return (1);
+        }
+
+        sem_take(&pipeline.rx_free, NULL);
+    }
+
+    return (pipeline.rx_abort);
+}
+
+/**
+ * Receive fast write data packets from the host into the receive
+ * ring, while previous packets are written to the PIC. Credits are
+ * returned to the host as packets are moved from the data channel to
+ * the ring, so the data channel never overflows.
+ */
+static void *reader_main(void *arg_p)
+{
+    struct programmer_t *self_p;
+    struct time_t timeout;
+    uint8_t *buf_p;
+    ssize_t res;
+    int left;
+
+    self_p = arg_p;
+
+    while (1) {
+        sem_take(&pipeline.rx_start, NULL);
+        left = pipeline.rx_number_of_packets;
+        credits_start(self_p, left);
+
+        while (left > 0) {
+            if (reader_wait_free()) {
+                credits_drain(self_p);
+                break;
+            }
+
+            buf_p = packet_ring_write_begin(&pipeline.rx);
+            timeout.seconds = 0;
+            timeout.nanoseconds = CTRL_TIMEOUT_NS;
+            res = chan_read_with_timeout(self_p->link_p->data_chin_p,
+                                         buf_p,
+                                         PACKET_FAST_WRITE_DATA_SIZE,
+                                         &timeout);
+            packet_ring_write_end(&pipeline.rx, res);
+            sem_give(&pipeline.rx_ready, 1);
+            left--;
+
+            if (res != PACKET_FAST_WRITE_DATA_SIZE) {
+                pipeline.rx_outstanding = 0;
+                break;
+            }
+
+            credits_received(self_p);
+        }
+
+        sem_give(&pipeline.rx_done, 1);
+    }
+
+    return (NULL);
+}
+
+/**
+ * Send responses in the transmit ring to the host.
+ */
+static void *writer_main(void *arg_p)
+{
+    struct programmer_t *self_p;
+    uint8_t *buf_p;
+    ssize_t size;
+
+    self_p = arg_p;
+
+    while (1) {
+        buf_p = packet_ring_read_begin(&pipeline.tx, &size);
+
+        if (buf_p == NULL) {
+            sem_take(&pipeline.tx_ready, NULL);
+        } else {
+            chan_write(self_p->link_p->chout_p, buf_p, size);
+            packet_ring_read_end(&pipeline.tx);
+            sem_give(&pipeline.tx_free, 1);
+        }
+    }
+
+    return (NULL);
+}
+
+/**
+ * Wait until all responses have been sent to the host.
+ */
+static void tx_flush(void)
+{
+    while (packet_ring_used(&pipeline.tx) > 0) {
+        sem_take(&pipeline.tx_free, NULL);
+    }
+}
+
+static void pipeline_start(struct programmer_t *self_p)
+{
+    sem_init(&pipeline.rx_start, 0, 1);
+    sem_init(&pipeline.rx_ready, 0, RX_PACKETS);
+    sem_init(&pipeline.rx_free, 0, RX_PACKETS);
+    sem_init(&pipeline.rx_done, 0, 1);
+    sem_init(&pipeline.tx_ready, 0, TX_PACKETS);
+    sem_init(&pipeline.tx_free, 0, TX_PACKETS);
+    thrd_spawn(reader_main,
+               self_p,
+               -1,
+               reader_stack,
+               sizeof(reader_stack));
+    thrd_spawn(writer_main,
+               self_p,
+               -1,
+               writer_stack,
+               sizeof(writer_stack));
+}
+
+/**
+ * Start receiving given number of fast write data packets.
+ */
+static void rx_start(struct programmer_t *self_p, int number_of_packets)
+{
+    /* Credits are written by the reader. */
+    tx_flush();
+    pipeline.rx_number_of_packets = number_of_packets;
+    pipeline.rx_abort = 0;
+    sem_give(&pipeline.rx_start, 1);
+}
+
+/**
+ * Get the next received fast write data packet.
+ *
+ * @return Packet size or negative error code.
+ */
+static ssize_t rx_get(struct programmer_t *self_p, uint8_t **buf_pp)
+{
+    int phase;
+    ssize_t size;
+
+    phase = stats_begin(STATS_PHASE_RECEIVE);
+
+    while ((*buf_pp = packet_ring_read_begin(&pipeline.rx, &size)) == NULL) {
+        sem_take(&pipeline.rx_ready, NULL);
+    }
+
+    stats_end(phase, MAX(size, 0));
+
+    return (size);
+}
+
+/**
+ * Release the fast write data packet returned by rx_get().
+ */
+static void rx_put(struct programmer_t *self_p)
+{
+    packet_ring_read_end(&pipeline.rx);
+    sem_give(&pipeline.rx_free, 1);
+}
+
+/**
+ * Wait for the reader to finish, optionally after stopping it early.
+ */
+static void rx_stop(struct programmer_t *self_p, int abort)
+{
+    if (abort) {
+        pipeline.rx_abort = 1;
+        sem_give(&pipeline.rx_free, 1);
+    }
+
+    sem_take(&pipeline.rx_done, NULL);
+    packet_ring_init(&pipeline.rx,
+                     &pipeline.rx_buf[0][0],
+                     &pipeline.rx_sizes[0],
+                     PACKET_FAST_WRITE_DATA_SIZE,
+                     RX_PACKETS);
+}
+
+/**
+ * Get a buffer for the next request and its response.
+ */
+static uint8_t *tx_begin(void)
+{
+    uint8_t *buf_p;
+
+    while ((buf_p = packet_ring_write_begin(&pipeline.tx)) == NULL) {
+        sem_take(&pipeline.tx_free, NULL);
+    }
+
+    return (buf_p);
+}
+
+/**
+ * Queue given response for the writer.
+ */
+static int tx_end(struct programmer_t *self_p, uint8_t *buf_p, ssize_t size)
+{
+    packet_ring_write_end(&pipeline.tx, size);
+    sem_give(&pipeline.tx_ready, 1);
+
+    return (0);
+}
+
+#else
+
+static void pipeline_start(struct programmer_t *self_p)
+{
+}
+
+static void rx_start(struct programmer_t *self_p, int number_of_packets)
+{
+    credits_start(self_p, number_of_packets);
+}
+
+static ssize_t rx_get(struct programmer_t *self_p, uint8_t **buf_pp)
+{
+    struct time_t timeout;
+    int phase;
+    ssize_t res;
+
+    timeout.seconds = 0;
+    timeout.nanoseconds = CTRL_TIMEOUT_NS;
+    *buf_pp = &pipeline.rx_buf[0][0];
+    phase = stats_begin(STATS_PHASE_RECEIVE);
+    res = chan_read_with_timeout(self_p->link_p->data_chin_p,
+                                 *buf_pp,
+                                 PACKET_FAST_WRITE_DATA_SIZE,
+                                 &timeout);
+    stats_end(phase, MAX(res, 0));
+
+    if (res == PACKET_FAST_WRITE_DATA_SIZE) {
+        credits_received(self_p);
+    } else {
+        pipeline.rx_outstanding = 0;
+    }
+
+    return (res);
+}
+
+static void rx_put(struct programmer_t *self_p)
+{
+}
+
+static void rx_stop(struct programmer_t *self_p, int abort)
+{
+    if (abort) {
+        credits_drain(self_p);
+    }
+}
+
+static void tx_flush(void)
+{
+}
+
+static uint8_t *tx_begin(void)
+{
+    return (&pipeline.tx_buf[0][0]);
+}
+
+static int tx_end(struct programmer_t *self_p, uint8_t *buf_p, ssize_t size)
+{
+    chan_write(self_p->link_p->chout_p, buf_p, size);
+
+    return (0);
+}
+
+#endif
+
+/**
+ * Forward a response with an extended size field from the ramapp to
+ * the host in parts, as it does not fit in the packet buffer. The
+ * host is sent the parts while the next part is read from the PIC.
+ * Once the first part is sent the response cannot be replaced by a
+ * failure on error, and the host times out instead.
+ *
+ * @return zero(0), or negative error code if no part was sent.
+ */
+static ssize_t forward_extended_response(struct programmer_t *self_p,
+                                         uint8_t *buf_p,
+                                         uint32_t data)
+{
+    uint32_t words[FAST_DATA_BURST_WORDS_MAX];
+    size_t size;
+    size_t left;
+    size_t number_of_words;
+    size_t offset;
+    size_t i;
+    int res;
+    int is_sent;
+
+    res = icsp_fast_data_read(self_p, &words[0]);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    size = words[0];
+
+    if (size > MAXIMUM_EXTENDED_PAYLOAD_SIZE) {
+        return (-EPROTO);
+    }
+
+    buf_p[0] = (data >> 24);
+    buf_p[1] = (data >> 16);
+    buf_p[2] = (data >> 8);
+    buf_p[3] = (data >> 0);
+    buf_p[4] = (size >> 24);
+    buf_p[5] = (size >> 16);
+    buf_p[6] = (size >> 8);
+    buf_p[7] = (size >> 0);
+    offset = (PAYLOAD_OFFSET + EXTENDED_SIZE_SIZE);
+    size += CRC_SIZE;
+    left = DIV_CEIL(size, 4);
+    is_sent = 0;
+
+    while (left > 0) {
+        number_of_words = MIN(left, membersof(words));
+        res = fast_data_read_words(self_p, &words[0], number_of_words);
+
+        if (res != 0) {
+            return (is_sent ? 0 : res);
+        }
+
+        for (i = 0; i < number_of_words; i++) {
+            buf_p[offset + 4 * i + 0] = (words[i] >> 24);
+            buf_p[offset + 4 * i + 1] = (words[i] >> 16);
+            buf_p[offset + 4 * i + 2] = (words[i] >> 8);
+            buf_p[offset + 4 * i + 3] = (words[i] >> 0);
+        }
+
+        offset += (4 * number_of_words);
+        left -= number_of_words;
+
+        if ((left == 0) || ((offset + sizeof(words)) > TX_PACKET_SIZE)) {
+            /* Without padding after the crc. */
+            if (left == 0) {
+                offset -= (4 * DIV_CEIL(size, 4) - size);
+            }
+
+            tx_end(self_p, buf_p, offset);
+            buf_p = tx_begin();
+            offset = 0;
+            is_sent = 1;
+        }
+    }
+
+    return (0);
+}
+
+/**
+ * Returns true(1) if given ramapp command is a read with an extended
+ * size response.
+ */
+static int is_extended_read(const uint8_t *buf_p, size_t size)
+{
+    uint32_t read_size;
+
+    if ((buf_p[0] != 0)
+        || (buf_p[1] != RAMAPP_COMMAND_TYPE_READ)
+        || (size != (PAYLOAD_OFFSET + 8 + CRC_SIZE))) {
+        return (0);
+    }
+
+    read_size = ((buf_p[8] << 24)
+                 | (buf_p[9] << 16)
+                 | (buf_p[10] << 8)
+                 | (buf_p[11] << 0));
+
+    return (read_size > MAXIMUM_PAYLOAD_SIZE);
+}
+
+static ssize_t handle_ramapp_command(struct programmer_t *self_p,
+                                     uint8_t *buf_p,
+                                     size_t size)
+{
+    ssize_t res;
+    uint32_t data;
+
+    res = -ENOTCONN;
+
+    if (self_p->is_connected) {
+        res = load_ext(self_p, (int16_t)((buf_p[0] << 8) | buf_p[1]));
+
+        if (res != 0) {
+            return (res);
+        }
+
+        /* Bigger reads do not fit in the packet buffer of a ramapp
+           without extended read responses. */
+        if (is_extended_read(buf_p, size)
+            && !(self_p->ramapp_features & RAMAPP_FEATURE_EXTENDED_READ)) {
+            return (-EMSGSIZE);
+        }
+
+        res = ramapp_write(self_p, buf_p, size);
+
+        if (res != size) {
+            return (res);
+        }
+
+        /* Read type and size. */
+        res = icsp_fast_data_read(self_p, &data);
+
+        if (res != 0) {
+            return (res);
+        }
+
+        if ((data & 0xffff) == SIZE_EXTENDED) {
+            return (forward_extended_response(self_p, buf_p, data));
+        }
+
+        res = ramapp_read_rest(self_p, buf_p, data);
+
+        /* Downclock on bit errors. The response is forwarded as is,
+           and the host may retry the command. */
+        if ((res > 0)
+            && (self_p->transport == PROGRAMMER_TRANSPORT_ICSP_SPI)
+            && is_bad_crc_response(buf_p, res)) {
+            downclock(self_p);
+        }
+    }
+
+    return (res);
+}
+
+static ssize_t prepare_command_response(uint8_t *buf_p,
+                                        ssize_t size)
+{
+    uint16_t crc;
+
+    /* Failure. */
+    if (size < 0) {
+        buf_p[0] = (COMMAND_TYPE_FAILED >> 8);
+        buf_p[1] = COMMAND_TYPE_FAILED;
+        buf_p[4] = (size >> 24);
+        buf_p[5] = (size >> 16);
+        buf_p[6] = (size >> 8);
+        buf_p[7] = (size >> 0);
+        size = 4;
+    }
+
+    buf_p[2] = (size >> 8);
+    buf_p[3] = size;
+
+    size += PAYLOAD_OFFSET;
+
+    crc = packet_crc(buf_p, size);
+
+    buf_p[size] = (crc >> 8);
+    buf_p[size + 1] = crc;
+    size += CRC_SIZE;
+
+    return (size);
+}
+
+/**
+ * Prepare a failure response with an index after the error code, of
+ * for example the failed data packet of a fast write, or the failed
+ * step of a job.
+ */
+static ssize_t prepare_failure_with_index(uint8_t *buf_p,
+                                          int error,
+                                          int index)
+{
+    uint16_t crc;
+
+    buf_p[0] = (COMMAND_TYPE_FAILED >> 8);
+    buf_p[1] = COMMAND_TYPE_FAILED;
+    buf_p[2] = 0;
+    buf_p[3] = 8;
+    buf_p[4] = (error >> 24);
+    buf_p[5] = (error >> 16);
+    buf_p[6] = (error >> 8);
+    buf_p[7] = (error >> 0);
+    buf_p[8] = (index >> 24);
+    buf_p[9] = (index >> 16);
+    buf_p[10] = (index >> 8);
+    buf_p[11] = (index >> 0);
+    crc = packet_crc(buf_p, 12);
+    buf_p[12] = (crc >> 8);
+    buf_p[13] = crc;
+
+    return (14);
+}
+
+/**
+ * Read a memory area with a single request. The ramapp writes the
+ * data in data packets, each with a CRC of its own, followed by the
+ * response. The packets are forwarded to the host as they are, while
+ * the next packet is read from the PIC. A failure is sent in place of
+ * the next packet, so the host is not left waiting.
+ *
+ * @return zero(0), as the response is sent, or negative error code.
+ */
+static ssize_t handle_fast_read(struct programmer_t *self_p,
+                                uint8_t *buf_p,
+                                size_t size)
+{
+    ssize_t res;
+    int is_downclocked;
+
+    if (!self_p->is_connected) {
+        return (-ENOTCONN);
+    }
+
+    if (size != PACKET_FAST_READ_REQUEST_SIZE) {
+        return (-EMSGSIZE);
+    }
+
+    /* The host reads with the read command instead. */
+    if (!(self_p->ramapp_features & RAMAPP_FEATURE_FAST_READ)) {
+        return (-ENOSYS);
+    }
+
+    /* Forward the request to the PIC. */
+    res = ramapp_write(self_p, buf_p, PACKET_FAST_READ_REQUEST_SIZE);
+
+    if (res != PACKET_FAST_READ_REQUEST_SIZE) {
+        return (res);
+    }
+
+    is_downclocked = 0;
+
+    while (1) {
+        res = ramapp_read(self_p, buf_p);
+
+        if (res < 0) {
+            res = prepare_command_response(buf_p, res);
+            break;
+        }
+
+        /* Downclock once on bit errors. The packets are forwarded as
+           is, and the host may retry the read. */
+        if (!is_downclocked
+            && (self_p->transport == PROGRAMMER_TRANSPORT_ICSP_SPI)
+            && is_bad_crc_response(buf_p, res)) {
+            downclock(self_p);
+            is_downclocked = 1;
+        }
+
+        if ((buf_p[0] != 0) || (buf_p[1] != COMMAND_TYPE_FAST_READ_DATA)) {
+            break;
+        }
+
+        tx_end(self_p, buf_p, res);
+        buf_p = tx_begin();
+    }
+
+    tx_end(self_p, buf_p, res);
+
+    return (0);
+}
+
+/**
+ * Write a fast write request to the ramapp. Given number of bytes
+ * are written to the ramapp in rows after the request.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int ramapp_fast_write_start(struct programmer_t *self_p,
+                                   uint32_t address,
+                                   uint32_t size,
+                                   uint16_t data_crc)
+{
+    uint8_t request[PACKET_FAST_WRITE_REQUEST_SIZE];
+    uint16_t crc;
+    ssize_t res;
+
+    request[0] = (COMMAND_TYPE_FAST_WRITE >> 8);
+    request[1] = COMMAND_TYPE_FAST_WRITE;
+    request[2] = 0;
+    request[3] = 10;
+    request[4] = (address >> 24);
+    request[5] = (address >> 16);
+    request[6] = (address >> 8);
+    request[7] = (address >> 0);
+    request[8] = (size >> 24);
+    request[9] = (size >> 16);
+    request[10] = (size >> 8);
+    request[11] = (size >> 0);
+    request[12] = (data_crc >> 8);
+    request[13] = data_crc;
+    crc = packet_crc(&request[0], 14);
+    request[14] = (crc >> 8);
+    request[15] = crc;
+
+    res = ramapp_write(self_p, &request[0], sizeof(request));
+
+    if (res != sizeof(request)) {
+        return (res);
+    }
+
+    return (0);
+}
+
+/**
+ * Write given row to the ramapp, followed by a word with the CRC of
+ * all rows written so far if the ramapp checks each row. The ramapp
+ * does not write a row not matching its CRC, but reports it as
+ * failed.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int ramapp_fast_write_row(struct programmer_t *self_p,
+                                 uint8_t *buf_p,
+                                 uint16_t *crc_p)
+{
+    uint32_t word;
+    ssize_t res;
+    int phase;
+
+    res = ramapp_write(self_p, buf_p, PACKET_FAST_WRITE_DATA_SIZE);
+
+    if (res != PACKET_FAST_WRITE_DATA_SIZE) {
+        return (res);
+    }
+
+    if (!(self_p->ramapp_features & RAMAPP_FEATURE_FAST_WRITE_ROW_CRC)) {
+        return (0);
+    }
+
+    phase = stats_begin(STATS_PHASE_CRC);
+    *crc_p = packet_crc_ccitt(*crc_p, buf_p, PACKET_FAST_WRITE_DATA_SIZE);
+    stats_end(phase, PACKET_FAST_WRITE_DATA_SIZE);
+    word = *crc_p;
+
+    return (fast_data_write_words(self_p, &word, 1));
+}
+
+/**
+ * Read the fast write response from the ramapp, once all rows are
+ * written. The addresses of failed rows are copied to given buffer,
+ * if not NULL.
+ *
+ * @return Number of failed rows or negative error code.
+ */
+static int ramapp_fast_write_finish_rows(struct programmer_t *self_p,
+                                         uint8_t *rows_p)
+{
+    uint8_t response[PAYLOAD_OFFSET
+                     + 4 * FAST_WRITE_FAILED_ROWS_MAX
+                     + CRC_SIZE
+                     + 2];
+    uint32_t data;
+    size_t size;
+    ssize_t res;
+
+    res = icsp_fast_data_read(self_p, &data);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    /* Anything but a fast write or failure response may not fit in
+       the buffer. */
+    if ((data & 0xffff) > 4 * FAST_WRITE_FAILED_ROWS_MAX) {
+        return (-EPROTO);
+    }
+
+    res = ramapp_read_rest(self_p, &response[0], data);
+
+    if (res < 0) {
+        return (res);
+    }
+
+    /* Downclock on bit errors, as for other ramapp commands. */
+    if (is_bad_crc_response(&response[0], res)) {
+        if (self_p->transport == PROGRAMMER_TRANSPORT_ICSP_SPI) {
+            downclock(self_p);
+        }
+
+        return (-EPROTO);
+    }
+
+    if (response[0] == 0xff) {
+        return ((response[4] << 24)
+                | (response[5] << 16)
+                | (response[6] << 8)
+                | (response[7] << 0));
+    }
+
+    size = ((response[2] << 8) | response[3]);
+
+    if (rows_p != NULL) {
+        memcpy(rows_p, &response[PAYLOAD_OFFSET], size);
+    }
+
+    return (size / 4);
+}
+
+/**
+ * Read the fast write response from the ramapp, once all rows are
+ * written. Failed rows fail the write.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int ramapp_fast_write_finish(struct programmer_t *self_p)
+{
+    int res;
+
+    res = ramapp_fast_write_finish_rows(self_p, NULL);
+
+    if (res > 0) {
+        res = -EFLASHWRITE;
+    }
+
+    return (res);
+}
+
+/**
+ * Prepare the response of a fast write, or a staged write, of rows
+ * at given address, with the addresses of given number of failed
+ * rows in the payload. Unless the host asked for failed rows to be
+ * reported, a failed row fails the command with its index.
+ *
+ * @return Response size or negative error code.
+ */
+static ssize_t prepare_fast_write_response(uint8_t *buf_p,
+                                           int number_of_failed_rows,
+                                           uint32_t address,
+                                           int flags)
+{
+    uint32_t row_address;
+
+    if (number_of_failed_rows < 0) {
+        return (number_of_failed_rows);
+    }
+
+    if ((number_of_failed_rows == 0)
+        || (flags & FAST_WRITE_FLAG_REPORT_FAILED_ROWS)) {
+        return (prepare_command_response(buf_p, 4 * number_of_failed_rows));
+    }
+
+    row_address = ((buf_p[4] << 24)
+                   | (buf_p[5] << 16)
+                   | (buf_p[6] << 8)
+                   | (buf_p[7] << 0));
+
+    return (prepare_failure_with_index(
+                buf_p,
+                -EFLASHWRITE,
+                (row_address - address) / PACKET_FAST_WRITE_DATA_SIZE));
+}
+
+static ssize_t handle_fast_write(struct programmer_t *self_p,
+                                 uint8_t *buf_p,
+                                 size_t size)
+{
+    uint8_t *data_p;
+    uint32_t address;
+    uint16_t crc;
+    int flags;
+    int res;
+    int row;
+
+    if (!self_p->is_connected) {
+        return (-ENOTCONN);
+    }
+
+    if (size == PACKET_FAST_WRITE_REQUEST_SIZE + 1) {
+        flags = buf_p[14];
+    } else if (size == PACKET_FAST_WRITE_REQUEST_SIZE) {
+        flags = 0;
+    } else {
+        return (-EMSGSIZE);
+    }
+
+    address = ((buf_p[4] << 24)
+               | (buf_p[5] << 16)
+               | (buf_p[6] << 8)
+               | (buf_p[7] << 0));
+    size = ((buf_p[8] << 24)
+            | (buf_p[9] << 16)
+            | (buf_p[10] << 8)
+            | (buf_p[11] << 0));
+
+    if ((size % PACKET_FAST_WRITE_DATA_SIZE) != 0) {
+        return (-EINVAL);
+    }
+
+    if (size == 0) {
+        return (-EINVAL);
+    }
+
+    res = ramapp_fast_write_start(self_p,
+                                  address,
+                                  size,
+                                  ((buf_p[12] << 8) | buf_p[13]));
+
+    if (res != 0) {
+        return (res);
+    }
+
+    /* Perform data transfer. Data packets are received while
+       previous packets are written to the PIC. */
+    rx_start(self_p, size / PACKET_FAST_WRITE_DATA_SIZE);
+    row = 0;
+    crc = 0xffff;
+
+    while (size > 0) {
+        res = rx_get(self_p, &data_p);
+
+        if (res != PACKET_FAST_WRITE_DATA_SIZE) {
+            rx_stop(self_p, 1);
+
+            return (prepare_failure_with_index(buf_p, -ETIMEDOUT, row));
+        }
+
+        res = ramapp_fast_write_row(self_p, data_p, &crc);
+
+        if (res != 0) {
+            rx_stop(self_p, 1);
+
+            return (prepare_failure_with_index(buf_p, res, row));
+        }
+
+        rx_put(self_p);
+        size -= PACKET_FAST_WRITE_DATA_SIZE;
+        row++;
+    }
+
+    rx_stop(self_p, 0);
+    res = ramapp_fast_write_finish_rows(self_p, &buf_p[PAYLOAD_OFFSET]);
+
+    return (prepare_fast_write_response(buf_p, res, address, flags));
+}
+
+#if CONFIG_PROGRAMMER_STAGING_SLICE_SIZE > 0
+
+/**
+ * Receive a slice of an image from the host into the staging
+ * buffer. The data is read from the data channel after the request,
+ * and checked before it is written to the PIC.
+ */
+static ssize_t handle_stage(struct programmer_t *self_p,
+                            uint8_t *buf_p,
+                            size_t size)
+{
+    struct time_t timeout;
+    int slice;
+    uint16_t crc;
+    int phase;
+    ssize_t res;
+
+    if (size != PACKET_STAGE_REQUEST_SIZE) {
+        return (-EMSGSIZE);
+    }
+
+    slice = buf_p[4];
+    size = ((buf_p[5] << 24)
+            | (buf_p[6] << 16)
+            | (buf_p[7] << 8)
+            | (buf_p[8] << 0));
+    crc = ((buf_p[9] << 8) | buf_p[10]);
+
+    if ((slice >= STAGING_SLICES)
+        || (size > staging_slice_size(self_p))
+        || ((size % PACKET_FAST_WRITE_DATA_SIZE) != 0)
+        || (size == 0)) {
+        return (-EINVAL);
+    }
+
+    staging.sizes[slice] = 0;
+    timeout.seconds = 0;
+    timeout.nanoseconds = CTRL_TIMEOUT_NS;
+    phase = stats_begin(STATS_PHASE_RECEIVE);
+    res = chan_read_with_timeout(self_p->link_p->data_chin_p,
+                                 &staging.buf[slice][0],
+                                 size,
+                                 &timeout);
+    stats_end(phase, MAX(res, 0));
+
+    if (res != size) {
+        return (-ETIMEDOUT);
+    }
+
+    if (packet_crc(&staging.buf[slice][0], size) != crc) {
+        return (-EBADCRC);
+    }
+
+    staging.sizes[slice] = size;
+    staging.crcs[slice] = crc;
+
+    return (0);
+}
+
+/**
+ * Write a staged slice to flash using the ramapp fast write command.
+ */
+static ssize_t handle_staged_write(struct programmer_t *self_p,
+                                   uint8_t *buf_p,
+                                   size_t size)
+{
+    uint32_t address;
+    uint16_t crc;
+    int slice;
+    int flags;
+    int row;
+    ssize_t res;
+
+    if (!self_p->is_connected) {
+        return (-ENOTCONN);
+    }
+
+    if (size == PACKET_STAGED_WRITE_REQUEST_SIZE + 1) {
+        flags = buf_p[9];
+    } else if (size == PACKET_STAGED_WRITE_REQUEST_SIZE) {
+        flags = 0;
+    } else {
+        return (-EMSGSIZE);
+    }
+
+    slice = buf_p[4];
+
+    if ((slice >= STAGING_SLICES) || (staging.sizes[slice] == 0)) {
+        return (-EINVAL);
+    }
+
+    size = staging.sizes[slice];
+    staging.sizes[slice] = 0;
+    address = ((buf_p[5] << 24)
+               | (buf_p[6] << 16)
+               | (buf_p[7] << 8)
+               | (buf_p[8] << 0));
+
+    res = ramapp_fast_write_start(self_p,
+                                  address,
+                                  size,
+                                  staging.crcs[slice]);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    crc = 0xffff;
+
+    for (row = 0; row < size / PACKET_FAST_WRITE_DATA_SIZE; row++) {
+        res = ramapp_fast_write_row(
+            self_p,
+            &staging.buf[slice][row * PACKET_FAST_WRITE_DATA_SIZE],
+            &crc);
+
+        if (res != 0) {
+            return (prepare_failure_with_index(buf_p, res, row));
+        }
+    }
+
+    res = ramapp_fast_write_finish_rows(self_p, &buf_p[PAYLOAD_OFFSET]);
+
+    return (prepare_fast_write_response(buf_p, res, address, flags));
+}
+
+#else
+
+static ssize_t handle_stage(struct programmer_t *self_p,
+                            uint8_t *buf_p,
+                            size_t size)
+{
+    return (-ENOSYS);
 }
 
+static ssize_t handle_staged_write(struct programmer_t *self_p,
+                                   uint8_t *buf_p,
+                                   size_t size)
+{
+    return (-ENOSYS);
+}
+
+#endif
+
+#if CONFIG_PROGRAMMER_PRODUCTION == 1
+
 /**
- * Write a packet to the ramapp in the PIC.
+ * Read the segment header at given programmer flash address.
  *
  * @return zero(0) or negative error code.
  */
-static ssize_t ramapp_write(struct programmer_t *self_p,
-                            uint8_t *buf_p,
-                            size_t size)
+static int production_read_segment(uint32_t address,
+                                   struct production_segment_t *segment_p)
 {
-    uint32_t data;
-    size_t number_of_words;
-    size_t i;
+    uint8_t buf[PRODUCTION_SEGMENT_HEADER_SIZE];
+
+    if (flash_read(&production.flash,
+                   &buf[0],
+                   address,
+                   sizeof(buf)) != sizeof(buf)) {
+        return (-EIO);
+    }
+
+    segment_p->address = ((buf[0] << 24)
+                          | (buf[1] << 16)
+                          | (buf[2] << 8)
+                          | (buf[3] << 0));
+    segment_p->size = ((buf[4] << 24)
+                       | (buf[5] << 16)
+                       | (buf[6] << 8)
+                       | (buf[7] << 0));
+    segment_p->crc_32 = ((buf[8] << 24)
+                         | (buf[9] << 16)
+                         | (buf[10] << 8)
+                         | (buf[11] << 0));
+    segment_p->crc = ((buf[12] << 8) | buf[13]);
+
+    if (((segment_p->address % PACKET_FAST_WRITE_DATA_SIZE) != 0)
+        || ((segment_p->size % PACKET_FAST_WRITE_DATA_SIZE) != 0)
+        || (segment_p->size == 0)) {
+        return (-EINVAL);
+    }
+
+    return (0);
+}
+
+/**
+ * Check the CRC-32 of a stored image of given size, and that its
+ * segments fill it.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int production_check_image(const struct production_header_t *header_p)
+{
+    struct production_segment_t segment;
+    uint8_t buf[PACKET_FAST_WRITE_DATA_SIZE];
+    uint32_t address;
+    uint32_t offset;
+    uint32_t crc;
+    size_t size;
+    int phase;
     int res;
 
-    number_of_words = DIV_CEIL(size, 4);
+    address = (CONFIG_PROGRAMMER_PRODUCTION_ADDRESS + PRODUCTION_IMAGE_OFFSET);
+    crc = 0;
 
-    for (i = 0; i < number_of_words; i++) {
-        data = ((buf_p[4 * i + 0] << 24)
-                | (buf_p[4 * i + 1] << 16)
-                | (buf_p[4 * i + 2] << 8)
-                | (buf_p[4 * i + 3] << 0));
+    for (offset = 0; offset < header_p->size; offset += size) {
+        size = MIN(header_p->size - offset, sizeof(buf));
 
-        res = icsp_soft_fast_data_write(&self_p->icsp, data);
+        if (flash_read(&production.flash,
+                       &buf[0],
+                       address + offset,
+                       size) != size) {
+            return (-EIO);
+        }
+
+        phase = stats_begin(STATS_PHASE_CRC);
+        crc = crc_32(crc, &buf[0], size);
+        stats_end(phase, size);
+    }
+
+    if (crc != header_p->crc) {
+        return (-EBADCRC);
+    }
+
+    offset = 0;
+
+    while (offset < header_p->size) {
+        res = production_read_segment(address + offset, &segment);
 
         if (res != 0) {
             return (res);
         }
+
+        offset += (PRODUCTION_SEGMENT_HEADER_SIZE + segment.size);
     }
 
-    return (size);
+    if (offset != header_p->size) {
+        return (-EINVAL);
+    }
+
+    return (0);
 }
 
-static ssize_t handle_ramapp_command(struct programmer_t *self_p,
-                                     uint8_t *buf_p,
-                                     size_t size)
+/**
+ * Write a segment, with its data at given programmer flash address,
+ * to the PIC flash, one row at a time.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int production_write_segment(struct programmer_t *self_p,
+                                    const struct production_segment_t *segment_p,
+                                    uint32_t address)
 {
+    uint8_t row[PACKET_FAST_WRITE_DATA_SIZE];
+    uint32_t offset;
+    uint16_t crc;
     ssize_t res;
 
-    res = -ENOTCONN;
+    res = ramapp_fast_write_start(self_p,
+                                  segment_p->address,
+                                  segment_p->size,
+                                  segment_p->crc);
 
-    if (self_p->is_connected) {
-        res = ramapp_write(self_p, buf_p, size);
+    if (res != 0) {
+        return (res);
+    }
 
-        if (res != size) {
+    crc = 0xffff;
+
+    for (offset = 0; offset < segment_p->size; offset += sizeof(row)) {
+        if (flash_read(&production.flash,
+                       &row[0],
+                       address + offset,
+                       sizeof(row)) != sizeof(row)) {
+            return (-EIO);
+        }
+
+        res = ramapp_fast_write_row(self_p, &row[0], &crc);
+
+        if (res != 0) {
+            return (res);
+        }
+    }
+
+    return (ramapp_fast_write_finish(self_p));
+}
+
+static int production_verify_segment(struct programmer_t *self_p,
+                                     const struct production_segment_t *segment_p)
+{
+    uint32_t crc;
+    int res;
+
+    res = ramapp_crc_32(self_p, segment_p->address, segment_p->size, &crc);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    if (crc != segment_p->crc_32) {
+        return (-EVERIFY);
+    }
+
+    return (0);
+}
+
+/**
+ * Program the connected PIC with the stored image, as the host would
+ * with the chip erase, connect and fast write commands.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int production_program(struct programmer_t *self_p,
+                              const struct production_header_t *header_p)
+{
+    struct production_segment_t segment;
+    uint32_t address;
+    uint32_t end;
+    int res;
+
+    if (header_p->flags & PRODUCTION_FLAG_CHIP_ERASE) {
+        icsp_start(self_p);
+        res = chip_erase(self_p);
+        icsp_stop(self_p);
+
+        if (res != 0) {
             return (res);
         }
+    }
+
+    res = start_ramapp(self_p, 0);
+    address = (CONFIG_PROGRAMMER_PRODUCTION_ADDRESS + PRODUCTION_IMAGE_OFFSET);
+    end = (address + header_p->size);
+
+    while ((res == 0) && (address < end)) {
+        res = production_read_segment(address, &segment);
+
+        if (res != 0) {
+            break;
+        }
+
+        address += PRODUCTION_SEGMENT_HEADER_SIZE;
+        res = production_write_segment(self_p, &segment, address);
+
+        if ((res == 0) && (header_p->flags & PRODUCTION_FLAG_VERIFY)) {
+            res = production_verify_segment(self_p, &segment);
+        }
+
+        address += segment.size;
+    }
+
+    icsp_stop(self_p);
+
+    return (res);
+}
+
+/**
+ * Returns true(1) if a production image is stored, with its header in
+ * given header.
+ */
+static int production_is_enabled(struct production_header_t *header_p)
+{
+    if (flash_read(&production.flash,
+                   header_p,
+                   CONFIG_PROGRAMMER_PRODUCTION_ADDRESS,
+                   sizeof(*header_p)) != sizeof(*header_p)) {
+        return (0);
+    }
+
+    return (header_p->magic == PRODUCTION_MAGIC);
+}
+
+/**
+ * Store a part of the production image in the programmer flash. The
+ * region is erased, disabling production mode, when the first part is
+ * stored.
+ */
+static ssize_t handle_production_store(struct programmer_t *self_p,
+                                       uint8_t *buf_p,
+                                       size_t size)
+{
+    uint32_t offset;
+    ssize_t res;
+
+    if (size < (PAYLOAD_OFFSET + 4 + CRC_SIZE)) {
+        return (-EMSGSIZE);
+    }
+
+    offset = ((buf_p[4] << 24)
+              | (buf_p[5] << 16)
+              | (buf_p[6] << 8)
+              | (buf_p[7] << 0));
+    size -= (PAYLOAD_OFFSET + 4 + CRC_SIZE);
+
+    if ((offset + size)
+        > (CONFIG_PROGRAMMER_PRODUCTION_SIZE - PRODUCTION_IMAGE_OFFSET)) {
+        return (-EINVAL);
+    }
+
+    if (offset == 0) {
+        res = flash_erase(&production.flash,
+                          CONFIG_PROGRAMMER_PRODUCTION_ADDRESS,
+                          CONFIG_PROGRAMMER_PRODUCTION_SIZE);
+
+        if (res != 0) {
+            return (-EIO);
+        }
+    }
+
+    res = flash_write(&production.flash,
+                      (CONFIG_PROGRAMMER_PRODUCTION_ADDRESS
+                       + PRODUCTION_IMAGE_OFFSET
+                       + offset),
+                      &buf_p[8],
+                      size);
+
+    if (res != size) {
+        return (-EIO);
+    }
+
+    return (0);
+}
+
+/**
+ * Enable production mode with the stored image, once its CRC-32 is
+ * checked, or disable it if the size is zero(0). The transport is
+ * optional.
+ */
+static ssize_t handle_production_enable(struct programmer_t *self_p,
+                                        uint8_t *buf_p,
+                                        size_t size)
+{
+    struct production_header_t header;
+    int res;
+
+    if ((size != PACKET_PRODUCTION_ENABLE_REQUEST_SIZE)
+        && (size != (PACKET_PRODUCTION_ENABLE_REQUEST_SIZE + 1))) {
+        return (-EMSGSIZE);
+    }
+
+    header.magic = PRODUCTION_MAGIC;
+    header.flags = buf_p[4];
+    header.size = ((buf_p[5] << 24)
+                   | (buf_p[6] << 16)
+                   | (buf_p[7] << 8)
+                   | (buf_p[8] << 0));
+    header.crc = ((buf_p[9] << 24)
+                  | (buf_p[10] << 16)
+                  | (buf_p[11] << 8)
+                  | (buf_p[12] << 0));
+    header.transport = CONFIG_PROGRAMMER_TRANSPORT;
+
+    if (size > PACKET_PRODUCTION_ENABLE_REQUEST_SIZE) {
+        header.transport = buf_p[13];
+    }
+
+    /* Single target transports only. */
+    if (((header.transport != PROGRAMMER_TRANSPORT_ICSP_SOFT)
+         && (header.transport != PROGRAMMER_TRANSPORT_ICSP_SPI))
+        || (header.size
+            > (CONFIG_PROGRAMMER_PRODUCTION_SIZE - PRODUCTION_IMAGE_OFFSET))) {
+        return (-EINVAL);
+    }
+
+    if (flash_erase(&production.flash,
+                    CONFIG_PROGRAMMER_PRODUCTION_ADDRESS,
+                    PRODUCTION_IMAGE_OFFSET) != 0) {
+        return (-EIO);
+    }
+
+    if (header.size == 0) {
+        return (0);
+    }
+
+    res = production_check_image(&header);
+
+    if (res != 0) {
+        return (res);
+    }
+
+    if (flash_write(&production.flash,
+                    CONFIG_PROGRAMMER_PRODUCTION_ADDRESS,
+                    &header,
+                    sizeof(header)) != sizeof(header)) {
+        return (-EIO);
+    }
+
+    production.state = PRODUCTION_STATE_WAIT_PRESENT;
+    production.passed = 0;
+    production.failed = 0;
+    production.error = 0;
+
+    return (0);
+}
+
+/**
+ * Respond with if production mode is enabled, the number of passed
+ * and failed PICs, and the error of the last failed PIC.
+ */
+static ssize_t handle_production_status(struct programmer_t *self_p,
+                                        uint8_t *buf_p,
+                                        size_t size)
+{
+    struct production_header_t header;
+
+    buf_p[4] = production_is_enabled(&header);
+    buf_p[5] = (production.passed >> 24);
+    buf_p[6] = (production.passed >> 16);
+    buf_p[7] = (production.passed >> 8);
+    buf_p[8] = (production.passed >> 0);
+    buf_p[9] = (production.failed >> 24);
+    buf_p[10] = (production.failed >> 16);
+    buf_p[11] = (production.failed >> 8);
+    buf_p[12] = (production.failed >> 0);
+    buf_p[13] = (production.error >> 24);
+    buf_p[14] = (production.error >> 16);
+    buf_p[15] = (production.error >> 8);
+    buf_p[16] = (production.error >> 0);
+
+    return (13);
+}
+
+#else
+
+static ssize_t handle_production_store(struct programmer_t *self_p,
+                                       uint8_t *buf_p,
+                                       size_t size)
+{
+    return (-ENOSYS);
+}
+
+static ssize_t handle_production_enable(struct programmer_t *self_p,
+                                        uint8_t *buf_p,
+                                        size_t size)
+{
+    return (-ENOSYS);
+}
+
+static ssize_t handle_production_status(struct programmer_t *self_p,
+                                        uint8_t *buf_p,
+                                        size_t size)
+{
+    return (-ENOSYS);
+}
+
+#endif
+
+/**
+ * Respond with the time since the counters were last read, and the
+ * time spent and bytes transferred in each phase, in microseconds.
+ * The counters are reset.
+ */
+static ssize_t handle_stats(struct programmer_t *self_p,
+                            uint8_t *buf_p,
+                            size_t size)
+{
+    struct time_t now;
+    struct time_t elapsed;
+    uint32_t value;
+    int i;
+
+    time_get(&now);
+    time_subtract(&elapsed, &now, &stats.reset_time);
+    value = (1000000 * elapsed.seconds + elapsed.nanoseconds / 1000);
+    buf_p[4] = (value >> 24);
+    buf_p[5] = (value >> 16);
+    buf_p[6] = (value >> 8);
+    buf_p[7] = (value >> 0);
+
+    for (i = 0; i < STATS_PHASES; i++) {
+        value = (stats.cycles[i] / CYCLE_COUNTER_FREQUENCY_MHZ);
+        buf_p[8 + 8 * i + 0] = (value >> 24);
+        buf_p[8 + 8 * i + 1] = (value >> 16);
+        buf_p[8 + 8 * i + 2] = (value >> 8);
+        buf_p[8 + 8 * i + 3] = (value >> 0);
+        value = stats.bytes[i];
+        buf_p[8 + 8 * i + 4] = (value >> 24);
+        buf_p[8 + 8 * i + 5] = (value >> 16);
+        buf_p[8 + 8 * i + 6] = (value >> 8);
+        buf_p[8 + 8 * i + 7] = (value >> 0);
+    }
+
+    stats_reset();
+    stats.reset_time = now;
+
+    return (4 + 8 * STATS_PHASES);
+}
+
+#if CONFIG_PROGRAMMER_TRACE_ENTRIES > 0
+
+/**
+ * Start or stop the trace. Recorded shifts are discarded when
+ * started.
+ */
+static ssize_t handle_trace_control(struct programmer_t *self_p,
+                                    uint8_t *buf_p,
+                                    size_t size)
+{
+    if (size != (PAYLOAD_OFFSET + 1 + CRC_SIZE)) {
+        return (-EINVAL);
+    }
+
+    trace.is_enabled = 0;
+
+    if (buf_p[4] != 0) {
+        trace.count = 0;
+        trace.instruction = 0;
+        trace.flags = 0;
+        trace.is_enabled = 1;
+    }
+
+    return (0);
+}
+
+/**
+ * Respond with the number of recorded shifts and the entries from
+ * given index, or from the oldest entry still in the ring buffer if
+ * given index has been overwritten.
+ */
+static ssize_t handle_trace_read(struct programmer_t *self_p,
+                                 uint8_t *buf_p,
+                                 size_t size)
+{
+    uint32_t index;
+    uint32_t first;
+    uint32_t number_of_entries;
+    struct trace_entry_t *entry_p;
+    uint8_t *payload_p;
+    uint32_t i;
+
+    if (size != (PAYLOAD_OFFSET + 4 + CRC_SIZE)) {
+        return (-EINVAL);
+    }
+
+    index = ((buf_p[4] << 24)
+             | (buf_p[5] << 16)
+             | (buf_p[6] << 8)
+             | (buf_p[7] << 0));
+    first = 0;
+
+    if (trace.count > CONFIG_PROGRAMMER_TRACE_ENTRIES) {
+        first = (trace.count - CONFIG_PROGRAMMER_TRACE_ENTRIES);
+    }
+
+    index = MIN(MAX(index, first), trace.count);
+    number_of_entries = MIN(trace.count - index, TRACE_READ_ENTRIES_MAX);
+
+    buf_p[4] = (trace.count >> 24);
+    buf_p[5] = (trace.count >> 16);
+    buf_p[6] = (trace.count >> 8);
+    buf_p[7] = (trace.count >> 0);
+    buf_p[8] = (index >> 24);
+    buf_p[9] = (index >> 16);
+    buf_p[10] = (index >> 8);
+    buf_p[11] = (index >> 0);
+    payload_p = &buf_p[12];
+
+    for (i = 0; i < number_of_entries; i++) {
+        entry_p = &trace.entries[(index + i) % CONFIG_PROGRAMMER_TRACE_ENTRIES];
+        payload_p[0] = (entry_p->start >> 24);
+        payload_p[1] = (entry_p->start >> 16);
+        payload_p[2] = (entry_p->start >> 8);
+        payload_p[3] = (entry_p->start >> 0);
+        payload_p[4] = (entry_p->end >> 24);
+        payload_p[5] = (entry_p->end >> 16);
+        payload_p[6] = (entry_p->end >> 8);
+        payload_p[7] = (entry_p->end >> 0);
+        payload_p[8] = entry_p->kind;
+        payload_p[9] = entry_p->instruction;
+        payload_p[10] = (entry_p->number_of_bits >> 8);
+        payload_p[11] = (entry_p->number_of_bits >> 0);
+        payload_p += TRACE_ENTRY_SIZE;
+    }
+
+    return (8 + TRACE_ENTRY_SIZE * number_of_entries);
+}
+
+#else
+
+static ssize_t handle_trace_control(struct programmer_t *self_p,
+                                    uint8_t *buf_p,
+                                    size_t size)
+{
+    return (-ENOSYS);
+}
+
+static ssize_t handle_trace_read(struct programmer_t *self_p,
+                                 uint8_t *buf_p,
+                                 size_t size)
+{
+    return (-ENOSYS);
+}
+
+#endif
+
+/**
+ * Returns the size of given job step, or negative error code if the
+ * step is invalid or does not fit in given number of bytes.
+ */
+static int job_step_size(const uint8_t *step_p, int left)
+{
+    uint32_t size;
+    int step_size;
+
+    switch (step_p[0]) {
+
+    case JOB_STEP_CHIP_ERASE:
+    case JOB_STEP_CONNECT:
+    case JOB_STEP_DISCONNECT:
+        return (1);
+
+    case JOB_STEP_WRITE:
+        step_size = 11;
+        break;
+
+    case JOB_STEP_VERIFY:
+        step_size = 13;
+        break;
+
+    default:
+        return (-EINVAL);
+    }
+
+    if (step_size > left) {
+        return (-EMSGSIZE);
+    }
+
+    size = ((step_p[5] << 24)
+            | (step_p[6] << 16)
+            | (step_p[7] << 8)
+            | (step_p[8] << 0));
+
+    if (size == 0) {
+        return (-EINVAL);
+    }
+
+    if ((step_p[0] == JOB_STEP_WRITE)
+        && ((size % PACKET_FAST_WRITE_DATA_SIZE) != 0)) {
+        return (-EINVAL);
+    }
 
-        res = ramapp_read(self_p, buf_p);
+    if ((step_p[0] == JOB_STEP_VERIFY) && ((size % 4) != 0)) {
+        return (-EINVAL);
     }
 
-    return (res);
+    return (step_size);
 }
 
-static ssize_t handle_connect(struct programmer_t *self_p,
-                              uint8_t *buf_p,
-                              size_t size)
+static int job_chip_erase(struct programmer_t *self_p)
 {
     int res;
 
-    res = 0;
-
     if (self_p->is_connected) {
         return (-EISCONN);
     }
 
-    icsp_soft_init(&self_p->icsp,
-                   &pin_pgec_dev,
-                   &pin_pged_dev,
-                   &pin_mclrn_dev);
-    icsp_soft_start(&self_p->icsp);
-
-    res = enter_serial_execution_mode(&self_p->icsp);
+    icsp_start(self_p);
+    res = chip_erase(self_p);
+    icsp_stop(self_p);
 
-    if (res != 0) {
-        return (-EENTERSERIALEXECUTIONMODE);
-    }
+    return (res);
+}
 
-    res = upload_ramapp(&self_p->icsp);
+static int job_connect(struct programmer_t *self_p)
+{
+    int res;
 
-    if (res != 0) {
-        return (-ERAMAPPUPLOAD);
+    if (self_p->is_connected) {
+        return (-EISCONN);
     }
 
-    res = send_command(&self_p->icsp, ETAP_FASTDATA);
+    res = start_ramapp(self_p, 0);
 
     if (res != 0) {
         return (res);
     }
 
+    self_p->ext_image_p = NULL;
     self_p->is_connected = 1;
 
-    return (res);
+    return (0);
 }
 
-static ssize_t handle_disconnect(struct programmer_t *self_p,
-                                 uint8_t *buf_p,
-                                 size_t size)
+/**
+ * Write the data of a write step to flash. The data is received from
+ * the host in fast write data packets, as by the fast write command.
+ */
+static int job_write(struct programmer_t *self_p, const uint8_t *step_p)
 {
-    if (!self_p->is_connected) {
-        return (-ENOTCONN);
+    uint32_t address;
+    uint32_t size;
+    uint8_t *data_p;
+    uint16_t crc;
+    ssize_t res;
+
+    address = ((step_p[1] << 24)
+               | (step_p[2] << 16)
+               | (step_p[3] << 8)
+               | (step_p[4] << 0));
+    size = ((step_p[5] << 24)
+            | (step_p[6] << 16)
+            | (step_p[7] << 8)
+            | (step_p[8] << 0));
+
+    /* Started first, so the data packets are discarded on failure. */
+    rx_start(self_p, size / PACKET_FAST_WRITE_DATA_SIZE);
+
+    if (self_p->is_connected) {
+        res = ramapp_fast_write_start(self_p,
+                                      address,
+                                      size,
+                                      ((step_p[9] << 8) | step_p[10]));
+    } else {
+        res = -ENOTCONN;
     }
 
-    icsp_soft_stop(&self_p->icsp);
+    crc = 0xffff;
 
-    self_p->is_connected = 0;
+    while ((res == 0) && (size > 0)) {
+        res = rx_get(self_p, &data_p);
 
-    return (0);
-}
+        if (res != PACKET_FAST_WRITE_DATA_SIZE) {
+            res = -ETIMEDOUT;
+            break;
+        }
 
-static ssize_t handle_reset(struct programmer_t *self_p,
-                            uint8_t *buf_p,
-                            size_t size)
-{
-    struct pin_driver_t mclrn;
+        res = ramapp_fast_write_row(self_p, data_p, &crc);
 
-    if (self_p->is_connected) {
-        return (-EISCONN);
+        if (res != 0) {
+            break;
+        }
+
+        rx_put(self_p);
+        size -= PACKET_FAST_WRITE_DATA_SIZE;
     }
 
-    pin_init(&mclrn, &pin_mclrn_dev, PIN_OUTPUT);
-    pin_write(&mclrn, 0);
-    time_busy_wait_us(2);
-    pin_set_mode(&mclrn, PIN_INPUT);
-    thrd_sleep_ms(20);
+    if (res != 0) {
+        rx_stop(self_p, 1);
 
-    return (0);
+        return (res);
+    }
+
+    rx_stop(self_p, 0);
+
+    return (ramapp_fast_write_finish(self_p));
 }
 
-static ssize_t handle_device_status(struct programmer_t *self_p,
-                                    uint8_t *buf_p,
-                                    size_t size)
+static int job_verify(struct programmer_t *self_p, const uint8_t *step_p)
 {
-    int status;
+    uint32_t crc;
+    int res;
 
-    if (self_p->is_connected) {
-        return (-EISCONN);
+    if (!self_p->is_connected) {
+        return (-ENOTCONN);
     }
 
-    icsp_soft_init(&self_p->icsp,
-                   &pin_pgec_dev,
-                   &pin_pged_dev,
-                   &pin_mclrn_dev);
-    icsp_soft_start(&self_p->icsp);
+    res = ramapp_crc_32(self_p,
+                        ((step_p[1] << 24)
+                         | (step_p[2] << 16)
+                         | (step_p[3] << 8)
+                         | (step_p[4] << 0)),
+                        ((step_p[5] << 24)
+                         | (step_p[6] << 16)
+                         | (step_p[7] << 8)
+                         | (step_p[8] << 0)),
+                        &crc);
 
-    status = read_device_status(&self_p->icsp);
-
-    icsp_soft_stop(&self_p->icsp);
+    if (res != 0) {
+        return (res);
+    }
 
-    buf_p[4] = bits_reverse_8(status);
-    status = 1;
+    if (crc != ((step_p[9] << 24)
+                | (step_p[10] << 16)
+                | (step_p[11] << 8)
+                | (step_p[12] << 0))) {
+        return (-EVERIFY);
+    }
 
-    return (status);
+    return (0);
 }
 
-static ssize_t handle_chip_erase(struct programmer_t *self_p,
-                                 uint8_t *buf_p,
-                                 size_t size)
+static int job_run_step(struct programmer_t *self_p, const uint8_t *step_p)
 {
-    int res;
+    switch (step_p[0]) {
 
-    if (self_p->is_connected) {
-        return (-EISCONN);
-    }
+    case JOB_STEP_CHIP_ERASE:
+        return (job_chip_erase(self_p));
 
-    icsp_soft_init(&self_p->icsp,
-                   &pin_pgec_dev,
-                   &pin_pged_dev,
-                   &pin_mclrn_dev);
-    icsp_soft_start(&self_p->icsp);
+    case JOB_STEP_CONNECT:
+        return (job_connect(self_p));
 
-    res = chip_erase(&self_p->icsp);
+    case JOB_STEP_WRITE:
+        return (job_write(self_p, step_p));
 
-    icsp_soft_stop(&self_p->icsp);
+    case JOB_STEP_VERIFY:
+        return (job_verify(self_p, step_p));
 
-    return (res);
+    default:
+        return (handle_disconnect(self_p, NULL, 0));
+    }
 }
 
-static ssize_t handle_version(uint8_t *buf_p, size_t size)
+/**
+ * The host sends the first data packet of a write step without a
+ * credit, once all data of previous write steps is sent. Discard it
+ * if the job failed before the write step.
+ */
+static void job_drain(struct programmer_t *self_p,
+                      const uint8_t *step_p,
+                      const uint8_t *end_p)
 {
-    strcpy((char *)&buf_p[4], VERSION_STR);
+    while (step_p < end_p) {
+        if (step_p[0] == JOB_STEP_WRITE) {
+            pipeline.rx_outstanding = 1;
+            credits_drain(self_p);
+            break;
+        }
 
-    return (strlen((char *)&buf_p[4]));
+        step_p += job_step_size(step_p, end_p - step_p);
+    }
 }
 
-static ssize_t handle_fast_write(struct programmer_t *self_p,
-                                 uint8_t *buf_p,
-                                 size_t size)
+/**
+ * Run all steps of a job, and respond with the time each step took in
+ * microseconds. All steps are validated before the first is run. On
+ * failure, the index of the failed step follows the error code.
+ */
+static ssize_t handle_job(struct programmer_t *self_p,
+                          uint8_t *buf_p,
+                          size_t size)
 {
-    uint16_t response;
+    uint32_t times[JOB_STEPS_MAX];
+    struct time_t start;
+    struct time_t end;
+    uint8_t *step_p;
+    uint8_t *end_p;
+    int number_of_steps;
+    int transport_size;
+    int i;
     int res;
-    struct time_t timeout;
-
-    if (!self_p->is_connected) {
-        return (-ENOTCONN);
-    }
 
-    if (size != PACKET_FAST_WRITE_REQUEST_SIZE) {
+    if (size < (PAYLOAD_OFFSET + 1 + CRC_SIZE)) {
         return (-EMSGSIZE);
     }
 
-    size = ((buf_p[8] << 24)
-            | (buf_p[9] << 16)
-            | (buf_p[10] << 8)
-            | (buf_p[11] << 0));
+    transport_size = buf_p[4];
 
-    if ((size % PACKET_FAST_WRITE_DATA_SIZE) != 0) {
-        return (-EINVAL);
+    if (size < (PAYLOAD_OFFSET + 1 + transport_size + CRC_SIZE)) {
+        return (-EMSGSIZE);
     }
 
-    if (size == 0) {
-        return (-EINVAL);
-    }
+    end_p = &buf_p[size - CRC_SIZE];
+    number_of_steps = 0;
 
-    /* Forward the request to the PIC. */
-    res = ramapp_write(self_p, buf_p, PACKET_FAST_WRITE_REQUEST_SIZE);
+    for (step_p = &buf_p[PAYLOAD_OFFSET + 1 + transport_size];
+         step_p < end_p;
+         step_p += res) {
+        res = job_step_size(step_p, end_p - step_p);
 
-    if (res != PACKET_FAST_WRITE_REQUEST_SIZE) {
-        return (res);
+        if (res < 0) {
+            return (res);
+        }
+
+        number_of_steps++;
     }
 
-    /* Perform data transfer. */
-    response = 0;
-    timeout.seconds = 0;
-    timeout.nanoseconds = CTRL_TIMEOUT_NS;
+    if ((number_of_steps == 0) || (number_of_steps > JOB_STEPS_MAX)) {
+        return (-EINVAL);
+    }
 
-    while (size > 0) {
-        res = chan_read_with_timeout(sys_get_stdin(),
-                                     &buf_p[4],
-                                     PACKET_FAST_WRITE_DATA_SIZE,
-                                     &timeout);
+    step_p = &buf_p[PAYLOAD_OFFSET + 1 + transport_size];
 
-        if (res != PACKET_FAST_WRITE_DATA_SIZE) {
-            return (-ETIMEDOUT);
-        }
+    if (!self_p->is_connected) {
+        res = select_transport(self_p,
+                               &buf_p[PAYLOAD_OFFSET + 1],
+                               transport_size);
 
-        res = ramapp_write(self_p, &buf_p[4], PACKET_FAST_WRITE_DATA_SIZE);
+        if (res != 0) {
+            job_drain(self_p, step_p, end_p);
 
-        if (res != PACKET_FAST_WRITE_DATA_SIZE) {
             return (res);
         }
-
-        chan_write(sys_get_stdout(), &response, sizeof(response));
-        size -= PACKET_FAST_WRITE_DATA_SIZE;
     }
 
-    return (ramapp_read(self_p, buf_p));
-}
-
-static ssize_t prepare_command_response(uint8_t *buf_p,
-                                        ssize_t size)
-{
-    uint16_t crc;
-
-    /* Failure. */
-    if (size < 0) {
-        buf_p[0] = (COMMAND_TYPE_FAILED >> 8);
-        buf_p[1] = COMMAND_TYPE_FAILED;
-        buf_p[4] = (size >> 24);
-        buf_p[5] = (size >> 16);
-        buf_p[6] = (size >> 8);
-        buf_p[7] = (size >> 0);
-        size = 4;
-    }
+    for (i = 0; i < number_of_steps; i++) {
+        time_get(&start);
+        res = job_run_step(self_p, step_p);
+        time_get(&end);
+        time_subtract(&end, &end, &start);
+        times[i] = (1000000 * end.seconds + end.nanoseconds / 1000);
 
-    buf_p[2] = (size >> 8);
-    buf_p[3] = size;
+        if (res != 0) {
+            if (step_p[0] != JOB_STEP_WRITE) {
+                job_drain(self_p,
+                          step_p + job_step_size(step_p, end_p - step_p),
+                          end_p);
+            }
 
-    size += PAYLOAD_OFFSET;
+            return (prepare_failure_with_index(buf_p, res, i));
+        }
 
-    crc = crc_ccitt(0xffff, buf_p, size);
+        step_p += job_step_size(step_p, end_p - step_p);
+    }
 
-    buf_p[size] = (crc >> 8);
-    buf_p[size + 1] = crc;
-    size += CRC_SIZE;
+    for (i = 0; i < number_of_steps; i++) {
+        buf_p[PAYLOAD_OFFSET + 4 * i + 0] = (times[i] >> 24);
+        buf_p[PAYLOAD_OFFSET + 4 * i + 1] = (times[i] >> 16);
+        buf_p[PAYLOAD_OFFSET + 4 * i + 2] = (times[i] >> 8);
+        buf_p[PAYLOAD_OFFSET + 4 * i + 3] = (times[i] >> 0);
+    }
 
-    return (size);
+    return (prepare_command_response(buf_p, 4 * number_of_steps));
 }
 
 static ssize_t handle_programmer_command(struct programmer_t *self_p,
@@ -707,7 +5043,7 @@ static ssize_t handle_programmer_command(struct programmer_t *self_p,
     res = -EBADCRC;
     actual_crc = ((buf_p[size - CRC_SIZE] << 8)
                   | buf_p[size - CRC_SIZE + 1]);
-    expected_crc = crc_ccitt(0xffff, &buf_p[0], size - CRC_SIZE);
+    expected_crc = packet_crc(&buf_p[0], size - CRC_SIZE);
 
     if (actual_crc == expected_crc) {
         switch (type) {
@@ -749,6 +5085,73 @@ static ssize_t handle_programmer_command(struct programmer_t *self_p,
             res = handle_version(buf_p, size);
             break;
 
+        case COMMAND_TYPE_TARGETS_STATUS:
+            res = handle_targets_status(self_p, buf_p, size);
+            break;
+
+        case COMMAND_TYPE_READ_WORDS:
+            res = handle_read_words(self_p, buf_p, size);
+            break;
+
+        case COMMAND_TYPE_CAPABILITIES:
+            res = handle_capabilities(self_p, buf_p, size);
+            break;
+
+        case COMMAND_TYPE_STAGE:
+            res = handle_stage(self_p, buf_p, size);
+            break;
+
+        case COMMAND_TYPE_STAGED_WRITE:
+            res = handle_staged_write(self_p, buf_p, size);
+
+            if (res >= 0) {
+                return (res);
+            }
+
+            break;
+
+        case COMMAND_TYPE_PRODUCTION_STORE:
+            res = handle_production_store(self_p, buf_p, size);
+            break;
+
+        case COMMAND_TYPE_PRODUCTION_ENABLE:
+            res = handle_production_enable(self_p, buf_p, size);
+            break;
+
+        case COMMAND_TYPE_PRODUCTION_STATUS:
+            res = handle_production_status(self_p, buf_p, size);
+            break;
+
+        case COMMAND_TYPE_JOB:
+            res = handle_job(self_p, buf_p, size);
+
+            if (res >= 0) {
+                return (res);
+            }
+
+            break;
+
+        case COMMAND_TYPE_STATS:
+            res = handle_stats(self_p, buf_p, size);
+            break;
+
+        case COMMAND_TYPE_TRACE_CONTROL:
+            res = handle_trace_control(self_p, buf_p, size);
+            break;
+
+        case COMMAND_TYPE_TRACE_READ:
+            res = handle_trace_read(self_p, buf_p, size);
+            break;
+
+        case COMMAND_TYPE_FAST_READ:
+            res = handle_fast_read(self_p, buf_p, size);
+
+            if (res >= 0) {
+                return (res);
+            }
+
+            break;
+
         default:
             res = -1;
             break;
@@ -774,6 +5177,7 @@ static ssize_t handle_command(struct programmer_t *self_p,
     int type;
 
     type = ((buf_p[0] << 8) | buf_p[1]);
+    trace_command(type);
 
     if (type < 100) {
         res = handle_ramapp_command(self_p, buf_p, size);
@@ -788,17 +5192,19 @@ static ssize_t handle_command(struct programmer_t *self_p,
     return (res);
 }
 
-static ssize_t read_command_request(uint8_t *buf_p)
+static ssize_t read_command_request(struct programmer_t *self_p,
+                                    uint8_t *buf_p)
 {
     ssize_t size;
     ssize_t res;
     struct time_t timeout;
+    int phase;
 
     timeout.seconds = 0;
     timeout.nanoseconds = CTRL_TIMEOUT_NS;
 
     /* Read type and size. */
-    res = chan_read_with_timeout(sys_get_stdin(),
+    res = chan_read_with_timeout(self_p->link_p->chin_p,
                                  &buf_p[0],
                                  PAYLOAD_OFFSET,
                                  &timeout);
@@ -813,47 +5219,175 @@ static ssize_t read_command_request(uint8_t *buf_p)
         return (-EMSGSIZE);
     }
 
-    /* Read payload and crc. */
-    res = chan_read_with_timeout(sys_get_stdin(),
+    /* Read payload and crc. Waiting for the next request is not
+       counted, as the programmer may be idle. */
+    phase = stats_begin(STATS_PHASE_RECEIVE);
+    res = chan_read_with_timeout(self_p->link_p->chin_p,
                                  &buf_p[4],
                                  size + CRC_SIZE,
                                  &timeout);
+    stats_end(phase, MAX(res, 0));
 
     if (res != (size + CRC_SIZE)) {
         return (-ETIMEDOUT);
     }
 
-    return (PAYLOAD_OFFSET + size + CRC_SIZE);
-}
+    size += (PAYLOAD_OFFSET + CRC_SIZE);
 
-static int write_command_response(uint8_t *buf_p, ssize_t size)
-{
-    chan_write(sys_get_stdout(), &buf_p[0], size);
+    /* Packets are forwarded to the ramapp in words. Zero the padding
+       of the last word, as the buffer is reused. */
+    memset(&buf_p[size], 0, 4 * DIV_CEIL(size, 4) - size);
 
-    return (0);
+    return (size);
 }
 
 int programmer_init(struct programmer_t *self_p)
 {
+    console_link.chin_p = sys_get_stdin();
+    console_link.chout_p = sys_get_stdout();
+    console_link.data_chin_p = sys_get_stdin();
+    console_link.window = CONFIG_PROGRAMMER_CONSOLE_WINDOW;
+    self_p->link_p = &console_link;
+    self_p->transport = CONFIG_PROGRAMMER_TRANSPORT;
+    self_p->targets = 0;
+    self_p->jtag_number_of_devices = 1;
+    self_p->jtag_ir_lengths[0] = JTAG_SOFT_IR_LENGTH_PIC32;
     self_p->is_connected = 0;
+    self_p->ext_image_p = NULL;
+    self_p->ramapp_features = 0;
+#if CONFIG_PROGRAMMER_PRODUCTION == 1
+    flash_init(&production.flash, &flash_device[0]);
+    production.state = PRODUCTION_STATE_WAIT_PRESENT;
+    production.passed = 0;
+    production.failed = 0;
+    production.error = 0;
+    /* Drive the status pins from start, instead of letting them float
+       until the first PIC is programmed. */
+    pin_init(&production.pass, &pin_production_pass_dev, PIN_OUTPUT);
+    pin_write(&production.pass, 0);
+    pin_init(&production.fail, &pin_production_fail_dev, PIN_OUTPUT);
+    pin_write(&production.fail, 0);
+    pin_init(&production.busy, &pin_production_busy_dev, PIN_OUTPUT);
+    pin_write(&production.busy, 0);
+    pin_init(&production.sense, &pin_production_sense_dev, PIN_INPUT);
+#endif
+    cycle_counter_start();
+    stats_reset();
+    stats.reset_time.seconds = 0;
+    stats.reset_time.nanoseconds = 0;
+    packet_ring_init(&pipeline.rx,
+                     &pipeline.rx_buf[0][0],
+                     &pipeline.rx_sizes[0],
+                     PACKET_FAST_WRITE_DATA_SIZE,
+                     RX_PACKETS);
+    packet_ring_init(&pipeline.tx,
+                     &pipeline.tx_buf[0][0],
+                     &pipeline.tx_sizes[0],
+                     TX_PACKET_SIZE,
+                     TX_PACKETS);
+    pipeline_start(self_p);
 
     return (0);
 }
 
+void programmer_set_link(struct programmer_t *self_p,
+                         struct programmer_link_t *link_p)
+{
+    /* Queued responses are sent on the link they belong to. */
+    if (link_p != self_p->link_p) {
+        tx_flush();
+        self_p->link_p = link_p;
+    }
+}
+
 int programmer_process_packet(struct programmer_t *self_p)
 {
     ssize_t size;
-    uint8_t buf[PAYLOAD_OFFSET + MAXIMUM_PAYLOAD_SIZE + CRC_SIZE + 2];
+    uint8_t *buf_p;
 
-    size = read_command_request(&buf[0]);
+    /* The response is sent while the next request is handled. */
+    buf_p = tx_begin();
+    size = read_command_request(self_p, buf_p);
 
     if (size >= 0) {
-        size = handle_command(self_p, &buf[0], size);
+        size = handle_command(self_p, buf_p, size);
 
         if (size > 0) {
-            size = write_command_response(&buf[0], size);
+            size = tx_end(self_p, buf_p, size);
         }
     }
 
     return (size);
 }
+
+#if CONFIG_PROGRAMMER_PRODUCTION == 1
+
+int programmer_production_poll(struct programmer_t *self_p)
+{
+    struct production_header_t header;
+    int transport;
+    int status;
+    int res;
+
+    /* The PIC belongs to the host while connected. */
+    if (self_p->is_connected || !production_is_enabled(&header)) {
+        return (0);
+    }
+
+    /* Entering the PIC resets it, so a programmed PIC is only sensed
+       until removed. */
+    if (production.state == PRODUCTION_STATE_WAIT_REMOVED) {
+        if (pin_read(&production.sense) == 0) {
+            production.state = PRODUCTION_STATE_WAIT_PRESENT;
+        }
+
+        return (0);
+    }
+
+    /* The transport selected by the host is kept. */
+    transport = self_p->transport;
+    self_p->transport = header.transport;
+
+    /* A PIC is present if its code protect status bit reads as
+       set. */
+    icsp_start(self_p);
+    status = read_device_status(self_p);
+    icsp_stop(self_p);
+
+    if ((status < 0) || (status == 0xff) || ((status & STATUS_CPS) == 0)) {
+        self_p->transport = transport;
+
+        return (0);
+    }
+
+    pin_write(&production.pass, 0);
+    pin_write(&production.fail, 0);
+    pin_write(&production.busy, 1);
+
+    res = production_program(self_p, &header);
+
+    pin_write(&production.busy, 0);
+    self_p->transport = transport;
+
+    if (res == 0) {
+        pin_write(&production.pass, 1);
+        production.passed++;
+    } else {
+        pin_write(&production.fail, 1);
+        production.failed++;
+        production.error = res;
+    }
+
+    production.state = PRODUCTION_STATE_WAIT_REMOVED;
+
+    return (1);
+}
+
+#else
+
+int programmer_production_poll(struct programmer_t *self_p)
+{
+    return (0);
+}
+
+#endif
@@ -30,10 +30,87 @@
 #define __PROGRAMMER_H__
 
 #include "simba.h"
+#include "icsp_spi.h"
+#include "jtag_soft.h"
+#include "icsp_gang.h"
+
+/* ICSP transports. */
+#define PROGRAMMER_TRANSPORT_ICSP_SOFT                      0
+#define PROGRAMMER_TRANSPORT_ICSP_SPI                       1
+#define PROGRAMMER_TRANSPORT_JTAG_SOFT                      2
+#define PROGRAMMER_TRANSPORT_ICSP_GANG                      3
+
+/* Receive fast write data and send responses in threads of their
+   own, in parallel with the ICSP transfers. */
+#ifndef CONFIG_PROGRAMMER_PIPELINE
+#    define CONFIG_PROGRAMMER_PIPELINE                      0
+#endif
+
+/* Fast write window of the console link. */
+#ifndef CONFIG_PROGRAMMER_CONSOLE_WINDOW
+#    define CONFIG_PROGRAMMER_CONSOLE_WINDOW                1
+#endif
+
+/* Size of each of the two staging buffer slices. Zero(0) to disable
+   staged writes. Slices are further limited to the fast write window
+   of the link. */
+#ifndef CONFIG_PROGRAMMER_STAGING_SLICE_SIZE
+#    define CONFIG_PROGRAMMER_STAGING_SLICE_SIZE         8192
+#endif
+
+/* Standalone production mode. An image stored in the programmer
+   flash is written to each PIC connected while the host is idle. */
+#ifndef CONFIG_PROGRAMMER_PRODUCTION
+#    define CONFIG_PROGRAMMER_PRODUCTION                    0
+#endif
+
+/* Programmer flash region of the production image, by default the
+   second flash bank of the Arduino Due. */
+#ifndef CONFIG_PROGRAMMER_PRODUCTION_ADDRESS
+#    define CONFIG_PROGRAMMER_PRODUCTION_ADDRESS   0x000c0000
+#endif
+
+#ifndef CONFIG_PROGRAMMER_PRODUCTION_SIZE
+#    define CONFIG_PROGRAMMER_PRODUCTION_SIZE      0x00040000
+#endif
+
+/* Number of ICSP shifts kept in the trace ring buffer. Zero(0) to
+   disable the trace. */
+#ifndef CONFIG_PROGRAMMER_TRACE_ENTRIES
+#    define CONFIG_PROGRAMMER_TRACE_ENTRIES               512
+#endif
+
+/* Transport used unless selected by the host. */
+#ifndef CONFIG_PROGRAMMER_TRANSPORT
+#    define CONFIG_PROGRAMMER_TRANSPORT PROGRAMMER_TRANSPORT_ICSP_SOFT
+#endif
+
+/* Channels to and from the host. Fast write data packets are read
+   from the data channel. The window is the number of fast write data
+   packets the host may send ahead, limited by the size of the data
+   channel receive buffer. */
+struct programmer_link_t {
+    void *chin_p;
+    void *chout_p;
+    void *data_chin_p;
+    int window;
+};
 
 struct programmer_t {
+    struct programmer_link_t *link_p;
+    int transport;
     struct icsp_soft_driver_t icsp;
+    struct icsp_spi_driver_t icsp_spi;
+    struct jtag_soft_driver_t jtag_soft;
+    struct icsp_gang_driver_t icsp_gang;
+    uint32_t targets;
+    uint8_t jtag_ir_lengths[JTAG_SOFT_DEVICES_MAX];
+    int jtag_number_of_devices;
     int is_connected;
+    /* Features of the ramapp running in the PIC. */
+    uint32_t ramapp_features;
+    /* The extension module loaded into the ramapp, or NULL. */
+    const struct ramapp_ext_image_t *ext_image_p;
 };
 
 /**
@@ -43,6 +120,13 @@ struct programmer_t {
  */
 int programmer_init(struct programmer_t *self_p);
 
+/**
+ * Set the host link for following packets. The console is used by
+ * default.
+ */
+void programmer_set_link(struct programmer_t *self_p,
+                         struct programmer_link_t *link_p);
+
 /**
  * Process a packet.
  *
@@ -50,4 +134,14 @@ int programmer_init(struct programmer_t *self_p);
  */
 int programmer_process_packet(struct programmer_t *self_p);
 
+/**
+ * Program the PIC with the production image stored in the programmer
+ * flash, if any, once it is connected. Call when the host is idle. A
+ * programmed PIC must be removed before the next PIC is programmed.
+ *
+ * @return one(1) if a PIC was programmed, successfully or not,
+ *         zero(0) if not, or negative error code.
+ */
+int programmer_production_poll(struct programmer_t *self_p);
+
 #endif
@@ -0,0 +1,10 @@
+/**
+ * This file was generated by pictools.py version 0.17.0.
+ *
+ * Ramapp extension module images, loaded by the programmer when a
+ * command handled by a module is first forwarded to the ramapp.
+ */
+
+static const struct ramapp_ext_image_t ramapp_ext_images[] = {
+    { { 0 }, NULL }
+};
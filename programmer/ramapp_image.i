@@ -0,0 +1,99 @@
+/**
+ * This file was generated by pictools.py version 0.17.0.
+ */
+
+/* Number of words in the image. */
+525,
+
+/* The image. */
+0xa00041bd, 0x02a6f400, 0x7ff833bd, 0x02c0f400, 0x00000000, 0xa00041a8,
+0x04c93108, 0x000045c8, 0x0c000000, 0xfffe40e0, 0x00033065, 0x8d9925b5,
+0x25b40c45, 0x41aa6f30, 0x6dc0ff20, 0xfcca0668, 0x6db20000, 0xc0400126,
+0x80400106, 0x192327e1, 0x1903fffb, 0x18e3fffc, 0xb483fffd, 0x18c3fff0,
+0x45bffffe, 0x800360a4, 0x900060a4, 0x0c40459f, 0xf9b833bd, 0x233dee84,
+0x0e04d620, 0x0014f400, 0x0010309d, 0x0012163d, 0x0013145d, 0x44ca2490,
+0x04019051, 0x016c9402, 0x000230b1, 0x0014f400, 0x0014309d, 0x6d896f12,
+0x6e090566, 0x09a00498, 0x50800915, 0x24b0ffff, 0xf4006e89, 0x005103f6,
+0xb4518a90, 0x145d015a, 0x147d0010, 0xee030011, 0x44d32520, 0x011a9482,
+0x00049062, 0x00699403, 0x9462ed81, 0xed82010c, 0x00a3b462, 0x001414fd,
+0x0015151d, 0x0018145d, 0x0019147d, 0x00036090, 0x001714bd, 0x0016155d,
+0x001b14dd, 0x001a153d, 0x80000108, 0x80000063, 0xc00000e7, 0xc0000042,
+0x3a900107, 0x609044d3, 0x44ef1000, 0x40000069, 0x4000010a, 0x44f344f2,
+0x03b0f400, 0x2a900105, 0x40800062, 0x2fad2dbd, 0x016c4002, 0x808000a2,
+0x50806ca2, 0x3042ffff, 0x0cd10009, 0x187d6e89, 0x24250012, 0x03f6f400,
+0x001318fd, 0x04986e09, 0x899025a1, 0x89118c18, 0x27846d89, 0x41a807f6,
+0x0930ff20, 0x0b330ab1, 0x00420a32, 0x00a5c000, 0x44d58000, 0x264044d6,
+0x6db244d4, 0x0000f848, 0xffefb4e3, 0x233d0c00, 0x0c405620, 0x33bd459f,
+0xed840648, 0x00689462, 0xb462edea, 0x145d003a, 0x147d0014, 0x14bd0015,
+0x165d0016, 0x00630017, 0x00428000, 0x44d3c000, 0x92900242, 0x007225d0,
+0x147d9290, 0x309d001d, 0x30a00418, 0x163d0100, 0x169d0018, 0x167d0019,
+0x16fd001a, 0x16dd001b, 0xf400001c, 0xf87d0014, 0x60900618, 0x0cb20003,
+0x041830dd, 0x10006090, 0x02ecf400, 0x010030e0, 0x00af9402, 0xc0000231,
+0x40800062, 0xcf8c2dbd, 0xef952fad, 0x00fc3060, 0x00ff30a0, 0x00ff3040,
+0x185dee7f, 0x189d0014, 0x189d0010, 0x18bd0011, 0x187d0015, 0x18fd0016,
+0xec030017, 0x00093240, 0xef086c8d, 0x5080ed04, 0x6e89ffff, 0x0012181d,
+0x03f6f400, 0x0013185d, 0x25a16e09, 0x91500244, 0xcf7a8990, 0x00001852,
+0x001414fd, 0x0015151d, 0x001814bd, 0x001914dd, 0x00036090, 0x0017163d,
+0x0016147d, 0x001b153d, 0x001a145d, 0x800000c6, 0xc00000e7, 0x80000108,
+0xc00000a5, 0x3a900107, 0x44cf44ee, 0x2a900125, 0x252025b0, 0x10006090,
+0x004544cb, 0x6f0f8290, 0xf4000cb1, 0x00100358, 0xb4503a90, 0x0062ffa3,
+0x84424080, 0x02d4f400, 0x001c309d, 0xb402ef90, 0x3060ff9f, 0xec0200fc,
+0x00053240, 0xef046c8b, 0x0c40cfae, 0x001814dd, 0x001914fd, 0x0014149d,
+0x001514bd, 0x001b145d, 0x001a153d, 0x0017151d, 0x0016147d, 0x800000a5,
+0xc00000c6, 0x800000e7, 0xc0000084, 0x44e544f7, 0x010444d6, 0x00a92290,
+0x25b04000, 0x44d544dc, 0x94026e0b, 0x073400a5, 0x6e400ab0, 0xb4c36db0,
+0x18a4fffb, 0x0062ffff, 0x2dbd4080, 0x2fadceed, 0x00ea30e0, 0x3060cf61,
+0xef9100ff, 0x3060cf5d, 0x029400fc, 0x02348000, 0x02738a90, 0x02f14000,
+0x50808a90, 0x30bdffff, 0x30c00418, 0xf4000100, 0x027103f6, 0x0e62a290,
+0x0101b054, 0x008ab402, 0x010033c0, 0x010032a0, 0x72370ee0, 0x309d0001,
+0x03d10418, 0x03c44000, 0x0c9ef150, 0x0014f400, 0x010030a0, 0x00036090,
+0x0312f400, 0x10006090, 0xff22b402, 0x40000137, 0x0418305d, 0x49500122,
+0x295002b2, 0x01003169, 0x0c69cc04, 0x00169563, 0x01230cde, 0x07de39d0,
+0x0000fd03, 0xff00fc47, 0xfff49448, 0xef906db2, 0x00fc3060, 0xfc103040,
+0x808000a2, 0xcf0c2edd, 0xc0400042, 0x00036090, 0x010030e0, 0x02ecf400,
+0x10006090, 0xfef4b402, 0x0cbe0c93, 0x010030c0, 0x03f6f400, 0x010032b5,
+0x02950e62, 0x0fd51390, 0xffafb402, 0x60900ef1, 0xf4000003, 0x60900312,
+0xb4021000, 0x2490fedd, 0x0418307d, 0x32520496, 0x03d2ff00, 0x30d19150,
+0xcc040100, 0x94c30c71, 0x0ce0000e, 0x02440617, 0x6ab02150, 0x94856a40,
+0x6db2fff6, 0xef90cfbd, 0xce560c60, 0xfc7d0ce0, 0x02d60618, 0x00764000,
+0x9675aa90, 0x0c60fe4d, 0x3060ef91, 0xcfb000fc, 0xfc113040, 0x0e20cfcc,
+0xbf8041a2, 0x36703082, 0xe9c00c60, 0xaa9941a3, 0x66553063, 0x41a3e9c0,
+0x50635566, 0xe9c099aa, 0x000141a3, 0x26a03082, 0x00803063, 0x3080e9c0,
+0x30620100, 0xea302680, 0x3042ee01, 0xea202688, 0x2d216930, 0xfffc40a2,
+0x41a34ff1, 0x3063bf80, 0xcbe73670, 0xf400e930, 0x0000032c, 0x41a50000,
+0x6e09a000, 0x0352f400, 0x084030a5, 0xf4006e0b, 0x30bd0032, 0xf4000010,
+0x309d0038, 0x40e00014, 0x0c00fffa, 0xa00041a6, 0xa00041a5, 0x084030c6,
+0x084c30a5, 0x004506eb, 0x8d0c1080, 0xa00041a7, 0x30e70c40, 0x05ae0840,
+0x05ac6a30, 0xb4a26d22, 0xea30fffa, 0x0c0045bf, 0xa00041a5, 0xa00041a4,
+0x084c30a5, 0x08503084, 0x00640659, 0x8d861080, 0x05aa0c40, 0xb4826d22,
+0xe830fffc, 0x0c0045bf, 0x076acc0d, 0x1c446ed0, 0x1c65ffff, 0x0062ffff,
+0xaf893b50, 0x13500043, 0x000740a2, 0xfff2b4c5, 0x459f6e40, 0x459f0c40,
+0x459fed7f, 0x0c00ed01, 0xbf8041a2, 0x29503062, 0x41a3eab0, 0x50631fff,
+0x44b3ffff, 0x29803062, 0x3060eb30, 0x30824003, 0xe9c02930, 0xaa9941a3,
+0x29403082, 0x66553063, 0x41a3e9c0, 0x50635566, 0xe9c099aa, 0x80005060,
+0x29383042, 0x459fe9a0, 0x0c000c40, 0xbf8041a2, 0x29303042, 0x2dbe69a0,
+0x41a4adfd, 0x3044bf80, 0x69202930, 0x400030a0, 0x293430c4, 0x3084eae0,
+0xe9c02940, 0x90000042, 0x0042459f, 0x0c00f880, 0xa00041a3, 0x084c1c43,
+0x9482ee01, 0x0c00001d, 0x084c1883, 0xbf8041a2, 0xaa9941a4, 0x29403062,
+0x66553084, 0x41a4ea30, 0x50845566, 0xea3099aa, 0x80005080, 0x29a830a2,
+0x3080ea50, 0x30420700, 0xea2029a4, 0xe9300c40, 0x0c40459f, 0x800360a4,
+0x900060a4, 0x0c40459f, 0x00559407, 0x41ab0c47, 0x4ff9bf80, 0xaa9941ad,
+0x556641ac, 0x2930308b, 0xd004207d, 0x2940314b, 0x2950324b, 0x2960322b,
+0x2970320b, 0x2938332b, 0x316b0d06, 0x06eb2934, 0x40023300, 0x665531ad,
+0x99aa518c, 0x800051e0, 0x400031c0, 0x195000a8, 0x0000f872, 0x0000fc68,
+0x3108e990, 0xfc680008, 0xe980fffc, 0x0000fb04, 0x0000f9aa, 0x0000f98a,
+0x0000f9f9, 0x2dbe69c0, 0xfffc40a3, 0x0000fd24, 0x0000f9cb, 0x0000f86a,
+0x2000d129, 0x00049409, 0x19d000c8, 0xfc103040, 0x1b9000e3, 0x000440e3,
+0xffd69447, 0x195000a8, 0x5004207d, 0x45bf4704, 0x30406f6e, 0x00a6f800,
+0x004f7950, 0x44aa7a50, 0x139000af, 0x41a7ad38, 0x41a9bf80, 0x41a8aa99,
+0x31c75566, 0x30672950, 0x30c72930, 0x31a72940, 0x31802938, 0x30e74004,
+0x31292934, 0x51086655, 0x516099aa, 0x31408000, 0xf8ae4000, 0xf9830000,
+0xf9260000, 0xf9060000, 0xf96d0000, 0x69300000, 0x40a22d2e, 0x6a30fffc,
+0x0000f947, 0xd084e960, 0x8e052000, 0x080030a5, 0x3040459f, 0x00affc0f,
+0x40e21390, 0x459fffe2, 0x0c000c40, 0x27c12e4f, 0x2e4d8f15, 0x1505076a,
+0x6ed00000, 0x3b100107, 0x445f25f9, 0x18400103, 0x3b100104, 0x263a2538,
+0x4463447a, 0xb4c52ffd, 0x2e4dffee, 0x054a26f0, 0x2d2f459f, 0x00000000,
+0x00030000, 0x01000101, 0x00000000,
+
+/* CRC-32 of the image. */
+0x906b355c
@@ -28,18 +28,148 @@
 
 #include "simba.h"
 #include "../programmer.h"
+#include "../packet_ring.h"
+#include "../packet_crc.h"
+#include "../compat.h"
 #include "kernel/time_mock.h"
 #include "sync/chan_mock.h"
 #include "drivers/basic/pin_mock.h"
 #include "drivers/network/icsp_soft_mock.h"
+#include "drivers/storage/flash_mock.h"
 
 static const uint32_t ramapp_upload_instructions[] = {
 #include "../ramapp_upload_instructions.i"
 };
 
+static const uint32_t ramapp_image[] = {
+#include "../ramapp_image.i"
+};
+
+/* Advances one microsecond per read. */
+static uint32_t cycle_counter;
+
+void cycle_counter_start(void)
+{
+    cycle_counter = 0;
+}
+
+uint32_t cycle_counter_read(void)
+{
+    cycle_counter += CYCLE_COUNTER_FREQUENCY_MHZ;
+
+    return (cycle_counter);
+}
+
+void usart_spi_start(int clock_divider)
+{
+    harness_mock_assert("usart_spi_start(clock_divider)",
+                        &clock_divider,
+                        sizeof(clock_divider));
+}
+
+void usart_spi_set_clock_divider(int clock_divider)
+{
+    harness_mock_assert("usart_spi_set_clock_divider(clock_divider)",
+                        &clock_divider,
+                        sizeof(clock_divider));
+}
+
+void usart_spi_stop(void)
+{
+    harness_mock_read("usart_spi_stop()", NULL, 0);
+}
+
+void usart_spi_transfer(uint8_t *rxbuf_p,
+                        const uint8_t *txbuf_p,
+                        size_t size)
+{
+    harness_mock_assert("usart_spi_transfer(txbuf_p)", txbuf_p, size);
+    harness_mock_read("usart_spi_transfer(): return (rxbuf_p)",
+                      rxbuf_p,
+                      size);
+}
+
+void jtag_start(void)
+{
+    harness_mock_read("jtag_start()", NULL, 0);
+}
+
+void jtag_stop(void)
+{
+    harness_mock_read("jtag_stop()", NULL, 0);
+}
+
+int jtag_clock(int tms, int tdi)
+{
+    int tdo;
+
+    harness_mock_assert("jtag_clock(tms)", &tms, sizeof(tms));
+    harness_mock_assert("jtag_clock(tdi)", &tdi, sizeof(tdi));
+    harness_mock_read("jtag_clock(): return (res)", &tdo, sizeof(tdo));
+
+    return (tdo);
+}
+
+void gang_start(void)
+{
+    harness_mock_read("gang_start()", NULL, 0);
+}
+
+void gang_stop(void)
+{
+    harness_mock_read("gang_stop()", NULL, 0);
+}
+
+void gang_clock(uint32_t pged)
+{
+    harness_mock_assert("gang_clock(pged)", &pged, sizeof(pged));
+}
+
+uint32_t gang_sample(void)
+{
+    uint32_t tdo;
+
+    harness_mock_read("gang_sample(): return (res)", &tdo, sizeof(tdo));
+
+    return (tdo);
+}
+
+static void write_usart_spi_start(int clock_divider)
+{
+    harness_mock_write("usart_spi_start(clock_divider)",
+                       &clock_divider,
+                       sizeof(clock_divider));
+}
+
+static void write_usart_spi_set_clock_divider(int clock_divider)
+{
+    harness_mock_write("usart_spi_set_clock_divider(clock_divider)",
+                       &clock_divider,
+                       sizeof(clock_divider));
+}
+
+static void write_usart_spi_stop(void)
+{
+    harness_mock_write("usart_spi_stop()", NULL, 0);
+}
+
+static void write_usart_spi_transfer(const uint8_t *rxbuf_p,
+                                     const uint8_t *txbuf_p,
+                                     size_t size)
+{
+    harness_mock_write("usart_spi_transfer(txbuf_p)", txbuf_p, size);
+    harness_mock_write("usart_spi_transfer(): return (rxbuf_p)",
+                       rxbuf_p,
+                       size);
+}
+
+/* Number of written IR and DR scans. */
+static int number_of_scans = 0;
+
 static void write_send_command(uint8_t command, int res)
 {
     mock_write_icsp_soft_instruction_write(&command, 5, res);
+    number_of_scans++;
 }
 
 static int write_enter_serial_execution_mode(int mtap_sw_mtap_res,
@@ -135,6 +265,7 @@ static void write_xfer_data_32(uint32_t request,
                                        (uint8_t *)&request,
                                        32,
                                        res);
+    number_of_scans++;
 }
 
 static int write_xfer_instruction(uint32_t instruction,
@@ -186,31 +317,182 @@ static int write_xfer_instruction(uint32_t instruction,
     return (xfer_data_32_res_3);
 }
 
-static int write_upload_ramapp(int etap_control_res,
+static int write_xfer_instruction_speculative(uint32_t instruction,
+                                              int etap_data_res,
+                                              int xfer_data_32_res,
+                                              int etap_control_res,
+                                              int xfer_data_32_res_2,
+                                              int pracc)
+{
+    write_send_command(0x90, etap_data_res);
+
+    if (etap_data_res != 0) {
+        return (-1);
+    }
+
+    write_xfer_data_32(bits_reverse_32(instruction), 0, xfer_data_32_res);
+
+    if (xfer_data_32_res != 0) {
+        return (-1);
+    }
+
+    write_send_command(0x50, etap_control_res);
+
+    if (etap_control_res != 0) {
+        return (-1);
+    }
+
+    /* PrAcc in the captured control register. */
+    write_xfer_data_32(0x0030000,
+                       (pracc ? 0xffffffff : 0),
+                       xfer_data_32_res_2);
+
+    return (xfer_data_32_res_2);
+}
+
+/**
+ * Write a loader upload where given instruction is not accepted
+ * speculatively, and it and the rest are transferred with
+ * polling. The jump and its delay slot are always transferred with
+ * polling.
+ */
+static void write_upload_loader_miss(size_t miss)
+{
+    size_t i;
+    size_t jump;
+
+    jump = (membersof(ramapp_upload_instructions) - 1);
+
+    for (i = 0; (i < miss) && (i < jump); i++) {
+        write_xfer_instruction_speculative(ramapp_upload_instructions[i],
+                                           0, 0, 0, 0, 1);
+    }
+
+    if (i < jump) {
+        write_xfer_instruction_speculative(ramapp_upload_instructions[i],
+                                           0, 0, 0, 0, 0);
+    }
+
+    for (; i <= jump; i++) {
+        write_xfer_instruction(ramapp_upload_instructions[i],
+                               0, 0, 0, 0, 0, 0);
+    }
+
+    write_xfer_instruction(0, 0, 0, 0, 0, 0, 0);
+}
+
+static int write_upload_loader(int etap_control_res,
                                int xfer_data_32_res,
                                int etap_data_res,
                                int xfer_data_32_res_2,
                                int etap_control_res_2,
                                int xfer_data_32_res_3)
+{
+    /* Polling is only done after a miss. */
+    if ((etap_control_res != 0) || (xfer_data_32_res != 0)) {
+        write_xfer_instruction_speculative(ramapp_upload_instructions[0],
+                                           0, 0, 0, 0, 0);
+
+        return (write_xfer_instruction(ramapp_upload_instructions[0],
+                                       etap_control_res,
+                                       xfer_data_32_res,
+                                       etap_data_res,
+                                       xfer_data_32_res_2,
+                                       etap_control_res_2,
+                                       xfer_data_32_res_3));
+    }
+
+    if ((etap_data_res != 0)
+        || (xfer_data_32_res_2 != 0)
+        || (etap_control_res_2 != 0)
+        || (xfer_data_32_res_3 != 0)) {
+        return (write_xfer_instruction_speculative(
+                    ramapp_upload_instructions[0],
+                    etap_data_res,
+                    xfer_data_32_res_2,
+                    etap_control_res_2,
+                    xfer_data_32_res_3,
+                    1));
+    }
+
+    write_upload_loader_miss(membersof(ramapp_upload_instructions));
+
+    return (0);
+}
+
+static void write_upload_ramapp(uint32_t result, int res)
 {
     size_t i;
-    int res;
+    uint32_t data;
+    struct time_t time;
 
-    for (i = 0; i < membersof(ramapp_upload_instructions); i++) {
-        res = write_xfer_instruction(ramapp_upload_instructions[i],
-                                     etap_control_res,
-                                     xfer_data_32_res,
-                                     etap_data_res,
-                                     xfer_data_32_res_2,
-                                     etap_control_res_2,
-                                     xfer_data_32_res_3);
-
-        if (res != 0) {
-            return (-1);
-        }
+    for (i = 0; i < membersof(ramapp_image); i++) {
+        data = htonl(ramapp_image[i]);
+        mock_write_icsp_soft_fast_data_write((uint8_t *)&data, 4, 0);
     }
 
-    return (write_xfer_instruction(0, 0, 0, 0, 0, 0, 0));
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+    mock_write_time_get(&time, 0);
+    mock_write_icsp_soft_fast_data_read(&result, res);
+    mock_write_time_get(&time, 0);
+}
+
+/* All features of the ramapp in the ramapp image. */
+#define RAMAPP_FEATURES                                  0x3f
+
+static void write_ramapp_write(uint8_t *buf_p, size_t size, int res);
+static void write_ramapp_read(uint8_t *buf_p, size_t size, ssize_t res);
+
+/**
+ * The production mode status pins are configured when the programmer
+ * is initialized.
+ */
+static void write_programmer_init(void)
+{
+    mock_write_pin_init(&pin_d5_dev, PIN_OUTPUT, 0);
+    mock_write_pin_write(0, 0);
+    mock_write_pin_init(&pin_d6_dev, PIN_OUTPUT, 0);
+    mock_write_pin_write(0, 0);
+    mock_write_pin_init(&pin_d13_dev, PIN_OUTPUT, 0);
+    mock_write_pin_write(0, 0);
+    mock_write_pin_init(&pin_d7_dev, PIN_INPUT, 0);
+}
+
+/**
+ * The features request after the ramapp upload. A ramapp without
+ * features fails it.
+ */
+static void write_ramapp_features(uint32_t features)
+{
+    uint8_t request[] = { 0x00, 0x08, 0x00, 0x00, 0x2d, 0x61 };
+    uint8_t response[] = {
+        0x00, 0x08, 0x00, 0x08,
+        0x00, 0x00, 0x00, 0x00, /* Features. */
+        0x00, 0x00, 0x08, 0x00, /* Size of code and constants. */
+        0x00, 0x00
+    };
+    uint8_t failure_response[] = {
+        0xff, 0xff, 0x00, 0x04, 0xff, 0xff, 0xfc, 0x15, 0x19, 0xfe
+    };
+    uint16_t crc;
+
+    write_ramapp_write(&request[0], sizeof(request), sizeof(request));
+
+    if (features == 0) {
+        write_ramapp_read(&failure_response[0],
+                          sizeof(failure_response),
+                          sizeof(failure_response));
+    } else {
+        response[4] = (features >> 24);
+        response[5] = (features >> 16);
+        response[6] = (features >> 8);
+        response[7] = (features >> 0);
+        crc = packet_crc_ccitt(0xffff, &response[0], 12);
+        response[12] = (crc >> 8);
+        response[13] = crc;
+        write_ramapp_read(&response[0], sizeof(response), sizeof(response));
+    }
 }
 
 static void write_read_command_request(uint8_t *header_p,
@@ -275,7 +557,7 @@ static void write_handle_connect(int enter_serial_execution_mode_mtap_sw_mtap_re
         return;
     }
 
-    res = write_upload_ramapp(upload_ramapp_etap_control_res,
+    res = write_upload_loader(upload_ramapp_etap_control_res,
                               upload_ramapp_xfer_data_32_res,
                               upload_ramapp_etap_data_res,
                               upload_ramapp_xfer_data_32_res_2,
@@ -287,6 +569,13 @@ static void write_handle_connect(int enter_serial_execution_mode_mtap_sw_mtap_re
     }
 
     write_send_command(0x70, etap_fastdata_res);
+
+    if (etap_fastdata_res != 0) {
+        return;
+    }
+
+    write_upload_ramapp(0, 0);
+    write_ramapp_features(RAMAPP_FEATURES);
 }
 
 static void write_programmer_process_packet(uint8_t *header_p,
@@ -305,12 +594,34 @@ static void write_programmer_process_packet(uint8_t *header_p,
                           response_size);
 }
 
-static int connect(struct programmer_t *programmer_p)
+/**
+ * Enter serial execution mode and start a ramapp with given features.
+ */
+static void write_start_ramapp(uint32_t features)
+{
+    mock_write_icsp_soft_init(&pin_d2_dev,
+                              &pin_d3_dev,
+                              &pin_d4_dev,
+                              0);
+    mock_write_icsp_soft_start(0);
+    write_enter_serial_execution_mode(0, 0, 0, 0xff, 0, 0, 0, 0, 0, 0, 0);
+    write_upload_loader(0, 0, 0, 0, 0, 0);
+    write_send_command(0x70, 0);
+    write_upload_ramapp(0, 0);
+    write_ramapp_features(features);
+}
+
+/**
+ * Connect to a PIC running a ramapp with given features.
+ */
+static int connect_ramapp_features(struct programmer_t *programmer_p,
+                                   uint32_t features)
 {
     uint8_t request_header[] = { 0x00, 0x65, 0x00, 0x00 };
     uint8_t request_crc[] = { 0xf4, 0x5b };
     uint8_t response[] = { 0x00, 0x65, 0x00, 0x00, 0xf4, 0x5b };
 
+    write_programmer_init();
     BTASSERT(programmer_init(programmer_p) == 0);
 
     write_programmer_process_packet(&request_header[0],
@@ -319,30 +630,18 @@ static int connect(struct programmer_t *programmer_p)
                                     sizeof(request_crc),
                                     &response[0],
                                     sizeof(response));
-    write_handle_connect(0,
-                         0,
-                         0,
-                         0xff,
-                         0,
-                         0,
-                         0,
-                         0,
-                         0,
-                         0,
-                         0,
-                         0,
-                         0,
-                         0,
-                         0,
-                         0,
-                         0,
-                         0);
+    write_start_ramapp(features);
 
     BTASSERTI(programmer_process_packet(programmer_p), ==, 0);
 
     return (0);
 }
 
+static int connect(struct programmer_t *programmer_p)
+{
+    return (connect_ramapp_features(programmer_p, RAMAPP_FEATURES));
+}
+
 static void write_ramapp_write(uint8_t *buf_p, size_t size, int res)
 {
     size_t offset;
@@ -410,6 +709,26 @@ static void write_ramapp_read(uint8_t *buf_p, size_t size, ssize_t res)
     }
 }
 
+/**
+ * A fast write row, followed by the CRC of all rows written so far.
+ *
+ * @return The CRC including given row.
+ */
+static uint16_t write_ramapp_fast_write_row(uint8_t *buf_p, uint16_t crc)
+{
+    uint8_t word[4];
+
+    write_ramapp_write(buf_p, 256, 256);
+    crc = packet_crc_ccitt(crc, buf_p, 256);
+    word[0] = 0;
+    word[1] = 0;
+    word[2] = (crc >> 8);
+    word[3] = crc;
+    mock_write_icsp_soft_fast_data_write(&word[0], 4, 0);
+
+    return (crc);
+}
+
 static void write_chip_erase(int mtap_sw_mtap_res,
                              int mtap_command_res,
                              int mchp_erase_res,
@@ -491,7 +810,6 @@ static void write_handle_fast_write(uint8_t *request_p,
 {
     uint8_t buf[256];
     struct time_t time;
-    uint16_t ack;
 
     /* Request to ramapp. */
     write_ramapp_write(request_p, request_size, forward_ramapp_write_res);
@@ -513,14 +831,13 @@ static void write_handle_fast_write(uint8_t *request_p,
         return;
     }
 
-    write_ramapp_write(&buf[0], sizeof(buf), ramapp_write_res);
-
     if (ramapp_write_res != sizeof(buf)) {
+        write_ramapp_write(&buf[0], sizeof(buf), ramapp_write_res);
+
         return;
     }
 
-    ack = 0;
-    mock_write_chan_write(&ack, sizeof(ack), sizeof(ack));
+    write_ramapp_fast_write_row(&buf[0], 0xffff);
 
     /* Response from ramapp. */
     write_ramapp_read(response_p, response_size, ramapp_read_res);
@@ -540,6 +857,7 @@ static int test_ping(void)
                                     &response[0],
                                     sizeof(response));
 
+    write_programmer_init();
     BTASSERT(programmer_init(&programmer) == 0);
     BTASSERTI(programmer_process_packet(&programmer), ==, 0);
 
@@ -725,6 +1043,7 @@ static int test_connect_enter_serial_execution_mode_failure(void)
                               sizeof(datas[i].response),
                               sizeof(datas[i].response));
 
+        write_programmer_init();
         BTASSERTI(programmer_init(&programmer), ==, 0);
         BTASSERTI(programmer_process_packet(&programmer), ==, 0);
     }
@@ -825,6 +1144,7 @@ static int test_connect_upload_ramapp_failure(void)
                               sizeof(datas[i].response),
                               sizeof(datas[i].response));
 
+        write_programmer_init();
         BTASSERTI(programmer_init(&programmer), ==, 0);
         BTASSERTI(programmer_process_packet(&programmer), ==, 0);
     }
@@ -832,6 +1152,125 @@ static int test_connect_upload_ramapp_failure(void)
     return (0);
 }
 
+static int test_connect_upload_ramapp_crc_failure(void)
+{
+    struct programmer_t programmer;
+    size_t i;
+    uint32_t data;
+    struct time_t time;
+    uint8_t request_header[] = { 0x00, 0x65, 0x00, 0x00 };
+    uint8_t request_crc[] = { 0xf4, 0x5b };
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xd8, 0xef, /* Error code -ERAMAPPUPLOAD. */
+        0x9d, 0x89
+    };
+
+    write_read_command_request(&request_header[0],
+                               sizeof(request_header),
+                               &request_crc[0],
+                               sizeof(request_crc));
+    mock_write_icsp_soft_init(&pin_d2_dev,
+                              &pin_d3_dev,
+                              &pin_d4_dev,
+                              0);
+    mock_write_icsp_soft_start(0);
+    write_enter_serial_execution_mode(0, 0, 0, 0xff, 0, 0, 0, 0, 0, 0, 0);
+    write_upload_loader(0, 0, 0, 0, 0, 0);
+    write_send_command(0x70, 0);
+
+    for (i = 0; i < membersof(ramapp_image); i++) {
+        data = htonl(ramapp_image[i]);
+        mock_write_icsp_soft_fast_data_write((uint8_t *)&data, 4, 0);
+    }
+
+    /* The loader is busy calculating the CRC, and then responds with
+       a mismatch. */
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+    mock_write_time_get(&time, 0);
+    data = 0;
+    mock_write_icsp_soft_fast_data_read(&data, -EPROTO);
+    mock_write_time_get(&time, 0);
+    data = 0x00000001;
+    mock_write_icsp_soft_fast_data_read(&data, 0);
+    mock_write_time_get(&time, 0);
+    mock_write_chan_write(&response[0], sizeof(response), sizeof(response));
+
+    write_programmer_init();
+    BTASSERTI(programmer_init(&programmer), ==, 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+/**
+ * Connect where the speculative loader upload misses at given
+ * instruction.
+ *
+ * @return Number of scans of the loader upload.
+ */
+static int connect_upload_loader_miss(size_t miss)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x65, 0x00, 0x00 };
+    uint8_t request_crc[] = { 0xf4, 0x5b };
+    uint8_t response[] = { 0x00, 0x65, 0x00, 0x00, 0xf4, 0x5b };
+    int res;
+
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_crc[0],
+                                    sizeof(request_crc),
+                                    &response[0],
+                                    sizeof(response));
+    mock_write_icsp_soft_init(&pin_d2_dev,
+                              &pin_d3_dev,
+                              &pin_d4_dev,
+                              0);
+    mock_write_icsp_soft_start(0);
+    write_enter_serial_execution_mode(0, 0, 0, 0xff, 0, 0, 0, 0, 0, 0, 0);
+    number_of_scans = 0;
+    write_upload_loader_miss(miss);
+    res = number_of_scans;
+    write_send_command(0x70, 0);
+    write_upload_ramapp(0, 0);
+    write_ramapp_features(RAMAPP_FEATURES);
+
+    write_programmer_init();
+    BTASSERTI(programmer_init(&programmer), ==, 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (res);
+}
+
+static int test_connect_upload_loader_speculative(void)
+{
+    int speculative;
+    int strict;
+    int n;
+
+    n = membersof(ramapp_upload_instructions);
+
+    /* Miss in the middle of the upload. */
+    BTASSERTI(connect_upload_loader_miss(5), ==, 4 * 6 + 6 * (n - 5 + 1));
+
+    /* Four scans per instruction instead of six, except for the jump
+       and its delay slot. The strict upload also starts with a
+       miss. */
+    speculative = connect_upload_loader_miss(n);
+    strict = connect_upload_loader_miss(0);
+
+    std_printf(OSTR("Loader upload scans: speculative %d, strict %d.\r\n"),
+               speculative,
+               strict);
+
+    BTASSERTI(speculative, ==, 4 * (n - 1) + 6 * 2);
+    BTASSERTI(strict, ==, 4 + 6 * (n + 1));
+
+    return (0);
+}
+
 static int test_disconnect(void)
 {
     struct programmer_t programmer;
@@ -872,6 +1311,7 @@ static int test_disconnect_not_connected(void)
                                     &response[0],
                                     sizeof(response));
 
+    write_programmer_init();
     BTASSERT(programmer_init(&programmer) == 0);
     BTASSERTI(programmer_process_packet(&programmer), ==, 0);
 
@@ -892,6 +1332,7 @@ static int test_reset(void)
                                     &response[0],
                                     sizeof(response));
 
+    write_programmer_init();
     mock_write_pin_init(&pin_d4_dev, PIN_OUTPUT, 0);
     mock_write_pin_write(0, 0);
     mock_write_pin_set_mode(PIN_INPUT, 0);
@@ -918,6 +1359,7 @@ static int test_bad_command_type(void)
                                     &response[0],
                                     sizeof(response));
 
+    write_programmer_init();
     BTASSERT(programmer_init(&programmer) == 0);
     BTASSERTI(programmer_process_packet(&programmer), ==, 0);
 
@@ -940,6 +1382,7 @@ static int test_bad_command_crc(void)
                                     &response[0],
                                     sizeof(response));
 
+    write_programmer_init();
     BTASSERT(programmer_init(&programmer) == 0);
     BTASSERTI(programmer_process_packet(&programmer), ==, 0);
 
@@ -958,6 +1401,7 @@ static int test_command_read_header_timeout(void)
                                       sizeof(request_header),
                                       &time,
                                       -ETIMEDOUT);
+    write_programmer_init();
     BTASSERT(programmer_init(&programmer) == 0);
     BTASSERTI(programmer_process_packet(&programmer), ==, -ETIMEDOUT);
 
@@ -982,6 +1426,7 @@ static int test_command_read_crc_timeout(void)
                                       &time,
                                       -ETIMEDOUT);
 
+    write_programmer_init();
     BTASSERT(programmer_init(&programmer) == 0);
     BTASSERTI(programmer_process_packet(&programmer), ==, -ETIMEDOUT);
 
@@ -1013,37 +1458,137 @@ static int test_ramapp_command(void)
     return (0);
 }
 
-static int test_ramapp_command_fast_data_write_fail(void)
+static int test_ramapp_command_extended_response(void)
 {
     struct programmer_t programmer;
-    uint8_t request[] = { 0x00, 0x01, 0x00, 0x00, 0x57, 0x80 };
-    uint8_t response[] = {
-        0xff, 0xff, 0x00, 0x04, 0xff, 0xff, 0xff, 0xfe, 0x00, 0xe8
+    uint8_t request[] = {
+        0x00, 0x03, 0x00, 0x08,
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x04, 0x4c, /* Size. */
+        0xfb, 0xa0
     };
+    uint8_t response[8 + 1100 + 2];
+    uint8_t failure_response[] = {
+        0xff, 0xff, 0x00, 0x04, 0xff, 0xff, 0xff, 0xfb, 0x50, 0x4d
+    };
+    size_t i;
+
+    /* Type, extended size, data and crc. */
+    response[0] = 0x00;
+    response[1] = 0x03;
+    response[2] = 0xff;
+    response[3] = 0xff;
+    response[4] = 0x00;
+    response[5] = 0x00;
+    response[6] = 0x04;
+    response[7] = 0x4c;
+
+    for (i = 0; i < 1100; i++) {
+        response[8 + i] = i;
+    }
+
+    response[8 + 1100] = 0x12;
+    response[8 + 1100 + 1] = 0x34;
 
     BTASSERT(connect(&programmer) == 0);
 
     write_read_command_request(&request[0],
                                4,
                                &request[4],
-                               2);
-    mock_write_icsp_soft_fast_data_write(&request[0],
-                                         4,
-                                         -2);
-    mock_write_chan_write(&response[0],
-                          sizeof(response),
-                          sizeof(response));
+                               10);
+    write_ramapp_write(&request[0], sizeof(request), sizeof(request));
+    write_ramapp_read(&response[0], sizeof(response), sizeof(response));
+
+    /* Forwarded in parts. */
+    mock_write_chan_write(&response[0], 1032, 1032);
+    mock_write_chan_write(&response[1032],
+                          sizeof(response) - 1032,
+                          sizeof(response) - 1032);
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* Read error before the first part is sent. */
+    write_read_command_request(&request[0],
+                               4,
+                               &request[4],
+                               10);
+    write_ramapp_write(&request[0], sizeof(request), sizeof(request));
+    write_ramapp_read(&response[0], 16, 16);
+    write_ramapp_read(NULL, 0, -EIO);
+    mock_write_chan_write(&failure_response[0],
+                          sizeof(failure_response),
+                          sizeof(failure_response));
 
     BTASSERTI(programmer_process_packet(&programmer), ==, 0);
 
     return (0);
 }
 
-static int test_chip_erase(void)
+/**
+ * A ramapp without extended read responses is not asked for more
+ * than 1024 bytes.
+ */
+static int test_ramapp_command_extended_read_without_feature(void)
 {
     struct programmer_t programmer;
-    uint8_t request_header[] = { 0x00, 0x69, 0x00, 0x00 };
-    uint8_t request_crc[] = { 0x81, 0x3a };
+    uint8_t request[] = {
+        0x00, 0x03, 0x00, 0x08,
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x04, 0x4c, /* Size. */
+        0xfb, 0xa0
+    };
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0xa6, /* -EMSGSIZE. */
+        0xdb, 0x15
+    };
+
+    BTASSERT(connect_ramapp_features(&programmer, 0) == 0);
+
+    write_read_command_request(&request[0],
+                               4,
+                               &request[4],
+                               10);
+    mock_write_chan_write(&response[0],
+                          sizeof(response),
+                          sizeof(response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_ramapp_command_fast_data_write_fail(void)
+{
+    struct programmer_t programmer;
+    uint8_t request[] = { 0x00, 0x01, 0x00, 0x00, 0x57, 0x80 };
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x04, 0xff, 0xff, 0xff, 0xfe, 0x00, 0xe8
+    };
+
+    BTASSERT(connect(&programmer) == 0);
+
+    write_read_command_request(&request[0],
+                               4,
+                               &request[4],
+                               2);
+    mock_write_icsp_soft_fast_data_write(&request[0],
+                                         4,
+                                         -2);
+    mock_write_chan_write(&response[0],
+                          sizeof(response),
+                          sizeof(response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_chip_erase(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x69, 0x00, 0x00 };
+    uint8_t request_crc[] = { 0x81, 0x3a };
     uint8_t response[] = {
         0x00, 0x69, 0x00, 0x00, 0x81, 0x3a
     };
@@ -1065,6 +1610,7 @@ static int test_chip_erase(void)
 
     mock_write_icsp_soft_stop(0);
 
+    write_programmer_init();
     BTASSERT(programmer_init(&programmer) == 0);
     BTASSERTI(programmer_process_packet(&programmer), ==, 0);
 
@@ -1149,6 +1695,7 @@ static int test_chip_erase_errors(void)
 
         mock_write_icsp_soft_stop(0);
 
+        write_programmer_init();
         BTASSERT(programmer_init(&programmer) == 0);
         BTASSERTI(programmer_process_packet(&programmer), ==, 0);
     }
@@ -1174,9 +1721,92 @@ static int test_version(void)
                                     &response[0],
                                     sizeof(response));
 
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_capabilities(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x6e, 0x00, 0x00 };
+    uint8_t request_crc[] = { 0x04, 0xaa };
+    uint8_t response[] = {
+        0x00, 0x6e, 0x00, 0x13,
+        0x02,                   /* Protocol version. */
+        0x04, 0x00,             /* Maximum request payload. */
+        0x00, 0x00, 0x04, 0x00, /* Maximum response payload. */
+        0x01, 0x00,             /* Row size. */
+        0x00, 0x01,             /* Window. */
+        0x00, 0x00, 0x00, 0x7a, /* Optional commands. */
+        0x00, 0x00, 0x01, 0x00, /* Staging slice size. */
+        0x4f, 0x27
+    };
+    uint8_t connected_response[] = {
+        0x00, 0x6e, 0x00, 0x13,
+        0x02,                   /* Protocol version. */
+        0x04, 0x00,             /* Maximum request payload. */
+        0x00, 0x01, 0x00, 0x00, /* Maximum response payload. */
+        0x01, 0x00,             /* Row size. */
+        0x00, 0x01,             /* Window. */
+        0x00, 0x00, 0x01, 0xfa, /* Optional commands. */
+        0x00, 0x00, 0x01, 0x00, /* Staging slice size. */
+        0x7b, 0x0e
+    };
+    uint8_t window_response[] = {
+        0x00, 0x6e, 0x00, 0x13,
+        0x02,                   /* Protocol version. */
+        0x04, 0x00,             /* Maximum request payload. */
+        0x00, 0x01, 0x00, 0x00, /* Maximum response payload. */
+        0x01, 0x00,             /* Row size. */
+        0x00, 0x40,             /* Window. */
+        0x00, 0x00, 0x01, 0xfa, /* Optional commands. */
+        0x00, 0x00, 0x20, 0x00, /* Staging slice size. */
+        0xfa, 0x23
+    };
+    struct programmer_link_t link;
+
+    /* Commands depending on ramapp features are not available until
+       connected. */
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_crc[0],
+                                    sizeof(request_crc),
+                                    &response[0],
+                                    sizeof(response));
+
+    write_programmer_init();
     BTASSERT(programmer_init(&programmer) == 0);
     BTASSERTI(programmer_process_packet(&programmer), ==, 0);
 
+    BTASSERT(connect(&programmer) == 0);
+
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_crc[0],
+                                    sizeof(request_crc),
+                                    &connected_response[0],
+                                    sizeof(connected_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* The staging slice size is limited by the window of the link,
+       and then by the configured size. */
+    link = *programmer.link_p;
+    link.window = 64;
+    programmer_set_link(&programmer, &link);
+
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_crc[0],
+                                    sizeof(request_crc),
+                                    &window_response[0],
+                                    sizeof(window_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
     return (0);
 }
 
@@ -1191,7 +1821,7 @@ static int test_fast_write(void)
         0x24, 0xac
     };
     uint8_t response[] = {
-        0x00, 0x6a, 0x00, 0x00, 0x00, 0x00
+        0x00, 0x6a, 0x00, 0x00, 0xd8, 0x6a
     };
 
     BTASSERT(connect(&programmer) == 0);
@@ -1217,6 +1847,285 @@ static int test_fast_write(void)
     return (0);
 }
 
+/**
+ * A ramapp without features is not given the row crc words, and a
+ * response with a bad CRC fails the fast write.
+ */
+static int test_fast_write_ramapp_without_features(void)
+{
+    struct programmer_t programmer;
+    uint8_t request[] = {
+        0x00, 0x6a, 0x00, 0x0a,
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x01, 0x00, /* Size. */
+        0x12, 0x34, /* Crc. */
+        0x24, 0xac
+    };
+    uint8_t response[] = {
+        0x00, 0x6a, 0x00, 0x00, 0xd8, 0x6a
+    };
+    uint8_t bad_crc_response[] = {
+        0x00, 0x6a, 0x00, 0x00, 0xd8, 0x6b
+    };
+    uint8_t failure_response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0xb9, /* -EPROTO. */
+        0x38, 0xcb
+    };
+    uint8_t buf[256];
+    struct time_t time;
+    int i;
+
+    BTASSERT(connect_ramapp_features(&programmer, 0) == 0);
+
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+    memset(&buf[0], 1, sizeof(buf));
+
+    for (i = 0; i < 2; i++) {
+        write_read_command_request(&request[0],
+                                   4,
+                                   &request[4],
+                                   12);
+        write_ramapp_write(&request[0], sizeof(request), sizeof(request));
+        mock_write_chan_read_with_timeout(&buf[0],
+                                          sizeof(buf),
+                                          &time,
+                                          sizeof(buf));
+        write_ramapp_write(&buf[0], sizeof(buf), sizeof(buf));
+
+        if (i == 0) {
+            write_ramapp_read(&response[0],
+                              sizeof(response),
+                              sizeof(response));
+            mock_write_chan_write(&response[0],
+                                  sizeof(response),
+                                  sizeof(response));
+        } else {
+            write_ramapp_read(&bad_crc_response[0],
+                              sizeof(bad_crc_response),
+                              sizeof(bad_crc_response));
+            mock_write_chan_write(&failure_response[0],
+                                  sizeof(failure_response),
+                                  sizeof(failure_response));
+        }
+
+        BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+    }
+
+    return (0);
+}
+
+static int test_fast_write_window(void)
+{
+    struct programmer_t programmer;
+    struct programmer_link_t link;
+    uint8_t request[] = {
+        0x00, 0x6a, 0x00, 0x0a,
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x06, 0x00, /* Size. */
+        0x12, 0x34, /* Crc. */
+        0x75, 0x81
+    };
+    uint8_t credits_3[] = { 0x00, 0x00, 0x00, 0x03 };
+    uint8_t credits_2[] = { 0x00, 0x00, 0x00, 0x02 };
+    uint8_t response[] = {
+        0x00, 0x6a, 0x00, 0x00, 0xd8, 0x6a
+    };
+    uint8_t buf[256];
+    struct time_t time;
+    uint16_t crc;
+    int i;
+
+    BTASSERT(connect(&programmer) == 0);
+
+    /* Four packets ahead, with credits returned two at a time. */
+    link = *programmer.link_p;
+    link.window = 4;
+    programmer_set_link(&programmer, &link);
+
+    write_read_command_request(&request[0],
+                               4,
+                               &request[4],
+                               12);
+    write_ramapp_write(&request[0], sizeof(request), sizeof(request));
+    mock_write_chan_write(&credits_3[0],
+                          sizeof(credits_3),
+                          sizeof(credits_3));
+
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+    memset(&buf[0], 1, sizeof(buf));
+    crc = 0xffff;
+
+    for (i = 0; i < 6; i++) {
+        mock_write_chan_read_with_timeout(&buf[0],
+                                          sizeof(buf),
+                                          &time,
+                                          sizeof(buf));
+
+        if (i == 1) {
+            mock_write_chan_write(&credits_2[0],
+                                  sizeof(credits_2),
+                                  sizeof(credits_2));
+        }
+
+        crc = write_ramapp_fast_write_row(&buf[0], crc);
+    }
+
+    write_ramapp_read(&response[0], sizeof(response), sizeof(response));
+    mock_write_chan_write(&response[0],
+                          sizeof(response),
+                          sizeof(response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_staged_write(void)
+{
+    struct programmer_t programmer;
+    uint8_t stage_request[] = {
+        0x00, 0x6f, 0x00, 0x07,
+        0x00,                   /* Slice. */
+        0x00, 0x00, 0x02, 0x00, /* Size. */
+        0xf5, 0x9a,             /* Crc. */
+        0x2d, 0x1e
+    };
+    uint8_t stage_response[] = { 0x00, 0x6f, 0x00, 0x00, 0x33, 0x9a };
+    uint8_t staged_write_request[] = {
+        0x00, 0x70, 0x00, 0x05,
+        0x00,                   /* Slice. */
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0xc9, 0x5e
+    };
+    uint8_t ramapp_request[] = {
+        0x00, 0x6a, 0x00, 0x0a,
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x02, 0x00, /* Size. */
+        0xf5, 0x9a,             /* Crc. */
+        0x62, 0x71
+    };
+    uint8_t ramapp_response[] = {
+        0x00, 0x6a, 0x00, 0x00, 0xd8, 0x6a
+    };
+    uint8_t staged_write_response[] = {
+        0x00, 0x70, 0x00, 0x00, 0x5c, 0xc8
+    };
+    uint8_t not_staged_response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0xea, /* -EINVAL. */
+        0x52, 0x5d
+    };
+    uint8_t data[512];
+    struct programmer_link_t link;
+    struct time_t time;
+
+    BTASSERT(connect(&programmer) == 0);
+
+    /* Slices of two rows. */
+    link = *programmer.link_p;
+    link.window = 2;
+    programmer_set_link(&programmer, &link);
+
+    /* Upload a slice to the staging buffer. */
+    write_read_command_request(&stage_request[0],
+                               4,
+                               &stage_request[4],
+                               9);
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+    memset(&data[0], 1, sizeof(data));
+    mock_write_chan_read_with_timeout(&data[0],
+                                      sizeof(data),
+                                      &time,
+                                      sizeof(data));
+    mock_write_chan_write(&stage_response[0],
+                          sizeof(stage_response),
+                          sizeof(stage_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* Write it to flash. */
+    write_read_command_request(&staged_write_request[0],
+                               4,
+                               &staged_write_request[4],
+                               7);
+    write_ramapp_write(&ramapp_request[0],
+                       sizeof(ramapp_request),
+                       sizeof(ramapp_request));
+    write_ramapp_fast_write_row(&data[256],
+                                write_ramapp_fast_write_row(&data[0],
+                                                            0xffff));
+    write_ramapp_read(&ramapp_response[0],
+                      sizeof(ramapp_response),
+                      sizeof(ramapp_response));
+    mock_write_chan_write(&staged_write_response[0],
+                          sizeof(staged_write_response),
+                          sizeof(staged_write_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* The slice is consumed. */
+    write_read_command_request(&staged_write_request[0],
+                               4,
+                               &staged_write_request[4],
+                               7);
+    mock_write_chan_write(&not_staged_response[0],
+                          sizeof(not_staged_response),
+                          sizeof(not_staged_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_stage_bad_crc(void)
+{
+    struct programmer_t programmer;
+    uint8_t request[] = {
+        0x00, 0x6f, 0x00, 0x07,
+        0x00,                   /* Slice. */
+        0x00, 0x00, 0x02, 0x00, /* Size. */
+        0xf5, 0x9b,             /* Bad crc. */
+        0x3d, 0x3f
+    };
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xfc, 0x11, /* -EBADCRC. */
+        0x59, 0x7a
+    };
+    uint8_t data[512];
+    struct programmer_link_t link;
+    struct time_t time;
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+    link = *programmer.link_p;
+    link.window = 2;
+    programmer_set_link(&programmer, &link);
+
+    write_read_command_request(&request[0],
+                               4,
+                               &request[4],
+                               9);
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+    memset(&data[0], 1, sizeof(data));
+    mock_write_chan_read_with_timeout(&data[0],
+                                      sizeof(data),
+                                      &time,
+                                      sizeof(data));
+    mock_write_chan_write(&response[0],
+                          sizeof(response),
+                          sizeof(response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
 static int test_fast_write_not_connected(void)
 {
     struct programmer_t programmer;
@@ -1240,6 +2149,7 @@ static int test_fast_write_not_connected(void)
                                     &response[0],
                                     sizeof(response));
 
+    write_programmer_init();
     BTASSERT(programmer_init(&programmer) == 0);
     BTASSERTI(programmer_process_packet(&programmer), ==, 0);
 
@@ -1258,7 +2168,8 @@ static int test_fast_write_errors(void)
         int chan_read_with_timeout_res;
         int ramapp_write_res;
         int ramapp_read_res;
-        uint8_t response[10];
+        uint8_t response[14];
+        size_t response_size;
     } datas[] = {
         {
             .request = {
@@ -1274,7 +2185,8 @@ static int test_fast_write_errors(void)
                 0xff, 0xff, 0x00, 0x04,
                 0xff, 0xff, 0xff, 0xa6, /* -EMSGSIZE. */
                 0xdb, 0x15
-            }
+            },
+            .response_size = 10
         },
         {
             .request = {
@@ -1290,7 +2202,8 @@ static int test_fast_write_errors(void)
                 0xff, 0xff, 0x00, 0x04,
                 0xff, 0xff, 0xff, 0xea, /* -EINVAL. */
                 0x52, 0x5d
-            }
+            },
+            .response_size = 10
         },
         {
             .request = {
@@ -1306,7 +2219,8 @@ static int test_fast_write_errors(void)
                 0xff, 0xff, 0x00, 0x04,
                 0xff, 0xff, 0xff, 0xea, /* -EINVAL. */
                 0x52, 0x5d
-            }
+            },
+            .response_size = 10
         },
         {
             .request = {
@@ -1326,7 +2240,8 @@ static int test_fast_write_errors(void)
                 0xff, 0xff, 0x00, 0x04,
                 0xff, 0xff, 0xff, 0xfb, /* -5. */
                 0x50, 0x4d
-            }
+            },
+            .response_size = 10
         },
         {
             .request = {
@@ -1343,10 +2258,12 @@ static int test_fast_write_errors(void)
             .ramapp_write_res = 256,
             .ramapp_read_res = 256,
             .response = {
-                0xff, 0xff, 0x00, 0x04,
+                0xff, 0xff, 0x00, 0x08,
                 0xff, 0xff, 0xff, 0x92, /* -ETIMEDOUT. */
-                0xad, 0xc2
-            }
+                0x00, 0x00, 0x00, 0x00, /* Row. */
+                0x2e, 0x77
+            },
+            .response_size = 14
         },
         {
             .request = {
@@ -1363,10 +2280,12 @@ static int test_fast_write_errors(void)
             .ramapp_write_res = -6,
             .ramapp_read_res = 256,
             .response = {
-                0xff, 0xff, 0x00, 0x04,
+                0xff, 0xff, 0x00, 0x08,
                 0xff, 0xff, 0xff, 0xfa, /* -6. */
-                0x40, 0x6c
-            }
+                0x00, 0x00, 0x00, 0x00, /* Row. */
+                0x35, 0x86
+            },
+            .response_size = 14
         },
         {
             .request = {
@@ -1386,7 +2305,8 @@ static int test_fast_write_errors(void)
                 0xff, 0xff, 0x00, 0x04,
                 0xff, 0xff, 0xff, 0xf9, /* -7. */
                 0x70, 0x0f
-            }
+            },
+            .response_size = 10
         }
     };
 
@@ -1406,12 +2326,12 @@ static int test_fast_write_errors(void)
                                     datas[i].ramapp_write_res,
                                     datas[i].ramapp_read_res,
                                     &datas[i].response[0],
-                                    sizeof(datas[i].response));
+                                    datas[i].response_size);
         }
 
         mock_write_chan_write(&datas[i].response[0],
-                              sizeof(datas[i].response),
-                              sizeof(datas[i].response));
+                              datas[i].response_size,
+                              datas[i].response_size);
 
         BTASSERTI(programmer_process_packet(&programmer), ==, 0);
     }
@@ -1419,15 +2339,348 @@ static int test_fast_write_errors(void)
     return (0);
 }
 
-static int test_device_status(void)
+static int test_fast_write_failed_rows(void)
 {
     struct programmer_t programmer;
-    uint8_t request_header[] = { 0x00, 0x68, 0x00, 0x00 };
-    uint8_t request_crc[] = { 0xb6, 0x0a };
+    uint8_t report_request[] = {
+        0x00, 0x6a, 0x00, 0x0b,
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x02, 0x00, /* Size. */
+        0x12, 0x34,             /* Crc. */
+        0x01,                   /* Report failed rows. */
+        0x35, 0x60
+    };
+    uint8_t request[] = {
+        0x00, 0x6a, 0x00, 0x0a,
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x02, 0x00, /* Size. */
+        0x12, 0x34,             /* Crc. */
+        0xbf, 0x70
+    };
     uint8_t response[] = {
-        0x00, 0x68, 0x00, 0x01,
-        0x48, /* Status. */
-        0x37, 0xe0
+        0x00, 0x6a, 0x00, 0x04,
+        0x1d, 0x00, 0x01, 0x00, /* Failed row. */
+        0xe9, 0x7c
+    };
+    uint8_t failure_response[] = {
+        0xff, 0xff, 0x00, 0x08,
+        0xff, 0xff, 0xfc, 0x10, /* -EFLASHWRITE. */
+        0x00, 0x00, 0x00, 0x01, /* Row. */
+        0x96, 0xe5
+    };
+    uint8_t credits_1[] = { 0x00, 0x00, 0x00, 0x01 };
+    uint8_t buf[256];
+    struct time_t time;
+    int i;
+
+    BTASSERT(connect(&programmer) == 0);
+
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+    memset(&buf[0], 1, sizeof(buf));
+
+    /* The failed row is reported to the host, which asked for it. */
+    write_read_command_request(&report_request[0],
+                               4,
+                               &report_request[4],
+                               13);
+    write_ramapp_write(&request[0], sizeof(request), sizeof(request));
+
+    for (i = 0; i < 2; i++) {
+        mock_write_chan_read_with_timeout(&buf[0],
+                                          sizeof(buf),
+                                          &time,
+                                          sizeof(buf));
+
+        if (i == 0) {
+            mock_write_chan_write(&credits_1[0],
+                                  sizeof(credits_1),
+                                  sizeof(credits_1));
+        }
+    }
+
+    write_ramapp_fast_write_row(&buf[0],
+                                write_ramapp_fast_write_row(&buf[0], 0xffff));
+    write_ramapp_read(&response[0], sizeof(response), sizeof(response));
+    mock_write_chan_write(&response[0],
+                          sizeof(response),
+                          sizeof(response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* The failed row fails the command otherwise. */
+    write_read_command_request(&request[0],
+                               4,
+                               &request[4],
+                               12);
+    write_ramapp_write(&request[0], sizeof(request), sizeof(request));
+
+    for (i = 0; i < 2; i++) {
+        mock_write_chan_read_with_timeout(&buf[0],
+                                          sizeof(buf),
+                                          &time,
+                                          sizeof(buf));
+
+        if (i == 0) {
+            mock_write_chan_write(&credits_1[0],
+                                  sizeof(credits_1),
+                                  sizeof(credits_1));
+        }
+    }
+
+    write_ramapp_fast_write_row(&buf[0],
+                                write_ramapp_fast_write_row(&buf[0], 0xffff));
+    write_ramapp_read(&response[0], sizeof(response), sizeof(response));
+    mock_write_chan_write(&failure_response[0],
+                          sizeof(failure_response),
+                          sizeof(failure_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_fast_read(void)
+{
+    struct programmer_t programmer;
+    uint8_t request[] = {
+        0x00, 0x78, 0x00, 0x08,
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x04, 0x04, /* Size. */
+        0x00, 0x00
+    };
+    uint8_t data[4 + 1024 + 2];
+    uint8_t last_data[] = {
+        0x00, 0x00, 0x00, 0x04,
+        0x44, 0x33, 0x22, 0x11,
+        0x00, 0x00
+    };
+    uint8_t response[] = { 0x00, 0x78, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t failure_response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0xfb, /* -5. */
+        0x50, 0x4d
+    };
+    uint8_t buf[4];
+    uint16_t crc;
+    size_t i;
+
+    BTASSERT(connect(&programmer) == 0);
+
+    crc = packet_crc_ccitt(0xffff, &request[0], 12);
+    request[12] = (crc >> 8);
+    request[13] = crc;
+    data[0] = 0x00;
+    data[1] = 0x00;
+    data[2] = 0x04;
+    data[3] = 0x00;
+
+    for (i = 0; i < 1024; i++) {
+        data[4 + i] = i;
+    }
+
+    crc = packet_crc_ccitt(0xffff, &data[0], 4 + 1024);
+    data[4 + 1024] = (crc >> 8);
+    data[4 + 1024 + 1] = crc;
+    crc = packet_crc_ccitt(0xffff, &last_data[0], 8);
+    last_data[8] = (crc >> 8);
+    last_data[9] = crc;
+    crc = packet_crc_ccitt(0xffff, &response[0], 4);
+    response[4] = (crc >> 8);
+    response[5] = crc;
+
+    /* The data packets and the response are forwarded as they are. */
+    write_read_command_request(&request[0], 4, &request[4], 10);
+    write_ramapp_write(&request[0], sizeof(request), sizeof(request));
+    write_ramapp_read(&data[0], sizeof(data), sizeof(data));
+    mock_write_chan_write(&data[0], sizeof(data), sizeof(data));
+    write_ramapp_read(&last_data[0], sizeof(last_data), sizeof(last_data));
+    mock_write_chan_write(&last_data[0],
+                          sizeof(last_data),
+                          sizeof(last_data));
+    write_ramapp_read(&response[0], sizeof(response), sizeof(response));
+    mock_write_chan_write(&response[0],
+                          sizeof(response),
+                          sizeof(response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* A failure is sent after the data packets already sent. */
+    write_read_command_request(&request[0], 4, &request[4], 10);
+    write_ramapp_write(&request[0], sizeof(request), sizeof(request));
+    write_ramapp_read(&data[0], sizeof(data), sizeof(data));
+    mock_write_chan_write(&data[0], sizeof(data), sizeof(data));
+    write_ramapp_read(&buf[0], sizeof(buf), -5);
+    mock_write_chan_write(&failure_response[0],
+                          sizeof(failure_response),
+                          sizeof(failure_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_fast_read_ramapp_without_features(void)
+{
+    struct programmer_t programmer;
+    uint8_t request[] = {
+        0x00, 0x78, 0x00, 0x08,
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x04, 0x04, /* Size. */
+        0x00, 0x00
+    };
+    uint8_t failure_response[10];
+    uint16_t crc;
+
+    BTASSERT(connect_ramapp_features(&programmer, 0) == 0);
+
+    crc = packet_crc_ccitt(0xffff, &request[0], 12);
+    request[12] = (crc >> 8);
+    request[13] = crc;
+    failure_response[0] = 0xff;
+    failure_response[1] = 0xff;
+    failure_response[2] = 0x00;
+    failure_response[3] = 0x04;
+    failure_response[4] = ((-ENOSYS) >> 24);
+    failure_response[5] = ((-ENOSYS) >> 16);
+    failure_response[6] = ((-ENOSYS) >> 8);
+    failure_response[7] = (-ENOSYS);
+    crc = packet_crc_ccitt(0xffff, &failure_response[0], 8);
+    failure_response[8] = (crc >> 8);
+    failure_response[9] = crc;
+
+    /* Not forwarded to a ramapp without fast read. */
+    write_read_command_request(&request[0], 4, &request[4], 10);
+    mock_write_chan_write(&failure_response[0],
+                          sizeof(failure_response),
+                          sizeof(failure_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_read_words(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x6d, 0x00, 0x05 };
+    uint8_t request_payload_crc[] = {
+        0x1f, 0x80, 0x36, 0x60, /* Address. */
+        0x02,                   /* Number of words. */
+        0x60, 0x59
+    };
+    uint8_t response[] = {
+        0x00, 0x6d, 0x00, 0x08,
+        0x78, 0x56, 0x34, 0x12, 0xf0, 0xde, 0xbc, 0x9a,
+        0x7c, 0xf2
+    };
+    uint32_t words[] = { 0x12345678, 0x9abcdef0 };
+    struct time_t time;
+    int i;
+
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+
+    mock_write_icsp_soft_init(&pin_d2_dev,
+                              &pin_d3_dev,
+                              &pin_d4_dev,
+                              0);
+    mock_write_icsp_soft_start(0);
+    write_enter_serial_execution_mode(0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0);
+
+    /* lui s3, 0xff20, lui t0, 0x1f80 and ori t0, t0, 0x3660. */
+    write_xfer_instruction(0xff2041b3, 0, 0, 0, 0, 0, 0);
+    write_xfer_instruction(0x1f8041a8, 0, 0, 0, 0, 0, 0);
+    write_xfer_instruction(0x36605108, 0, 0, 0, 0, 0, 0);
+
+    time.seconds = 0;
+    time.nanoseconds = 0;
+
+    for (i = 0; i < membersof(words); i++) {
+        /* lw t1, 4 * i(t0), sw t1, 0(s3) and nop. */
+        write_xfer_instruction(((4 * i) << 16) | 0xfd28, 0, 0, 0, 0, 0, 0);
+        write_xfer_instruction(0x0000f933, 0, 0, 0, 0, 0, 0);
+        write_xfer_instruction(0x00000000, 0, 0, 0, 0, 0, 0);
+        write_send_command(0x70, 0);
+        mock_write_time_get(&time, 0);
+        mock_write_icsp_soft_fast_data_read(&words[i], 0);
+        mock_write_time_get(&time, 0);
+    }
+
+    mock_write_icsp_soft_stop(0);
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_read_words_errors(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x6d, 0x00, 0x05 };
+    uint8_t request_payload_crc[] = {
+        0x1f, 0x80, 0x36, 0x60, /* Address. */
+        0x41,                   /* Too many words. */
+        0x18, 0xfe
+    };
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0xea, /* -EINVAL. */
+        0x52, 0x5d
+    };
+    uint8_t connected_request_crc[] = {
+        0x1f, 0x80, 0x36, 0x60,
+        0x02,
+        0x60, 0x59
+    };
+    uint8_t connected_response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0x96, /* -EISCONN. */
+        0xed, 0x46
+    };
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* The ramapp reads memory when connected. */
+    BTASSERT(connect(&programmer) == 0);
+
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &connected_request_crc[0],
+                                    sizeof(connected_request_crc),
+                                    &connected_response[0],
+                                    sizeof(connected_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_device_status(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x68, 0x00, 0x00 };
+    uint8_t request_crc[] = { 0xb6, 0x0a };
+    uint8_t response[] = {
+        0x00, 0x68, 0x00, 0x01,
+        0x48, /* Status. */
+        0x37, 0xe0
     };
 
     write_programmer_process_packet(&request_header[0],
@@ -1442,12 +2695,2474 @@ static int test_device_status(void)
                               &pin_d4_dev,
                               0);
     mock_write_icsp_soft_start(0);
-
+
+    write_read_device_status(0x12);
+
+    mock_write_icsp_soft_stop(0);
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static void write_jtag_start(void)
+{
+    harness_mock_write("jtag_start()", NULL, 0);
+}
+
+static void write_jtag_stop(void)
+{
+    harness_mock_write("jtag_stop()", NULL, 0);
+}
+
+/**
+ * Write given TMS, TDI and TDO sequences as strings of '0' and '1',
+ * one character per TCK clock.
+ */
+static void write_jtag_clocks(const char *tms_p,
+                              const char *tdi_p,
+                              const char *tdo_p)
+{
+    int tms;
+    int tdi;
+    int tdo;
+
+    while (*tms_p != '\0') {
+        tms = (*tms_p++ == '1');
+        tdi = (*tdi_p++ == '1');
+        tdo = (*tdo_p++ == '1');
+        harness_mock_write("jtag_clock(tms)", &tms, sizeof(tms));
+        harness_mock_write("jtag_clock(tdi)", &tdi, sizeof(tdi));
+        harness_mock_write("jtag_clock(): return (res)", &tdo, sizeof(tdo));
+    }
+}
+
+/**
+ * Write given TMS and TDI sequences as strings of '0' and '1', one
+ * character per cycle, clocked into given targets. TDO is a string
+ * of octal digits, bit n for target n.
+ */
+static void write_gang_cycles(uint32_t targets,
+                              const char *tms_p,
+                              const char *tdi_p,
+                              const char *tdo_p)
+{
+    uint32_t tms;
+    uint32_t tdi;
+    uint32_t tdo;
+
+    while (*tms_p != '\0') {
+        tms = ((*tms_p++ == '1') ? targets : 0);
+        tdi = ((*tdi_p++ == '1') ? targets : 0);
+        tdo = (*tdo_p++ - '0');
+        harness_mock_write("gang_clock(pged)", &tdi, sizeof(tdi));
+        harness_mock_write("gang_clock(pged)", &tms, sizeof(tms));
+        harness_mock_write("gang_sample(): return (res)", &tdo, sizeof(tdo));
+    }
+}
+
+static void write_gang_start(uint32_t targets)
+{
+    static struct pin_device_t *mclrn_devs[] = {
+        &pin_d27_dev, &pin_d29_dev, &pin_d31_dev
+    };
+    uint32_t key;
+    uint32_t pged;
+    int i;
+
+    for (i = 0; i < membersof(mclrn_devs); i++) {
+        if (targets & BIT(i)) {
+            mock_write_pin_init(mclrn_devs[i], PIN_OUTPUT, 0);
+            mock_write_pin_write(0, 0);
+        }
+    }
+
+    harness_mock_write("gang_start()", NULL, 0);
+    key = 0x4d434850;
+
+    for (i = 31; i >= 0; i--) {
+        pged = (((key >> i) & 1) ? targets : 0);
+        harness_mock_write("gang_clock(pged)", &pged, sizeof(pged));
+    }
+
+    for (i = 0; i < membersof(mclrn_devs); i++) {
+        if (targets & BIT(i)) {
+            mock_write_pin_write(1, 0);
+        }
+    }
+
+    write_gang_cycles(targets, "111110", "000000", "000000");
+}
+
+static void write_gang_stop(uint32_t targets)
+{
+    int i;
+
+    harness_mock_write("gang_stop()", NULL, 0);
+
+    for (i = 0; i < 3; i++) {
+        if (targets & BIT(i)) {
+            mock_write_pin_set_mode(PIN_INPUT, 0);
+        }
+    }
+}
+
+static void write_icsp_spi_start(int clock_divider)
+{
+    uint8_t key[] = { 'M', 'C', 'H', 'P' };
+    uint8_t reset[] = { 0x44, 0x44, 0x40 };
+
+    mock_write_pin_init(&pin_d4_dev, PIN_OUTPUT, 0);
+    mock_write_pin_write(0, 0);
+    write_usart_spi_start(clock_divider);
+    write_usart_spi_transfer(&key[0], &key[0], sizeof(key));
+    mock_write_pin_write(1, 0);
+    write_usart_spi_transfer(&reset[0], &reset[0], sizeof(reset));
+}
+
+/**
+ * Write given TMS, TDI and TDO sequences as strings of '0' and '1',
+ * one character per cycle, as the nibble encoded transfer of the
+ * icsp_spi transport. An odd number of cycles is padded with an idle
+ * nibble.
+ */
+static void write_icsp_spi_cycles(const char *tms_p,
+                                  const char *tdi_p,
+                                  const char *tdo_p)
+{
+    uint8_t txbuf[32];
+    uint8_t rxbuf[32];
+    uint8_t nibble;
+    size_t i;
+
+    memset(&txbuf[0], 0, sizeof(txbuf));
+    memset(&rxbuf[0], 0, sizeof(rxbuf));
+
+    for (i = 0; tms_p[i] != '\0'; i++) {
+        nibble = 0;
+
+        if (tms_p[i] == '1') {
+            nibble |= 0x4;
+        }
+
+        if (tdi_p[i] == '1') {
+            nibble |= 0x8;
+        }
+
+        if ((i % 2) == 0) {
+            txbuf[i / 2] |= (nibble << 4);
+        } else {
+            txbuf[i / 2] |= nibble;
+        }
+
+        if (tdo_p[i] == '1') {
+            rxbuf[i / 2] |= (((i % 2) == 0) ? 0x10 : 0x01);
+        }
+    }
+
+    write_usart_spi_transfer(&rxbuf[0], &txbuf[0], DIV_CEIL(i, 2));
+}
+
+static void write_icsp_spi_stop(void)
+{
+    write_usart_spi_stop();
+    mock_write_pin_set_mode(PIN_INPUT, 0);
+}
+
+static int test_icsp_spi(void)
+{
+    struct icsp_spi_driver_t icsp;
+    uint8_t command;
+    uint8_t rxbuf[4];
+    uint8_t txbuf[4] = { 0x12, 0x34, 0x56, 0x78 };
+    uint32_t data;
+    uint8_t zeros[19];
+    struct icsp_spi_sequence_t sequence;
+    uint8_t replay_tx[400];
+    uint8_t replay_rx[400];
+    uint16_t replay_samples[] = { 2, 3, 100, 609, 610, 700, 750, 798, 799 };
+    uint8_t samples[2];
+    uint8_t instruction[] = { 0x44, 0x00, 0x00, 0x80, 0x44, 0x00 };
+    uint8_t data_32_tx[] = {
+        0x40, 0x00, 0x00, 0x80, 0x08, 0x00, 0x08, 0x80, 0x80, 0x00,
+        0x80, 0x80, 0x88, 0x00, 0x88, 0x88, 0x00, 0x44, 0x00
+    };
+    uint8_t data_32_rx[] = {
+        0x00, 0x01, 0x00, 0x11, 0x01, 0x01, 0x01, 0x11, 0x10, 0x01,
+        0x10, 0x11, 0x11, 0x01, 0x11, 0x10, 0x00, 0x00, 0x00
+    };
+    uint8_t fast_data_write_tx[] = {
+        0x40, 0x00, 0x00, 0x08, 0x88, 0x80, 0x08, 0x80, 0x80, 0x80,
+        0x00, 0x80, 0x88, 0x00, 0x08, 0x00, 0x80, 0x04, 0x40
+    };
+    uint8_t fast_data_write_rx[] = {
+        0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+    uint8_t fast_data_read_tx[] = {
+        0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x40
+    };
+    uint8_t fast_data_read_rx[] = {
+        0x00, 0x01, 0x11, 0x11, 0x01, 0x11, 0x01, 0x11, 0x11, 0x01,
+        0x10, 0x11, 0x01, 0x01, 0x01, 0x11, 0x10, 0x11, 0x00
+    };
+
+    memset(&zeros[0], 0, sizeof(zeros));
+
+    BTASSERT(icsp_spi_init(&icsp, &pin_d4_dev) == 0);
+
+    /* Clock divider, applied when started. */
+    BTASSERTI(icsp_spi_get_clock_frequency(&icsp), ==, 7000000);
+    BTASSERT(icsp_spi_set_clock_divider(&icsp, 5) == -EINVAL);
+    BTASSERT(icsp_spi_set_clock_divider(&icsp, 65536) == -EINVAL);
+    BTASSERT(icsp_spi_set_clock_divider(&icsp, 24) == 0);
+    BTASSERTI(icsp_spi_get_clock_frequency(&icsp), ==, 3500000);
+    write_icsp_spi_start(24);
+    BTASSERT(icsp_spi_start(&icsp) == 0);
+    write_usart_spi_set_clock_divider(6);
+    BTASSERT(icsp_spi_set_clock_divider(&icsp, 6) == 0);
+    BTASSERTI(icsp_spi_get_clock_frequency(&icsp), ==, 14000000);
+
+    /* Instruction. */
+    write_usart_spi_transfer(&instruction[0],
+                             &instruction[0],
+                             sizeof(instruction));
+    command = 0x20;
+    BTASSERT(icsp_spi_instruction_write(&icsp, &command, 5) == 0);
+
+    /* Data transfer. */
+    write_usart_spi_transfer(&data_32_rx[0],
+                             &data_32_tx[0],
+                             sizeof(data_32_tx));
+    BTASSERT(icsp_spi_data_transfer(&icsp, &rxbuf[0], &txbuf[0], 32) == 0);
+    BTASSERTI(rxbuf[0], ==, 0x9a);
+    BTASSERTI(rxbuf[1], ==, 0xbc);
+    BTASSERTI(rxbuf[2], ==, 0xde);
+    BTASSERTI(rxbuf[3], ==, 0xf0);
+
+    /* Fast data write accepted and not accepted by the core. */
+    write_usart_spi_transfer(&fast_data_write_rx[0],
+                             &fast_data_write_tx[0],
+                             sizeof(fast_data_write_tx));
+    BTASSERT(icsp_spi_fast_data_write(&icsp, 0x12345678) == 0);
+
+    write_usart_spi_transfer(&zeros[0],
+                             &fast_data_write_tx[0],
+                             sizeof(fast_data_write_tx));
+    BTASSERT(icsp_spi_fast_data_write(&icsp, 0x12345678) == -EPROTO);
+
+    /* Fast data read. */
+    write_usart_spi_transfer(&fast_data_read_rx[0],
+                             &fast_data_read_tx[0],
+                             sizeof(fast_data_read_tx));
+    BTASSERT(icsp_spi_fast_data_read(&icsp, &data) == 0);
+    BTASSERTI(data, ==, 0xdeadbeef);
+
+    /* Too many bits. */
+    BTASSERT(icsp_spi_data_transfer(&icsp, &rxbuf[0], &txbuf[0], 700)
+             == -EINVAL);
+
+    /* Replay a sequence longer than the driver buffers, sampling TDO
+       in both transfers. */
+    memset(&replay_tx[0], 0x44, sizeof(replay_tx));
+    memset(&replay_rx[0], 0, sizeof(replay_rx));
+    replay_rx[1] = 0x10;
+    replay_rx[304] = 0x01;
+    replay_rx[399] = 0x01;
+    sequence.buf_p = &replay_tx[0];
+    sequence.size = sizeof(replay_tx);
+    sequence.samples_p = &replay_samples[0];
+    sequence.number_of_samples = membersof(replay_samples);
+    write_usart_spi_transfer(&replay_rx[0], &replay_tx[0], 304);
+    write_usart_spi_transfer(&replay_rx[304], &replay_tx[304], 96);
+    BTASSERT(icsp_spi_replay(&icsp, &sequence, &samples[0]) == 0);
+    BTASSERTI(samples[0], ==, 0x90);
+    BTASSERTI(samples[1], ==, 0x80);
+
+    return (0);
+}
+
+/**
+ * Encode a 38 cycles fast data word transfer as shifted on the SPI
+ * bus, and the PrAcc bit and word shifted out by the PIC.
+ */
+static void encode_icsp_spi_fast_data(uint8_t *tx_p,
+                                      uint8_t *rx_p,
+                                      uint32_t txdata,
+                                      int pracc,
+                                      uint32_t rxdata)
+{
+    uint8_t tx[38];
+    uint8_t rx[38];
+    int i;
+
+    memset(&tx[0], 0, sizeof(tx));
+    memset(&rx[0], 0, sizeof(rx));
+
+    /* Select-DR-Scan, PrAcc, data and exit. */
+    tx[0] = 0x4;
+    rx[3] = pracc;
+
+    for (i = 0; i < 32; i++) {
+        tx[4 + i] = (((txdata >> i) & 1) << 3);
+        rx[4 + i] = ((rxdata >> i) & 1);
+    }
+
+    tx[35] |= 0x4;
+    tx[36] = 0x4;
+
+    for (i = 0; i < 19; i++) {
+        tx_p[i] = ((tx[2 * i] << 4) | tx[2 * i + 1]);
+        rx_p[i] = ((rx[2 * i] << 4) | rx[2 * i + 1]);
+    }
+}
+
+static void write_icsp_spi_attach(int clock_divider)
+{
+    uint8_t reset[] = { 0x44, 0x44, 0x40 };
+
+    mock_write_pin_init(&pin_d4_dev, PIN_INPUT, 0);
+    mock_write_pin_write(1, 0);
+    mock_write_pin_set_mode(PIN_OUTPUT, 0);
+    write_usart_spi_start(clock_divider);
+    write_usart_spi_transfer(&reset[0], &reset[0], sizeof(reset));
+}
+
+/**
+ * No ramapp accepts the first word of the CRC request when attaching.
+ */
+static void write_icsp_spi_attach_no_ramapp(void)
+{
+    uint8_t sw_etap[] = { 0x44, 0x00, 0x80, 0x80, 0x44, 0x00 };
+    uint8_t fastdata[] = { 0x44, 0x00, 0x08, 0x88, 0x44, 0x00 };
+    uint8_t tx[19];
+    uint8_t rx[19];
+
+    write_usart_spi_transfer(&sw_etap[0], &sw_etap[0], sizeof(sw_etap));
+    write_usart_spi_transfer(&fastdata[0], &fastdata[0], sizeof(fastdata));
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0x00080000, 0, 0);
+    write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+    write_icsp_spi_stop();
+}
+
+static int test_icsp_spi_fast_data_burst(void)
+{
+    struct icsp_spi_driver_t icsp;
+    uint32_t words[3] = { 0x11111111, 0x22222222, 0x33333333 };
+    uint32_t rxwords[3];
+    uint8_t tx[3 * 19];
+    uint8_t rx[3 * 19];
+    int i;
+
+    BTASSERT(icsp_spi_init(&icsp, &pin_d4_dev) == 0);
+
+    /* All words accepted in one transfer. */
+    for (i = 0; i < 3; i++) {
+        encode_icsp_spi_fast_data(&tx[19 * i], &rx[19 * i], words[i], 1, 0);
+    }
+
+    write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+    BTASSERTI(icsp_spi_fast_data_write_burst(&icsp, &words[0], 3), ==, 3);
+
+    /* The second word is rejected, and so is the third. */
+    encode_icsp_spi_fast_data(&tx[19], &rx[19], words[1], 0, 0);
+    encode_icsp_spi_fast_data(&tx[38], &rx[38], words[2], 0, 0);
+    write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+    BTASSERTI(icsp_spi_fast_data_write_burst(&icsp, &words[0], 3), ==, 1);
+
+    /* A word accepted after a rejected word breaks the stream. */
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], words[0], 0, 0);
+    encode_icsp_spi_fast_data(&tx[19], &rx[19], words[1], 1, 0);
+    write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+    BTASSERTI(icsp_spi_fast_data_write_burst(&icsp, &words[0], 3),
+              ==,
+              -EPROTO);
+
+    /* Read. */
+    for (i = 0; i < 3; i++) {
+        encode_icsp_spi_fast_data(&tx[19 * i], &rx[19 * i], 0, 1, words[i]);
+    }
+
+    write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+    BTASSERTI(icsp_spi_fast_data_read_burst(&icsp, &rxwords[0], 3), ==, 3);
+    BTASSERTI(rxwords[0], ==, 0x11111111);
+    BTASSERTI(rxwords[1], ==, 0x22222222);
+    BTASSERTI(rxwords[2], ==, 0x33333333);
+
+    return (0);
+}
+
+static int test_ramapp_command_icsp_spi_burst(void)
+{
+    struct programmer_t programmer;
+    uint8_t request[] = {
+        0x00, 0x01, 0x00, 0x02, 0x12, 0x34, 0xd9, 0xe7
+    };
+    uint8_t response[] = {
+        0x00, 0x01, 0x00, 0x00, 0xb3, 0xf0
+    };
+    uint8_t tx[2 * 19];
+    uint8_t rx[2 * 19];
+
+    BTASSERT(connect(&programmer) == 0);
+    programmer.transport = PROGRAMMER_TRANSPORT_ICSP_SPI;
+
+    write_read_command_request(&request[0],
+                               4,
+                               &request[4],
+                               4);
+
+    /* The second request word is rejected in the burst and accepted
+       when retried. */
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0x00010002, 1, 0);
+    encode_icsp_spi_fast_data(&tx[19], &rx[19], 0x1234d9e7, 0, 0);
+    write_usart_spi_transfer(&rx[0], &tx[0], 2 * 19);
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0x1234d9e7, 1, 0);
+    write_usart_spi_transfer(&rx[0], &tx[0], 19);
+
+    /* Response header, and then crc in a burst. */
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0, 1, 0x00010000);
+    write_usart_spi_transfer(&rx[0], &tx[0], 19);
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0, 1, 0xb3f00000);
+    write_usart_spi_transfer(&rx[0], &tx[0], 19);
+
+    mock_write_chan_write(&response[0],
+                          sizeof(response),
+                          sizeof(response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_device_status_icsp_spi(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x68, 0x00, 0x01 };
+    uint8_t request_payload_crc[] = {
+        0x01, /* ICSP over SPI. */
+        0xee, 0x0d
+    };
+    uint8_t response[] = {
+        0x00, 0x68, 0x00, 0x01,
+        0x48, /* Status. */
+        0x37, 0xe0
+    };
+    /* MTAP_SW_MTAP, MTAP_COMMAND and MCHP_STATUS in one precompiled
+       transfer. */
+    uint8_t read_status_tx[] = {
+        0x44, 0x00, 0x00, 0x80, 0x44, 0x00,
+        0x44, 0x00, 0x88, 0x80, 0x44, 0x00,
+        0x40, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00
+    };
+    uint8_t read_status_rx[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x10, 0x01, 0x00, 0x00
+    };
+
+    write_programmer_init();
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+
+    write_icsp_spi_start(ICSP_SPI_CLOCK_DIVIDER_DEFAULT);
+    write_usart_spi_transfer(&read_status_rx[0],
+                             &read_status_tx[0],
+                             sizeof(read_status_tx));
+    write_icsp_spi_stop();
+
+    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+/**
+ * Encode a 32 bits data register transfer as shifted on the SPI bus,
+ * and the word shifted out by the PIC.
+ */
+static void encode_icsp_spi_data_32(uint8_t *tx_p,
+                                    uint8_t *rx_p,
+                                    uint32_t txdata,
+                                    uint32_t rxdata)
+{
+    uint8_t tx[38];
+    uint8_t rx[38];
+    int i;
+
+    memset(&tx[0], 0, sizeof(tx));
+    memset(&rx[0], 0, sizeof(rx));
+
+    /* Select-DR-Scan, data and exit. */
+    tx[0] = 0x4;
+
+    for (i = 0; i < 32; i++) {
+        tx[3 + i] = (((txdata >> (31 - i)) & 1) << 3);
+        rx[3 + i] = ((rxdata >> (31 - i)) & 1);
+    }
+
+    tx[34] |= 0x4;
+    tx[35] = 0x4;
+
+    for (i = 0; i < 19; i++) {
+        tx_p[i] = ((tx[2 * i] << 4) | tx[2 * i + 1]);
+        rx_p[i] = ((rx[2 * i] << 4) | rx[2 * i + 1]);
+    }
+}
+
+/**
+ * Write a clock check of given number of good IDCODE reads, followed
+ * by a bad read if less than four, or the loopback with the third
+ * pattern read back as given value.
+ */
+static void write_icsp_spi_check_clock(int good_idcodes, uint32_t loopback)
+{
+    uint8_t sw_mtap[] = { 0x44, 0x00, 0x00, 0x80, 0x44, 0x00 };
+    uint8_t idcode[] = { 0x44, 0x00, 0x80, 0x00, 0x44, 0x00 };
+    uint8_t sw_etap[] = { 0x44, 0x00, 0x80, 0x80, 0x44, 0x00 };
+    uint8_t data[] = { 0x44, 0x00, 0x80, 0x08, 0x44, 0x00 };
+    uint32_t patterns[] = {
+        0x00000000, 0xffffffff, 0xaaaaaaaa, 0x55555555, 0x00000000
+    };
+    uint8_t tx[19];
+    uint8_t rx[19];
+    int i;
+
+    write_usart_spi_transfer(&sw_mtap[0], &sw_mtap[0], sizeof(sw_mtap));
+    write_usart_spi_transfer(&idcode[0], &idcode[0], sizeof(idcode));
+
+    for (i = 0; i < good_idcodes; i++) {
+        encode_icsp_spi_data_32(&tx[0], &rx[0], 0, 0x12345678);
+        write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+    }
+
+    if (good_idcodes < 4) {
+        encode_icsp_spi_data_32(&tx[0], &rx[0], 0, 0x12345679);
+        write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+
+        return;
+    }
+
+    write_usart_spi_transfer(&sw_etap[0], &sw_etap[0], sizeof(sw_etap));
+    write_usart_spi_transfer(&data[0], &data[0], sizeof(data));
+
+    /* Each transfer shifts out the previous pattern. */
+    encode_icsp_spi_data_32(&tx[0], &rx[0], patterns[0], 0);
+    write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+
+    for (i = 1; i < membersof(patterns); i++) {
+        if (i == 3) {
+            encode_icsp_spi_data_32(&tx[0], &rx[0], patterns[i], loopback);
+        } else {
+            encode_icsp_spi_data_32(&tx[0],
+                                    &rx[0],
+                                    patterns[i],
+                                    patterns[i - 1]);
+        }
+
+        write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+
+        if ((i == 3) && (loopback != patterns[2])) {
+            break;
+        }
+    }
+}
+
+static int test_connect_icsp_spi_clock_calibration(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x65, 0x00, 0x01 };
+    uint8_t request_payload_crc[] = {
+        0x01, /* ICSP over SPI. */
+        0xd7, 0x8b
+    };
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xd8, 0xf0, /* -EENTERSERIALEXECUTIONMODE. */
+        0x7e, 0x57
+    };
+    uint8_t sw_mtap[] = { 0x44, 0x00, 0x00, 0x80, 0x44, 0x00 };
+    uint8_t idcode[] = { 0x44, 0x00, 0x80, 0x00, 0x44, 0x00 };
+    uint8_t reset[] = { 0x44, 0x44, 0x40 };
+    uint8_t read_status_tx[] = {
+        0x44, 0x00, 0x00, 0x80, 0x44, 0x00,
+        0x44, 0x00, 0x88, 0x80, 0x44, 0x00,
+        0x40, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00
+    };
+    uint8_t zeros[19];
+    uint8_t tx[19];
+    uint8_t rx[19];
+
+    memset(&zeros[0], 0, sizeof(zeros));
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+
+    /* Loopback error at divider 16. */
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+    write_icsp_spi_attach(ICSP_SPI_CLOCK_DIVIDER_DEFAULT);
+    write_icsp_spi_attach_no_ramapp();
+    write_icsp_spi_start(ICSP_SPI_CLOCK_DIVIDER_DEFAULT);
+
+    /* Reference IDCODE 0x12345678 at the slowest clock. */
+    write_usart_spi_set_clock_divider(48);
+    write_usart_spi_transfer(&sw_mtap[0], &sw_mtap[0], sizeof(sw_mtap));
+    write_usart_spi_transfer(&idcode[0], &idcode[0], sizeof(idcode));
+    encode_icsp_spi_data_32(&tx[0], &rx[0], 0, 0x12345678);
+    write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+
+    /* Good at divider 48, 32 and 24, but not at 16. */
+    write_icsp_spi_check_clock(4, 0xaaaaaaaa);
+    write_usart_spi_set_clock_divider(32);
+    write_icsp_spi_check_clock(4, 0xaaaaaaaa);
+    write_usart_spi_set_clock_divider(24);
+    write_icsp_spi_check_clock(4, 0xaaaaaaaa);
+    write_usart_spi_set_clock_divider(16);
+    write_icsp_spi_check_clock(4, 0xaaaaaaab);
+
+    /* One divider slower than the fastest good clock. */
+    write_usart_spi_set_clock_divider(32);
+    write_usart_spi_transfer(&reset[0], &reset[0], sizeof(reset));
+
+    /* Code protected. */
+    write_usart_spi_transfer(&zeros[0],
+                             &read_status_tx[0],
+                             sizeof(read_status_tx));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* IDCODE error at divider 32. */
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+    write_icsp_spi_attach(ICSP_SPI_CLOCK_DIVIDER_DEFAULT);
+    write_icsp_spi_attach_no_ramapp();
+    write_icsp_spi_start(ICSP_SPI_CLOCK_DIVIDER_DEFAULT);
+    write_usart_spi_set_clock_divider(48);
+    write_usart_spi_transfer(&sw_mtap[0], &sw_mtap[0], sizeof(sw_mtap));
+    write_usart_spi_transfer(&idcode[0], &idcode[0], sizeof(idcode));
+    encode_icsp_spi_data_32(&tx[0], &rx[0], 0, 0x12345678);
+    write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+    write_icsp_spi_check_clock(4, 0xaaaaaaaa);
+    write_usart_spi_set_clock_divider(32);
+    write_icsp_spi_check_clock(1, 0);
+    write_usart_spi_set_clock_divider(48);
+    write_usart_spi_transfer(&reset[0], &reset[0], sizeof(reset));
+    write_usart_spi_transfer(&zeros[0],
+                             &read_status_tx[0],
+                             sizeof(read_status_tx));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_connect_icsp_spi_clock_override(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x65, 0x00, 0x05 };
+    uint8_t request_payload_crc[] = {
+        0x01,                   /* ICSP over SPI. */
+        0x00, 0x3d, 0x09, 0x00, /* 4 MHz. */
+        0x09, 0x48
+    };
+    uint8_t too_fast_request_payload_crc[] = {
+        0x01,                   /* ICSP over SPI. */
+        0x01, 0x31, 0x2d, 0x00, /* 20 MHz. */
+        0xc0, 0xbf
+    };
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xd8, 0xf0, /* -EENTERSERIALEXECUTIONMODE. */
+        0x7e, 0x57
+    };
+    uint8_t too_fast_response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0xea, /* -EINVAL. */
+        0x52, 0x5d
+    };
+    uint8_t read_status_tx[] = {
+        0x44, 0x00, 0x00, 0x80, 0x44, 0x00,
+        0x44, 0x00, 0x88, 0x80, 0x44, 0x00,
+        0x40, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00
+    };
+    uint8_t zeros[19];
+
+    memset(&zeros[0], 0, sizeof(zeros));
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+
+    /* 84 MHz / 21 = 4 MHz, without calibration. */
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+    write_icsp_spi_attach(ICSP_SPI_CLOCK_DIVIDER_DEFAULT);
+    write_usart_spi_set_clock_divider(21);
+    write_icsp_spi_attach_no_ramapp();
+    write_icsp_spi_start(ICSP_SPI_CLOCK_DIVIDER_DEFAULT);
+    write_usart_spi_set_clock_divider(21);
+    write_usart_spi_transfer(&zeros[0],
+                             &read_status_tx[0],
+                             sizeof(read_status_tx));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* Faster than the USART can clock. */
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &too_fast_request_payload_crc[0],
+                                    sizeof(too_fast_request_payload_crc),
+                                    &too_fast_response[0],
+                                    sizeof(too_fast_response));
+    write_icsp_spi_attach(ICSP_SPI_CLOCK_DIVIDER_DEFAULT);
+    write_icsp_spi_stop();
+    write_icsp_spi_start(ICSP_SPI_CLOCK_DIVIDER_DEFAULT);
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_ramapp_command_icsp_spi_downclock(void)
+{
+    struct programmer_t programmer;
+    uint8_t request[] = {
+        0x00, 0x01, 0x00, 0x00, 0xb3, 0xf0
+    };
+    uint8_t bad_crc_response[] = {
+        0x00, 0x01, 0x00, 0x00, 0x12, 0x34
+    };
+    uint8_t bad_crc_failure_response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xfc, 0x11, /* -EBADCRC. */
+        0x59, 0x7a
+    };
+    uint8_t tx[2 * 19];
+    uint8_t rx[2 * 19];
+
+    BTASSERT(connect(&programmer) == 0);
+    programmer.transport = PROGRAMMER_TRANSPORT_ICSP_SPI;
+    programmer.icsp_spi.clock_divider = ICSP_SPI_CLOCK_DIVIDER_DEFAULT;
+    programmer.icsp_spi.is_started = 1;
+
+    /* Bad response crc. */
+    write_read_command_request(&request[0], 4, &request[4], 2);
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0x00010000, 1, 0);
+    encode_icsp_spi_fast_data(&tx[19], &rx[19], 0xb3f00000, 1, 0);
+    write_usart_spi_transfer(&rx[0], &tx[0], 2 * 19);
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0, 1, 0x00010000);
+    write_usart_spi_transfer(&rx[0], &tx[0], 19);
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0, 1, 0x12340000);
+    write_usart_spi_transfer(&rx[0], &tx[0], 19);
+    write_usart_spi_set_clock_divider(16);
+    mock_write_chan_write(&bad_crc_response[0],
+                          sizeof(bad_crc_response),
+                          sizeof(bad_crc_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* Bad request crc as received by the ramapp. */
+    write_read_command_request(&request[0], 4, &request[4], 2);
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0x00010000, 1, 0);
+    encode_icsp_spi_fast_data(&tx[19], &rx[19], 0xb3f00000, 1, 0);
+    write_usart_spi_transfer(&rx[0], &tx[0], 2 * 19);
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0, 1, 0xffff0004);
+    write_usart_spi_transfer(&rx[0], &tx[0], 19);
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0, 1, 0xfffffc11);
+    encode_icsp_spi_fast_data(&tx[19], &rx[19], 0, 1, 0x597a0000);
+    write_usart_spi_transfer(&rx[0], &tx[0], 2 * 19);
+    write_usart_spi_set_clock_divider(24);
+    mock_write_chan_write(&bad_crc_failure_response[0],
+                          sizeof(bad_crc_failure_response),
+                          sizeof(bad_crc_failure_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+/**
+ * Given bytes written to the ramapp over the icsp_spi transport, in
+ * bursts of at most 16 words.
+ */
+static void write_icsp_spi_ramapp_write(const uint8_t *buf_p, size_t size)
+{
+    uint8_t tx[16 * 19];
+    uint8_t rx[16 * 19];
+    uint32_t word;
+    size_t number_of_words;
+    size_t i;
+
+    while (size > 0) {
+        number_of_words = MIN(DIV_CEIL(size, 4), 16);
+
+        for (i = 0; i < number_of_words; i++) {
+            word = ((buf_p[4 * i + 0] << 24)
+                    | (buf_p[4 * i + 1] << 16)
+                    | (buf_p[4 * i + 2] << 8)
+                    | (buf_p[4 * i + 3] << 0));
+            encode_icsp_spi_fast_data(&tx[19 * i], &rx[19 * i], word, 1, 0);
+        }
+
+        write_usart_spi_transfer(&rx[0], &tx[0], 19 * number_of_words);
+        buf_p += (4 * number_of_words);
+        size -= MIN(size, 4 * number_of_words);
+    }
+}
+
+static int test_fast_write_icsp_spi_downclock(void)
+{
+    struct programmer_t programmer;
+    uint8_t request[] = {
+        0x00, 0x6a, 0x00, 0x0a,
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x01, 0x00, /* Size. */
+        0x12, 0x34, /* Crc. */
+        0x24, 0xac
+    };
+    uint8_t failure_response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0xb9, /* -EPROTO. */
+        0x38, 0xcb
+    };
+    uint8_t buf[256];
+    struct time_t time;
+    uint8_t tx[19];
+    uint8_t rx[19];
+
+    BTASSERT(connect_ramapp_features(&programmer, 0) == 0);
+    programmer.transport = PROGRAMMER_TRANSPORT_ICSP_SPI;
+    programmer.icsp_spi.clock_divider = ICSP_SPI_CLOCK_DIVIDER_DEFAULT;
+    programmer.icsp_spi.is_started = 1;
+
+    write_read_command_request(&request[0], 4, &request[4], 12);
+    write_icsp_spi_ramapp_write(&request[0], sizeof(request));
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+    memset(&buf[0], 1, sizeof(buf));
+    mock_write_chan_read_with_timeout(&buf[0],
+                                      sizeof(buf),
+                                      &time,
+                                      sizeof(buf));
+    write_icsp_spi_ramapp_write(&buf[0], sizeof(buf));
+
+    /* Bad response crc. */
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0, 1, 0x006a0000);
+    write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+    encode_icsp_spi_fast_data(&tx[0], &rx[0], 0, 1, 0x12340000);
+    write_usart_spi_transfer(&rx[0], &tx[0], sizeof(tx));
+    write_usart_spi_set_clock_divider(16);
+    mock_write_chan_write(&failure_response[0],
+                          sizeof(failure_response),
+                          sizeof(failure_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_jtag_soft(void)
+{
+    struct jtag_soft_driver_t jtag;
+    uint8_t command;
+    uint8_t rxbuf[4];
+    uint8_t txbuf[4] = { 0x12, 0x34, 0x56, 0x78 };
+    uint32_t data;
+
+    BTASSERT(jtag_soft_init(&jtag, &pin_d4_dev) == 0);
+
+    /* Start. */
+    mock_write_pin_init(&pin_d4_dev, PIN_OUTPUT, 0);
+    mock_write_pin_write(1, 0);
+    write_jtag_start();
+    write_jtag_clocks("111110", "000000", "000000");
+    BTASSERT(jtag_soft_start(&jtag) == 0);
+
+    /* Instruction. */
+    write_jtag_clocks("11000000110", "00000010000", "00000000000");
+    command = 0x20;
+    BTASSERT(jtag_soft_instruction_write(&jtag, &command, 5) == 0);
+
+    /* Data transfer. */
+    write_jtag_clocks("1000000000000000000000000000000000110",
+                      "0000001001000110100010101100111100000",
+                      "0001001101010111100110111101111000000");
+    BTASSERT(jtag_soft_data_transfer(&jtag, &rxbuf[0], &txbuf[0], 32) == 0);
+    BTASSERTI(rxbuf[0], ==, 0x9a);
+    BTASSERTI(rxbuf[1], ==, 0xbc);
+    BTASSERTI(rxbuf[2], ==, 0xde);
+    BTASSERTI(rxbuf[3], ==, 0xf0);
+
+    /* Fast data write accepted and not accepted by the core. */
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000001111001101010001011000100100000",
+                      "00010000000000000000000000000000000000");
+    BTASSERT(jtag_soft_fast_data_write(&jtag, 0x12345678) == 0);
+
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000001111001101010001011000100100000",
+                      "00000000000000000000000000000000000000");
+    BTASSERT(jtag_soft_fast_data_write(&jtag, 0x12345678) == -EPROTO);
+
+    /* Fast data read. */
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000000000000000000000",
+                      "00011111011101111101101101010111101100");
+    BTASSERT(jtag_soft_fast_data_read(&jtag, &data) == 0);
+    BTASSERTI(data, ==, 0xdeadbeef);
+
+    /* Stop. */
+    write_jtag_stop();
+    mock_write_pin_set_mode(PIN_INPUT, 0);
+    BTASSERT(jtag_soft_stop(&jtag) == 0);
+
+    return (0);
+}
+
+static int test_device_status_jtag_soft(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x68, 0x00, 0x01 };
+    uint8_t request_payload_crc[] = {
+        0x02, /* JTAG. */
+        0xde, 0x6e
+    };
+    uint8_t response[] = {
+        0x00, 0x68, 0x00, 0x01,
+        0x48, /* Status. */
+        0x37, 0xe0
+    };
+
+    write_programmer_init();
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+
+    mock_write_pin_init(&pin_d4_dev, PIN_OUTPUT, 0);
+    mock_write_pin_write(1, 0);
+    write_jtag_start();
+    write_jtag_clocks("111110", "000000", "000000");
+    write_jtag_clocks("11000000110", "00000010000", "00000000000");
+    write_jtag_clocks("11000000110", "00001110000", "00000000000");
+    write_jtag_clocks("1000000000110", "0000000000000", "0000001001000");
+    write_jtag_stop();
+    mock_write_pin_set_mode(PIN_INPUT, 0);
+
+    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_connect_jtag_soft_attach(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x65, 0x00, 0x01 };
+    uint8_t request_payload_crc[] = {
+        0x02, /* JTAG. */
+        0xe7, 0xe8
+    };
+    uint8_t response[] = {
+        0x00, 0x65, 0x00, 0x00,
+        0xf4, 0x5b
+    };
+    struct time_t time;
+
+    write_programmer_init();
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+
+    /* Started without a reset. */
+    mock_write_pin_init(&pin_d4_dev, PIN_OUTPUT, 0);
+    mock_write_pin_write(1, 0);
+    write_jtag_start();
+    write_jtag_clocks("111110", "000000", "000000");
+    write_jtag_clocks("11000000110", "00001010000", "00000000000");
+    write_jtag_clocks("11000000110", "00000111000", "00000000000");
+
+    /* Features request. */
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000000100000000000000",
+                      "00010000000000000000000000000000000000");
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000100001101011010000",
+                      "00010000000000000000000000000000000000");
+
+    /* All features, with 2000 bytes of code and constants. */
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000000000000000000000",
+                      "00010001000000000000000100000000000000");
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000000000000000000000",
+                      "00011111110000000000000000000000000000");
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000000000000000000000",
+                      "00010000101111100000000000000000000000");
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000000000000000000000",
+                      "00010000000000000000101011100010110000");
+
+    /* CRC-32 request of the code and constants at 0xa0000000. */
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000001000000000000101000000000000000",
+                      "00010000000000000000000000000000000000");
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000000000000000010100",
+                      "00010000000000000000000000000000000000");
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000101111100000000000000000000000",
+                      "00010000000000000000000000000000000000");
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000110100000000111100",
+                      "00010000000000000000000000000000000000");
+
+    /* The response header is not ready at first. */
+    time.seconds = 0;
+    time.nanoseconds = 0;
+    mock_write_time_get(&time, 0);
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000000000000000000000",
+                      "00000000000000000000000000000000000000");
+    mock_write_time_get(&time, 0);
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000000000000000000000",
+                      "00010010000000000000101000000000000000");
+    mock_write_time_get(&time, 0);
+
+    /* CRC-32 0x21f775a4, matching the image. */
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000000000000000000000",
+                      "00010010010110101110111011111000010000");
+    write_jtag_clocks("10000000000000000000000000000000000110",
+                      "00000000000000000000000000000000000000",
+                      "00010000000000000000101001100010011100");
+
+    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+    BTASSERTI(programmer.is_connected, ==, 1);
+
+    return (0);
+}
+
+static int test_jtag_soft_chain(void)
+{
+    struct jtag_soft_driver_t jtag;
+    uint8_t ir_lengths[] = { 5, 4, 5 };
+    uint8_t command;
+    uint8_t rxbuf[4];
+    uint8_t txbuf[4] = { 0x12, 0x34, 0x56, 0x78 };
+    uint8_t mask;
+    uint8_t value;
+    uint32_t data;
+    struct time_t time;
+
+    BTASSERT(jtag_soft_init(&jtag, &pin_d4_dev) == 0);
+
+    /* Only PIC32 devices may be selected. */
+    BTASSERT(jtag_soft_set_chain(&jtag, &ir_lengths[0], 3, 0x2) == -EINVAL);
+    BTASSERT(jtag_soft_set_chain(&jtag, &ir_lengths[0], 3, 0x8) == -EINVAL);
+    BTASSERT(jtag_soft_set_chain(&jtag, &ir_lengths[0], 3, 0x5) == 0);
+
+    /* Start. */
+    mock_write_pin_init(&pin_d4_dev, PIN_OUTPUT, 0);
+    mock_write_pin_write(1, 0);
+    write_jtag_start();
+    write_jtag_clocks("111110", "000000", "000000");
+    BTASSERT(jtag_soft_start(&jtag) == 0);
+    BTASSERTI(jtag_soft_get_alive(&jtag), ==, 0x5);
+
+    /* Instruction to devices 0 and 2, and BYPASS to device 1. */
+    write_jtag_clocks("11000000000000000110",
+                      "00000010011110010000",
+                      "00000000000000000000");
+    command = 0x20;
+    BTASSERT(jtag_soft_instruction_write(&jtag, &command, 5) == 0);
+
+    /* Data transfer, with one bypass bit in device 1. */
+    write_jtag_clocks("1000000000000000000110",
+                      "0000001001000001001000",
+                      "0001001101001001101000");
+    BTASSERT(jtag_soft_data_transfer(&jtag, &rxbuf[0], &txbuf[0], 8) == 0);
+    BTASSERTI(rxbuf[0], ==, 0x9a);
+    BTASSERT(jtag_soft_data_transfer(&jtag, &rxbuf[0], &txbuf[0], 33)
+             == -EINVAL);
+
+    /* Fast data write accepted by device 0, and by device 2 on the
+       first retry. */
+    write_jtag_clocks("100000000000000000000000000000000000"
+                      "000000000000000000000000000000000110",
+                      "000000011110011010100010110001001000"
+                      "000001111001101010001011000100100000",
+                      "000100000000000000000000000000000000"
+                      "000000000000000000000000000000000000");
+    write_jtag_clocks("11000000000000000110",
+                      "00001111111110010000",
+                      "00000000000000000000");
+    write_jtag_clocks("1000000000000000000000000000000000000110",
+                      "0000000001111001101010001011000100100000",
+                      "0000010000000000000000000000000000000000");
+    write_jtag_clocks("11000000000000000110",
+                      "00000010011110010000",
+                      "00000000000000000000");
+    BTASSERT(jtag_soft_fast_data_write(&jtag, 0x12345678) == 0);
+    BTASSERTI(jtag_soft_get_alive(&jtag), ==, 0x5);
+
+    /* Fast data read. */
+    write_jtag_clocks("100000000000000000000000000000000000"
+                      "000000000000000000000000000000000110",
+                      "000000000000000000000000000000000000"
+                      "000000000000000000000000000000000000",
+                      "000111110111011111011011010101111011"
+                      "011111011101111101101101010111101100");
+    BTASSERT(jtag_soft_fast_data_read(&jtag, &data) == 0);
+    BTASSERTI(data, ==, 0xdeadbeef);
+
+    /* Poll until not busy, with device 2 done after device 0. */
+    write_jtag_clocks("1000000000000000000110",
+                      "0000000000000000000000",
+                      "0000001000000000000000");
+    time.seconds = 0;
+    time.nanoseconds = 0;
+    mock_write_time_get(&time, 0);
+    write_jtag_clocks("1000000000000000000110",
+                      "0000000000000000000000",
+                      "0000001000000001000000");
+    command = 0x00;
+    mask = 0x30;
+    value = 0x10;
+    time.seconds = 1;
+    BTASSERT(jtag_soft_data_poll(&jtag,
+                                 &rxbuf[0],
+                                 &command,
+                                 &mask,
+                                 &value,
+                                 8,
+                                 &time) == 0);
+    BTASSERTI(rxbuf[0], ==, 0x10);
+    BTASSERTI(jtag_soft_get_alive(&jtag), ==, 0x5);
+
+    /* Device 2 disagrees and is put in BYPASS. */
+    write_jtag_clocks("1000000000000000000110",
+                      "0000001001000001001000",
+                      "0001001101001001101100");
+    write_jtag_clocks("11000000000000000110",
+                      "00000010011111111100",
+                      "00000000000000000000");
+    BTASSERT(jtag_soft_data_transfer(&jtag, &rxbuf[0], &txbuf[0], 8) == 0);
+    BTASSERTI(rxbuf[0], ==, 0x9a);
+    BTASSERTI(jtag_soft_get_alive(&jtag), ==, 0x1);
+
+    /* Stop. */
+    write_jtag_stop();
+    mock_write_pin_set_mode(PIN_INPUT, 0);
+    BTASSERT(jtag_soft_stop(&jtag) == 0);
+
+    return (0);
+}
+
+static int test_device_status_jtag_soft_chain(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x68, 0x00, 0x06 };
+    uint8_t request_payload_crc[] = {
+        0x02,             /* JTAG. */
+        0x05,             /* Devices 0 and 2. */
+        0x03,             /* Three devices. */
+        0x05, 0x04, 0x05, /* IR lengths. */
+        0xd5, 0x9c
+    };
+    uint8_t response[] = {
+        0x00, 0x68, 0x00, 0x02,
+        0x48, /* Status. */
+        0x05, /* Devices 0 and 2. */
+        0xaf, 0x41
+    };
+
+    write_programmer_init();
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+
+    mock_write_pin_init(&pin_d4_dev, PIN_OUTPUT, 0);
+    mock_write_pin_write(1, 0);
+    write_jtag_start();
+    write_jtag_clocks("111110", "000000", "000000");
+    write_jtag_clocks("11000000000000000110",
+                      "00000010011110010000",
+                      "00000000000000000000");
+    write_jtag_clocks("11000000000000000110",
+                      "00001110011111110000",
+                      "00000000000000000000");
+    write_jtag_clocks("1000000000000000000110",
+                      "0000000000000000000000",
+                      "0000001001000001001000");
+    write_jtag_stop();
+    mock_write_pin_set_mode(PIN_INPUT, 0);
+
+    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_device_status_jtag_soft_chain_bad_ir_length(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x68, 0x00, 0x05 };
+    uint8_t request_payload_crc[] = {
+        0x02,       /* JTAG. */
+        0x03,       /* Devices 0 and 1. */
+        0x02,       /* Two devices. */
+        0x05, 0x04, /* IR lengths, device 1 is not a PIC32. */
+        0xc6, 0x5f
+    };
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0xea, /* -EINVAL. */
+        0x52, 0x5d
+    };
+
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_icsp_gang(void)
+{
+    struct icsp_gang_driver_t gang;
+    struct pin_device_t *mclrn_devs[] = {
+        &pin_d27_dev, &pin_d29_dev, &pin_d31_dev
+    };
+    uint8_t command;
+    uint8_t rxbuf[4];
+    uint8_t txbuf[4] = { 0x12, 0x34, 0x56, 0x78 };
+    uint8_t mask;
+    uint8_t value;
+    uint32_t data;
+    struct time_t time;
+    int i;
+
+    BTASSERT(icsp_gang_init(&gang, &mclrn_devs[0], 3) == 0);
+    BTASSERT(icsp_gang_start(&gang, 0x8) == -EINVAL);
+
+    /* Start. */
+    write_gang_start(0x7);
+    BTASSERT(icsp_gang_start(&gang, 0x7) == 0);
+    BTASSERTI(icsp_gang_get_alive(&gang), ==, 0x7);
+
+    /* Instruction. */
+    write_gang_cycles(0x7, "11000000110", "00000010000", "00000000000");
+    command = 0x20;
+    BTASSERT(icsp_gang_instruction_write(&gang, &command, 5) == 0);
+
+    /* Data transfer with target 2 outvoted and dropped. */
+    write_gang_cycles(0x7,
+                      "1000000000000000000000000000000000110",
+                      "0000001001000110100010101100111100000",
+                      "0003403303030333300330333303333000000");
+    BTASSERT(icsp_gang_data_transfer(&gang, &rxbuf[0], &txbuf[0], 32) == 0);
+    BTASSERTI(rxbuf[0], ==, 0x9a);
+    BTASSERTI(rxbuf[1], ==, 0xbc);
+    BTASSERTI(rxbuf[2], ==, 0xde);
+    BTASSERTI(rxbuf[3], ==, 0xf0);
+    BTASSERTI(icsp_gang_get_alive(&gang), ==, 0x3);
+
+    /* Poll until not busy, with target 1 done after target 0. */
+    write_gang_cycles(0x3, "1000000000110", "0000000000000", "0000023000000");
+    time.seconds = 0;
+    time.nanoseconds = 0;
+    mock_write_time_get(&time, 0);
+    write_gang_cycles(0x2, "1000000000110", "0000000000000", "0000003000000");
+    command = 0x00;
+    mask = 0x30;
+    value = 0x10;
+    time.seconds = 1;
+    BTASSERT(icsp_gang_data_poll(&gang,
+                                 &rxbuf[0],
+                                 &command,
+                                 &mask,
+                                 &value,
+                                 8,
+                                 &time) == 0);
+    BTASSERTI(rxbuf[0], ==, 0x10);
+    BTASSERTI(icsp_gang_get_alive(&gang), ==, 0x3);
+
+    /* Fast data write accepted by target 1 after target 0. */
+    write_gang_cycles(0x3,
+                      "10000000000000000000000000000000000110",
+                      "00000001111001101010001011000100100000",
+                      "00010000000000000000000000000000000000");
+    write_gang_cycles(0x2,
+                      "10000000000000000000000000000000000110",
+                      "00000001111001101010001011000100100000",
+                      "00020000000000000000000000000000000000");
+    BTASSERT(icsp_gang_fast_data_write(&gang, 0x12345678) == 0);
+    BTASSERTI(icsp_gang_get_alive(&gang), ==, 0x3);
+
+    /* Fast data write not accepted by any target. */
+    write_gang_cycles(0x3,
+                      "10000000000000000000000000000000000110",
+                      "00000001111001101010001011000100100000",
+                      "00000000000000000000000000000000000000");
+    BTASSERT(icsp_gang_fast_data_write(&gang, 0x12345678) == -EPROTO);
+
+    /* Fast data read. */
+    write_gang_cycles(0x3,
+                      "10000000000000000000000000000000000110",
+                      "00000000000000000000000000000000000000",
+                      "00033333033303333303303303030333303300");
+    BTASSERT(icsp_gang_fast_data_read(&gang, &data) == 0);
+    BTASSERTI(data, ==, 0xdeadbeef);
+
+    /* Target 1 never accepts the fast data write and is dropped. */
+    write_gang_cycles(0x3,
+                      "10000000000000000000000000000000000110",
+                      "00000001111001101010001011000100100000",
+                      "00010000000000000000000000000000000000");
+
+    for (i = 0; i < ICSP_GANG_FAST_DATA_RETRIES; i++) {
+        write_gang_cycles(0x2,
+                          "10000000000000000000000000000000000110",
+                          "00000001111001101010001011000100100000",
+                          "00000000000000000000000000000000000000");
+    }
+
+    BTASSERT(icsp_gang_fast_data_write(&gang, 0x12345678) == 0);
+    BTASSERTI(icsp_gang_get_alive(&gang), ==, 0x1);
+
+    /* Stop. */
+    write_gang_stop(0x7);
+    BTASSERT(icsp_gang_stop(&gang) == 0);
+    BTASSERTI(icsp_gang_get_alive(&gang), ==, 0x1);
+
+    return (0);
+}
+
+/**
+ * The icsp_spi transport must clock the same cycles as a bit-banged
+ * ICSP transport for the same MTAP/ETAP sequence. The icsp_soft
+ * driver is part of Simba and mocked in this suite, so the bit-banged
+ * reference is the icsp_gang transport with a single target.
+ */
+static int test_icsp_spi_bitstream(void)
+{
+    struct icsp_spi_driver_t spi;
+    struct icsp_gang_driver_t gang;
+    struct pin_device_t *mclrn_devs[] = { &pin_d27_dev };
+    /* MTAP_SW_MTAP, MTAP_COMMAND, MCHP_STATUS reading 0x88,
+       MTAP_SW_ETAP, ETAP_FASTDATA and a fast data write of
+       0x12345678. */
+    static const struct {
+        const char *tms_p;
+        const char *tdi_p;
+        const char *tdo_p;
+    } cycles[] = {
+        { "11000000110", "00000010000", "00000000000" },
+        { "11000000110", "00001110000", "00000000000" },
+        { "1000000000110", "0000000000000", "0000001000100" },
+        { "11000000110", "00001010000", "00000000000" },
+        { "11000000110", "00000111000", "00000000000" },
+        {
+            "10000000000000000000000000000000000110",
+            "00000001111001101010001011000100100000",
+            "00010000000000000000000000000000000000"
+        }
+    };
+    uint8_t command;
+    uint8_t rxbuf[1];
+    uint8_t txbuf[1];
+    size_t i;
+
+    txbuf[0] = 0x00;
+
+    /* Bit-banged reference. */
+    BTASSERT(icsp_gang_init(&gang, &mclrn_devs[0], 1) == 0);
+    write_gang_start(0x1);
+    BTASSERT(icsp_gang_start(&gang, 0x1) == 0);
+
+    for (i = 0; i < membersof(cycles); i++) {
+        write_gang_cycles(0x1,
+                          cycles[i].tms_p,
+                          cycles[i].tdi_p,
+                          cycles[i].tdo_p);
+    }
+
+    command = bits_reverse_8(0x04);
+    BTASSERT(icsp_gang_instruction_write(&gang, &command, 5) == 0);
+    command = bits_reverse_8(0x07);
+    BTASSERT(icsp_gang_instruction_write(&gang, &command, 5) == 0);
+    BTASSERT(icsp_gang_data_transfer(&gang, &rxbuf[0], &txbuf[0], 8) == 0);
+    BTASSERTI(bits_reverse_8(rxbuf[0]), ==, 0x88);
+    command = bits_reverse_8(0x05);
+    BTASSERT(icsp_gang_instruction_write(&gang, &command, 5) == 0);
+    command = bits_reverse_8(0x0e);
+    BTASSERT(icsp_gang_instruction_write(&gang, &command, 5) == 0);
+    BTASSERT(icsp_gang_fast_data_write(&gang, 0x12345678) == 0);
+
+    write_gang_stop(0x1);
+    BTASSERT(icsp_gang_stop(&gang) == 0);
+
+    /* The same cycles, nibble encoded. */
+    BTASSERT(icsp_spi_init(&spi, &pin_d4_dev) == 0);
+    write_icsp_spi_start(ICSP_SPI_CLOCK_DIVIDER_DEFAULT);
+    BTASSERT(icsp_spi_start(&spi) == 0);
+
+    for (i = 0; i < membersof(cycles); i++) {
+        write_icsp_spi_cycles(cycles[i].tms_p,
+                              cycles[i].tdi_p,
+                              cycles[i].tdo_p);
+    }
+
+    command = bits_reverse_8(0x04);
+    BTASSERT(icsp_spi_instruction_write(&spi, &command, 5) == 0);
+    command = bits_reverse_8(0x07);
+    BTASSERT(icsp_spi_instruction_write(&spi, &command, 5) == 0);
+    rxbuf[0] = 0x00;
+    BTASSERT(icsp_spi_data_transfer(&spi, &rxbuf[0], &txbuf[0], 8) == 0);
+    BTASSERTI(bits_reverse_8(rxbuf[0]), ==, 0x88);
+    command = bits_reverse_8(0x05);
+    BTASSERT(icsp_spi_instruction_write(&spi, &command, 5) == 0);
+    command = bits_reverse_8(0x0e);
+    BTASSERT(icsp_spi_instruction_write(&spi, &command, 5) == 0);
+    BTASSERT(icsp_spi_fast_data_write(&spi, 0x12345678) == 0);
+
+    write_icsp_spi_stop();
+    BTASSERT(icsp_spi_stop(&spi) == 0);
+
+    return (0);
+}
+
+static int test_device_status_icsp_gang(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x68, 0x00, 0x02 };
+    uint8_t request_payload_crc[] = {
+        0x03, /* ICSP gang. */
+        0x07, /* Targets 0, 1 and 2. */
+        0x5e, 0x35
+    };
+    uint8_t response[] = {
+        0x00, 0x68, 0x00, 0x02,
+        0x48, /* Status. */
+        0x03, /* Targets 0 and 1. */
+        0xcf, 0x87
+    };
+
+    write_programmer_init();
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+
+    /* Target 2 has another status. */
+    write_gang_start(0x7);
+    write_gang_cycles(0x7, "11000000110", "00000010000", "00000000000");
+    write_gang_cycles(0x7, "11000000110", "00001110000", "00000000000");
+    write_gang_cycles(0x7, "1000000000110", "0000000000000", "0000003003000");
+    write_gang_stop(0x7);
+
+    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_targets_status_not_connected(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x6c, 0x00, 0x00 };
+    uint8_t request_payload_crc[] = { 0x6a, 0xca };
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0x95, /* ENOTCONN. */
+        0xdd, 0x25
+    };
+
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_connect_bad_transport(void)
+{
+    struct programmer_t programmer;
+    uint8_t request_header[] = { 0x00, 0x65, 0x00, 0x01 };
+    uint8_t request_payload_crc[] = {
+        0x05, /* Bad transport. */
+        0x97, 0x0f
+    };
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0xea, /* -EINVAL. */
+        0x52, 0x5d
+    };
+
+    write_programmer_process_packet(&request_header[0],
+                                    sizeof(request_header),
+                                    &request_payload_crc[0],
+                                    sizeof(request_payload_crc),
+                                    &response[0],
+                                    sizeof(response));
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_packet_ring(void)
+{
+    struct packet_ring_t ring;
+    uint8_t buf[3][4];
+    ssize_t sizes[3];
+    uint8_t *buf_p;
+    ssize_t size;
+    int i;
+
+    BTASSERT(packet_ring_init(&ring, &buf[0][0], &sizes[0], 4, 3) == 0);
+    BTASSERTI(packet_ring_used(&ring), ==, 0);
+    BTASSERT(packet_ring_read_begin(&ring, &size) == NULL);
+
+    /* Fill the ring. */
+    for (i = 0; i < 3; i++) {
+        buf_p = packet_ring_write_begin(&ring);
+        BTASSERT(buf_p == &buf[i][0]);
+        buf_p[0] = i;
+        packet_ring_write_end(&ring, i + 1);
+    }
+
+    BTASSERTI(packet_ring_used(&ring), ==, 3);
+    BTASSERT(packet_ring_write_begin(&ring) == NULL);
+
+    /* Drain one packet and write another, wrapping around. */
+    buf_p = packet_ring_read_begin(&ring, &size);
+    BTASSERT(buf_p == &buf[0][0]);
+    BTASSERTI(size, ==, 1);
+    BTASSERTI(buf_p[0], ==, 0);
+    packet_ring_read_end(&ring);
+
+    buf_p = packet_ring_write_begin(&ring);
+    BTASSERT(buf_p == &buf[0][0]);
+    buf_p[0] = 3;
+    packet_ring_write_end(&ring, -ETIMEDOUT);
+
+    /* Drain the rest in order. */
+    for (i = 1; i < 4; i++) {
+        buf_p = packet_ring_read_begin(&ring, &size);
+        BTASSERT(buf_p == &buf[i % 3][0]);
+        BTASSERTI(buf_p[0], ==, i);
+
+        if (i < 3) {
+            BTASSERTI(size, ==, i + 1);
+        } else {
+            BTASSERTI(size, ==, -ETIMEDOUT);
+        }
+
+        packet_ring_read_end(&ring);
+    }
+
+    BTASSERTI(packet_ring_used(&ring), ==, 0);
+    BTASSERT(packet_ring_read_begin(&ring, &size) == NULL);
+
+    return (0);
+}
+
+static int test_packet_crc(void)
+{
+    uint8_t buf[1030];
+    size_t i;
+    size_t size;
+
+    for (i = 0; i < sizeof(buf); i++) {
+        buf[i] = (i * 7 + (i >> 3));
+    }
+
+    /* Known value. */
+    BTASSERTI(packet_crc_ccitt(0xffff, "123456789", 9), ==, 0x29b1);
+
+    /* Same as the software implementation in Simba, for all packet
+       sizes, and when calculated in parts. */
+    for (size = 0; size <= sizeof(buf); size++) {
+        BTASSERTI(packet_crc_ccitt(0xffff, &buf[0], size),
+                  ==,
+                  crc_ccitt(0xffff, &buf[0], size));
+    }
+
+    BTASSERTI(packet_crc_ccitt(packet_crc_ccitt(0xffff, &buf[0], 100),
+                               &buf[100],
+                               930),
+              ==,
+              crc_ccitt(0xffff, &buf[0], 1030));
+    BTASSERTI(packet_crc_ccitt(0x1234, &buf[0], 16),
+              ==,
+              crc_ccitt(0x1234, &buf[0], 16));
+
+    return (0);
+}
+
+static void write_packet_crc(uint8_t *buf_p, size_t size)
+{
+    uint16_t crc;
+
+    crc = packet_crc_ccitt(0xffff, buf_p, size);
+    buf_p[size] = (crc >> 8);
+    buf_p[size + 1] = crc;
+}
+
+/* A production image with one segment of one row at 0x1d000000. */
+static void create_production_image(uint8_t *image_p)
+{
+    uint32_t image_crc;
+    uint16_t crc;
+    size_t i;
+
+    for (i = 0; i < 256; i++) {
+        image_p[16 + i] = i;
+    }
+
+    image_crc = crc_32(0, &image_p[16], 256);
+    crc = packet_crc_ccitt(0xffff, &image_p[16], 256);
+    image_p[0] = 0x1d;
+    image_p[1] = 0x00;
+    image_p[2] = 0x00;
+    image_p[3] = 0x00;
+    image_p[4] = 0x00;
+    image_p[5] = 0x00;
+    image_p[6] = 0x01;
+    image_p[7] = 0x00;
+    image_p[8] = (image_crc >> 24);
+    image_p[9] = (image_crc >> 16);
+    image_p[10] = (image_crc >> 8);
+    image_p[11] = (image_crc >> 0);
+    image_p[12] = (crc >> 8);
+    image_p[13] = crc;
+    image_p[14] = 0;
+    image_p[15] = 0;
+}
+
+static int test_production_store_enable(void)
+{
+    struct programmer_t programmer;
+    uint8_t image[272];
+    uint8_t store_request[4 + 4 + 272 + 2];
+    uint8_t store_response[] = { 0x00, 0x71, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t enable_request[4 + 9 + 2];
+    uint8_t enable_response[] = { 0x00, 0x72, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t status_request[] = { 0x00, 0x73, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t status_response[4 + 13 + 2];
+    uint32_t header[5];
+    uint32_t image_crc;
+
+    create_production_image(&image[0]);
+    image_crc = crc_32(0, &image[0], sizeof(image));
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+
+    /* Store the image. */
+    store_request[0] = 0x00;
+    store_request[1] = 0x71;
+    store_request[2] = 0x01;
+    store_request[3] = 0x14;
+    memset(&store_request[4], 0, 4);
+    memcpy(&store_request[8], &image[0], sizeof(image));
+    write_packet_crc(&store_request[0], 280);
+    write_packet_crc(&store_response[0], 4);
+    write_programmer_process_packet(&store_request[0],
+                                    4,
+                                    &store_request[4],
+                                    sizeof(store_request) - 4,
+                                    &store_response[0],
+                                    sizeof(store_response));
+    mock_write_flash_erase(0xc0000, 0x40000, 0);
+    mock_write_flash_write(0xc0100, &image[0], sizeof(image), sizeof(image));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* Enable production mode with chip erase and verify. */
+    enable_request[0] = 0x00;
+    enable_request[1] = 0x72;
+    enable_request[2] = 0x00;
+    enable_request[3] = 0x09;
+    enable_request[4] = 0x03;
+    enable_request[5] = 0x00;
+    enable_request[6] = 0x00;
+    enable_request[7] = 0x01;
+    enable_request[8] = 0x10;
+    enable_request[9] = (image_crc >> 24);
+    enable_request[10] = (image_crc >> 16);
+    enable_request[11] = (image_crc >> 8);
+    enable_request[12] = (image_crc >> 0);
+    write_packet_crc(&enable_request[0], 13);
+    write_packet_crc(&enable_response[0], 4);
+    write_programmer_process_packet(&enable_request[0],
+                                    4,
+                                    &enable_request[4],
+                                    sizeof(enable_request) - 4,
+                                    &enable_response[0],
+                                    sizeof(enable_response));
+    mock_write_flash_erase(0xc0000, 256, 0);
+    mock_write_flash_read(&image[0], 0xc0100, 256, 256);
+    mock_write_flash_read(&image[256], 0xc0200, 16, 16);
+    mock_write_flash_read(&image[0], 0xc0100, 16, 16);
+    header[0] = 0x70726f64;
+    header[1] = 0x03;
+    header[2] = 0;
+    header[3] = sizeof(image);
+    header[4] = image_crc;
+    mock_write_flash_write(0xc0000, &header[0], sizeof(header), sizeof(header));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* Enabled, and no PIC programmed yet. */
+    write_packet_crc(&status_request[0], 4);
+    memset(&status_response[0], 0, sizeof(status_response));
+    status_response[1] = 0x73;
+    status_response[3] = 13;
+    status_response[4] = 1;
+    write_packet_crc(&status_response[0], 17);
+    write_programmer_process_packet(&status_request[0],
+                                    4,
+                                    &status_request[4],
+                                    2,
+                                    &status_response[0],
+                                    sizeof(status_response));
+    mock_write_flash_read(&header[0], 0xc0000, sizeof(header), sizeof(header));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* A corrupt image is not enabled. */
+    enable_request[12] ^= 1;
+    write_packet_crc(&enable_request[0], 13);
+    write_read_command_request(&enable_request[0],
+                               4,
+                               &enable_request[4],
+                               sizeof(enable_request) - 4);
+    mock_write_flash_erase(0xc0000, 256, 0);
+    mock_write_flash_read(&image[0], 0xc0100, 256, 256);
+    mock_write_flash_read(&image[256], 0xc0200, 16, 16);
+    status_response[0] = 0xff;
+    status_response[1] = 0xff;
+    status_response[2] = 0x00;
+    status_response[3] = 0x04;
+    status_response[4] = 0xff;
+    status_response[5] = 0xff;
+    status_response[6] = 0xfc;
+    status_response[7] = 0x11;
+    write_packet_crc(&status_response[0], 8);
+    mock_write_chan_write(&status_response[0], 10, 10);
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_production_poll(void)
+{
+    struct programmer_t programmer;
+    uint8_t image[272];
+    uint8_t fast_write_request[16];
+    uint8_t fast_write_response[] = {
+        0x00, 0x6a, 0x00, 0x00, 0xd8, 0x6a
+    };
+    uint8_t crc_request[16];
+    uint8_t crc_response[10];
+    uint32_t header[5];
+    uint32_t data;
+    struct time_t time;
+
+    create_production_image(&image[0]);
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+
+    /* The transport selected by the host is restored after each
+       poll. */
+    programmer.transport = PROGRAMMER_TRANSPORT_JTAG_SOFT;
+
+    /* Production mode disabled. */
+    memset(&header[0], 0xff, sizeof(header));
+    mock_write_flash_read(&header[0], 0xc0000, sizeof(header), sizeof(header));
+
+    BTASSERTI(programmer_production_poll(&programmer), ==, 0);
+
+    header[0] = 0x70726f64;
+    header[1] = 0x03;
+    header[2] = 0;
+    header[3] = sizeof(image);
+    header[4] = crc_32(0, &image[0], sizeof(image));
+
+    /* No PIC. */
+    mock_write_flash_read(&header[0], 0xc0000, sizeof(header), sizeof(header));
+    mock_write_icsp_soft_init(&pin_d2_dev, &pin_d3_dev, &pin_d4_dev, 0);
+    mock_write_icsp_soft_start(0);
+    write_read_device_status(0x00);
+    mock_write_icsp_soft_stop(0);
+
+    BTASSERTI(programmer_production_poll(&programmer), ==, 0);
+
+    /* A PIC is connected. Chip erase, connect, write and verify. */
+    mock_write_flash_read(&header[0], 0xc0000, sizeof(header), sizeof(header));
+    mock_write_icsp_soft_init(&pin_d2_dev, &pin_d3_dev, &pin_d4_dev, 0);
+    mock_write_icsp_soft_start(0);
+    write_read_device_status(0x11);
+    mock_write_icsp_soft_stop(0);
+
+    mock_write_pin_write(0, 0);
+    mock_write_pin_write(0, 0);
+    mock_write_pin_write(1, 0);
+
+    mock_write_icsp_soft_init(&pin_d2_dev, &pin_d3_dev, &pin_d4_dev, 0);
+    mock_write_icsp_soft_start(0);
+    write_chip_erase(0, 0, 0, 0, 0);
+    mock_write_icsp_soft_stop(0);
+
+    write_handle_connect(0, 0, 0, 0xff, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    mock_write_flash_read(&image[0], 0xc0100, 16, 16);
+    fast_write_request[0] = 0x00;
+    fast_write_request[1] = 0x6a;
+    fast_write_request[2] = 0x00;
+    fast_write_request[3] = 0x0a;
+    memcpy(&fast_write_request[4], &image[0], 8);
+    memcpy(&fast_write_request[12], &image[12], 2);
+    write_packet_crc(&fast_write_request[0], 14);
+    write_ramapp_write(&fast_write_request[0],
+                       sizeof(fast_write_request),
+                       sizeof(fast_write_request));
+    mock_write_flash_read(&image[16], 0xc0110, 256, 256);
+    write_ramapp_fast_write_row(&image[16], 0xffff);
+    write_ramapp_read(&fast_write_response[0],
+                      sizeof(fast_write_response),
+                      sizeof(fast_write_response));
+
+    crc_request[0] = 0x00;
+    crc_request[1] = 0x05;
+    crc_request[2] = 0x00;
+    crc_request[3] = 0x08;
+    memcpy(&crc_request[4], &image[0], 8);
+    write_packet_crc(&crc_request[0], 12);
+    write_ramapp_write(&crc_request[0], 14, 14);
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+    mock_write_time_get(&time, 0);
+    data = 0x00050004;
+    mock_write_icsp_soft_fast_data_read(&data, 0);
+    mock_write_time_get(&time, 0);
+    crc_response[0] = 0x00;
+    crc_response[1] = 0x05;
+    crc_response[2] = 0x00;
+    crc_response[3] = 0x04;
+    memcpy(&crc_response[4], &image[8], 4);
+    write_packet_crc(&crc_response[0], 8);
+    write_ramapp_read(&crc_response[4], 6, 6);
+    mock_write_icsp_soft_stop(0);
+
+    mock_write_pin_write(0, 0);
+    mock_write_pin_write(1, 0);
+
+    BTASSERTI(programmer_production_poll(&programmer), ==, 1);
+    BTASSERTI(programmer.transport, ==, PROGRAMMER_TRANSPORT_JTAG_SOFT);
+
+    /* The programmed PIC is sensed, and not reset or programmed
+       again. */
+    mock_write_flash_read(&header[0], 0xc0000, sizeof(header), sizeof(header));
+    mock_write_pin_read(1);
+
+    BTASSERTI(programmer_production_poll(&programmer), ==, 0);
+
+    /* The PIC is removed. */
+    mock_write_flash_read(&header[0], 0xc0000, sizeof(header), sizeof(header));
+    mock_write_pin_read(0);
+
+    BTASSERTI(programmer_production_poll(&programmer), ==, 0);
+
+    mock_write_flash_read(&header[0], 0xc0000, sizeof(header), sizeof(header));
+    mock_write_icsp_soft_init(&pin_d2_dev, &pin_d3_dev, &pin_d4_dev, 0);
+    mock_write_icsp_soft_start(0);
+    write_read_device_status(0x00);
+    mock_write_icsp_soft_stop(0);
+
+    BTASSERTI(programmer_production_poll(&programmer), ==, 0);
+    BTASSERTI(programmer.transport, ==, PROGRAMMER_TRANSPORT_JTAG_SOFT);
+
+    return (0);
+}
+
+static int test_production_poll_ramapp_without_features(void)
+{
+    struct programmer_t programmer;
+    uint8_t image[272];
+    uint8_t fast_write_request[16];
+    uint8_t fast_write_response[] = {
+        0x00, 0x6a, 0x00, 0x00, 0xd8, 0x6a
+    };
+    uint8_t read_request[16];
+    uint8_t read_response[4 + 256 + 2 + 2];
+    uint32_t header[5];
+    uint32_t data;
+
+    create_production_image(&image[0]);
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+
+    header[0] = 0x70726f64;
+    header[1] = 0x03;
+    header[2] = 0;
+    header[3] = sizeof(image);
+    header[4] = crc_32(0, &image[0], sizeof(image));
+
+    /* A PIC with a ramapp without features is connected. The written
+       segment is verified by reading it, as the ramapp does not have
+       the CRC-32 command. */
+    mock_write_flash_read(&header[0], 0xc0000, sizeof(header), sizeof(header));
+    mock_write_icsp_soft_init(&pin_d2_dev, &pin_d3_dev, &pin_d4_dev, 0);
+    mock_write_icsp_soft_start(0);
+    write_read_device_status(0x11);
+    mock_write_icsp_soft_stop(0);
+
+    mock_write_pin_write(0, 0);
+    mock_write_pin_write(0, 0);
+    mock_write_pin_write(1, 0);
+
+    mock_write_icsp_soft_init(&pin_d2_dev, &pin_d3_dev, &pin_d4_dev, 0);
+    mock_write_icsp_soft_start(0);
+    write_chip_erase(0, 0, 0, 0, 0);
+    mock_write_icsp_soft_stop(0);
+
+    write_start_ramapp(0);
+
+    /* Fast write without the row CRC word. */
+    mock_write_flash_read(&image[0], 0xc0100, 16, 16);
+    fast_write_request[0] = 0x00;
+    fast_write_request[1] = 0x6a;
+    fast_write_request[2] = 0x00;
+    fast_write_request[3] = 0x0a;
+    memcpy(&fast_write_request[4], &image[0], 8);
+    memcpy(&fast_write_request[12], &image[12], 2);
+    write_packet_crc(&fast_write_request[0], 14);
+    write_ramapp_write(&fast_write_request[0],
+                       sizeof(fast_write_request),
+                       sizeof(fast_write_request));
+    mock_write_flash_read(&image[16], 0xc0110, 256, 256);
+    write_ramapp_write(&image[16], 256, 256);
+    write_ramapp_read(&fast_write_response[0],
+                      sizeof(fast_write_response),
+                      sizeof(fast_write_response));
+
+    /* Verify with the read command. */
+    read_request[0] = 0x00;
+    read_request[1] = 0x03;
+    read_request[2] = 0x00;
+    read_request[3] = 0x08;
+    memcpy(&read_request[4], &image[0], 8);
+    write_packet_crc(&read_request[0], 12);
+    write_ramapp_write(&read_request[0], 14, 14);
+    data = 0x00030100;
+    mock_write_icsp_soft_fast_data_read(&data, 0);
+    read_response[0] = 0x00;
+    read_response[1] = 0x03;
+    read_response[2] = 0x01;
+    read_response[3] = 0x00;
+    memcpy(&read_response[4], &image[16], 256);
+    write_packet_crc(&read_response[0], 260);
+    read_response[262] = 0x00;
+    read_response[263] = 0x00;
+    write_ramapp_read(&read_response[4], 260, 260);
+    mock_write_icsp_soft_stop(0);
+
+    mock_write_pin_write(0, 0);
+    mock_write_pin_write(1, 0);
+
+    BTASSERTI(programmer_production_poll(&programmer), ==, 1);
+
+    return (0);
+}
+
+static void write_job_step_start(void)
+{
+    struct time_t time;
+
+    time.seconds = 1;
+    time.nanoseconds = 0;
+    mock_write_time_get(&time, 0);
+}
+
+/* Step n takes n + 1 milliseconds. */
+static void write_job_step_end(int step)
+{
+    struct time_t time;
+
+    time.seconds = 1;
+    time.nanoseconds = (1000000 * (step + 1));
+    mock_write_time_get(&time, 0);
+}
+
+static int test_job(void)
+{
+    struct programmer_t programmer;
+    uint8_t request[4 + 1 + 1 + 1 + 11 + 13 + 1 + 2];
+    uint8_t response[4 + 20 + 2];
+    uint8_t row[256];
+    uint8_t fast_write_request[16];
+    uint8_t fast_write_response[] = {
+        0x00, 0x6a, 0x00, 0x00, 0xd8, 0x6a
+    };
+    uint8_t crc_request[16];
+    uint8_t crc_response[10];
+    uint32_t image_crc;
+    uint16_t crc;
+    uint32_t data;
+    struct time_t time;
+    int i;
+
+    for (i = 0; i < 256; i++) {
+        row[i] = i;
+    }
+
+    image_crc = crc_32(0, &row[0], sizeof(row));
+    crc = packet_crc_ccitt(0xffff, &row[0], sizeof(row));
+
+    /* Chip erase, connect, write, verify and disconnect with the
+       default transport. */
+    request[0] = 0x00;
+    request[1] = 0x74;
+    request[2] = 0x00;
+    request[3] = 0x1c;
+    request[4] = 0x00;
+    request[5] = 0x01;
+    request[6] = 0x02;
+    request[7] = 0x03;
+    request[8] = 0x1d;
+    request[9] = 0x00;
+    request[10] = 0x00;
+    request[11] = 0x00;
+    request[12] = 0x00;
+    request[13] = 0x00;
+    request[14] = 0x01;
+    request[15] = 0x00;
+    request[16] = (crc >> 8);
+    request[17] = crc;
+    request[18] = 0x04;
+    memcpy(&request[19], &request[8], 8);
+    request[27] = (image_crc >> 24);
+    request[28] = (image_crc >> 16);
+    request[29] = (image_crc >> 8);
+    request[30] = (image_crc >> 0);
+    request[31] = 0x05;
+    write_packet_crc(&request[0], 32);
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+
+    write_read_command_request(&request[0],
+                               4,
+                               &request[4],
+                               sizeof(request) - 4);
+
+    write_job_step_start();
+    mock_write_icsp_soft_init(&pin_d2_dev, &pin_d3_dev, &pin_d4_dev, 0);
+    mock_write_icsp_soft_start(0);
+    write_chip_erase(0, 0, 0, 0, 0);
+    mock_write_icsp_soft_stop(0);
+    write_job_step_end(0);
+
+    write_job_step_start();
+    write_handle_connect(0, 0, 0, 0xff, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    write_job_step_end(1);
+
+    write_job_step_start();
+    fast_write_request[0] = 0x00;
+    fast_write_request[1] = 0x6a;
+    fast_write_request[2] = 0x00;
+    fast_write_request[3] = 0x0a;
+    memcpy(&fast_write_request[4], &request[8], 10);
+    write_packet_crc(&fast_write_request[0], 14);
+    write_ramapp_write(&fast_write_request[0],
+                       sizeof(fast_write_request),
+                       sizeof(fast_write_request));
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+    mock_write_chan_read_with_timeout(&row[0], sizeof(row), &time, sizeof(row));
+    write_ramapp_fast_write_row(&row[0], 0xffff);
+    write_ramapp_read(&fast_write_response[0],
+                      sizeof(fast_write_response),
+                      sizeof(fast_write_response));
+    write_job_step_end(2);
+
+    write_job_step_start();
+    crc_request[0] = 0x00;
+    crc_request[1] = 0x05;
+    crc_request[2] = 0x00;
+    crc_request[3] = 0x08;
+    memcpy(&crc_request[4], &request[19], 8);
+    write_packet_crc(&crc_request[0], 12);
+    write_ramapp_write(&crc_request[0], 14, 14);
+    mock_write_time_get(&time, 0);
+    data = 0x00050004;
+    mock_write_icsp_soft_fast_data_read(&data, 0);
+    mock_write_time_get(&time, 0);
+    crc_response[0] = 0x00;
+    crc_response[1] = 0x05;
+    crc_response[2] = 0x00;
+    crc_response[3] = 0x04;
+    memcpy(&crc_response[4], &request[27], 4);
+    write_packet_crc(&crc_response[0], 8);
+    write_ramapp_read(&crc_response[4], 6, 6);
+    write_job_step_end(3);
+
+    write_job_step_start();
+    mock_write_icsp_soft_stop(0);
+    write_job_step_end(4);
+
+    /* Step times in microseconds. */
+    memset(&response[0], 0, sizeof(response));
+    response[1] = 0x74;
+    response[3] = 20;
+
+    for (i = 0; i < 5; i++) {
+        response[4 + 4 * i + 2] = (((i + 1) * 1000) >> 8);
+        response[4 + 4 * i + 3] = ((i + 1) * 1000);
+    }
+
+    write_packet_crc(&response[0], 24);
+    mock_write_chan_write(&response[0], sizeof(response), sizeof(response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_job_verify_ramapp_without_features(void)
+{
+    struct programmer_t programmer;
+    uint8_t request[4 + 1 + 1 + 13 + 1 + 2];
+    uint8_t response[4 + 12 + 2];
+    uint8_t read_request[16];
+    uint8_t read_response[4 + 256 + 2 + 2];
+    uint32_t image_crc;
+    uint32_t data;
+    int i;
+
+    for (i = 0; i < 256; i++) {
+        read_response[4 + i] = i;
+    }
+
+    image_crc = crc_32(0, &read_response[4], 256);
+
+    /* Connect, verify and disconnect with a ramapp without the CRC-32
+       command. The flash area is read instead. */
+    request[0] = 0x00;
+    request[1] = 0x74;
+    request[2] = 0x00;
+    request[3] = 0x10;
+    request[4] = 0x00;
+    request[5] = 0x02;
+    request[6] = 0x04;
+    request[7] = 0x1d;
+    request[8] = 0x00;
+    request[9] = 0x00;
+    request[10] = 0x00;
+    request[11] = 0x00;
+    request[12] = 0x00;
+    request[13] = 0x01;
+    request[14] = 0x00;
+    request[15] = (image_crc >> 24);
+    request[16] = (image_crc >> 16);
+    request[17] = (image_crc >> 8);
+    request[18] = (image_crc >> 0);
+    request[19] = 0x05;
+    write_packet_crc(&request[0], 20);
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+
+    write_read_command_request(&request[0],
+                               4,
+                               &request[4],
+                               sizeof(request) - 4);
+
+    write_job_step_start();
+    write_start_ramapp(0);
+    write_job_step_end(0);
+
+    write_job_step_start();
+    read_request[0] = 0x00;
+    read_request[1] = 0x03;
+    read_request[2] = 0x00;
+    read_request[3] = 0x08;
+    memcpy(&read_request[4], &request[7], 8);
+    write_packet_crc(&read_request[0], 12);
+    write_ramapp_write(&read_request[0], 14, 14);
+    data = 0x00030100;
+    mock_write_icsp_soft_fast_data_read(&data, 0);
+    read_response[0] = 0x00;
+    read_response[1] = 0x03;
+    read_response[2] = 0x01;
+    read_response[3] = 0x00;
+    write_packet_crc(&read_response[0], 260);
+    read_response[262] = 0x00;
+    read_response[263] = 0x00;
+    write_ramapp_read(&read_response[4], 260, 260);
+    write_job_step_end(1);
+
+    write_job_step_start();
+    mock_write_icsp_soft_stop(0);
+    write_job_step_end(2);
+
+    /* Step times in microseconds. */
+    memset(&response[0], 0, sizeof(response));
+    response[1] = 0x74;
+    response[3] = 12;
+
+    for (i = 0; i < 3; i++) {
+        response[4 + 4 * i + 2] = (((i + 1) * 1000) >> 8);
+        response[4 + 4 * i + 3] = ((i + 1) * 1000);
+    }
+
+    write_packet_crc(&response[0], 16);
+    mock_write_chan_write(&response[0], sizeof(response), sizeof(response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_job_failure(void)
+{
+    struct programmer_t programmer;
+    uint8_t request[4 + 1 + 13 + 11 + 2];
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x08,
+        0xff, 0xff, 0xff, 0x95, /* -ENOTCONN. */
+        0x00, 0x00, 0x00, 0x00, /* Step. */
+        0x00, 0x00
+    };
+    uint8_t row[256];
+    struct time_t time;
+
+    /* A verify step and a write step, not connected. */
+    memset(&request[0], 0, sizeof(request));
+    request[1] = 0x74;
+    request[3] = 25;
+    request[5] = 0x04;
+    request[6] = 0x1d;
+    request[12] = 0x01;
+    request[18] = 0x03;
+    request[19] = 0x1d;
+    request[25] = 0x01;
+    write_packet_crc(&request[0], 29);
+    write_packet_crc(&response[0], 12);
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+
+    write_programmer_process_packet(&request[0],
+                                    4,
+                                    &request[4],
+                                    sizeof(request) - 4,
+                                    &response[0],
+                                    sizeof(response));
+    write_job_step_start();
+    write_job_step_end(0);
+
+    /* The first data packet of the write step is discarded. */
+    memset(&row[0], 0, sizeof(row));
+    time.seconds = 0;
+    time.nanoseconds = 500000000;
+    mock_write_chan_read_with_timeout(&row[0], sizeof(row), &time, sizeof(row));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_stats(void)
+{
+    struct programmer_t programmer;
+    uint8_t ping_request[] = { 0x00, 0x64, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t ping_response[] = { 0x00, 0x64, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t stats_request[] = { 0x00, 0x75, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t stats_response[4 + 52 + 2];
+    struct time_t time;
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+
+    write_packet_crc(&ping_request[0], 4);
+    write_packet_crc(&ping_response[0], 4);
+    write_programmer_process_packet(&ping_request[0],
+                                    4,
+                                    &ping_request[4],
+                                    2,
+                                    &ping_response[0],
+                                    sizeof(ping_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* Each phase takes one microsecond. The payload and crc of both
+       requests are received, and the crc of both requests and the
+       ping response are calculated. */
+    write_packet_crc(&stats_request[0], 4);
+    memset(&stats_response[0], 0, sizeof(stats_response));
+    stats_response[1] = 0x75;
+    stats_response[3] = 52;
+    stats_response[4] = 0x00;
+    stats_response[5] = 0x0f;
+    stats_response[6] = 0x44;
+    stats_response[7] = 0x34;
+    stats_response[11] = 2;
+    stats_response[15] = 4;
+    stats_response[43] = 3;
+    stats_response[47] = 12;
+    write_packet_crc(&stats_response[0], 56);
+    write_programmer_process_packet(&stats_request[0],
+                                    4,
+                                    &stats_request[4],
+                                    2,
+                                    &stats_response[0],
+                                    sizeof(stats_response));
+    time.seconds = 1;
+    time.nanoseconds = 500000;
+    mock_write_time_get(&time, 0);
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    return (0);
+}
+
+static int test_trace(void)
+{
+    struct programmer_t programmer;
+    uint8_t control_request[] = { 0x00, 0x76, 0x00, 0x01, 0x01, 0x00, 0x00 };
+    uint8_t control_response[] = { 0x00, 0x76, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t status_request[] = { 0x00, 0x68, 0x00, 0x00, 0xb6, 0x0a };
+    uint8_t status_response[] = { 0x00, 0x68, 0x00, 0x01, 0x48, 0x37, 0xe0 };
+    uint8_t read_request[] = {
+        0x00, 0x77, 0x00, 0x04,
+        0x00, 0x00, 0x00, 0x00, /* Index. */
+        0x00, 0x00
+    };
+    uint8_t read_response[] = {
+        0x00, 0x77, 0x00, 0x44,
+        0x00, 0x00, 0x00, 0x05, /* Number of recorded entries. */
+        0x00, 0x00, 0x00, 0x00, /* Index of first entry. */
+        /* Device status command. */
+        0x00, 0x00, 0x03, 0x48, /* Start. */
+        0x00, 0x00, 0x03, 0x9c, /* End. */
+        0x00, 0x68, 0x00, 0x00,
+        /* Switch to MTAP. */
+        0x00, 0x00, 0x04, 0xec, /* Start. */
+        0x00, 0x00, 0x05, 0x94, /* End. */
+        0x01, 0x04, 0x00, 0x05,
+        /* MCHP command instruction. */
+        0x00, 0x00, 0x06, 0x3c, /* Start. */
+        0x00, 0x00, 0x06, 0xe4, /* End. */
+        0x01, 0x07, 0x00, 0x05,
+        /* MCHP status command. */
+        0x00, 0x00, 0x07, 0x8c, /* Start. */
+        0x00, 0x00, 0x08, 0x34, /* End. */
+        0x02, 0x07, 0x00, 0x08,
+        /* Trace read command. */
+        0x00, 0x00, 0x09, 0xd8, /* Start. */
+        0x00, 0x00, 0x0a, 0x2c, /* End. */
+        0x00, 0x77, 0x00, 0x00,
+        0x00, 0x00
+    };
+
+    write_programmer_init();
+    BTASSERT(programmer_init(&programmer) == 0);
+
+    /* Start the trace. */
+    write_packet_crc(&control_request[0], 5);
+    write_packet_crc(&control_response[0], 4);
+    write_programmer_process_packet(&control_request[0],
+                                    4,
+                                    &control_request[4],
+                                    3,
+                                    &control_response[0],
+                                    sizeof(control_response));
+
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* Shift a few bits. */
+    write_programmer_process_packet(&status_request[0],
+                                    4,
+                                    &status_request[4],
+                                    2,
+                                    &status_response[0],
+                                    sizeof(status_response));
+    mock_write_icsp_soft_init(&pin_d2_dev,
+                              &pin_d3_dev,
+                              &pin_d4_dev,
+                              0);
+    mock_write_icsp_soft_start(0);
     write_read_device_status(0x12);
-
     mock_write_icsp_soft_stop(0);
 
-    BTASSERT(programmer_init(&programmer) == 0);
+    BTASSERTI(programmer_process_packet(&programmer), ==, 0);
+
+    /* Read the recorded commands and shifts. */
+    write_packet_crc(&read_request[0], 8);
+    write_packet_crc(&read_response[0], 72);
+    write_programmer_process_packet(&read_request[0],
+                                    4,
+                                    &read_request[4],
+                                    6,
+                                    &read_response[0],
+                                    sizeof(read_response));
+
     BTASSERTI(programmer_process_packet(&programmer), ==, 0);
 
     return (0);
@@ -1467,6 +5182,14 @@ int main()
             test_connect_upload_ramapp_failure,
             "test_connect_upload_ramapp_failure"
         },
+        {
+            test_connect_upload_ramapp_crc_failure,
+            "test_connect_upload_ramapp_crc_failure"
+        },
+        {
+            test_connect_upload_loader_speculative,
+            "test_connect_upload_loader_speculative"
+        },
         { test_disconnect, "test_disconnect" },
         { test_disconnect_not_connected, "test_disconnect_not_connected" },
         { test_reset, "test_reset" },
@@ -1475,6 +5198,14 @@ int main()
         { test_command_read_header_timeout, "test_command_read_header_timeout" },
         { test_command_read_crc_timeout, "test_command_read_crc_timeout" },
         { test_ramapp_command, "test_ramapp_command" },
+        {
+            test_ramapp_command_extended_response,
+            "test_ramapp_command_extended_response"
+        },
+        {
+            test_ramapp_command_extended_read_without_feature,
+            "test_ramapp_command_extended_read_without_feature"
+        },
         {
             test_ramapp_command_fast_data_write_fail,
             "test_ramapp_command_fast_data_write_fail"
@@ -1482,10 +5213,81 @@ int main()
         { test_chip_erase, "test_chip_erase" },
         { test_chip_erase_errors, "test_chip_erase_errors" },
         { test_version, "test_version" },
+        { test_capabilities, "test_capabilities" },
         { test_fast_write, "test_fast_write" },
+        { test_fast_write_window, "test_fast_write_window" },
+        {
+            test_fast_write_ramapp_without_features,
+            "test_fast_write_ramapp_without_features"
+        },
         { test_fast_write_not_connected, "test_fast_write_not_connected" },
+        { test_staged_write, "test_staged_write" },
+        { test_stage_bad_crc, "test_stage_bad_crc" },
+        { test_production_store_enable, "test_production_store_enable" },
+        { test_production_poll, "test_production_poll" },
+        {
+            test_production_poll_ramapp_without_features,
+            "test_production_poll_ramapp_without_features"
+        },
+        { test_job, "test_job" },
+        {
+            test_job_verify_ramapp_without_features,
+            "test_job_verify_ramapp_without_features"
+        },
+        { test_job_failure, "test_job_failure" },
+        { test_stats, "test_stats" },
+        { test_trace, "test_trace" },
         { test_fast_write_errors, "test_fast_write_errors" },
+        { test_fast_write_failed_rows, "test_fast_write_failed_rows" },
+        { test_fast_read, "test_fast_read" },
+        {
+            test_fast_read_ramapp_without_features,
+            "test_fast_read_ramapp_without_features"
+        },
         { test_device_status, "test_device_status" },
+        { test_read_words, "test_read_words" },
+        { test_read_words_errors, "test_read_words_errors" },
+        { test_icsp_spi, "test_icsp_spi" },
+        { test_device_status_icsp_spi, "test_device_status_icsp_spi" },
+        {
+            test_icsp_spi_fast_data_burst,
+            "test_icsp_spi_fast_data_burst"
+        },
+        {
+            test_ramapp_command_icsp_spi_burst,
+            "test_ramapp_command_icsp_spi_burst"
+        },
+        {
+            test_connect_icsp_spi_clock_calibration,
+            "test_connect_icsp_spi_clock_calibration"
+        },
+        {
+            test_connect_icsp_spi_clock_override,
+            "test_connect_icsp_spi_clock_override"
+        },
+        {
+            test_ramapp_command_icsp_spi_downclock,
+            "test_ramapp_command_icsp_spi_downclock"
+        },
+        {
+            test_fast_write_icsp_spi_downclock,
+            "test_fast_write_icsp_spi_downclock"
+        },
+        { test_jtag_soft, "test_jtag_soft" },
+        { test_device_status_jtag_soft, "test_device_status_jtag_soft" },
+        { test_jtag_soft_chain, "test_jtag_soft_chain" },
+        { test_device_status_jtag_soft_chain,
+          "test_device_status_jtag_soft_chain" },
+        { test_device_status_jtag_soft_chain_bad_ir_length,
+          "test_device_status_jtag_soft_chain_bad_ir_length" },
+        { test_connect_jtag_soft_attach, "test_connect_jtag_soft_attach" },
+        { test_icsp_gang, "test_icsp_gang" },
+        { test_icsp_spi_bitstream, "test_icsp_spi_bitstream" },
+        { test_device_status_icsp_gang, "test_device_status_icsp_gang" },
+        { test_targets_status_not_connected, "test_targets_status_not_connected" },
+        { test_connect_bad_transport, "test_connect_bad_transport" },
+        { test_packet_ring, "test_packet_ring" },
+        { test_packet_crc, "test_packet_crc" },
         { NULL, NULL }
     };
 
@@ -0,0 +1,110 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#include "simba.h"
+#include "usb_vendor.h"
+
+/**
+ * Move received packets from given OUT endpoint to given queue. A
+ * packet is left in the endpoint until there is room for it in the
+ * queue, so the host is NAKed instead of data being dropped.
+ */
+static void read_endpoint_isr(struct usb_vendor_driver_t *self_p,
+                              int endpoint,
+                              struct queue_t *queue_p)
+{
+    ssize_t size;
+
+    while (queue_unused_size_isr(queue_p) >= sizeof(self_p->packet)) {
+        size = usb_device_read_isr(self_p->drv_p,
+                                   endpoint,
+                                   &self_p->packet[0],
+                                   sizeof(self_p->packet));
+
+        if (size <= 0) {
+            break;
+        }
+
+        queue_write_isr(queue_p, &self_p->packet[0], size);
+    }
+}
+
+static int start_of_frame_isr(struct usb_device_driver_base_t *base_p)
+{
+    struct usb_vendor_driver_t *self_p;
+
+    self_p = (struct usb_vendor_driver_t *)base_p;
+
+    read_endpoint_isr(self_p, USB_VENDOR_ENDPOINT_OUT, &self_p->chin);
+    read_endpoint_isr(self_p,
+                      USB_VENDOR_ENDPOINT_DATA_OUT,
+                      &self_p->data_chin);
+
+    return (0);
+}
+
+/**
+ * The interface has no class specific requests.
+ */
+static int setup_isr(struct usb_device_driver_base_t *base_p,
+                     struct usb_setup_t *setup_p)
+{
+    return (-1);
+}
+
+static ssize_t write_cb(void *arg_p,
+                        const void *buf_p,
+                        size_t size)
+{
+    struct usb_vendor_driver_t *self_p;
+
+    self_p = container_of(arg_p, struct usb_vendor_driver_t, chout);
+
+    return (usb_device_write(self_p->drv_p,
+                             USB_VENDOR_ENDPOINT_IN,
+                             buf_p,
+                             size));
+}
+
+int usb_vendor_init(struct usb_vendor_driver_t *self_p,
+                    struct usb_device_driver_t *drv_p,
+                    void *rxbuf_p,
+                    size_t size,
+                    void *data_rxbuf_p,
+                    size_t data_size)
+{
+    self_p->base.start_of_frame_isr = start_of_frame_isr;
+    self_p->base.setup_isr = setup_isr;
+    self_p->drv_p = drv_p;
+
+    queue_init(&self_p->chin, rxbuf_p, size);
+    queue_init(&self_p->data_chin, data_rxbuf_p, data_size);
+    chan_init(&self_p->chout, chan_read_null, write_cb, chan_size_null);
+
+    return (0);
+}
@@ -0,0 +1,77 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#ifndef __USB_VENDOR_H__
+#define __USB_VENDOR_H__
+
+#include "simba.h"
+
+/* Vendor specific interface with bulk endpoints for the programmer
+   protocol, next to the CDC ACM console. */
+#ifndef CONFIG_PROGRAMMER_USB_VENDOR
+#    define CONFIG_PROGRAMMER_USB_VENDOR                    0
+#endif
+
+#define USB_VENDOR_INTERFACE                                2
+
+/* Commands and responses, and fast write data packets on an
+   endpoint of its own. */
+#define USB_VENDOR_ENDPOINT_OUT                             4
+#define USB_VENDOR_ENDPOINT_IN                              5
+#define USB_VENDOR_ENDPOINT_DATA_OUT                        6
+
+/* Bulk endpoint maximum packet size at high speed. */
+#define USB_VENDOR_PACKET_SIZE                            512
+
+/**
+ * A USB device class driver for the vendor specific interface.
+ */
+struct usb_vendor_driver_t {
+    struct usb_device_driver_base_t base;
+    struct usb_device_driver_t *drv_p;
+    struct queue_t chin;
+    struct queue_t data_chin;
+    struct chan_t chout;
+    uint8_t packet[USB_VENDOR_PACKET_SIZE];
+};
+
+/**
+ * Initialize given driver object. Received commands are buffered in
+ * given receive buffer, and fast write data in given data receive
+ * buffer.
+ *
+ * @return zero(0) or negative error code.
+ */
+int usb_vendor_init(struct usb_vendor_driver_t *self_p,
+                    struct usb_device_driver_t *drv_p,
+                    void *rxbuf_p,
+                    size_t size,
+                    void *data_rxbuf_p,
+                    size_t data_size);
+
+#endif
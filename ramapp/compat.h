@@ -68,6 +68,22 @@ static inline int memcmp8(void *buf_p, uint32_t address, size_t size)
     return (memcmp(buf_p, (void *)(uintptr_t)address, size));
 }
 
+static inline uint32_t *ext_region(void)
+{
+    return ((uint32_t *)RAMAPP_EXT_ADDRESS);
+}
+
+/**
+ * Size of the code and constants at the start of the image.
+ */
+static inline uint32_t image_constant_size(void)
+{
+    extern uint8_t __ram_begin[];
+    extern uint8_t __constant_end[];
+
+    return ((uintptr_t)&__constant_end[0] - (uintptr_t)&__ram_begin[0]);
+}
+
 #else
 
 extern uint32_t etap_fast_data_read(void);
@@ -75,6 +91,8 @@ extern void etap_fast_data_write(uint32_t value);
 extern uint8_t load_flash_8(uint32_t address, size_t index);
 extern uint32_t load_flash_32(uint32_t address, size_t index);
 extern int memcmp8(void *buf_p, uint32_t address, size_t size);
+extern uint32_t *ext_region(void);
+extern uint32_t image_constant_size(void);
 
 #endif
 
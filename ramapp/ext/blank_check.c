@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+/**
+ * Blank check extension module. Checks that a flash memory area is
+ * erased.
+ */
+
+#include "ramapp_ext.h"
+
+#define COMMAND_TYPE_BLANK_CHECK                            7
+
+/**
+ * Respond with the address of the first word not erased, or an empty
+ * response if all words are erased.
+ */
+static ssize_t handle_blank_check(int type, uint8_t *buf_p, size_t size)
+{
+    uint32_t address;
+    volatile uint32_t *words_p;
+    size_t i;
+
+    address = ((buf_p[0] << 24) | (buf_p[1] << 16) | (buf_p[2] << 8) | buf_p[3]);
+    size = ((buf_p[4] << 24) | (buf_p[5] << 16) | (buf_p[6] << 8) | buf_p[7]);
+    words_p = (volatile uint32_t *)address;
+
+    for (i = 0; i < size / 4; i++) {
+        if (words_p[i] != 0xffffffff) {
+            address += (4 * i);
+            buf_p[0] = (address >> 24);
+            buf_p[1] = (address >> 16);
+            buf_p[2] = (address >> 8);
+            buf_p[3] = (address >> 0);
+
+            return (4);
+        }
+    }
+
+    return (0);
+}
+
+RAMAPP_EXT_DEFINE(handle_blank_check, COMMAND_TYPE_BLANK_CHECK);
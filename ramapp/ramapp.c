@@ -37,16 +37,45 @@
 
 #define PAYLOAD_OFFSET                (TYPE_SIZE + SIZE_SIZE)
 
+/* Size field of packets with a 32 bits size after the size field. */
+#define SIZE_EXTENDED                                  0xffff
+#define EXTENDED_SIZE_SIZE                                  4
+
+/* Returned by command handlers that have written the response
+   themselves. */
+#define RESPONSE_WRITTEN                           0x7fffffff
+
 /* Command types. */
 #define COMMAND_TYPE_FAILED                                -1
 #define COMMAND_TYPE_PING                                   1
 #define COMMAND_TYPE_ERASE                                  2
 #define COMMAND_TYPE_READ                                   3
 #define COMMAND_TYPE_WRITE                                  4
+#define COMMAND_TYPE_CRC                                    5
+#define COMMAND_TYPE_EXT_LOAD                               6
+#define COMMAND_TYPE_FEATURES                               8
 #define COMMAND_TYPE_FAST_WRITE                           106
+#define COMMAND_TYPE_FAST_READ                            120
+
+/* Data packets of a fast read. */
+#define COMMAND_TYPE_FAST_READ_DATA                         0
+#define FAST_READ_DATA_SIZE                  MAXIMUM_PAYLOAD_SIZE
+
+/* Features in the features response. The programmer only uses
+   features of the ramapp running in the PIC. */
+#define FEATURE_PING_ECHO                              (1 << 0)
+#define FEATURE_CRC                                    (1 << 1)
+#define FEATURE_EXT_LOAD                               (1 << 2)
+#define FEATURE_EXTENDED_READ                          (1 << 3)
+#define FEATURE_FAST_WRITE_ROW_CRC                     (1 << 4)
+#define FEATURE_FAST_READ                              (1 << 5)
 
 #define FLASH_ROW_SIZE                                    256
 
+/* Failed rows listed in a fast write response. More failed rows fail
+   the command. */
+#define FAST_WRITE_FAILED_ROWS_MAX                         64
+
 /**
  * Faster than memcmp.
  */
@@ -115,6 +144,53 @@ static ssize_t handle_erase(struct ramapp_t *self_p,
     return (flash_erase(self_p->flash_p, address, size));
 }
 
+/**
+ * Write a read response with an extended size field, with data read
+ * from flash while written, as it does not fit in the packet buffer.
+ */
+static ssize_t write_read_response_extended(uint32_t address, size_t size)
+{
+    uint8_t buf[PAYLOAD_OFFSET + EXTENDED_SIZE_SIZE];
+    uint16_t crc;
+    size_t i;
+    size_t j;
+
+    buf[0] = 0;
+    buf[1] = COMMAND_TYPE_READ;
+    buf[2] = (SIZE_EXTENDED >> 8);
+    buf[3] = (SIZE_EXTENDED & 0xff);
+    buf[4] = (size >> 24);
+    buf[5] = (size >> 16);
+    buf[6] = (size >> 8);
+    buf[7] = (size >> 0);
+    crc = crc_ccitt(0xffff, &buf[0], sizeof(buf));
+    fast_data_write(&buf[0], sizeof(buf));
+
+    /* Data, one word at a time. */
+    for (i = 0; (size - i) >= 4; i += 4) {
+        for (j = 0; j < 4; j++) {
+            buf[j] = load_flash_8(address, i + j);
+        }
+
+        crc = crc_ccitt(crc, &buf[0], 4);
+        fast_data_write(&buf[0], 4);
+    }
+
+    /* Remaining data and crc. */
+    memset(&buf[0], 0, sizeof(buf));
+
+    for (j = 0; i + j < size; j++) {
+        buf[j] = load_flash_8(address, i + j);
+    }
+
+    crc = crc_ccitt(crc, &buf[0], j);
+    buf[j] = (crc >> 8);
+    buf[j + 1] = crc;
+    fast_data_write(&buf[0], j + CRC_SIZE);
+
+    return (RESPONSE_WRITTEN);
+}
+
 static ssize_t handle_read(struct ramapp_t *self_p,
                            uint8_t *buf_p,
                            size_t size)
@@ -126,6 +202,10 @@ static ssize_t handle_read(struct ramapp_t *self_p,
     address = ((buf_p[0] << 24) | (buf_p[1] << 16) | (buf_p[2] << 8) | buf_p[3]);
     size = ((buf_p[4] << 24) | (buf_p[5] << 16) | (buf_p[6] << 8) | buf_p[7]);
 
+    if (size > MAXIMUM_PAYLOAD_SIZE) {
+        return (write_read_response_extended(address, size));
+    }
+
     dst_p = buf_p;
 
     for (i = 0; i < size; i++) {
@@ -135,6 +215,59 @@ static ssize_t handle_read(struct ramapp_t *self_p,
     return (size);
 }
 
+/**
+ * Write given memory area to FASTDATA in data packets, each with a
+ * CRC of its own, read from memory a word at a time. The programmer
+ * forwards the data packets to the host as they are, followed by the
+ * response.
+ */
+static ssize_t handle_fast_read(struct ramapp_t *self_p,
+                                uint8_t *buf_p,
+                                size_t size)
+{
+    uint32_t address;
+    uint32_t data;
+    uint16_t crc;
+    uint8_t bytes[4];
+    size_t data_size;
+    size_t i;
+
+    address = ((buf_p[0] << 24) | (buf_p[1] << 16) | (buf_p[2] << 8) | buf_p[3]);
+    size = ((buf_p[4] << 24) | (buf_p[5] << 16) | (buf_p[6] << 8) | buf_p[7]);
+
+    if (((address % 4) != 0) || ((size % 4) != 0)) {
+        return (-EINVAL);
+    }
+
+    while (size > 0) {
+        data_size = MIN(size, FAST_READ_DATA_SIZE);
+        bytes[0] = (COMMAND_TYPE_FAST_READ_DATA >> 8);
+        bytes[1] = COMMAND_TYPE_FAST_READ_DATA;
+        bytes[2] = (data_size >> 8);
+        bytes[3] = data_size;
+        crc = crc_ccitt(0xffff, &bytes[0], sizeof(bytes));
+        fast_data_write(&bytes[0], sizeof(bytes));
+
+        for (i = 0; i < data_size / 4; i++) {
+            data = load_flash_32(address, i);
+            bytes[0] = (data >> 0);
+            bytes[1] = (data >> 8);
+            bytes[2] = (data >> 16);
+            bytes[3] = (data >> 24);
+            crc = crc_ccitt(crc, &bytes[0], sizeof(bytes));
+            fast_data_write(&bytes[0], sizeof(bytes));
+        }
+
+        bytes[0] = (crc >> 8);
+        bytes[1] = crc;
+        fast_data_write(&bytes[0], CRC_SIZE);
+        address += data_size;
+        size -= data_size;
+    }
+
+    return (0);
+}
+
 static ssize_t handle_write(struct ramapp_t *self_p,
                             uint8_t *buf_p,
                             size_t size)
@@ -158,98 +291,295 @@ static ssize_t handle_write(struct ramapp_t *self_p,
     return (res);
 }
 
-static ssize_t handle_fast_write(struct ramapp_t *self_p,
-                                 uint8_t *buf_p,
-                                 size_t size)
+/**
+ * Calculate the CRC-32 of given memory area, read in words. The
+ * programmer compares the CRC-32 of the ramapp image in RAM to its
+ * own copy, to find out if the ramapp is already running.
+ */
+static ssize_t handle_crc(struct ramapp_t *self_p,
+                          uint8_t *buf_p,
+                          size_t size)
 {
     uint32_t address;
-    ssize_t res;
-    uint32_t actual_crc;
-    uint32_t expected_crc;
-    uint8_t buf[2][FLASH_ROW_SIZE];
-    int index;
-    int i;
+    uint32_t data;
+    uint32_t crc;
+    uint8_t bytes[4];
+    size_t i;
 
     address = ((buf_p[0] << 24) | (buf_p[1] << 16) | (buf_p[2] << 8) | buf_p[3]);
     size = ((buf_p[4] << 24) | (buf_p[5] << 16) | (buf_p[6] << 8) | buf_p[7]);
-    expected_crc = ((buf_p[8] << 8) | (buf_p[9] << 0));
 
-    /* Start the first row. */
-    fast_data_read(&buf[0][0], FLASH_ROW_SIZE);
+    crc = 0;
 
-    res = flash_async_write(self_p->flash_p,
-                            address,
-                            &buf[0][0],
-                            FLASH_ROW_SIZE);
+    for (i = 0; i < size / 4; i++) {
+        data = load_flash_32(address, i);
+        bytes[0] = (data >> 0);
+        bytes[1] = (data >> 8);
+        bytes[2] = (data >> 16);
+        bytes[3] = (data >> 24);
+        crc = crc_32(crc, &bytes[0], sizeof(bytes));
+    }
 
-    if (res != 0) {
-        return (res);
+    buf_p[0] = (crc >> 24);
+    buf_p[1] = (crc >> 16);
+    buf_p[2] = (crc >> 8);
+    buf_p[3] = (crc >> 0);
+
+    return (4);
+}
+
+/**
+ * Load an extension module into the extension module region. The
+ * module image is read from FASTDATA after the request, one word at
+ * a time, as it is stored in memory.
+ */
+static ssize_t handle_ext_load(struct ramapp_t *self_p,
+                               uint8_t *buf_p,
+                               size_t size)
+{
+    uint32_t expected_crc;
+    uint32_t *region_p;
+    const struct ramapp_ext_t *ext_p;
+    size_t i;
+
+    size = ((buf_p[0] << 24) | (buf_p[1] << 16) | (buf_p[2] << 8) | buf_p[3]);
+    expected_crc = ((buf_p[4] << 24)
+                    | (buf_p[5] << 16)
+                    | (buf_p[6] << 8)
+                    | (buf_p[7] << 0));
+
+    if ((size < sizeof(*ext_p))
+        || (size > RAMAPP_EXT_SIZE)
+        || ((size % 4) != 0)) {
+        return (-EINVAL);
     }
 
-    actual_crc = crc_ccitt(0xffff, &buf[0][0], FLASH_ROW_SIZE);
+    self_p->ext_p = NULL;
+    region_p = ext_region();
 
-    /* Middle rows. */
-    index = 0;
+    for (i = 0; i < size / 4; i++) {
+        region_p[i] = etap_fast_data_read();
+    }
 
-    for (i = FLASH_ROW_SIZE; i < size; i += FLASH_ROW_SIZE) {
-        index ^= 1;
-        fast_data_read(&buf[index][0], FLASH_ROW_SIZE);
+    if (crc_32(0, region_p, size) != expected_crc) {
+        return (-EBADCRC);
+    }
 
-        res = flash_async_wait(self_p->flash_p);
+    ext_p = (const struct ramapp_ext_t *)region_p;
 
-        if (res != 0) {
-            return (res);
-        }
+    if (ext_p->magic != RAMAPP_EXT_MAGIC) {
+        return (-EINVAL);
+    }
 
-        /* Reading from flash at the same time as writing stalls the
-           CPU until the write is complete. */
-        res = memcmp32((uint32_t *)&buf[index ^ 1][0],
-                       address + i - FLASH_ROW_SIZE,
-                       FLASH_ROW_SIZE);
+    self_p->ext_p = ext_p;
 
-        if (res != 0) {
-            return (-EFLASHWRITE);
-        }
+    return (0);
+}
 
-        res = flash_async_write(self_p->flash_p,
-                                address + i,
-                                &buf[index][0],
-                                FLASH_ROW_SIZE);
+/**
+ * Pass given command to the loaded extension module, if it handles
+ * it.
+ */
+static ssize_t handle_ext(struct ramapp_t *self_p,
+                          int type,
+                          uint8_t *buf_p,
+                          size_t size)
+{
+    int i;
 
-        if (res != 0) {
-            return (res);
-        }
+    if (self_p->ext_p == NULL) {
+        return (-ENOCOMMAND);
+    }
 
-        actual_crc = crc_ccitt(actual_crc,
-                               &buf[index][0],
-                               FLASH_ROW_SIZE);
+    for (i = 0; i < RAMAPP_EXT_TYPES_MAX; i++) {
+        if (self_p->ext_p->types[i] == type) {
+            return (self_p->ext_p->handle(type, buf_p, size));
+        }
     }
 
-    /* Wait for the last row. */
+    return (-ENOCOMMAND);
+}
+
+/**
+ * Respond with the features of this ramapp, and the size of the code
+ * and constants at the start of its image. A ramapp without this
+ * command fails it, and has none of the features.
+ */
+static ssize_t handle_features(struct ramapp_t *self_p,
+                               uint8_t *buf_p,
+                               size_t size)
+{
+    uint32_t features;
+
+    features = (FEATURE_PING_ECHO
+                | FEATURE_CRC
+                | FEATURE_EXT_LOAD
+                | FEATURE_EXTENDED_READ
+                | FEATURE_FAST_WRITE_ROW_CRC
+                | FEATURE_FAST_READ);
+
+    buf_p[0] = (features >> 24);
+    buf_p[1] = (features >> 16);
+    buf_p[2] = (features >> 8);
+    buf_p[3] = (features >> 0);
+    size = image_constant_size();
+    buf_p[4] = (size >> 24);
+    buf_p[5] = (size >> 16);
+    buf_p[6] = (size >> 8);
+    buf_p[7] = (size >> 0);
+
+    return (8);
+}
+
+/**
+ * Wait for the write of given row to complete, and compare the flash
+ * with the row.
+ *
+ * @return zero(0) or negative error code.
+ */
+static int fast_write_wait(struct ramapp_t *self_p,
+                           uint8_t *row_p,
+                           uint32_t address)
+{
+    int res;
+
     res = flash_async_wait(self_p->flash_p);
 
     if (res != 0) {
         return (res);
     }
 
-    res = memcmp32((uint32_t *)&buf[index][0],
-                   address + i - FLASH_ROW_SIZE,
-                   FLASH_ROW_SIZE);
-
-    if (res != 0) {
+    /* Reading from flash at the same time as writing stalls the CPU
+       until the write is complete. */
+    if (memcmp32((uint32_t *)row_p, address, FLASH_ROW_SIZE) != 0) {
         return (-EFLASHWRITE);
     }
 
-    if (actual_crc != expected_crc) {
+    return (0);
+}
+
+/**
+ * Add given row address to the failed rows in the response payload,
+ * unless the list is full.
+ *
+ * @return The number of failed rows.
+ */
+static size_t fast_write_add_failed_row(uint8_t *buf_p,
+                                        size_t number_of_failed_rows,
+                                        uint32_t address)
+{
+    if (number_of_failed_rows < FAST_WRITE_FAILED_ROWS_MAX) {
+        buf_p = &buf_p[4 * number_of_failed_rows];
+        buf_p[0] = (address >> 24);
+        buf_p[1] = (address >> 16);
+        buf_p[2] = (address >> 8);
+        buf_p[3] = (address >> 0);
+    }
+
+    return (number_of_failed_rows + 1);
+}
+
+/**
+ * Write rows read from FASTDATA to flash. Each row is followed by a
+ * word with the CRC of all data up to and including the row,
+ * calculated by the programmer. A row not matching its CRC is not
+ * written, so it is still erased. Rows not matching their CRC or
+ * failing to be written are listed in the response, and all other
+ * rows are written.
+ */
+static ssize_t handle_fast_write(struct ramapp_t *self_p,
+                                 uint8_t *buf_p,
+                                 size_t size)
+{
+    uint32_t address;
+    uint32_t offset;
+    ssize_t res;
+    uint16_t crc;
+    uint16_t row_crc;
+    uint16_t expected_crc;
+    uint8_t buf[2][FLASH_ROW_SIZE];
+    size_t number_of_failed_rows;
+    int is_writing;
+    int index;
+
+    address = ((buf_p[0] << 24) | (buf_p[1] << 16) | (buf_p[2] << 8) | buf_p[3]);
+    size = ((buf_p[4] << 24) | (buf_p[5] << 16) | (buf_p[6] << 8) | buf_p[7]);
+    expected_crc = ((buf_p[8] << 8) | (buf_p[9] << 0));
+
+    crc = 0xffff;
+    number_of_failed_rows = 0;
+    is_writing = 0;
+    index = 0;
+
+    for (offset = 0; offset < size; offset += FLASH_ROW_SIZE) {
+        fast_data_read(&buf[index][0], FLASH_ROW_SIZE);
+        row_crc = etap_fast_data_read();
+
+        /* The previous row is written while this row is read. */
+        if (is_writing) {
+            res = fast_write_wait(self_p,
+                                  &buf[index ^ 1][0],
+                                  address + offset - FLASH_ROW_SIZE);
+
+            if (res != 0) {
+                number_of_failed_rows = fast_write_add_failed_row(
+                    buf_p,
+                    number_of_failed_rows,
+                    address + offset - FLASH_ROW_SIZE);
+            }
+        }
+
+        if (crc_ccitt(crc, &buf[index][0], FLASH_ROW_SIZE) == row_crc) {
+            res = flash_async_write(self_p->flash_p,
+                                    address + offset,
+                                    &buf[index][0],
+                                    FLASH_ROW_SIZE);
+        } else {
+            res = -EBADCRC;
+        }
+
+        is_writing = (res == 0);
+
+        if (!is_writing) {
+            number_of_failed_rows = fast_write_add_failed_row(
+                buf_p,
+                number_of_failed_rows,
+                address + offset);
+        }
+
+        crc = row_crc;
+        index ^= 1;
+    }
+
+    /* Wait for the last row. */
+    if (is_writing) {
+        res = fast_write_wait(self_p,
+                              &buf[index ^ 1][0],
+                              address + offset - FLASH_ROW_SIZE);
+
+        if (res != 0) {
+            number_of_failed_rows = fast_write_add_failed_row(
+                buf_p,
+                number_of_failed_rows,
+                address + offset - FLASH_ROW_SIZE);
+        }
+    }
+
+    /* The programmer received other data than sent by the host. */
+    if (crc != expected_crc) {
 #if defined(UNIT_TEST)
         std_printf(OSTR("fast_write: actual_crc: 0x%04x, expected_crc: 0x%04x\r\n"),
-                   actual_crc,
+                   crc,
                    expected_crc);
 #endif
         return (-EBADCRC);
     }
 
-    return (0);
+    if (number_of_failed_rows > FAST_WRITE_FAILED_ROWS_MAX) {
+        return (-EFLASHWRITE);
+    }
+
+    return (4 * number_of_failed_rows);
 }
 
 static ssize_t handle_command(struct ramapp_t *self_p,
@@ -264,7 +594,8 @@ static ssize_t handle_command(struct ramapp_t *self_p,
     switch (type) {
 
     case COMMAND_TYPE_PING:
-        res = 0;
+        /* Echo the payload, already in the buffer. */
+        res = size;
         break;
 
     case COMMAND_TYPE_ERASE:
@@ -279,12 +610,28 @@ static ssize_t handle_command(struct ramapp_t *self_p,
         res = handle_write(self_p, &buf_p[PAYLOAD_OFFSET], size);
         break;
 
+    case COMMAND_TYPE_CRC:
+        res = handle_crc(self_p, &buf_p[PAYLOAD_OFFSET], size);
+        break;
+
+    case COMMAND_TYPE_EXT_LOAD:
+        res = handle_ext_load(self_p, &buf_p[PAYLOAD_OFFSET], size);
+        break;
+
+    case COMMAND_TYPE_FEATURES:
+        res = handle_features(self_p, &buf_p[PAYLOAD_OFFSET], size);
+        break;
+
     case COMMAND_TYPE_FAST_WRITE:
         res = handle_fast_write(self_p, &buf_p[PAYLOAD_OFFSET], size);
         break;
 
+    case COMMAND_TYPE_FAST_READ:
+        res = handle_fast_read(self_p, &buf_p[PAYLOAD_OFFSET], size);
+        break;
+
     default:
-        res = -ENOCOMMAND;
+        res = handle_ext(self_p, type, &buf_p[PAYLOAD_OFFSET], size);
         break;
     }
 
@@ -360,6 +707,7 @@ int ramapp_init(struct ramapp_t *self_p,
                 struct flash_driver_t *flash_p)
 {
     self_p->flash_p = flash_p;
+    self_p->ext_p = NULL;
 
     return (0);
 }
@@ -373,6 +721,10 @@ int ramapp_process_packet(struct ramapp_t *self_p)
 
     if (size >= 0) {
         size = handle_command(self_p, &buf[0], size);
+
+        if (size == RESPONSE_WRITTEN) {
+            return (0);
+        }
     }
 
     return (write_command_response(&buf[0], size));
@@ -30,9 +30,12 @@
 #define __RAMAPP_H__
 
 #include "simba.h"
+#include "ramapp_ext.h"
 
 struct ramapp_t {
     struct flash_driver_t *flash_p;
+    /* Loaded extension module, or NULL. */
+    const struct ramapp_ext_t *ext_p;
 };
 
 /**
@@ -0,0 +1,76 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018, Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * This file is part of the PIC tools project.
+ */
+
+#ifndef __RAMAPP_EXT_H__
+#define __RAMAPP_EXT_H__
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/* Extension modules are linked to and loaded into this RAM
+   region. */
+#define RAMAPP_EXT_ADDRESS                         0xa0006000
+#define RAMAPP_EXT_SIZE                                0x1000
+
+#define RAMAPP_EXT_MAGIC                           0x54584552
+#define RAMAPP_EXT_TYPES_MAX                                4
+
+/**
+ * Handle given command. The request payload is in the buffer, and
+ * the response payload is written to it.
+ *
+ * @return Response payload size or negative error code.
+ */
+typedef ssize_t (*ramapp_ext_handle_t)(int type,
+                                       uint8_t *buf_p,
+                                       size_t size);
+
+/**
+ * Extension module header, first in the module image.
+ */
+struct ramapp_ext_t {
+    uint32_t magic;
+    ramapp_ext_handle_t handle;
+    /* Command types handled by the module. Unused entries are
+       zero(0). */
+    int32_t types[RAMAPP_EXT_TYPES_MAX];
+};
+
+/**
+ * Define the extension module header. Place it first in a module
+ * source file.
+ */
+#define RAMAPP_EXT_DEFINE(handle, ...)                          \
+    const struct ramapp_ext_t ramapp_ext                        \
+    __attribute__ ((section (".ramapp_ext"), used)) = {         \
+        .magic = RAMAPP_EXT_MAGIC,                              \
+        .handle = handle,                                       \
+        .types = { __VA_ARGS__ }                                \
+    }
+
+#endif
@@ -142,6 +142,18 @@ static void write_load_flash_32(uint32_t address, size_t index, uint32_t res)
                        sizeof(res));
 }
 
+static uint32_t ext_region_words[RAMAPP_EXT_SIZE / 4];
+
+uint32_t *ext_region(void)
+{
+    return (&ext_region_words[0]);
+}
+
+uint32_t image_constant_size(void)
+{
+    return (0x800);
+}
+
 static void write_cmp32(uint8_t *buf_p, uint32_t address, size_t size)
 {
     size_t i;
@@ -263,6 +275,28 @@ static int test_ping(void)
     return (0);
 }
 
+static int test_ping_echo(void)
+{
+    struct ramapp_t ramapp;
+    struct flash_driver_t flash;
+    uint8_t request_header[] = { 0x00, 0x01, 0x00, 0x04 };
+    uint8_t request_payload_crc[] = { 0xaa, 0x55, 0x00, 0xff, 0x29, 0x4a };
+    uint8_t response[] = {
+        0x00, 0x01, 0x00, 0x04, 0xaa, 0x55, 0x00, 0xff, 0x29, 0x4a
+    };
+
+    write_read_command_request(&request_header[0],
+                               &request_payload_crc[0],
+                               sizeof(request_payload_crc));
+    write_write_command_response(&response[0],
+                                 sizeof(response));
+
+    BTASSERT(ramapp_init(&ramapp, &flash) == 0);
+    BTASSERT(ramapp_process_packet(&ramapp) == 0);
+
+    return (0);
+}
+
 static int test_erase(void)
 {
     struct ramapp_t ramapp;
@@ -317,6 +351,156 @@ static int test_read(void)
     return (0);
 }
 
+static int test_read_extended(void)
+{
+    struct ramapp_t ramapp;
+    struct flash_driver_t flash;
+    uint8_t request_header[] = { 0x00, 0x03, 0x00, 0x08 };
+    uint8_t request_payload_crc[] = {
+        0x04, 0x03, 0x02, 0x01, /* Address. */
+        0x00, 0x00, 0x04, 0x03, /* Size. */
+        0xdf, 0xa5
+    };
+    uint8_t response[8 + 1027 + 2];
+    size_t i;
+
+    /* Too big for the packet buffer, so the size field is extended
+       and the data is written while read from flash. */
+    response[0] = 0x00;
+    response[1] = 0x03;
+    response[2] = 0xff;
+    response[3] = 0xff;
+    response[4] = 0x00;
+    response[5] = 0x00;
+    response[6] = 0x04;
+    response[7] = 0x03;
+
+    for (i = 0; i < 1027; i++) {
+        response[8 + i] = i;
+    }
+
+    response[8 + 1027] = 0x9a;
+    response[8 + 1027 + 1] = 0x40;
+
+    write_read_command_request(&request_header[0],
+                               &request_payload_crc[0],
+                               sizeof(request_payload_crc));
+    write_fast_data_write(&response[0], 8);
+
+    for (i = 0; i < 1024; i += 4) {
+        write_load_flash_8(0x04030201, i, i + 0);
+        write_load_flash_8(0x04030201, i + 1, i + 1);
+        write_load_flash_8(0x04030201, i + 2, i + 2);
+        write_load_flash_8(0x04030201, i + 3, i + 3);
+        write_fast_data_write(&response[8 + i], 4);
+    }
+
+    write_load_flash_8(0x04030201, 1024, 1024 & 0xff);
+    write_load_flash_8(0x04030201, 1025, 1025 & 0xff);
+    write_load_flash_8(0x04030201, 1026, 1026 & 0xff);
+    write_fast_data_write(&response[8 + 1024], 5);
+
+    BTASSERT(ramapp_init(&ramapp, &flash) == 0);
+    BTASSERT(ramapp_process_packet(&ramapp) == 0);
+
+    return (0);
+}
+
+static int test_fast_read(void)
+{
+    struct ramapp_t ramapp;
+    struct flash_driver_t flash;
+    uint8_t request_header[] = { 0x00, 0x78, 0x00, 0x08 };
+    uint8_t request_payload_crc[] = {
+        0x1d, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x04, 0x04, /* Size. */
+        0x00, 0x00
+    };
+    uint8_t data_header[] = { 0x00, 0x00, 0x04, 0x00 };
+    uint8_t last_data[] = { 0x00, 0x00, 0x00, 0x04, 0x44, 0x33, 0x22, 0x11 };
+    uint8_t response[] = { 0x00, 0x78, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t bytes[4];
+    uint16_t crc;
+    size_t i;
+
+    crc = crc_ccitt(0xffff, &request_header[0], sizeof(request_header));
+    crc = crc_ccitt(crc, &request_payload_crc[0], 8);
+    request_payload_crc[8] = (crc >> 8);
+    request_payload_crc[9] = crc;
+    write_read_command_request(&request_header[0],
+                               &request_payload_crc[0],
+                               sizeof(request_payload_crc));
+
+    /* A full data packet, read a word at a time. */
+    write_fast_data_write(&data_header[0], sizeof(data_header));
+    crc = crc_ccitt(0xffff, &data_header[0], sizeof(data_header));
+
+    for (i = 0; i < 256; i++) {
+        write_load_flash_32(0x1d000000, i, i);
+        bytes[0] = i;
+        bytes[1] = 0;
+        bytes[2] = 0;
+        bytes[3] = 0;
+        write_fast_data_write(&bytes[0], sizeof(bytes));
+        crc = crc_ccitt(crc, &bytes[0], sizeof(bytes));
+    }
+
+    bytes[0] = (crc >> 8);
+    bytes[1] = crc;
+    write_fast_data_write(&bytes[0], 2);
+
+    /* The last data packet. */
+    write_load_flash_32(0x1d000400, 0, 0x11223344);
+    write_fast_data_write(&last_data[0], sizeof(last_data));
+    crc = crc_ccitt(0xffff, &last_data[0], sizeof(last_data));
+    bytes[0] = (crc >> 8);
+    bytes[1] = crc;
+    write_fast_data_write(&bytes[0], 2);
+
+    /* The response. */
+    crc = crc_ccitt(0xffff, &response[0], 4);
+    response[4] = (crc >> 8);
+    response[5] = crc;
+    write_write_command_response(&response[0], sizeof(response));
+
+    BTASSERT(ramapp_init(&ramapp, &flash) == 0);
+    BTASSERT(ramapp_process_packet(&ramapp) == 0);
+
+    return (0);
+}
+
+static int test_fast_read_unaligned(void)
+{
+    struct ramapp_t ramapp;
+    struct flash_driver_t flash;
+    uint8_t request_header[] = { 0x00, 0x78, 0x00, 0x08 };
+    uint8_t request_payload_crc[] = {
+        0x1d, 0x00, 0x00, 0x01, /* Unaligned address. */
+        0x00, 0x00, 0x00, 0x04, /* Size. */
+        0x00, 0x00
+    };
+    uint8_t response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xff, 0xea, /* -EINVAL. */
+        0x52, 0x5d
+    };
+    uint16_t crc;
+
+    crc = crc_ccitt(0xffff, &request_header[0], sizeof(request_header));
+    crc = crc_ccitt(crc, &request_payload_crc[0], 8);
+    request_payload_crc[8] = (crc >> 8);
+    request_payload_crc[9] = crc;
+    write_read_command_request(&request_header[0],
+                               &request_payload_crc[0],
+                               sizeof(request_payload_crc));
+    write_write_command_response(&response[0], sizeof(response));
+
+    BTASSERT(ramapp_init(&ramapp, &flash) == 0);
+    BTASSERT(ramapp_process_packet(&ramapp) == 0);
+
+    return (0);
+}
+
 static int test_write(void)
 {
     struct ramapp_t ramapp;
@@ -420,6 +604,109 @@ static int test_write_memcmp_failure(void)
     return (0);
 }
 
+static int test_crc(void)
+{
+    struct ramapp_t ramapp;
+    struct flash_driver_t flash;
+    uint8_t request_header[] = { 0x00, 0x05, 0x00, 0x08 };
+    uint8_t request_payload_crc[] = {
+        0xa0, 0x00, 0x00, 0x00, /* Address. */
+        0x00, 0x00, 0x00, 0x08, /* Size. */
+        0x23, 0xe9
+    };
+    uint8_t response[] = {
+        0x00, 0x05, 0x00, 0x04,
+        0x17, 0x6f, 0x3f, 0xe5, /* CRC-32. */
+        0x84, 0x6f
+    };
+
+    write_read_command_request(&request_header[0],
+                               &request_payload_crc[0],
+                               sizeof(request_payload_crc));
+    write_load_flash_32(0xa0000000, 0, 0x11223344);
+    write_load_flash_32(0xa0000000, 1, 0x55667788);
+    write_write_command_response(&response[0],
+                                 sizeof(response));
+
+    BTASSERT(ramapp_init(&ramapp, &flash) == 0);
+    BTASSERT(ramapp_process_packet(&ramapp) == 0);
+
+    return (0);
+}
+
+/**
+ * Write a fast write row followed by the CRC of all data up to and
+ * including the row. Returns the CRC.
+ */
+static uint16_t write_fast_write_row(uint8_t *buf_p, uint16_t crc)
+{
+    crc = crc_ccitt(crc, buf_p, 256);
+    write_fast_data_read(buf_p, 256);
+    write_etap_fast_data_read(crc);
+
+    return (crc);
+}
+
+/**
+ * Write a fast write request of given rows.
+ */
+static void write_fast_write_request(uint32_t address,
+                                     uint32_t size,
+                                     uint16_t data_crc)
+{
+    uint8_t request_header[] = { 0x00, 0x6a, 0x00, 0x0a };
+    uint8_t request_payload_crc[12];
+    uint16_t crc;
+
+    request_payload_crc[0] = (address >> 24);
+    request_payload_crc[1] = (address >> 16);
+    request_payload_crc[2] = (address >> 8);
+    request_payload_crc[3] = (address >> 0);
+    request_payload_crc[4] = (size >> 24);
+    request_payload_crc[5] = (size >> 16);
+    request_payload_crc[6] = (size >> 8);
+    request_payload_crc[7] = (size >> 0);
+    request_payload_crc[8] = (data_crc >> 8);
+    request_payload_crc[9] = data_crc;
+    crc = crc_ccitt(0xffff, &request_header[0], sizeof(request_header));
+    crc = crc_ccitt(crc, &request_payload_crc[0], 10);
+    request_payload_crc[10] = (crc >> 8);
+    request_payload_crc[11] = crc;
+    write_read_command_request(&request_header[0],
+                               &request_payload_crc[0],
+                               sizeof(request_payload_crc));
+}
+
+/**
+ * Write a fast write response with given failed row addresses.
+ */
+static void write_fast_write_response(uint32_t *addresses_p,
+                                      size_t number_of_addresses)
+{
+    uint8_t response[4 + 8 + 2];
+    uint16_t crc;
+    size_t size;
+    size_t i;
+
+    size = (4 * number_of_addresses);
+    response[0] = 0x00;
+    response[1] = 0x6a;
+    response[2] = 0x00;
+    response[3] = size;
+
+    for (i = 0; i < number_of_addresses; i++) {
+        response[4 + 4 * i + 0] = (addresses_p[i] >> 24);
+        response[4 + 4 * i + 1] = (addresses_p[i] >> 16);
+        response[4 + 4 * i + 2] = (addresses_p[i] >> 8);
+        response[4 + 4 * i + 3] = (addresses_p[i] >> 0);
+    }
+
+    crc = crc_ccitt(0xffff, &response[0], 4 + size);
+    response[4 + size] = (crc >> 8);
+    response[4 + size + 1] = crc;
+    write_write_command_response(&response[0], 4 + size + 2);
+}
+
 static int test_fast_write_one_row(void)
 {
     struct ramapp_t ramapp;
@@ -439,7 +726,7 @@ static int test_fast_write_one_row(void)
                                sizeof(request_payload_crc));
     memset(&buf[0], 0x12, sizeof(buf));
     buf[3] = 0x21;
-    write_fast_data_read(&buf[0], sizeof(buf));
+    write_fast_write_row(&buf[0], 0xffff);
     mock_write_flash_async_write(0x04030201,
                                  &buf[0],
                                  sizeof(buf),
@@ -459,26 +746,15 @@ static int test_fast_write_one_row_bad_compare(void)
 {
     struct ramapp_t ramapp;
     struct flash_driver_t flash;
-    uint8_t request_header[] = { 0x00, 0x6a, 0x00, 0x0a };
-    uint8_t request_payload_crc[] = {
-        0x04, 0x03, 0x02, 0x01, /* Address. */
-        0x00, 0x00, 0x01, 0x00, /* Size. */
-        0x8f, 0xd6, /* Crc. */
-        0x3c, 0x6c
-    };
-    uint8_t response[] = {
-        0xff, 0xff, 0x00, 0x04,
-        0xff, 0xff, 0xfc, 0x10, /* Error code. */
-        0x49, 0x5b
-    };
+    uint32_t failed_rows[] = { 0x04030201 };
     uint8_t buf[256];
 
-    write_read_command_request(&request_header[0],
-                               &request_payload_crc[0],
-                               sizeof(request_payload_crc));
     memset(&buf[0], 0x12, sizeof(buf));
     buf[3] = 0x22;
-    write_fast_data_read(&buf[0], sizeof(buf));
+    write_fast_write_request(0x04030201,
+                             sizeof(buf),
+                             crc_ccitt(0xffff, &buf[0], sizeof(buf)));
+    write_fast_write_row(&buf[0], 0xffff);
     mock_write_flash_async_write(0x04030201,
                                  &buf[0],
                                  sizeof(buf),
@@ -486,8 +762,7 @@ static int test_fast_write_one_row_bad_compare(void)
     mock_write_flash_async_wait(0);
     buf[3] = 0x23;
     write_cmp32(&buf[0], 0x04030201, 4);
-    write_write_command_response(&response[0],
-                                 sizeof(response));
+    write_fast_write_response(&failed_rows[0], membersof(failed_rows));
 
     BTASSERT(ramapp_init(&ramapp, &flash) == 0);
     BTASSERT(ramapp_process_packet(&ramapp) == 0);
@@ -499,31 +774,19 @@ static int test_fast_write_one_row_bad_async_write(void)
 {
     struct ramapp_t ramapp;
     struct flash_driver_t flash;
-    uint8_t request_header[] = { 0x00, 0x6a, 0x00, 0x0a };
-    uint8_t request_payload_crc[] = {
-        0x04, 0x03, 0x02, 0x01, /* Address. */
-        0x00, 0x00, 0x01, 0x00, /* Size. */
-        0x8f, 0xd6, /* Crc. */
-        0x3c, 0x6c
-    };
-    uint8_t response[] = {
-        0xff, 0xff, 0x00, 0x04,
-        0xff, 0xff, 0xff, 0xed, /* Error code. */
-        0x22, 0xba
-    };
+    uint32_t failed_rows[] = { 0x04030201 };
     uint8_t buf[256];
 
-    write_read_command_request(&request_header[0],
-                               &request_payload_crc[0],
-                               sizeof(request_payload_crc));
     memset(&buf[0], 0x12, sizeof(buf));
-    write_fast_data_read(&buf[0], sizeof(buf));
+    write_fast_write_request(0x04030201,
+                             sizeof(buf),
+                             crc_ccitt(0xffff, &buf[0], sizeof(buf)));
+    write_fast_write_row(&buf[0], 0xffff);
     mock_write_flash_async_write(0x04030201,
                                  &buf[0],
                                  sizeof(buf),
                                  -19);
-    write_write_command_response(&response[0],
-                                 sizeof(response));
+    write_fast_write_response(&failed_rows[0], membersof(failed_rows));
 
     BTASSERT(ramapp_init(&ramapp, &flash) == 0);
     BTASSERT(ramapp_process_packet(&ramapp) == 0);
@@ -544,16 +807,18 @@ static int test_fast_write_two_rows(void)
     };
     uint8_t response[] = { 0x00, 0x6a, 0x00, 0x00, 0xd8, 0x6a };
     uint8_t buf[256];
+    uint16_t crc;
     int i;
 
     write_read_command_request(&request_header[0],
                                &request_payload_crc[0],
                                sizeof(request_payload_crc));
     memset(&buf[0], 0x12, sizeof(buf));
+    crc = 0xffff;
 
     for (i = 0; i < 2; i++) {
         buf[3] = 0x21 + i;
-        write_fast_data_read(&buf[0], sizeof(buf));
+        crc = write_fast_write_row(&buf[0], crc);
         mock_write_flash_async_write(0x04030201 + sizeof(buf) * i,
                                      &buf[0],
                                      sizeof(buf),
@@ -588,16 +853,20 @@ static int test_fast_write_two_rows_bad_crc(void)
         0x59, 0x7a
     };
     uint8_t buf[256];
+    uint16_t crc;
     int i;
 
+    /* The rows are received by the programmer as sent by the PIC, but
+       not as sent by the host. */
     write_read_command_request(&request_header[0],
                                &request_payload_crc[0],
                                sizeof(request_payload_crc));
     memset(&buf[0], 0x12, sizeof(buf));
     buf[3] = 0x21;
+    crc = 0xffff;
 
     for (i = 0; i < 2; i++) {
-        write_fast_data_read(&buf[0], sizeof(buf));
+        crc = write_fast_write_row(&buf[0], crc);
         mock_write_flash_async_write(0x04030201 + sizeof(buf) * i,
                                      &buf[0],
                                      sizeof(buf),
@@ -615,7 +884,7 @@ static int test_fast_write_two_rows_bad_crc(void)
     return (0);
 }
 
-static int test_fast_write_two_rows_bad_compare(void)
+static int test_fast_write_two_rows_bad_row_crc(void)
 {
     struct ramapp_t ramapp;
     struct flash_driver_t flash;
@@ -626,29 +895,83 @@ static int test_fast_write_two_rows_bad_compare(void)
         0x18, 0x87, /* Crc. */
         0x6c, 0x18
     };
-    uint8_t response[] = {
-        0xff, 0xff, 0x00, 0x04,
-        0xff, 0xff, 0xfc, 0x10, /* Error code. */
-        0x49, 0x5b
-    };
+    uint32_t failed_rows[] = { 0x04030201 };
     uint8_t buf[256];
+    uint16_t crc;
 
     write_read_command_request(&request_header[0],
                                &request_payload_crc[0],
                                sizeof(request_payload_crc));
+
+    /* First, with a bit error on the ICSP link. Not written. */
     memset(&buf[0], 0x12, sizeof(buf));
-    buf[3] = 0x22;
+    buf[3] = 0x21;
+    crc = crc_ccitt(0xffff, &buf[0], sizeof(buf));
+    buf[100] = 0x13;
     write_fast_data_read(&buf[0], sizeof(buf));
+    write_etap_fast_data_read(crc);
+
+    /* Second. */
+    buf[3] = 0x22;
+    buf[100] = 0x12;
+    write_fast_write_row(&buf[0], crc);
+    mock_write_flash_async_write(0x04030301,
+                                 &buf[0],
+                                 sizeof(buf),
+                                 0);
+    mock_write_flash_async_wait(0);
+    write_cmp32(&buf[0], 0x04030301, sizeof(buf));
+
+    write_fast_write_response(&failed_rows[0], membersof(failed_rows));
+
+    BTASSERT(ramapp_init(&ramapp, &flash) == 0);
+    BTASSERT(ramapp_process_packet(&ramapp) == 0);
+
+    return (0);
+}
+
+static int test_fast_write_two_rows_bad_compare(void)
+{
+    struct ramapp_t ramapp;
+    struct flash_driver_t flash;
+    uint8_t request_header[] = { 0x00, 0x6a, 0x00, 0x0a };
+    uint8_t request_payload_crc[] = {
+        0x04, 0x03, 0x02, 0x01, /* Address. */
+        0x00, 0x00, 0x02, 0x00, /* Size. */
+        0x18, 0x87, /* Crc. */
+        0x6c, 0x18
+    };
+    uint32_t failed_rows[] = { 0x04030201 };
+    uint8_t buf[256];
+    uint16_t crc;
+
+    write_read_command_request(&request_header[0],
+                               &request_payload_crc[0],
+                               sizeof(request_payload_crc));
+    memset(&buf[0], 0x12, sizeof(buf));
+
+    /* First - compare fails. */
+    buf[3] = 0x21;
+    crc = write_fast_write_row(&buf[0], 0xffff);
     mock_write_flash_async_write(0x04030201,
                                  &buf[0],
                                  sizeof(buf),
                                  0);
-    write_fast_data_read(&buf[0], sizeof(buf));
     mock_write_flash_async_wait(0);
     buf[3] = 0x23;
     write_cmp32(&buf[0], 0x04030201, 4);
-    write_write_command_response(&response[0],
-                                 sizeof(response));
+
+    /* Second. */
+    buf[3] = 0x22;
+    write_fast_write_row(&buf[0], crc);
+    mock_write_flash_async_write(0x04030301,
+                                 &buf[0],
+                                 sizeof(buf),
+                                 0);
+    mock_write_flash_async_wait(0);
+    write_cmp32(&buf[0], 0x04030301, sizeof(buf));
+
+    write_fast_write_response(&failed_rows[0], membersof(failed_rows));
 
     BTASSERT(ramapp_init(&ramapp, &flash) == 0);
     BTASSERT(ramapp_process_packet(&ramapp) == 0);
@@ -667,34 +990,156 @@ static int test_fast_write_two_rows_bad_async_write(void)
         0x18, 0x87, /* Crc. */
         0x6c, 0x18
     };
-    uint8_t response[] = {
-        0xff, 0xff, 0x00, 0x04,
-        0xff, 0xff, 0xff, 0xee, /* Error code. */
-        0x12, 0xd9
-    };
+    uint32_t failed_rows[] = { 0x04030201, 0x04030301 };
     uint8_t buf[256];
+    uint16_t crc;
 
     write_read_command_request(&request_header[0],
                                &request_payload_crc[0],
                                sizeof(request_payload_crc));
     memset(&buf[0], 0x12, sizeof(buf));
 
-    /* First. */
-    write_fast_data_read(&buf[0], sizeof(buf));
+    /* First - wait fails. */
+    buf[3] = 0x21;
+    crc = write_fast_write_row(&buf[0], 0xffff);
     mock_write_flash_async_write(0x04030201,
                                  &buf[0],
                                  sizeof(buf),
                                  0);
-    mock_write_flash_async_wait(0);
-    write_cmp32(&buf[0], 0x04030201, sizeof(buf));
+    mock_write_flash_async_wait(-5);
 
     /* Second - fail. */
-    write_fast_data_read(&buf[0], sizeof(buf));
-    mock_write_flash_async_write(0x04030201 + sizeof(buf),
+    buf[3] = 0x22;
+    write_fast_write_row(&buf[0], crc);
+    mock_write_flash_async_write(0x04030301,
                                  &buf[0],
                                  sizeof(buf),
                                  -18);
 
+    write_fast_write_response(&failed_rows[0], membersof(failed_rows));
+
+    BTASSERT(ramapp_init(&ramapp, &flash) == 0);
+    BTASSERT(ramapp_process_packet(&ramapp) == 0);
+
+    return (0);
+}
+
+static ssize_t ext_handle(int type, uint8_t *buf_p, size_t size)
+{
+    buf_p[0] = type;
+    buf_p[1] = size;
+
+    return (2);
+}
+
+static int test_ext(void)
+{
+    struct ramapp_t ramapp;
+    struct flash_driver_t flash;
+    struct ramapp_ext_t ext = {
+        .magic = RAMAPP_EXT_MAGIC,
+        .handle = ext_handle,
+        .types = { 7, 8 }
+    };
+    uint32_t words[sizeof(ext) / 4];
+    uint8_t load_request[16];
+    uint8_t load_response[6];
+    uint8_t request[] = { 0x00, 0x07, 0x00, 0x01, 0xaa, 0x67, 0xb0 };
+    uint8_t response[] = {
+        0x00, 0x07, 0x00, 0x02,
+        0x07, 0x01, /* Type and size. */
+        0x8e, 0x12
+    };
+    uint8_t unknown_request[] = { 0x00, 0x09, 0x00, 0x00, 0x1a, 0x51 };
+    uint8_t unknown_response[] = {
+        0xff, 0xff, 0x00, 0x04,
+        0xff, 0xff, 0xfc, 0x15, /* Error code. */
+        0x19, 0xfe
+    };
+    uint32_t crc;
+    size_t i;
+
+    BTASSERT(ramapp_init(&ramapp, &flash) == 0);
+
+    /* Load the module. */
+    memcpy(&words[0], &ext, sizeof(words));
+    crc = crc_32(0, &words[0], sizeof(words));
+    load_request[0] = 0x00;
+    load_request[1] = 0x06;
+    load_request[2] = 0x00;
+    load_request[3] = 0x08;
+    load_request[4] = 0x00;
+    load_request[5] = 0x00;
+    load_request[6] = 0x00;
+    load_request[7] = sizeof(words);
+    load_request[8] = (crc >> 24);
+    load_request[9] = (crc >> 16);
+    load_request[10] = (crc >> 8);
+    load_request[11] = (crc >> 0);
+    crc = crc_ccitt(0xffff, &load_request[0], 12);
+    load_request[12] = (crc >> 8);
+    load_request[13] = crc;
+    load_request[14] = 0x00;
+    load_request[15] = 0x00;
+    load_response[0] = 0x00;
+    load_response[1] = 0x06;
+    load_response[2] = 0x00;
+    load_response[3] = 0x00;
+    crc = crc_ccitt(0xffff, &load_response[0], 4);
+    load_response[4] = (crc >> 8);
+    load_response[5] = crc;
+
+    write_read_command_request(&load_request[0],
+                               &load_request[4],
+                               10);
+
+    for (i = 0; i < membersof(words); i++) {
+        write_etap_fast_data_read(words[i]);
+    }
+
+    write_write_command_response(&load_response[0],
+                                 sizeof(load_response));
+
+    BTASSERT(ramapp_process_packet(&ramapp) == 0);
+    BTASSERT(memcmp(&ext_region_words[0], &words[0], sizeof(words)) == 0);
+
+    /* A command handled by the module. */
+    write_read_command_request(&request[0],
+                               &request[4],
+                               sizeof(request) - 4);
+    write_write_command_response(&response[0],
+                                 sizeof(response));
+
+    BTASSERT(ramapp_process_packet(&ramapp) == 0);
+
+    /* A command not handled by the module. */
+    write_read_command_request(&unknown_request[0],
+                               &unknown_request[4],
+                               sizeof(unknown_request) - 4);
+    write_write_command_response(&unknown_response[0],
+                                 sizeof(unknown_response));
+
+    BTASSERT(ramapp_process_packet(&ramapp) == 0);
+
+    return (0);
+}
+
+static int test_features(void)
+{
+    struct ramapp_t ramapp;
+    struct flash_driver_t flash;
+    uint8_t request_header[] = { 0x00, 0x08, 0x00, 0x00 };
+    uint8_t request_crc[] = { 0x2d, 0x61 };
+    uint8_t response[] = {
+        0x00, 0x08, 0x00, 0x08,
+        0x00, 0x00, 0x00, 0x3f, /* Features. */
+        0x00, 0x00, 0x08, 0x00, /* Size of code and constants. */
+        0xef, 0x36
+    };
+
+    write_read_command_request(&request_header[0],
+                               &request_crc[0],
+                               sizeof(request_crc));
     write_write_command_response(&response[0],
                                  sizeof(response));
 
@@ -756,11 +1201,16 @@ int main()
 {
     struct harness_testcase_t testcases[] = {
         { test_ping, "test_ping" },
+        { test_ping_echo, "test_ping_echo" },
         { test_erase, "test_erase" },
         { test_read, "test_read" },
+        { test_read_extended, "test_read_extended" },
+        { test_fast_read, "test_fast_read" },
+        { test_fast_read_unaligned, "test_fast_read_unaligned" },
         { test_write, "test_write" },
         { test_write_failure, "test_write_failure" },
         { test_write_memcmp_failure, "test_write_memcmp_failure" },
+        { test_crc, "test_crc" },
         { test_fast_write_one_row, "test_fast_write_one_row" },
         {
             test_fast_write_one_row_bad_compare,
@@ -775,6 +1225,10 @@ int main()
             test_fast_write_two_rows_bad_crc,
             "test_fast_write_two_rows_bad_crc"
         },
+        {
+            test_fast_write_two_rows_bad_row_crc,
+            "test_fast_write_two_rows_bad_row_crc"
+        },
         {
             test_fast_write_two_rows_bad_compare,
             "test_fast_write_two_rows_bad_compare"
@@ -783,6 +1237,8 @@ int main()
             test_fast_write_two_rows_bad_async_write,
             "test_fast_write_two_rows_bad_async_write"
         },
+        { test_ext, "test_ext" },
+        { test_features, "test_features" },
         { test_bad_command, "test_bad_command" },
         { test_bad_request_crc, "test_bad_request_crc" },
         { NULL, NULL }
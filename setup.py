@@ -30,6 +30,9 @@ setup(name='pictools',
           'tqdm',
           'bitstruct'
       ],
+      extras_require={
+          'usb': ['pyusb']
+      },
       packages=find_packages(),
       include_package_data=True,
       test_suite="tests",
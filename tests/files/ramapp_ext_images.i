@@ -0,0 +1,23 @@
+/**
+ * This file was generated by pictools.py version {}.
+ *
+ * Ramapp extension module images, loaded by the programmer when a
+ * command handled by a module is first forwarded to the ramapp.
+ */
+
+static const uint32_t ramapp_ext_blank_check_image[] = {
+    /* Number of words in the image. */
+    8,
+
+    /* The image. */
+    0x54584552, 0xa0006019, 0x00000007, 0x00000000, 0x00000000, 0x00000000,
+    0xffff41a2, 0x0c00459f,
+
+    /* CRC-32 of the image. */
+    0x1fbc8ae7
+};
+
+static const struct ramapp_ext_image_t ramapp_ext_images[] = {
+    { { 7, 0, 0, 0 }, &ramapp_ext_blank_check_image[0] },
+    { { 0 }, NULL }
+};
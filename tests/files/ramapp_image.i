@@ -0,0 +1,100 @@
+/**
+ * This file was generated by pictools.py version {}.
+ */
+
+/* Number of words in the image. */
+531,
+
+/* The image. */
+0xa00041bd, 0x02b4f400, 0x7ff833bd, 0x02cef400, 0x00000000, 0xa00041a8,
+0x02153108, 0x000045c8, 0x0c000000, 0xfffe40e0, 0x00033065, 0x8d9925b5,
+0x25b40c45, 0x41aa6f30, 0x6dc0ff20, 0xfcca0668, 0x6db20000, 0xc0400126,
+0x80400106, 0x192327e1, 0x1903fffb, 0x18e3fffc, 0xb483fffd, 0x18c3fff0,
+0x45bffffe, 0xa00041a2, 0x08643042, 0x233d4ed9, 0x09a4d228, 0x08a70a25,
+0xc0000063, 0x80000084, 0x44cb44dc, 0x0b2609ac, 0x00081642, 0x0210f87d,
+0x17c209ad, 0x082a0009, 0x000b1662, 0x0214f87d, 0x144209ae, 0x2760000f,
+0x6e0944ce, 0x010030a0, 0xa00041b4, 0x0218f87d, 0x0014f400, 0x021cf85d,
+0x0c6c3094, 0xf4000cb1, 0x30dd02fa, 0x8d060010, 0x800003de, 0x5228233d,
+0x4d29459f, 0xc0000252, 0x9290025e, 0x9a900272, 0x50802400, 0x6e89ffff,
+0x0404f400, 0x010030c0, 0x9a900213, 0xb0530e42, 0xb4020101, 0x30600082,
+0x32c00100, 0x0ea00100, 0x0c6c33d4, 0x00017215, 0x40000170, 0x01626d09,
+0x0c97b950, 0x0014f400, 0x010030a0, 0x0320f400, 0x2290001e, 0x0115ad4f,
+0x6d894000, 0x41500103, 0x295002d1, 0x01003148, 0x0c48cc04, 0x00109542,
+0x01020c9e, 0x05d619d0, 0xfc636ba0, 0x9467ff00, 0x6d22fff5, 0xfc103040,
+0x5228233d, 0x4d29459f, 0x02faf400, 0x32900017, 0xffacb402, 0x0cb70c92,
+0x0404f400, 0x010030c0, 0x010032d6, 0x02760e42, 0x0c761390, 0xffbeb402,
+0x30940eb0, 0xf4000c6c, 0xf87d0320, 0xb4020220, 0xfc7dff95, 0x6d090220,
+0x04042400, 0xff003231, 0x30b004b2, 0xcc050100, 0x94a20c50, 0xfc7d000c,
+0x05850214, 0x6a200596, 0x946469b0, 0x6d22fff6, 0x3040cfc7, 0x02e3fc10,
+0xfc7d8000, 0x02a30210, 0xfc7dc000, 0x02b7021c, 0x0075aa90, 0xfc7db290,
+0x25300218, 0xb2900056, 0x0005b656, 0xcf660c00, 0xcfc70c40, 0xcf620e00,
+0xfc113040, 0xbf8041a2, 0x36703082, 0xe9c00c60, 0xaa9941a3, 0x66553063,
+0x41a3e9c0, 0x50635566, 0xe9c099aa, 0x000141a3, 0x26a03082, 0x00803063,
+0x3080e9c0, 0x30620100, 0xea302680, 0x3042ee01, 0xea202688, 0x2d216930,
+0xfffc40a2, 0x41a34fe5, 0x3063bf80, 0x233d3670, 0xe930d010, 0x033af400,
+0xa00041b4, 0xa00041a2, 0xa00041a5, 0x086433d4, 0x0c6c3082, 0x0360f400,
+0x085830a5, 0xa00041b2, 0x0e3e0e74, 0x0c910e1e, 0x0014f400, 0x000430a0,
+0x0002147e, 0x0003145e, 0x004325b0, 0x9055aa90, 0x94020401, 0x30400099,
+0x30b500ea, 0xf4000002, 0x30920014, 0x30d50868, 0x050c0004, 0x02150a20,
+0x09351950, 0x25c00cb0, 0xffff5080, 0x0404f400, 0xaa900043, 0x0110b455,
+0x1453ee03, 0x09910864, 0x44d32520, 0x010c9482, 0x90620c00, 0x94030004,
+0xed8100a0, 0x00f19462, 0xb462ed82, 0xed1500b3, 0x0b950a14, 0x09990918,
+0x15510a97, 0x0b1b0006, 0x000a1531, 0x800000e7, 0x80000063, 0xc0000084,
+0xc0000042, 0x44d344e7, 0x44f244ec, 0x400000ea, 0x40000069, 0xa00041a2,
+0x0c6c3082, 0xf40044ef, 0x006603be, 0x40023290, 0x00820085, 0x32c28080,
+0x01220004, 0x30e24080, 0x50800009, 0x0cb0ffff, 0x193e0cd6, 0x185e0002,
+0xf4000003, 0x02a70404, 0x26211040, 0x195002de, 0x94158a30, 0x8931ff84,
+0x100000f5, 0x00fe0c50, 0x41a93950, 0x09a0ff20, 0x0b230aa1, 0x00630a22,
+0x00a5c000, 0x44dd8000, 0x264044de, 0x6d2244dc, 0x0000f869, 0xffefb4e2,
+0xf4000c91, 0x30a00014, 0x147e0004, 0x145e0002, 0x25b00003, 0xaa900043,
+0x04019055, 0xff6fb402, 0x000230b5, 0x00ea3040, 0x00ff30c0, 0x00ff3080,
+0x00ff30a0, 0x41b7edff, 0x18dea000, 0x185e0006, 0x18740007, 0x187e0864,
+0x18be0001, 0x189e0004, 0x32a00005, 0x32c00003, 0x32f70009, 0xef08086c,
+0x5080ed04, 0x0cb0ffff, 0x0002181e, 0x0404f400, 0x0003185e, 0x02de2621,
+0x18971950, 0xcfa80000, 0xed848930, 0x00199462, 0xb462edea, 0xed150013,
+0x0032f400, 0x00000000, 0xff834042, 0x000432c2, 0x80800082, 0x408000c2,
+0xc04000a2, 0x2f6d2e4d, 0x2d2dcfc1, 0x30c0cfbb, 0x099800fc, 0x0b140a99,
+0x15510b95, 0x091a000b, 0x800000a5, 0x00071531, 0x00630a16, 0x00e7c000,
+0x44dd8000, 0xc00000c6, 0x252044f7, 0x1a900143, 0xaa900043, 0x4a900126,
+0x41a22640, 0x0089a000, 0x3082b290, 0x41a20c6c, 0x0cb6a000, 0x087030c2,
+0x0366f400, 0x3a900015, 0xff41b455, 0xa00041a4, 0x08703084, 0xf4000cb6,
+0x001502e2, 0x40a23290, 0x41b7000b, 0x32a0a000, 0x32c00002, 0x32f70005,
+0xef040868, 0x0c40cf92, 0xcf74ed10, 0x00fc30c0, 0xcf70ed11, 0x00fc30c0,
+0x0b990b18, 0x0a950994, 0x1551091b, 0x00e7000a, 0x15318000, 0x0a160007,
+0xc00000c6, 0x800000a5, 0x006344f7, 0x44ddc000, 0x00ea44d6, 0x01234000,
+0x44d72a90, 0x940225c0, 0x44ddff0a, 0xa00041a4, 0x08683084, 0x0ab00734,
+0x6db06e40, 0xfffbb4c3, 0xffff18a4, 0xfef740e0, 0xa00041a6, 0xa00041a5,
+0x085830c6, 0x086430a5, 0x004506eb, 0x8d0c1080, 0xa00041a7, 0x30e70c40,
+0x05ae0858, 0x05ac6a30, 0xb4a26d22, 0xea30fffa, 0x0c0045bf, 0xa00041a5,
+0xa00041a4, 0x086430a5, 0x0c743084, 0x00640659, 0x8d861080, 0x05aa0c40,
+0xb4826d22, 0xe830fffc, 0x0c0045bf, 0x076acc0d, 0x1c446ed0, 0x1c65ffff,
+0x0062ffff, 0xaf893b50, 0x13500043, 0x000740a2, 0xfff2b4c5, 0x459f6e40,
+0x459f0c40, 0x459fed7f, 0x0c00ed01, 0xbf8041a2, 0x29503062, 0x41a3eab0,
+0x50631fff, 0x44b3ffff, 0x29803062, 0x3060eb30, 0x30824003, 0xe9c02930,
+0xaa9941a3, 0x29403082, 0x66553063, 0x41a3e9c0, 0x50635566, 0xe9c099aa,
+0x80005060, 0x29383042, 0x459fe9a0, 0x0c000c40, 0xbf8041a2, 0x29303042,
+0x2dbe69a0, 0x41a4adfd, 0x3044bf80, 0x69202930, 0x400030a0, 0x293430c4,
+0x3084eae0, 0xe9c02940, 0x90000042, 0x0042459f, 0x0c00f880, 0xa00041a3,
+0x0c701c43, 0x9482ee01, 0x0c00001d, 0x0c701883, 0xbf8041a2, 0xaa9941a4,
+0x29403062, 0x66553084, 0x41a4ea30, 0x50845566, 0xea3099aa, 0x80005080,
+0x29a830a2, 0x3080ea50, 0x30420700, 0xea2029a4, 0xe9300c40, 0x0c40459f,
+0x800360a4, 0x900060a4, 0x0c40459f, 0x00559407, 0x41ab0c47, 0x4ff9bf80,
+0xaa9941ad, 0x556641ac, 0x2930308b, 0xd004207d, 0x2940314b, 0x2950324b,
+0x2960322b, 0x2970320b, 0x2938332b, 0x316b0d06, 0x06eb2934, 0x40023300,
+0x665531ad, 0x99aa518c, 0x800051e0, 0x400031c0, 0x195000a8, 0x0000f872,
+0x0000fc68, 0x3108e990, 0xfc680008, 0xe980fffc, 0x0000fb04, 0x0000f9aa,
+0x0000f98a, 0x0000f9f9, 0x2dbe69c0, 0xfffc40a3, 0x0000fd24, 0x0000f9cb,
+0x0000f86a, 0x2000d129, 0x00049409, 0x19d000c8, 0xfc103040, 0x1b9000e3,
+0x000440e3, 0xffd69447, 0x195000a8, 0x5004207d, 0x45bf4704, 0x30406f6e,
+0x00a6f800, 0x004f7950, 0x44aa7a50, 0x139000af, 0x41a7ad38, 0x41a9bf80,
+0x41a8aa99, 0x31c75566, 0x30672950, 0x30c72930, 0x31a72940, 0x31802938,
+0x30e74004, 0x31292934, 0x51086655, 0x516099aa, 0x31408000, 0xf8ae4000,
+0xf9830000, 0xf9260000, 0xf9060000, 0xf96d0000, 0x69300000, 0x40a22d2e,
+0x6a30fffc, 0x0000f947, 0xd084e960, 0x8e052000, 0x080030a5, 0x3040459f,
+0x00affc0f, 0x40e21390, 0x459fffe2, 0x0c000c40, 0x27c12e4f, 0x2e4d8f15,
+0x1505076a, 0x6ed00000, 0x3b100107, 0x445f25f9, 0x18400103, 0x3b100104,
+0x263a2538, 0x4463447a, 0xb4c52ffd, 0x2e4dffee, 0x054a26f0, 0x2d2f459f,
+0x00030000, 0x01000101, 0x00000000,
+
+/* CRC-32 of the image. */
+0x72df6de9
@@ -51,6 +51,12 @@ def main():
     run('udid_print')
     run('reset')
     run('flash_write --chip-erase zeros.s19', timed=True)
+
+    # Compare the ICSP transports.
+    for transport in ['icsp_soft', 'icsp_spi']:
+        command = '--transport {} flash_write --chip-erase zeros.s19'
+        run(command.format(transport), timed=True)
+
     run('flash_erase_chip')
     run('programmer_version')
 
@@ -1,6 +1,8 @@
 import sys
+import os
 import unittest
 from unittest.mock import Mock
+from unittest.mock import call
 import bincopy
 import struct
 import binascii
@@ -37,6 +39,29 @@ def programmer_version_write():
     return ((b'\x00\x6b\x00\x00\xef\x5a', ), )
 
 
+def capabilities_read(commands=0x3):
+    payload = struct.pack('>BHIHHII', 2, 1024, 65536, 256, 8, commands, 16384)
+    header = b'\x00\x6e' + struct.pack('>H', len(payload))
+
+    return [
+        header,
+        payload,
+        struct.pack('>H', pictools.crc_ccitt(header + payload))
+    ]
+
+
+def capabilities_failed_read():
+    """Programmers without the capabilities command.
+
+    """
+
+    return [b'\xff\xff\x00\x04', b'\xff\xff\xff\xff', b'\x10\xc9']
+
+
+def capabilities_write():
+    return ((b'\x00\x6e\x00\x00\x04\xaa', ), )
+
+
 def connect_read():
     return [b'\x00\x65\x00\x00', b'\xf4\x5b']
 
@@ -45,6 +70,34 @@ def connect_write():
     return ((b'\x00\x65\x00\x00\xf4\x5b', ), )
 
 
+def connect_icsp_spi_write():
+    return ((b'\x00\x65\x00\x01\x01\xd7\x8b', ), )
+
+
+def connect_icsp_clock_read():
+    return [b'\x00\x65\x00\x04', b'\x00\x3d\x09\x00', b'\x4f\xe9']
+
+
+def connect_icsp_clock_write():
+    return ((b'\x00\x65\x00\x05\x01\x00\x3d\x09\x00\x09\x48', ), )
+
+
+def connect_icsp_gang_read():
+    return [b'\x00\x65\x00\x01', b'\x03', b'\xf7\xc9']
+
+
+def connect_icsp_gang_write():
+    return ((b'\x00\x65\x00\x02\x03\x0b\xbe\xc3', ), )
+
+
+def connect_jtag_soft_chain_read():
+    return [b'\x00\x65\x00\x01', b'\x05', b'\x97\x0f']
+
+
+def connect_jtag_soft_chain_write():
+    return ((b'\x00\x65\x00\x06\x02\x05\x03\x05\x04\x05\x8b\xaf', ), )
+
+
 def disconnect_read():
     return [b'\x00\x66\x00\x00', b'\xad\x0b']
 
@@ -81,6 +134,21 @@ def flash_erase_read():
     return [b'\x00\x02\x00\x00', b'\xea\xa0']
 
 
+def flash_blank_check_read(address=None):
+    if address is None:
+        return [b'\x00\x07\x00\x00', b'\x01\x50']
+    else:
+        return [b'\x00\x07\x00\x04', struct.pack('>I', address), b'\x91\x6c']
+
+
+def flash_blank_check_write(address, size, crc):
+    payload = struct.pack('>II', address, size)
+    header = b'\x00\x07' + struct.pack('>H', len(payload))
+    crc = struct.pack('>H', crc)
+
+    return ((header + payload + crc, ), )
+
+
 def failure_read():
     return [b'\xff\xff\x00\x04', b'\xff\xff\xfc\x10', b'\x49\x5b']
 
@@ -114,11 +182,22 @@ def device_status_write():
 
 
 def flash_read_read(data, crc=None):
-    header = b'\x00\x03' + struct.pack('>H', len(data))
+    if len(data) > 1024:
+        header = b'\x00\x03\xff\xff' + struct.pack('>I', len(data))
+    else:
+        header = b'\x00\x03' + struct.pack('>H', len(data))
 
     if crc is None:
         crc = pictools.crc_ccitt(header + data)
 
+    if len(data) > 1024:
+        return [
+            header[:4],
+            header[4:],
+            data,
+            struct.pack('>H', crc)
+        ]
+
     return [
         header,
         data,
@@ -138,6 +217,25 @@ def flash_read_write(address, size, crc=None):
     return ((header + payload + footer, ), )
 
 
+def read_words_read(data):
+    header = b'\x00\x6d' + struct.pack('>H', len(data))
+    crc = pictools.crc_ccitt(header + data)
+
+    return [header, data, struct.pack('>H', crc)]
+
+
+def read_words_write(address, length):
+    payload = struct.pack('>IB', address, length)
+    header = b'\x00\x6d' + struct.pack('>H', len(payload))
+    footer = struct.pack('>H', pictools.crc_ccitt(header + payload))
+
+    return ((header + payload + footer, ), )
+
+
+def is_connected_read():
+    return [b'\xff\xff\x00\x04', b'\xff\xff\xff\x96', b'\xed\x46']
+
+
 def flash_write_fast_read():
     return [b'\x00\x6a\x00\x00', b'\xd8\x6a']
 
@@ -150,14 +248,107 @@ def flash_write_fast_write(address, size, data_crc, crc):
     return ((header + payload + footer, ), )
 
 
-def flash_write_fast_data_ack():
-    return b'\x00\x00'
+def flash_write_fast_failed_rows_read(addresses):
+    payload = b''.join([struct.pack('>I', address) for address in addresses])
+
+    return production_read(0x6a, payload)
+
+
+def flash_write_fast_failed_rows_write(address, data):
+    payload = struct.pack('>IIHB',
+                          address,
+                          len(data),
+                          pictools.crc_ccitt(data),
+                          1)
+
+    return production_write(0x6a, payload)
+
+
+def flash_write_fast_data_credits(credits):
+    return [b'\x00\x00', struct.pack('>H', credits)]
 
 
 def flash_write_fast_data_write(chunk):
     return ((chunk, ), )
 
 
+def stage_read():
+    return [b'\x00\x6f\x00\x00', b'\x33\x9a']
+
+
+def stage_write(index, data):
+    payload = struct.pack('>BIH', index, len(data), pictools.crc_ccitt(data))
+    header = b'\x00\x6f' + struct.pack('>H', len(payload))
+    footer = struct.pack('>H', pictools.crc_ccitt(header + payload))
+
+    return ((header + payload + footer, ), )
+
+
+def staged_write_read():
+    return [b'\x00\x70\x00\x00', b'\x5c\xc8']
+
+
+def staged_write_write(index, address):
+    payload = struct.pack('>BI', index, address)
+    header = b'\x00\x70' + struct.pack('>H', len(payload))
+    footer = struct.pack('>H', pictools.crc_ccitt(header + payload))
+
+    return ((header + payload + footer, ), )
+
+
+def production_read(command_type, payload=b''):
+    header = struct.pack('>HH', command_type, len(payload))
+    footer = struct.pack('>H', pictools.crc_ccitt(header + payload))
+
+    if payload:
+        return [header, payload, footer]
+    else:
+        return [header, footer]
+
+
+def production_write(command_type, payload):
+    header = struct.pack('>HH', command_type, len(payload))
+    footer = struct.pack('>H', pictools.crc_ccitt(header + payload))
+
+    return ((header + payload + footer, ), )
+
+
+def execute_loader_upload_instructions(instructions):
+    """Execute given loader upload instructions and return the stored RAM
+    words and the lowest address.
+
+    """
+
+    registers = 32 * [0]
+    ram = {}
+
+    def set_register(number, value):
+        if number != 0:
+            registers[number] = (value & 0xffffffff)
+
+    for word, _ in instructions:
+        immediate = (word >> 16)
+        opcode = ((word >> 10) & 0x3f)
+        rt = ((word >> 5) & 0x1f)
+        rs = (word & 0x1f)
+
+        if opcode == 0b010000 and rt == 0b01101:
+            set_register(rs, immediate << 16)
+        elif opcode == 0b010100:
+            set_register(rt, registers[rs] | immediate)
+        elif opcode == 0b001100:
+            immediate -= ((immediate & 0x8000) << 1)
+            set_register(rt, registers[rs] + immediate)
+        elif opcode == 0b001000 and (immediate >> 12) == 0b1101:
+            for i, gpr in enumerate(pictools.REGLIST_GPRS[rt]):
+                address = (registers[rs] + (immediate & 0xfff) + 4 * i)
+                ram[address] = registers[gpr]
+        else:
+            raise Exception('bad instruction 0x{:08x}'.format(word))
+
+    return [ram[address] for address in sorted(ram)], sorted(ram)[0]
+
+
 class PicToolsTest(unittest.TestCase):
 
     def setUp(self):
@@ -190,15 +381,11 @@ class PicToolsTest(unittest.TestCase):
         self.assert_command(argv,
                            [
                                *programmer_ping_read(),
-                               *connect_read(),
-                               *ping_read(),
-                               *flash_read_read(data)
+                               *read_words_read(data)
                            ],
                            [
                                programmer_ping_write(),
-                               connect_write(),
-                               ping_write(),
-                               flash_read_write(address, len(data))
+                               read_words_write(address, len(data) // 4)
                            ],
                            output_lines)
 
@@ -243,6 +430,98 @@ class PicToolsTest(unittest.TestCase):
                 ping_write()
             ])
 
+    def test_ping_transport(self):
+        self.assert_command(
+            ['pictools', '--transport', 'icsp_spi', 'ping'],
+            [
+                *programmer_ping_read(),
+                *connect_read(),
+                *ping_read()
+            ],
+            [
+                programmer_ping_write(),
+                connect_icsp_spi_write(),
+                ping_write()
+            ])
+
+    def test_ping_icsp_clock(self):
+        self.assert_command(
+            [
+                'pictools',
+                '--transport', 'icsp_spi',
+                '--icsp-clock', '4000000',
+                'ping'
+            ],
+            [
+                *programmer_ping_read(),
+                *connect_icsp_clock_read(),
+                *ping_read()
+            ],
+            [
+                programmer_ping_write(),
+                connect_icsp_clock_write(),
+                ping_write()
+            ],
+            [
+                'Programmer is alive.',
+                'Connected to PIC.',
+                'ICSP clock is 4000000 Hz.',
+                'PIC is alive.',
+                ''
+            ])
+
+    def test_ping_icsp_gang(self):
+        self.assert_command(
+            [
+                'pictools',
+                '--transport', 'icsp_gang',
+                '--targets', '0,1,3',
+                'ping'
+            ],
+            [
+                *programmer_ping_read(),
+                *connect_icsp_gang_read(),
+                *ping_read()
+            ],
+            [
+                programmer_ping_write(),
+                connect_icsp_gang_write(),
+                ping_write()
+            ],
+            [
+                'Programmer is alive.',
+                'Connected to PIC.',
+                'Connected targets: 0, 1.',
+                'PIC is alive.',
+                ''
+            ])
+
+    def test_ping_jtag_soft_chain(self):
+        self.assert_command(
+            [
+                'pictools',
+                '--transport', 'jtag_soft',
+                '--jtag-chain', '5,4,5',
+                'ping'
+            ],
+            [
+                *programmer_ping_read(),
+                *connect_jtag_soft_chain_read(),
+                *ping_read()
+            ],
+            [
+                programmer_ping_write(),
+                connect_jtag_soft_chain_write(),
+                ping_write()
+            ],
+            [
+                'Programmer is alive.',
+                'Connected to PIC.',
+                'Connected targets: 0, 2.',
+                'PIC is alive.',
+                ''
+            ])
+
     def test_flash_write(self):
         with open('test_flash_write.s19', 'w') as fout:
             binfile = bincopy.BinFile()
@@ -281,6 +560,7 @@ class PicToolsTest(unittest.TestCase):
                 *programmer_ping_read(),
                 *disconnect_read(),
                 *reset_read(),
+                *capabilities_failed_read(),
                 *flash_erase_chip_read(),
                 *connect_read(),
                 *flash_write_read()
@@ -289,11 +569,100 @@ class PicToolsTest(unittest.TestCase):
                 programmer_ping_write(),
                 disconnect_write(),
                 reset_write(),
+                capabilities_write(),
                 flash_erase_chip_write(),
                 connect_write(),
                 flash_write_write(0x1d000004, 1, b'\x12', 0x0af8)
             ])
 
+    def test_flash_write_job(self):
+        with open('test_flash_write.s19', 'w') as fout:
+            binfile = bincopy.BinFile()
+            binfile.add_binary(b'\x12', 0x1d000004)
+            fout.write(binfile.as_srec())
+
+        row = 4 * b'\xff' + b'\x12' + 251 * b'\xff'
+        steps = (b'\x00\x01\x02'
+                 + b'\x03' + struct.pack('>IIH',
+                                        0x1d000000,
+                                        256,
+                                        pictools.crc_ccitt(row))
+                 + b'\x04' + struct.pack('>III',
+                                        0x1d000000,
+                                        256,
+                                        binascii.crc32(row)))
+
+        self.assert_command(
+            [
+                'pictools',
+                'flash_write',
+                '--chip-erase',
+                '--verify',
+                'test_flash_write.s19'
+            ],
+            [
+                *programmer_ping_read(),
+                *disconnect_read(),
+                *reset_read(),
+                *capabilities_read(0x23),
+                *production_read(116, struct.pack('>IIII',
+                                                  52000,
+                                                  120500,
+                                                  8000,
+                                                  3000))
+            ],
+            [
+                programmer_ping_write(),
+                disconnect_write(),
+                reset_write(),
+                capabilities_write(),
+                production_write(116, steps),
+                flash_write_fast_data_write(row)
+            ],
+            [
+                'Programmer is alive.',
+                'Disconnected from PIC.',
+                'PIC reset.',
+                'Writing {} to flash.'.format(
+                    os.path.abspath('test_flash_write.s19')),
+                'Write complete.',
+                'Verify complete.',
+                'Programmer job time: chip erase 52 ms, connect 120 ms, '
+                'write 8 ms, verify 3 ms.',
+                ''
+            ])
+
+    def test_flash_write_job_verify_failure(self):
+        argv = [
+            'pictools',
+            'flash_write',
+            '--chip-erase',
+            '--verify',
+            'test_flash_write.s19'
+        ]
+
+        with open('test_flash_write.s19', 'w') as fout:
+            binfile = bincopy.BinFile()
+            binfile.add_binary(bytes(range(256)), 0x1d000100)
+            fout.write(binfile.as_srec())
+
+        serial.Serial.read.side_effect = [
+            *programmer_ping_read(),
+            *disconnect_read(),
+            *reset_read(),
+            *capabilities_read(0x23),
+            *production_read(0xffff, struct.pack('>iI', -10003, 3))
+        ]
+
+        with patch('sys.argv', argv):
+            with self.assertRaises(SystemExit) as cm:
+                pictools.main()
+
+            self.assertEqual(
+                str(cm.exception),
+                'error: 10003: flash verify failed in job step verify at '
+                '0x1d000100')
+
     def test_flash_write_erase(self):
         with open('test_flash_write.s19', 'w') as fout:
             binfile = bincopy.BinFile()
@@ -340,19 +709,102 @@ class PicToolsTest(unittest.TestCase):
                 *programmer_ping_read(),
                 *connect_read(),
                 *ping_read(),
-                flash_write_fast_data_ack(),
-                flash_write_fast_data_ack(),
+                *capabilities_failed_read(),
+                *flash_write_fast_data_credits(1),
                 *flash_write_fast_read()
             ],
             [
                 programmer_ping_write(),
                 connect_write(),
                 ping_write(),
+                capabilities_write(),
                 flash_write_fast_write(0x1d000000, 512, 0x9d6f, 0x5f48),
                 flash_write_fast_data_write(chunks[0]),
                 flash_write_fast_data_write(chunks[1])
             ])
 
+    def test_flash_write_staged(self):
+        data = bytes(range(256)) * 10
+
+        with open('test_flash_write.s19', 'w') as fout:
+            binfile = bincopy.BinFile()
+            binfile.add_binary(data, 0x1d000000)
+            fout.write(binfile.as_srec())
+
+        self.assert_command(
+            ['pictools', 'flash_write', 'test_flash_write.s19'],
+            [
+                *programmer_ping_read(),
+                *connect_read(),
+                *ping_read(),
+                *capabilities_read(0xb),
+                *stage_read(),
+                *staged_write_read(),
+                *stage_read(),
+                *staged_write_read()
+            ],
+            [
+                programmer_ping_write(),
+                connect_write(),
+                ping_write(),
+                capabilities_write(),
+                stage_write(0, data[:2048]),
+                flash_write_fast_data_write(data[:2048]),
+                staged_write_write(0, 0x1d000000),
+                stage_write(1, data[2048:]),
+                flash_write_fast_data_write(data[2048:]),
+                staged_write_write(1, 0x1d000800)
+            ])
+
+    def test_flash_write_fast_failed_rows(self):
+        chunks = [
+            bytes(range(256)),
+            b'\x45' + bytes(range(256))[1:]
+        ]
+        page = b''.join(chunks) + 1536 * b'\xff'
+
+        with open('test_flash_write.s19', 'w') as fout:
+            binfile = bincopy.BinFile()
+            binfile.add_binary(b''.join(chunks), 0x1d000000)
+            fout.write(binfile.as_srec())
+
+        # The second row fails, and fails again when written alone. Its
+        # page is erased and written again.
+        self.assert_command(
+            ['pictools', 'flash_write', 'test_flash_write.s19'],
+            [
+                *programmer_ping_read(),
+                *connect_read(),
+                *ping_read(),
+                *capabilities_read(0x80),
+                *flash_write_fast_data_credits(1),
+                *flash_write_fast_failed_rows_read([0x1d000100]),
+                *flash_write_fast_failed_rows_read([0x1d000100]),
+                *flash_read_read(page),
+                *flash_erase_read(),
+                *flash_write_fast_data_credits(7),
+                *flash_write_fast_failed_rows_read([])
+            ],
+            [
+                programmer_ping_write(),
+                connect_write(),
+                ping_write(),
+                capabilities_write(),
+                flash_write_fast_failed_rows_write(0x1d000000,
+                                                   b''.join(chunks)),
+                flash_write_fast_data_write(chunks[0]),
+                flash_write_fast_data_write(chunks[1]),
+                flash_write_fast_failed_rows_write(0x1d000100, chunks[1]),
+                flash_write_fast_data_write(chunks[1]),
+                flash_read_write(0x1d000000, 2048),
+                production_write(2, struct.pack('>II', 0x1d000000, 2048)),
+                flash_write_fast_failed_rows_write(0x1d000000, page),
+                *[
+                    flash_write_fast_data_write(page[i:i + 256])
+                    for i in range(0, 2048, 256)
+                ]
+            ])
+
     def test_flash_write_verify(self):
         with open('test_flash_write.s19', 'w') as fout:
             binfile = bincopy.BinFile()
@@ -371,6 +823,7 @@ class PicToolsTest(unittest.TestCase):
                 *connect_read(),
                 *ping_read(),
                 *flash_write_read(),
+                *capabilities_failed_read(),
                 *flash_read_read(b'\x00', 0xb9e1)
             ],
             [
@@ -378,6 +831,7 @@ class PicToolsTest(unittest.TestCase):
                 connect_write(),
                 ping_write(),
                 flash_write_write(0x1d000000, 1, b'\x00', 0x3e2a),
+                capabilities_write(),
                 flash_read_write(0x1d000000, 1, 0xae0d)
             ])
 
@@ -389,6 +843,7 @@ class PicToolsTest(unittest.TestCase):
             *programmer_ping_read(),
             *connect_read(),
             *ping_read(),
+            *capabilities_failed_read(),
             b'\xff\xff',
             b'\x00\x04',
             b'\xff\xff\xfc\x10',
@@ -410,6 +865,7 @@ class PicToolsTest(unittest.TestCase):
             programmer_ping_write(),
             connect_write(),
             ping_write(),
+            capabilities_write(),
             flash_write_fast_write(0x1d000000, 256, 0x3fbd, 0x54b7),
             flash_write_fast_data_write(chunk)
         ]
@@ -417,16 +873,58 @@ class PicToolsTest(unittest.TestCase):
         self.assert_calls(serial.Serial.write.call_args_list,
                           expected_writes)
 
+    def test_flash_write_fast_data_packet_row_failure(self):
+        argv = ['pictools', 'flash_write', 'test_flash_write.s19']
+
+        chunks = [bytes(range(256)), bytes(range(256))]
+        serial.Serial.read.side_effect = [
+            *programmer_ping_read(),
+            *connect_read(),
+            *ping_read(),
+            *capabilities_failed_read(),
+            *flash_write_fast_data_credits(1),
+            b'\xff\xff',
+            b'\x00\x08',
+            b'\xff\xff\xff\x92\x00\x00\x00\x01',
+            b'\x3e\x56'
+        ]
+
+        with open('test_flash_write.s19', 'w') as fout:
+            binfile = bincopy.BinFile()
+            binfile.add_binary(b''.join(chunks), 0x1d000000)
+            fout.write(binfile.as_srec())
+
+        with patch('sys.argv', argv):
+            with self.assertRaises(SystemExit) as cm:
+                pictools.main()
+
+            self.assertEqual(
+                str(cm.exception),
+                'error: 110: PIC command timeout when writing row at 0x1d000100')
+
+        expected_writes = [
+            programmer_ping_write(),
+            connect_write(),
+            ping_write(),
+            capabilities_write(),
+            flash_write_fast_write(0x1d000000, 512, 0x56ee, 0x144f),
+            flash_write_fast_data_write(chunks[0]),
+            flash_write_fast_data_write(chunks[1])
+        ]
+
+        self.assert_calls(serial.Serial.write.call_args_list,
+                          expected_writes)
+
     def test_flash_read_all(self):
         binfile = bincopy.BinFile('tests/files/test_flash_read_all.s19')
         flash_read_reads = []
 
-        for _, data in binfile.segments.chunks(504):
+        for _, data in binfile.segments.chunks(65536):
             flash_read_reads += flash_read_read(data)
 
         flash_read_writes = []
 
-        for address, data in binfile.segments.chunks(504):
+        for address, data in binfile.segments.chunks(65536):
             flash_read_writes.append(flash_read_write(address, len(data)))
 
         self.assert_command(
@@ -435,12 +933,14 @@ class PicToolsTest(unittest.TestCase):
                 *programmer_ping_read(),
                 *connect_read(),
                 *ping_read(),
+                *capabilities_read(),
                 *flash_read_reads
             ],
             [
                 programmer_ping_write(),
                 connect_write(),
                 ping_write(),
+                capabilities_write(),
                 *flash_read_writes
             ])
 
@@ -476,12 +976,14 @@ class PicToolsTest(unittest.TestCase):
                 *programmer_ping_read(),
                 *connect_read(),
                 *ping_read(),
+                *capabilities_failed_read(),
                 *flash_read_reads
             ],
             [
                 programmer_ping_write(),
                 connect_write(),
                 ping_write(),
+                capabilities_write(),
                 *flash_read_writes
             ])
 
@@ -493,6 +995,48 @@ class PicToolsTest(unittest.TestCase):
 
         self.assertEqual(actual, expected)
 
+    def test_flash_read_fast(self):
+        data = bincopy.BinFile('tests/files/test_flash_read.s19').as_binary()
+        data_reads = []
+
+        # Type and size are read separately, as the type is peeked.
+        for offset in range(0, len(data), 1024):
+            header, payload, footer = production_read(
+                0,
+                data[offset:offset + 1024])
+            data_reads += [header[:2], header[2:], payload, footer]
+
+        # The unaligned area is widened to whole words.
+        self.assert_command(
+            [
+                'pictools',
+                'flash_read',
+                '0x1d000022',
+                '0xe7d',
+                'test_flash_read.s19'
+            ],
+            [
+                *programmer_ping_read(),
+                *connect_read(),
+                *ping_read(),
+                *capabilities_read(0x100),
+                *data_reads,
+                *production_read(120)
+            ],
+            [
+                programmer_ping_write(),
+                connect_write(),
+                ping_write(),
+                capabilities_write(),
+                production_write(120, struct.pack('>II', 0x1d000020, 0xe80))
+            ])
+
+        expected = bincopy.BinFile()
+        expected.add_binary(data[2:2 + 0xe7d], 0x1d000022)
+
+        with open('test_flash_read.s19', 'r') as fin:
+            self.assertEqual(fin.read(), expected.as_srec())
+
     def test_flash_erase(self):
         self.assert_command(
             [
@@ -514,6 +1058,51 @@ class PicToolsTest(unittest.TestCase):
                 flash_erase_write(0x1d001000, 0x3000, 0x7974)
             ])
 
+    def test_flash_blank_check(self):
+        self.assert_command(
+            [
+                'pictools',
+                'flash_blank_check',
+                '0x1d000000',
+                '0x1000'
+            ],
+            [
+                *programmer_ping_read(),
+                *connect_read(),
+                *ping_read(),
+                *flash_blank_check_read()
+            ],
+            [
+                programmer_ping_write(),
+                connect_write(),
+                ping_write(),
+                flash_blank_check_write(0x1d000000, 0x1000, 0xec18)
+            ],
+            [
+                'Programmer is alive.',
+                'Connected to PIC.',
+                'PIC is alive.',
+                '0x1d000000-0x1d001000 is blank.',
+                ''
+            ])
+
+    def test_flash_blank_check_not_blank(self):
+        argv = ['pictools', 'flash_blank_check', '0x1d000000', '0x1000']
+
+        serial.Serial.read.side_effect = [
+            *programmer_ping_read(),
+            *connect_read(),
+            *ping_read(),
+            *flash_blank_check_read(0x1d000010)
+        ]
+
+        with patch('sys.argv', argv):
+            with self.assertRaises(SystemExit) as cm:
+                pictools.main()
+
+        self.assertEqual(str(cm.exception),
+                         'error: 0x1d000010 is not blank.')
+
     def test_device_status_print(self):
         self.assert_command(['pictools', 'device_status_print'],
                            [
@@ -542,8 +1131,6 @@ class PicToolsTest(unittest.TestCase):
             bytes(range(40)),
             [
                 'Programmer is alive.',
-                'Connected to PIC.',
-                'PIC is alive.',
                 'FDEVOPT',
                 '  USERID: 1798',
                 '  FVBUSIO: 0',
@@ -585,7 +1172,29 @@ class PicToolsTest(unittest.TestCase):
             b'\x12\x34\x56\x78',
             [
                 'Programmer is alive.',
-                'Connected to PIC.',
+                'DEVID',
+                '  VER: 7',
+                '  DEVID: 0x08563412',
+                ''
+            ])
+
+    def test_device_id_print_connected(self):
+        self.assert_command(
+            ['pictools', 'device_id_print'],
+            [
+                *programmer_ping_read(),
+                *is_connected_read(),
+                *ping_read(),
+                *flash_read_read(b'\x12\x34\x56\x78')
+            ],
+            [
+                programmer_ping_write(),
+                read_words_write(0x1f803660, 1),
+                ping_write(),
+                flash_read_write(0x1f803660, 4)
+            ],
+            [
+                'Programmer is alive.',
                 'PIC is alive.',
                 'DEVID',
                 '  VER: 7',
@@ -600,8 +1209,6 @@ class PicToolsTest(unittest.TestCase):
             bytes(range(20)),
             [
                 'Programmer is alive.',
-                'Connected to PIC.',
-                'PIC is alive.',
                 'UDID',
                 '  UDID1: 0x03020100',
                 '  UDID2: 0x07060504',
@@ -648,12 +1255,266 @@ class PicToolsTest(unittest.TestCase):
                 ''
             ])
 
+    def test_programmer_capabilities(self):
+        self.assert_command(
+            ['pictools', 'programmer_capabilities'],
+            [
+                *programmer_ping_read(),
+                *capabilities_read()
+            ],
+            [
+                programmer_ping_write(),
+                capabilities_write()
+            ],
+            [
+                'Programmer is alive.',
+                'Protocol version:         2',
+                'Maximum request payload:  1024',
+                'Maximum response payload: 65536',
+                'Row size:                 256',
+                'Fast write window:        8',
+                'Optional commands:        blank_check, read_words',
+                'Staging slice size:       16384',
+                ''
+            ])
+
+    def test_programmer_stats(self):
+        payload = struct.pack('>13I',
+                              2000000,
+                              500000, 262144,
+                              900000, 1048576,
+                              100000, 4096,
+                              250, 16,
+                              20000, 262160,
+                              0, 0)
+
+        self.assert_command(
+            ['pictools', 'programmer_stats'],
+            [
+                *programmer_ping_read(),
+                *production_read(117, payload)
+            ],
+            [
+                programmer_ping_write(),
+                production_write(117, b'')
+            ],
+            [
+                'Programmer is alive.',
+                'Phase             Time [ms]      Bytes      Bytes/s',
+                'Receive wait        500.000     262144       524288',
+                'ICSP shifting       900.000    1048576      1165084',
+                'PRACC polling       100.000       4096        40960',
+                'FASTDATA wait         0.250         16        64000',
+                'CRC                  20.000     262160     13108000',
+                'Chip erase poll       0.000          0            -',
+                'Other               479.750          -            -',
+                'Total              2000.000          -            -',
+                ''
+            ])
+
+    def test_programmer_trace_start(self):
+        self.assert_command(
+            ['pictools', 'programmer_trace_start'],
+            [
+                *programmer_ping_read(),
+                *production_read(118)
+            ],
+            [
+                programmer_ping_write(),
+                production_write(118, b'\x01')
+            ],
+            [
+                'Programmer is alive.',
+                'Trace started.',
+                ''
+            ])
+
+    def test_programmer_trace_analyze(self):
+        entries = b''.join([
+            struct.pack('>IIBBH', 0, 84, 0x40, 106, 0),
+            struct.pack('>IIBBH', 100, 184, 0x41, 0x0a, 5),
+            struct.pack('>IIBBH', 200, 284, 0x42, 0x0a, 32),
+            struct.pack('>IIBBH', 300, 384, 0xc2, 0x0a, 32),
+            struct.pack('>IIBBH', 400, 8800, 0xc3, 0x0e, 528),
+            struct.pack('>IIBBH', 9000, 9084, 0x40, 118, 0)
+        ])
+
+        self.assert_command(
+            ['pictools', 'programmer_trace_analyze', '--dump'],
+            [
+                *programmer_ping_read(),
+                *production_read(118),
+                *production_read(119, struct.pack('>II', 8, 2) + entries),
+                *production_read(119, struct.pack('>II', 8, 8))
+            ],
+            [
+                programmer_ping_write(),
+                production_write(118, b'\x00'),
+                production_write(119, b'\x00\x00\x00\x00'),
+                production_write(119, b'\x00\x00\x00\x08')
+            ],
+            [
+                'Programmer is alive.',
+                '2 of 8 entries overwritten.',
+                '     Start  Cycles Kind            TAP  Instr',
+                '         0 command PROGRAMMER_FAST_WRITE',
+                '       100      84 instruction     ETAP 0x0a    5 bits',
+                '       200      84 data            ETAP 0x0a   32 bits',
+                '       300      84 data            ETAP 0x0a   32 bits PrAcc',
+                '       400    8400 fast_data_write ETAP 0x0e  528 bits PrAcc',
+                '      9000 command PROGRAMMER_TRACE_CONTROL',
+                'Command                       Scans  Payload Overhead   Eff.  '
+                'Polls Misses  ICSP [ms]  Idle [ms]',
+                'PROGRAMMER_FAST_WRITE            19      512      181  73.9%      '
+                '2      1      0.103      0.001',
+                'Total                            19      512      181  73.9%      '
+                '2      1      0.103      0.001',
+                ''
+            ])
+
+    def test_production_store(self):
+        with open('test_flash_write.s19', 'w') as fout:
+            binfile = bincopy.BinFile()
+            binfile.add_binary(b'\x12\x34', 0x9d000004)
+            binfile.add_binary(bytes(range(256)), 0x9d000100)
+            fout.write(binfile.as_srec())
+
+        # One segment of two rows.
+        data = 4 * b'\xff' + b'\x12\x34' + 250 * b'\xff' + bytes(range(256))
+        image = struct.pack('>IIIHH',
+                            0x1d000000,
+                            512,
+                            binascii.crc32(data),
+                            pictools.crc_ccitt(data),
+                            0)
+        image += data
+
+        self.assert_command(
+            [
+                'pictools',
+                '-t', 'icsp_spi',
+                'production_store',
+                '--chip-erase',
+                '--verify',
+                'test_flash_write.s19'
+            ],
+            [
+                *programmer_ping_read(),
+                *disconnect_read(),
+                *reset_read(),
+                *production_read(113),
+                *production_read(113),
+                *production_read(114)
+            ],
+            [
+                programmer_ping_write(),
+                disconnect_write(),
+                reset_write(),
+                production_write(113, b'\x00\x00\x00\x00' + image[:512]),
+                production_write(113, b'\x00\x00\x02\x00' + image[512:]),
+                production_write(114,
+                                 struct.pack('>BIIB',
+                                             0x3,
+                                             528,
+                                             binascii.crc32(image),
+                                             1))
+            ])
+
+    def test_production_disable(self):
+        self.assert_command(
+            ['pictools', 'production_disable'],
+            [
+                *programmer_ping_read(),
+                *production_read(114)
+            ],
+            [
+                programmer_ping_write(),
+                production_write(114, 9 * b'\x00')
+            ],
+            [
+                'Programmer is alive.',
+                'Production mode disabled.',
+                ''
+            ])
+
+    def test_production_status(self):
+        self.assert_command(
+            ['pictools', 'production_status'],
+            [
+                *programmer_ping_read(),
+                *production_read(115, struct.pack('>BIIi', 1, 3, 1, -10003))
+            ],
+            [
+                programmer_ping_write(),
+                production_write(115, b'')
+            ],
+            [
+                'Programmer is alive.',
+                'Production mode: enabled',
+                'Passed:          3',
+                'Failed:          1',
+                'Last failure:    error: 10003: flash verify failed',
+                ''
+            ])
+
+    def test_programmer_version_usb(self):
+        argv = ['pictools', '-p', 'usb', 'programmer_version']
+        device = Mock()
+        device.read.side_effect = [
+            b''.join(programmer_ping_read()),
+            b''.join(programmer_version_read())
+        ]
+        usb = Mock()
+        usb.core.find.return_value = device
+        modules = {
+            'usb': usb,
+            'usb.core': usb.core,
+            'usb.util': usb.util
+        }
+        stdout = StringIO()
+
+        with patch.dict('sys.modules', modules):
+            with patch('sys.argv', argv):
+                with patch('sys.stdout', stdout):
+                    pictools.main()
+
+        self.assertEqual(stdout.getvalue(), 'Programmer is alive.\n1.2.3\n')
+        usb.core.find.assert_called_once_with(idVendor=0x2341,
+                                              idProduct=0x003e)
+        self.assertEqual(device.write.call_args_list,
+                         [
+                             call(0x04, b'\x00\x64\x00\x00\xc3\x6b', 1000),
+                             call(0x04, b'\x00\x6b\x00\x00\xef\x5a', 1000)
+                         ])
+        # Whole packets are read, and buffered until used.
+        self.assertEqual(device.read.call_args_list,
+                         [call(0x85, 512, 1000), call(0x85, 512, 1000)])
+        serial.Serial.__init__.assert_not_called()
+
+    def test_loader_upload_instructions(self):
+        instructions = pictools.loader_upload_instructions()
+        expected = [word for word, _ in pictools.RAMAPP_LOADER]
+
+        # Fewer instructions than one lui and ori per word.
+        self.assertLess(len(instructions), 2 * len(expected))
+
+        # The stored loader is identical, even if each instruction is
+        # executed twice.
+        for repeat in [1, 2]:
+            ram, address = execute_loader_upload_instructions(
+                [instruction
+                 for instruction in instructions
+                 for _ in range(repeat)])
+            self.assertEqual(address, pictools.RAMAPP_LOADER_ADDRESS)
+            self.assertEqual(ram, expected)
+
     def test_generate_ramapp_upload_instructions(self):
         argv = [
             'pictools',
             'generate_ramapp_upload_instructions',
             'tests/files/ramapp.out',
-            'test_generate_ramapp_upload_instructions.i'
+            'test_generate_ramapp_upload_instructions.i',
+            'test_generate_ramapp_image.i'
         ]
 
         with open('tests/files/ramapp.dis', 'rb') as fin:
@@ -672,6 +1533,62 @@ class PicToolsTest(unittest.TestCase):
 
         self.assertEqual(actual, expected)
 
+        with open('tests/files/ramapp_image.i', 'r') as fin:
+            expected = fin.read()
+            expected = expected.format(pictools.__version__)
+
+        with open('test_generate_ramapp_image.i', 'r') as fin:
+            actual = fin.read()
+
+        self.assertEqual(actual, expected)
+
+    def test_generate_ramapp_ext_images(self):
+        argv = [
+            'pictools',
+            'generate_ramapp_ext_images',
+            'test_generate_ramapp_ext_images.i',
+            'tests/files/blank_check.out'
+        ]
+
+        with open('tests/files/blank_check.dis', 'rb') as fin:
+            check_output = Mock(return_value=fin.read())
+
+        with patch('subprocess.check_output', check_output):
+            with patch('sys.argv', argv):
+                pictools.main()
+
+        with open('tests/files/ramapp_ext_images.i', 'r') as fin:
+            expected = fin.read()
+            expected = expected.replace('version {}.',
+                                        'version {}.'.format(
+                                            pictools.__version__))
+
+        with open('test_generate_ramapp_ext_images.i', 'r') as fin:
+            actual = fin.read()
+
+        self.assertEqual(actual, expected)
+
+    def test_generate_icsp_spi_sequences(self):
+        argv = [
+            'pictools',
+            'generate_icsp_spi_sequences',
+            'test_generate_icsp_spi_sequences.i'
+        ]
+
+        with patch('sys.argv', argv):
+            pictools.main()
+
+        with open('tests/files/icsp_spi_sequences.i', 'r') as fin:
+            expected = fin.read()
+            expected = expected.replace('version {}.',
+                                        'version {}.'.format(
+                                            pictools.__version__))
+
+        with open('test_generate_icsp_spi_sequences.i', 'r') as fin:
+            actual = fin.read()
+
+        self.assertEqual(actual, expected)
+
     def test_execute_command_wrong_response(self):
         argv = ['pictools', 'device_status_print']
 